@@ -6,6 +6,7 @@ import os
 import sys
 import re
 import json
+import gzip
 
 # 현재 디렉토리를 sys.path에 추가 (inference.py import용)
 current_dir = os.path.dirname(os.path.abspath(__file__))
@@ -14,6 +15,7 @@ if current_dir not in sys.path:
 from typing import Dict, List, Optional, Set, Tuple
 from fastapi import FastAPI, HTTPException
 from fastapi.middleware.cors import CORSMiddleware
+from fastapi.responses import StreamingResponse
 from pydantic import BaseModel
 import uvicorn
 
@@ -479,17 +481,50 @@ class BoneInfo(BaseModel):
     children: Optional[List[str]] = None
 
 class MappingRequest(BaseModel):
-    bones: List[BoneInfo]
+    # 플러그인은 compact 형식 사용: 이름 테이블 + 부모 인덱스 (-1 = 루트)
+    names: Optional[List[str]] = None
+    parents: Optional[List[int]] = None
+    # 기존 형식 (본마다 parent/children 이름) - 수동 호출/구버전 호환
+    bones: Optional[List[BoneInfo]] = None
     use_ai: bool = True
 
+class BatchSkeleton(BaseModel):
+    names: List[str]
+    parents: List[int]
+
+class BatchMappingRequest(BaseModel):
+    skeletons: List[BatchSkeleton]
+    use_ai: bool = True
+
+def bones_from_compact(names: List[str], parents: List[int]) -> Dict:
+    """이름 테이블 + 부모 인덱스 → {name: {"parent", "children"}} (자식 목록 복원, O(N))"""
+    all_bones = {name: {"parent": None, "children": []} for name in names}
+    for i, name in enumerate(names):
+        parent_idx = parents[i] if i < len(parents) else -1
+        if 0 <= parent_idx < len(names):
+            parent_name = names[parent_idx]
+            all_bones[name]["parent"] = parent_name
+            all_bones[parent_name]["children"].append(name)
+    return all_bones
+
+def build_bone_dict(request) -> Dict:
+    """MappingRequest / ApproveRequest → {name: {"parent", "children"}}"""
+    if request.names is not None:
+        return bones_from_compact(request.names, request.parents or [])
+    return {b.name: {"parent": b.parent, "children": b.children or []} for b in (request.bones or [])}
+
 class MappingResponse(BaseModel):
     mapping: Dict[str, str]
     method: str
     bone_count: int
+    model_version: str
 
 class ApproveRequest(BaseModel):
     skeleton_name: str
-    bones: List[BoneInfo]
+    # compact 형식 (플러그인) 또는 기존 bones 형식
+    names: Optional[List[str]] = None
+    parents: Optional[List[int]] = None
+    bones: Optional[List[BoneInfo]] = None
     mapping: Dict[str, str]
 
 class ApproveResponse(BaseModel):
@@ -505,9 +540,55 @@ AUTO_TRAIN_THRESHOLD = 10  # 10개 쌓이면 자동 학습
 app = FastAPI(title="Bone Mapping API v4.0", version="4.0.0")
 app.add_middleware(CORSMiddleware, allow_origins=["*"], allow_methods=["*"], allow_headers=["*"])
 
+class GzipRequestMiddleware:
+    """Content-Encoding: gzip 요청 본문 해제 (플러그인이 큰 스켈레톤 요청을 압축해서 보냄)"""
+    def __init__(self, app):
+        self.app = app
+
+    async def __call__(self, scope, receive, send):
+        if scope["type"] != "http":
+            return await self.app(scope, receive, send)
+        headers = dict(scope.get("headers") or [])
+        if headers.get(b"content-encoding", b"").lower() != b"gzip":
+            return await self.app(scope, receive, send)
+
+        body = b""
+        more_body = True
+        while more_body:
+            message = await receive()
+            body += message.get("body", b"")
+            more_body = message.get("more_body", False)
+        data = gzip.decompress(body)
+
+        scope = dict(scope)
+        scope["headers"] = [(k, v) for k, v in scope["headers"] if k not in (b"content-encoding", b"content-length")]
+        scope["headers"].append((b"content-length", str(len(data)).encode()))
+
+        body_sent = False
+        async def decompressed_receive():
+            nonlocal body_sent
+            if body_sent:
+                return await receive()
+            body_sent = True
+            return {"type": "http.request", "body": data, "more_body": False}
+
+        await self.app(scope, decompressed_receive, send)
+
+app.add_middleware(GzipRequestMiddleware)
+
 ai_inference = None
 ai_loaded = False
 
+# 모델 버전 (규칙 버전 + LoRA 어댑터 수정 시각) - 클라이언트 매핑 캐시 무효화용
+RULE_VERSION = "chain_analysis_v4"
+LORA_ADAPTER_PATH = os.path.join(os.path.dirname(__file__), "..", "03_fine_tuning", "checkpoints", "bone_mapping_lora", "adapter_config.json")
+
+def get_model_version() -> str:
+    """재학습되면 어댑터 파일이 갱신되므로 버전이 바뀜"""
+    if os.path.exists(LORA_ADAPTER_PATH):
+        return f"{RULE_VERSION}-{int(os.path.getmtime(LORA_ADAPTER_PATH))}"
+    return RULE_VERSION
+
 @app.on_event("startup")
 async def startup():
     global ai_inference, ai_loaded
@@ -521,17 +602,17 @@ async def startup():
 
 @app.get("/health")
 async def health():
-    return {"status": "healthy", "ai_ready": ai_loaded}
+    return {"status": "healthy", "ai_ready": ai_loaded, "model_version": get_model_version()}
 
 @app.post("/predict", response_model=MappingResponse)
 async def predict_mapping(request: MappingRequest):
     """체인 기반 분석으로 매핑"""
     
     # 본 정보 구축
-    all_bones = {b.name: {"parent": b.parent, "children": b.children or []} for b in request.bones}
+    all_bones = build_bone_dict(request)
     
     print(f"\n{'='*60}")
-    print(f"[Mapping] {len(request.bones)} bones")
+    print(f"[Mapping] {len(all_bones)} bones")
     print(f"{'='*60}")
     
     # 체인 기반 분석
@@ -543,8 +624,9 @@ async def predict_mapping(request: MappingRequest):
     
     return MappingResponse(
         mapping=final_mapping,
-        method="chain_analysis_v4",
-        bone_count=len(final_mapping)
+        method=RULE_VERSION,
+        bone_count=len(final_mapping),
+        model_version=get_model_version()
     )
 
 def count_approved_samples() -> int:
@@ -585,6 +667,37 @@ def trigger_auto_training():
     thread = threading.Thread(target=run_training, daemon=True)
     thread.start()
 
+@app.post("/predict_batch")
+async def predict_batch(request: BatchMappingRequest):
+    """여러 스켈레톤 매핑 - 동일 스켈레톤은 한 번만 분석, 끝나는 대로 NDJSON 한 줄씩 전송
+    각 줄: {"index": 요청 배열 위치, "mapping", "method", "bone_count", "model_version"}"""
+    
+    # 동일 스켈레톤 묶기 (의상 세트/군중 변형은 대부분 같은 뼈대)
+    groups: Dict[Tuple, List[int]] = {}
+    for i, skel in enumerate(request.skeletons):
+        groups.setdefault((tuple(skel.names), tuple(skel.parents)), []).append(i)
+    
+    print(f"\n{'='*60}")
+    print(f"[Batch] {len(request.skeletons)} skeletons ({len(groups)} unique)")
+    print(f"{'='*60}")
+    
+    model_version = get_model_version()
+    
+    def stream():
+        # 동기 제너레이터 → 스레드풀에서 실행, 스켈레톤마다 바로 flush
+        for (names, parents), indices in groups.items():
+            final_mapping = analyze_and_map_skeleton(bones_from_compact(list(names), list(parents)))
+            for i in indices:
+                yield json.dumps({
+                    "index": i,
+                    "mapping": final_mapping,
+                    "method": RULE_VERSION,
+                    "bone_count": len(final_mapping),
+                    "model_version": model_version
+                }, ensure_ascii=False) + "\n"
+    
+    return StreamingResponse(stream(), media_type="application/x-ndjson")
+
 @app.post("/approve", response_model=ApproveResponse)
 async def approve_mapping(request: ApproveRequest):
     """매핑 승인 - 학습 데이터로 저장 + 자동 학습 트리거"""
@@ -595,7 +708,7 @@ async def approve_mapping(request: ApproveRequest):
     print(f"{'='*60}")
     
     # 본 정보 딕셔너리 구축
-    bone_info = {b.name: {"parent": b.parent, "children": b.children or []} for b in request.bones}
+    bone_info = build_bone_dict(request)
     
     # 학습 데이터 형식으로 변환
     training_entries = []
@@ -749,8 +862,24 @@ async def classify_batch(bones: List[BoneClassificationFeedback]):
     }
 
 if __name__ == "__main__":
+    import argparse
+
+    # 에디터 플러그인은 빈 포트를 골라 --port로 넘김 (수동 실행은 기본 8000)
+    parser = argparse.ArgumentParser(description="Bone Mapping API server")
+    parser.add_argument("--host", default="0.0.0.0")
+    parser.add_argument("--port", type=int, default=8000)
+    parser.add_argument("--log", default=None, help="stdout/stderr를 이 파일로 기록")
+    args = parser.parse_args()
+
+    if args.log:
+        log_file = open(args.log, "w", encoding="utf-8", buffering=1)
+        sys.stdout = log_file
+        sys.stderr = log_file
+
     print("="*60)
     print("Bone Mapping API v4.0")
     print("체인 기반 분석 + 다중 신호 종합")
+    print(f"Listening on {args.host}:{args.port}")
     print("="*60)
-    uvicorn.run(app, host="0.0.0.0", port=8000)
+    # 에디터 HTTP 클라이언트가 연결을 재사용하도록 keep-alive를 길게 유지
+    uvicorn.run(app, host=args.host, port=args.port, timeout_keep_alive=120)
@@ -0,0 +1,10 @@
+#!/usr/bin/env sh
+# 수동 실행용 (Linux / macOS). 에디터 플러그인은 Python을 직접 실행하므로 필요 없음
+# 사용: ./start_server.sh [--port 8000]
+cd "$(dirname "$0")"
+if [ -x python/bin/python3 ]; then
+    PYTHON=python/bin/python3
+else
+    PYTHON=python3
+fi
+exec "$PYTHON" 04_inference/api_server.py "$@" > server_log.txt 2>&1
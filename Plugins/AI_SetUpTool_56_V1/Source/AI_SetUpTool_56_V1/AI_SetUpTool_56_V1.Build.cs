@@ -19,12 +19,12 @@ public class AI_SetUpTool_56_V1 : ModuleRules
 			"Projects", "UnrealEd", "EditorFramework", "ToolMenus",
 			"AssetRegistry", "AssetTools", "ControlRigDeveloper",
 			"ControlRigEditor", "EditorScriptingUtilities",
-			"MeshUtilitiesCommon", "MeshUtilitiesEngine",  // 본 버텍스 정보용
 			"IKRig", "IKRigEditor",  // IK Rig 생성용
 			"DesktopPlatform",  // 폴더 선택 다이얼로그용
 			"AnimGraph", "AnimGraphRuntime", "BlueprintGraph",  // AnimBlueprint 생성용
 			"Kismet", "KismetCompiler",  // Blueprint 편집용
-			"AppFramework"  // 컬러 피커용
+			"AppFramework",  // 컬러 피커용
+			"Sockets"  // AI 서버 빈 포트 탐색용
 		});
 		
 		// Kawaii Physics는 외부 플러그인이므로 동적 로딩 사용
@@ -0,0 +1,182 @@
+#include "AIRigSetupCommandlet.h"
+#include "SControlRigToolWidget.h"
+#include "BoneMappingBatch.h"
+#include "MeshBoneHierarchy.h"
+#include "AIServerLauncher.h"
+#include "HttpModule.h"
+#include "HttpManager.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/SkeletalMesh.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/PackageName.h"
+
+UAIRigSetupCommandlet::UAIRigSetupCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+
+	HelpDescription = TEXT("AI bone mapping + Control Rig / IK Rig / Physics Asset / Kawaii AnimBP batch setup");
+	HelpUsage = TEXT("-run=AIRigSetup (-Meshes=<Path>+<Path> | -Folder=<ContentPath>) [-Template=] [-IKTemplate=] [-Output=] [-Skip=] [-Csv=]");
+}
+
+int32 UAIRigSetupCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	// ========================================================================
+	// 1. 대상 메쉬 수집
+	// ========================================================================
+	IAssetRegistry& AR = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AR.SearchAllAssets(true);
+
+	TArray<FString> MeshPaths;
+	if (const FString* MeshesParam = ParamValues.Find(TEXT("Meshes")))
+	{
+		MeshesParam->ParseIntoArray(MeshPaths, TEXT("+"), true);
+	}
+	if (const FString* FolderParam = ParamValues.Find(TEXT("Folder")))
+	{
+		FARFilter Filter;
+		Filter.ClassPaths.Add(USkeletalMesh::StaticClass()->GetClassPathName());
+		Filter.PackagePaths.Add(FName(**FolderParam));
+		Filter.bRecursiveClasses = true;
+		Filter.bRecursivePaths = true;
+		TArray<FAssetData> Assets;
+		AR.GetAssets(Filter, Assets);
+		for (const FAssetData& Asset : Assets)
+		{
+			MeshPaths.AddUnique(Asset.PackageName.ToString());
+		}
+	}
+	MeshPaths.Sort();
+
+	if (MeshPaths.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[AIRigSetup] No meshes. Usage: %s"), *HelpUsage);
+		return 1;
+	}
+
+	// ========================================================================
+	// 2. 공통 작업 설정
+	// ========================================================================
+	FAIRigSetupJob BaseJob;
+	BaseJob.TemplatePath = ParamValues.FindRef(TEXT("Template"));
+	BaseJob.IKRigTemplatePath = ParamValues.FindRef(TEXT("IKTemplate"));
+	if (const FString* OutputParam = ParamValues.Find(TEXT("Output")))
+	{
+		BaseJob.OutputFolder = *OutputParam;
+	}
+
+	TArray<FString> SkipStages;
+	ParamValues.FindRef(TEXT("Skip")).ParseIntoArray(SkipStages, TEXT("+"), true);
+	BaseJob.bControlRig = !SkipStages.Contains(TEXT("ControlRig"));
+	BaseJob.bIKRig = !SkipStages.Contains(TEXT("IKRig"));
+	BaseJob.bPhysicsAsset = !SkipStages.Contains(TEXT("PhysicsAsset"));
+	BaseJob.bKawaii = !SkipStages.Contains(TEXT("Kawaii"));
+
+	UE_LOG(LogTemp, Display, TEXT("[AIRigSetup] ========== %d meshes -> %s =========="), MeshPaths.Num(), *BaseJob.OutputFolder);
+
+	// ========================================================================
+	// 3. 본 매핑 일괄 요청 (결과는 디스크 캐시에 저장 → 메쉬별 실행에서 캐시 적중)
+	// ========================================================================
+	{
+		TSharedRef<FBoneMappingBatch> Batch = MakeShared<FBoneMappingBatch>();
+		for (const FString& MeshPath : MeshPaths)
+		{
+			if (const FReferenceSkeleton* RefSkeleton = FMeshBoneHierarchy::Read(MeshPath))
+			{
+				Batch->Add(MeshPath, FPackageName::GetShortName(MeshPath), *RefSkeleton);
+			}
+		}
+
+		int32 MappedCount = 0;
+		const double BatchStartTime = FPlatformTime::Seconds();
+		const bool bSent = Batch->Send(
+			FBoneMappingBatch::FOnSkeletonMapped::CreateLambda([&MappedCount](const FString&, const TMap<FName, FName>&, const FString&)
+			{
+				MappedCount++;
+			}),
+			FBoneMappingBatch::FOnBatchFinished());
+
+		// Commandlet에는 엔진 틱이 없으므로 직접 틱 (실패/타임아웃이면 메쉬별 요청으로 진행)
+		const double Deadline = BatchStartTime + BaseJob.MappingTimeout;
+		while (bSent && !Batch->IsFinished() && FPlatformTime::Seconds() < Deadline)
+		{
+			FTSTicker::GetCoreTicker().Tick(0.05f);
+			FHttpModule::Get().GetHttpManager().Tick(0.05f);
+			FPlatformProcess::Sleep(0.05f);
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("[AIRigSetup] Bone mapping prefetch: %d/%d meshes (%d unique skeletons sent, %.2fs)"),
+			MappedCount, MeshPaths.Num(), Batch->NumServerSkeletons(), FPlatformTime::Seconds() - BatchStartTime);
+	}
+
+	// ========================================================================
+	// 4. 메쉬별 실행 (메쉬마다 새 헤드리스 위젯 - 이전 상태 공유 X)
+	// ========================================================================
+	TArray<FAIRigSetupReport> Reports;
+	for (const FString& MeshPath : MeshPaths)
+	{
+		FAIRigSetupJob Job = BaseJob;
+		Job.MeshPath = MeshPath;
+
+		TSharedRef<SControlRigToolWidget> Tool = SNew(SControlRigToolWidget).Headless(true);
+		FAIRigSetupReport& Report = Reports.AddDefaulted_GetRef();
+		Tool->RunHeadlessSetup(Job, Report);
+
+		// 생성 에셋/로드한 메쉬 정리
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	// ========================================================================
+	// 5. 요약 (에셋별 단계 시간)
+	// ========================================================================
+	int32 FailedCount = 0;
+	double TotalSeconds = 0.0;
+	FString Csv = TEXT("Mesh,Stage,Seconds,Result\n");
+
+	UE_LOG(LogTemp, Display, TEXT("[AIRigSetup] ========== Summary =========="));
+	for (const FAIRigSetupReport& Report : Reports)
+	{
+		FString Line;
+		for (const FAIRigSetupStageTiming& Timing : Report.Stages)
+		{
+			const TCHAR* Result = Timing.bSkipped ? TEXT("skipped") : (Timing.bSuccess ? TEXT("ok") : TEXT("FAILED"));
+			Line += Timing.bSkipped
+				? FString::Printf(TEXT("%s skipped | "), *Timing.Stage)
+				: FString::Printf(TEXT("%s %.2fs%s | "), *Timing.Stage, Timing.Seconds, Timing.bSuccess ? TEXT("") : TEXT(" FAILED"));
+			Csv += FString::Printf(TEXT("%s,%s,%.3f,%s\n"), *Report.MeshName, *Timing.Stage, Timing.Seconds, Result);
+		}
+		for (const FPackageSaveResult& Saved : Report.SavedPackages)
+		{
+			Csv += FString::Printf(TEXT("%s,Save %s (%lld bytes),%.3f,%s\n"), *Report.MeshName,
+				*FPackageName::GetShortName(Saved.PackageName), Saved.SizeBytes, Saved.Seconds, Saved.bSuccess ? TEXT("ok") : TEXT("FAILED"));
+		}
+		Csv += FString::Printf(TEXT("%s,Total,%.3f,%s\n"), *Report.MeshName, Report.TotalSeconds, Report.bSuccess ? TEXT("ok") : TEXT("FAILED"));
+
+		UE_LOG(LogTemp, Display, TEXT("[AIRigSetup] %-32s %sTotal %.2fs %s"),
+			*Report.MeshName, *Line, Report.TotalSeconds, Report.bSuccess ? TEXT("OK") : TEXT("FAILED"));
+
+		TotalSeconds += Report.TotalSeconds;
+		if (!Report.bSuccess)
+		{
+			FailedCount++;
+		}
+	}
+	UE_LOG(LogTemp, Display, TEXT("[AIRigSetup] %d/%d succeeded, %.2fs total"), Reports.Num() - FailedCount, Reports.Num(), TotalSeconds);
+
+	if (const FString* CsvParam = ParamValues.Find(TEXT("Csv")))
+	{
+		FFileHelper::SaveStringToFile(Csv, **CsvParam);
+		UE_LOG(LogTemp, Display, TEXT("[AIRigSetup] Report: %s"), **CsvParam);
+	}
+
+	return FailedCount > 0 ? 1 : 0;
+}
@@ -0,0 +1,281 @@
+#include "AIServerLauncher.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/Paths.h"
+#include "SocketSubsystem.h"
+#include "Sockets.h"
+#include "IPAddress.h"
+
+// 모델 로드(PyTorch)까지 기다리는 최대 시간
+static constexpr double ServerStartupTimeout = 180.0;
+static constexpr double HealthPollInterval = 0.5;
+// 시작 실패 후 재시도까지 대기 (그동안은 바로 네이티브 폴백)
+static constexpr double RelaunchCooldown = 60.0;
+
+FAIServerLauncher& FAIServerLauncher::Get()
+{
+	static FAIServerLauncher Instance;
+	return Instance;
+}
+
+FString FAIServerLauncher::GetURL(const FString& Endpoint) const
+{
+	return FString::Printf(TEXT("http://127.0.0.1:%d%s"), Port, *Endpoint);
+}
+
+bool FAIServerLauncher::Send(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request, const FString& Endpoint, bool bStartIfNeeded)
+{
+	// 서버 프로세스가 죽었으면 다시 띄움
+	if (State == EState::Ready && !FPlatformProcess::IsProcRunning(ProcessHandle))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] API server exited, will relaunch on demand"));
+		StopProcess();
+		State = EState::Stopped;
+	}
+
+	if (State == EState::Ready)
+	{
+		Request->SetURL(GetURL(Endpoint));
+		return Request->ProcessRequest();
+	}
+
+	if (!bStartIfNeeded) return false;
+
+	if (State == EState::Failed && FPlatformTime::Seconds() - FailedTime > RelaunchCooldown)
+	{
+		State = EState::Stopped;
+	}
+
+	if (State == EState::Failed)
+	{
+		// 바로 전송 → 연결 실패 콜백에서 호출부 폴백 처리
+		Request->SetURL(GetURL(Endpoint));
+		return Request->ProcessRequest();
+	}
+
+	PendingRequests.Add({ Request, Endpoint });
+
+	if (State == EState::Stopped && !Launch())
+	{
+		FinishStartup(false);
+	}
+	return true;
+}
+
+bool FAIServerLauncher::ResolveServerPaths(FString& OutPython, FString& OutScript, FString& OutWorkingDir) const
+{
+	const FString ScriptRelPath = TEXT("BoneMapping_AI/04_inference/api_server.py");
+
+	// 플러그인 위치 후보 (IPluginManager → 프로젝트 → 엔진 → 프로젝트 루트)
+	TArray<FString> PluginDirs;
+	if (TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("AI_SetUpTool_56_V1")))
+	{
+		PluginDirs.Add(FPaths::ConvertRelativePathToFull(Plugin->GetBaseDir()));
+	}
+	PluginDirs.Add(FPaths::ConvertRelativePathToFull(FPaths::ProjectPluginsDir() / TEXT("AI_SetUpTool_56_V1")));
+	PluginDirs.Add(FPaths::ConvertRelativePathToFull(FPaths::EnginePluginsDir() / TEXT("AI_SetUpTool_56_V1")));
+	PluginDirs.Add(FPaths::ConvertRelativePathToFull(FPaths::ProjectDir()) / TEXT("Plugins/AI_SetUpTool_56_V1"));
+
+	for (const FString& PluginDir : PluginDirs)
+	{
+		if (!FPaths::FileExists(PluginDir / ScriptRelPath)) continue;
+
+		OutScript = PluginDir / ScriptRelPath;
+		OutWorkingDir = PluginDir / TEXT("BoneMapping_AI");
+
+		// 내장 Python 우선, 없으면 시스템 Python
+#if PLATFORM_WINDOWS
+		OutPython = OutWorkingDir / TEXT("python/python.exe");
+		if (!FPaths::FileExists(OutPython))
+		{
+			OutPython = TEXT("python");
+		}
+#else
+		OutPython = OutWorkingDir / TEXT("python/bin/python3");
+		if (!FPaths::FileExists(OutPython))
+		{
+			OutPython = TEXT("/usr/bin/python3");
+		}
+#endif
+		return true;
+	}
+	return false;
+}
+
+int32 FAIServerLauncher::FindFreePort()
+{
+	// 포트 0으로 바인드 → OS가 고른 빈 포트 번호만 가져오고 닫음
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	if (!SocketSubsystem) return 0;
+
+	FSocket* Socket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("AIServerPortProbe"), false);
+	if (!Socket) return 0;
+
+	TSharedRef<FInternetAddr> Addr = SocketSubsystem->CreateInternetAddr();
+	bool bIsValid = false;
+	Addr->SetIp(TEXT("127.0.0.1"), bIsValid);
+	Addr->SetPort(0);
+
+	int32 FreePort = 0;
+	if (Socket->Bind(*Addr))
+	{
+		FreePort = Socket->GetPortNo();
+	}
+	Socket->Close();
+	SocketSubsystem->DestroySocket(Socket);
+	return FreePort;
+}
+
+bool FAIServerLauncher::Launch()
+{
+	// 이전 프로세스 핸들이 남아 있으면 정리 (덮어쓰면 그 프로세스는 에디터 종료 후에도 남음)
+	if (ProcessHandle.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] Stopping previous API server (PID: %u) before relaunch"), ProcessId);
+		StopProcess();
+	}
+
+	FString PythonPath, ServerScript, WorkingDir;
+	if (!ResolveServerPaths(PythonPath, ServerScript, WorkingDir))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] API server script not found!"));
+		return false;
+	}
+
+	Port = FindFreePort();
+	if (Port == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] No free port for API server"));
+		return false;
+	}
+
+	const FString LogFile = WorkingDir / TEXT("server_log.txt");
+	const FString Args = FString::Printf(TEXT("\"%s\" --host 127.0.0.1 --port %d --log \"%s\""), *ServerScript, Port, *LogFile);
+
+	ProcessHandle = FPlatformProcess::CreateProc(
+		*PythonPath,
+		*Args,
+		true,   // bLaunchDetached
+		true,   // bLaunchHidden
+		true,   // bLaunchReallyHidden
+		&ProcessId,
+		0,      // Priority
+		*WorkingDir,
+		nullptr
+	);
+
+	if (!ProcessHandle.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] Failed to start API server: %s %s"), *PythonPath, *Args);
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] API server starting (PID: %u, port %d, python: %s)"), ProcessId, Port, *PythonPath);
+
+	State = EState::Starting;
+	LaunchTime = FPlatformTime::Seconds();
+	LastHealthPollTime = 0.0;
+	bHealthRequestInFlight = false;
+	StartupTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FAIServerLauncher::TickStartup));
+	return true;
+}
+
+bool FAIServerLauncher::TickStartup(float DeltaTime)
+{
+	if (State != EState::Starting)
+	{
+		StartupTickerHandle.Reset();
+		return false;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (!FPlatformProcess::IsProcRunning(ProcessHandle))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] API server exited during startup (see BoneMapping_AI/server_log.txt)"));
+		StartupTickerHandle.Reset();
+		FinishStartup(false);
+		return false;
+	}
+	if (Now - LaunchTime > ServerStartupTimeout)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] API server not ready after %.0fs"), ServerStartupTimeout);
+		StartupTickerHandle.Reset();
+		FinishStartup(false);
+		return false;
+	}
+
+	// /health 응답 = startup 이벤트(모델 로드) 완료
+	if (!bHealthRequestInFlight && Now - LastHealthPollTime >= HealthPollInterval)
+	{
+		LastHealthPollTime = Now;
+		bHealthRequestInFlight = true;
+
+		TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Req = FHttpModule::Get().CreateRequest();
+		Req->SetURL(GetURL(TEXT("/health")));
+		Req->SetVerb(TEXT("GET"));
+		Req->SetTimeout(2.0f);
+		Req->OnProcessRequestComplete().BindLambda([this](FHttpRequestPtr, FHttpResponsePtr Res, bool Ok)
+		{
+			bHealthRequestInFlight = false;
+			if (State == EState::Starting && Ok && Res.IsValid() && Res->GetResponseCode() == 200)
+			{
+				UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] API server ready on port %d (%.1fs)"), Port, FPlatformTime::Seconds() - LaunchTime);
+				FinishStartup(true);
+			}
+		});
+		Req->ProcessRequest();
+	}
+	return true;
+}
+
+void FAIServerLauncher::FinishStartup(bool bReady)
+{
+	State = bReady ? EState::Ready : EState::Failed;
+	if (!bReady)
+	{
+		FailedTime = FPlatformTime::Seconds();
+		// /health 응답 없이 시간 초과된 프로세스도 종료 (모델을 올린 채 남지 않도록)
+		StopProcess();
+	}
+
+	// 대기 요청 전송 (실패면 연결 실패 콜백으로 각 호출부가 폴백)
+	TArray<FPendingRequest> Requests = MoveTemp(PendingRequests);
+	PendingRequests.Reset();
+	for (FPendingRequest& Pending : Requests)
+	{
+		Pending.Request->SetURL(GetURL(Pending.Endpoint));
+		Pending.Request->ProcessRequest();
+	}
+}
+
+void FAIServerLauncher::Shutdown()
+{
+	if (StartupTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(StartupTickerHandle);
+		StartupTickerHandle.Reset();
+	}
+
+	if (ProcessHandle.IsValid())
+	{
+		StopProcess();
+		UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] API server stopped"));
+	}
+
+	PendingRequests.Reset();
+	State = EState::Stopped;
+}
+
+void FAIServerLauncher::StopProcess()
+{
+	if (!ProcessHandle.IsValid()) return;
+
+	if (FPlatformProcess::IsProcRunning(ProcessHandle))
+	{
+		FPlatformProcess::TerminateProc(ProcessHandle, true);
+	}
+	FPlatformProcess::CloseProc(ProcessHandle);
+	ProcessHandle.Reset();
+	ProcessId = 0;
+}
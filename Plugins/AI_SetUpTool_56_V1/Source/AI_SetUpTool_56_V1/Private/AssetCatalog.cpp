@@ -0,0 +1,295 @@
+#include "AssetCatalog.h"
+#include "ControlRigTemplateSnapshot.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Misc/PackageName.h"
+
+FAssetCatalog& FAssetCatalog::Get()
+{
+	static FAssetCatalog Instance;
+	return Instance;
+}
+
+FAssetCatalog::FAssetCatalog()
+{
+	Indices[static_cast<int32>(EAssetCatalogClass::ControlRig)].ClassPath = FTopLevelAssetPath(TEXT("/Script/ControlRigDeveloper"), TEXT("ControlRigBlueprint"));
+	Indices[static_cast<int32>(EAssetCatalogClass::SkeletalMesh)].ClassPath = FTopLevelAssetPath(TEXT("/Script/Engine"), TEXT("SkeletalMesh"));
+	Indices[static_cast<int32>(EAssetCatalogClass::IKRig)].ClassPath = FTopLevelAssetPath(TEXT("/Script/IKRig"), TEXT("IKRigDefinition"));
+}
+
+void FAssetCatalog::RegisterHooks()
+{
+	IAssetRegistry& AR = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	if (!AddedHandle.IsValid())
+	{
+		AddedHandle = AR.OnAssetAdded().AddRaw(this, &FAssetCatalog::OnAssetAdded);
+	}
+	if (!RemovedHandle.IsValid())
+	{
+		RemovedHandle = AR.OnAssetRemoved().AddRaw(this, &FAssetCatalog::OnAssetRemoved);
+	}
+	if (!RenamedHandle.IsValid())
+	{
+		RenamedHandle = AR.OnAssetRenamed().AddRaw(this, &FAssetCatalog::OnAssetRenamed);
+	}
+}
+
+void FAssetCatalog::UnregisterHooks()
+{
+	if (FAssetRegistryModule* ARM = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		IAssetRegistry& AR = ARM->Get();
+		AR.OnAssetAdded().Remove(AddedHandle);
+		AR.OnAssetRemoved().Remove(RemovedHandle);
+		AR.OnAssetRenamed().Remove(RenamedHandle);
+	}
+	AddedHandle.Reset();
+	RemovedHandle.Reset();
+	RenamedHandle.Reset();
+
+	if (BroadcastTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(BroadcastTickerHandle);
+		BroadcastTickerHandle.Reset();
+	}
+
+	for (FClassIndex& Index : Indices)
+	{
+		Index.ClassPaths.Empty();
+		Index.ByPackage.Empty();
+		Index.PackageByName.Empty();
+		Index.Sorted.Empty();
+		Index.bSortedDirty = true;
+	}
+	bInitialized = false;
+}
+
+void FAssetCatalog::EnsureInitialized()
+{
+	if (bInitialized) return;
+	bInitialized = true;
+
+	IAssetRegistry& AR = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	// 최초 1회 전체 스캔 (이후는 이벤트로만 갱신)
+	// 초기 검색 중에 호출돼도 나중에 발견되는 에셋은 OnAssetAdded로 들어옴
+	int32 Total = 0;
+	for (FClassIndex& Index : Indices)
+	{
+		Index.ClassPaths.Reset();
+		Index.ClassPaths.Add(Index.ClassPath);
+		AR.GetDerivedClassNames({ Index.ClassPath }, {}, Index.ClassPaths);
+
+		FARFilter Filter;
+		Filter.ClassPaths.Add(Index.ClassPath);
+		Filter.bRecursiveClasses = true;
+		Filter.bRecursivePaths = true;
+		TArray<FAssetData> Assets;
+		AR.GetAssets(Filter, Assets);
+
+		Index.ByPackage.Reserve(Assets.Num());
+		Index.PackageByName.Reserve(Assets.Num());
+		for (const FAssetData& Asset : Assets)
+		{
+			AddEntry(Index, Asset);
+		}
+		Index.bSortedDirty = true;
+		Total += Index.ByPackage.Num();
+	}
+
+	++Revision;
+	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Asset catalog built: %d assets"), Total);
+}
+
+const TArray<FAssetCatalogEntry>& FAssetCatalog::GetSorted(EAssetCatalogClass Class)
+{
+	EnsureInitialized();
+
+	FClassIndex& Index = Indices[static_cast<int32>(Class)];
+	if (Index.bSortedDirty)
+	{
+		Index.Sorted.Reset(Index.ByPackage.Num());
+		for (const TPair<FName, FAssetCatalogEntry>& Pair : Index.ByPackage)
+		{
+			Index.Sorted.Add(Pair.Value);
+		}
+		Index.Sorted.Sort([](const FAssetCatalogEntry& A, const FAssetCatalogEntry& B) { return A.Name < B.Name; });
+		Index.bSortedDirty = false;
+	}
+	return Index.Sorted;
+}
+
+const FAssetCatalogEntry* FAssetCatalog::FindByName(EAssetCatalogClass Class, const FString& Name)
+{
+	EnsureInitialized();
+
+	FClassIndex& Index = Indices[static_cast<int32>(Class)];
+	const FName* PackageName = Index.PackageByName.Find(Name);
+	return PackageName ? Index.ByPackage.Find(*PackageName) : nullptr;
+}
+
+const FAssetCatalogEntry* FAssetCatalog::FindByPackage(EAssetCatalogClass Class, const FString& PackagePath)
+{
+	EnsureInitialized();
+
+	// "/Game/A/B.B" 형태도 허용
+	const FString PackageName = PackagePath.Contains(TEXT(".")) ? FPackageName::ObjectPathToPackageName(PackagePath) : PackagePath;
+	return Indices[static_cast<int32>(Class)].ByPackage.Find(FName(*PackageName));
+}
+
+FString FAssetCatalog::FindPackagePathByName(EAssetCatalogClass Class, const FString& Name)
+{
+	const FAssetCatalogEntry* Entry = FindByName(Class, Name);
+	return Entry ? Entry->PackagePath : FString();
+}
+
+void FAssetCatalog::FilterOptions(const TArray<TSharedPtr<FString>>& Source, const FString& FilterText, TArray<TSharedPtr<FString>>& OutFiltered)
+{
+	OutFiltered.Reset();
+
+	FString Trimmed = FilterText.TrimStartAndEnd();
+	if (Trimmed.IsEmpty())
+	{
+		OutFiltered = Source;
+		return;
+	}
+
+	// 공백으로 나눈 단어가 모두 포함돼야 통과 ("mann sk" → SK_Mannequin)
+	TArray<FString> Tokens;
+	Trimmed.ParseIntoArrayWS(Tokens);
+
+	for (const TSharedPtr<FString>& Option : Source)
+	{
+		if (!Option.IsValid()) continue;
+
+		bool bMatch = true;
+		for (const FString& Token : Tokens)
+		{
+			if (!Option->Contains(Token, ESearchCase::IgnoreCase))
+			{
+				bMatch = false;
+				break;
+			}
+		}
+		if (bMatch)
+		{
+			OutFiltered.Add(Option);
+		}
+	}
+}
+
+FAssetCatalog::FClassIndex* FAssetCatalog::FindIndexForAsset(const FAssetData& Asset)
+{
+	for (FClassIndex& Index : Indices)
+	{
+		if (Index.ClassPaths.Contains(Asset.AssetClassPath))
+		{
+			return &Index;
+		}
+	}
+	return nullptr;
+}
+
+bool FAssetCatalog::AddEntry(FClassIndex& Index, const FAssetData& Asset)
+{
+	if (Index.ByPackage.Contains(Asset.PackageName)) return false;
+
+	// 템플릿 스냅샷(베이크 에셋)은 템플릿 목록에 노출하지 않음
+	if (Asset.PackagePath.ToString().StartsWith(FControlRigTemplateSnapshotCache::SnapshotFolder)) return false;
+
+	FAssetCatalogEntry& Entry = Index.ByPackage.Add(Asset.PackageName);
+	Entry.Name = Asset.AssetName.ToString();
+	Entry.PackagePath = Asset.PackageName.ToString();
+	Entry.ObjectPath = Asset.GetObjectPathString();
+	Entry.NameOption = MakeShared<FString>(Entry.Name);
+	Entry.ObjectPathOption = MakeShared<FString>(Entry.ObjectPath);
+
+	if (!Index.PackageByName.Contains(Entry.Name))
+	{
+		Index.PackageByName.Add(Entry.Name, Asset.PackageName);
+	}
+	Index.bSortedDirty = true;
+	return true;
+}
+
+bool FAssetCatalog::RemoveEntry(FClassIndex& Index, FName PackageName)
+{
+	FAssetCatalogEntry Removed;
+	if (!Index.ByPackage.RemoveAndCopyValue(PackageName, Removed)) return false;
+
+	// 이름 인덱스가 지운 패키지를 가리키면 같은 이름의 다른 에셋으로 교체 (드문 경우만 선형 탐색)
+	const FName* IndexedPackage = Index.PackageByName.Find(Removed.Name);
+	if (IndexedPackage && *IndexedPackage == PackageName)
+	{
+		Index.PackageByName.Remove(Removed.Name);
+		for (const TPair<FName, FAssetCatalogEntry>& Pair : Index.ByPackage)
+		{
+			if (Pair.Value.Name == Removed.Name)
+			{
+				Index.PackageByName.Add(Removed.Name, Pair.Key);
+				break;
+			}
+		}
+	}
+	Index.bSortedDirty = true;
+	return true;
+}
+
+void FAssetCatalog::MarkChanged()
+{
+	++Revision;
+
+	// 같은 프레임의 변경은 모아서 다음 틱에 한 번만 알림
+	if (!BroadcastTickerHandle.IsValid())
+	{
+		BroadcastTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this](float)
+		{
+			BroadcastTickerHandle.Reset();
+			ChangedEvent.Broadcast();
+			return false;
+		}));
+	}
+}
+
+void FAssetCatalog::OnAssetAdded(const FAssetData& Asset)
+{
+	// 아직 안 만든 카탈로그는 최초 조회 때 스캔하므로 무시
+	if (!bInitialized) return;
+
+	if (FClassIndex* Index = FindIndexForAsset(Asset))
+	{
+		if (AddEntry(*Index, Asset))
+		{
+			MarkChanged();
+		}
+	}
+}
+
+void FAssetCatalog::OnAssetRemoved(const FAssetData& Asset)
+{
+	if (!bInitialized) return;
+
+	if (FClassIndex* Index = FindIndexForAsset(Asset))
+	{
+		if (RemoveEntry(*Index, Asset.PackageName))
+		{
+			MarkChanged();
+		}
+	}
+}
+
+void FAssetCatalog::OnAssetRenamed(const FAssetData& Asset, const FString& OldObjectPath)
+{
+	if (!bInitialized) return;
+
+	if (FClassIndex* Index = FindIndexForAsset(Asset))
+	{
+		const bool bRemoved = RemoveEntry(*Index, FName(*FPackageName::ObjectPathToPackageName(OldObjectPath)));
+		const bool bAdded = AddEntry(*Index, Asset);
+		if (bRemoved || bAdded)
+		{
+			MarkChanged();
+		}
+	}
+}
@@ -0,0 +1,307 @@
+#include "BoneKeywordClassifier.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace BoneKeywordTables
+{
+	struct FCategoryTable
+	{
+		const TCHAR* ConfigName;
+		EBoneKeyword Category;
+		TArray<const TCHAR*> Contains;
+		TArray<const TCHAR*> Exact;
+	};
+
+	// ============================================================================
+	// 기본 키워드 테이블 (소문자)
+	// 프로젝트 설정 파일의 같은 이름 카테고리에 키워드를 추가할 수 있음
+	// ============================================================================
+	static const TArray<FCategoryTable>& GetDefaultTables()
+	{
+		static const TArray<FCategoryTable> Tables = {
+			// 제로 뼈구조 (UE5 표준 본)
+			{ TEXT("zero"), EBoneKeyword::Zero, {}, {
+				// 루트/몸통
+				TEXT("root"), TEXT("pelvis"),
+				TEXT("spine_01"), TEXT("spine_02"), TEXT("spine_03"), TEXT("spine_04"), TEXT("spine_05"),
+				TEXT("neck_01"), TEXT("neck_02"), TEXT("head"),
+				// 팔
+				TEXT("clavicle_l"), TEXT("upperarm_l"), TEXT("lowerarm_l"), TEXT("hand_l"),
+				TEXT("clavicle_r"), TEXT("upperarm_r"), TEXT("lowerarm_r"), TEXT("hand_r"),
+				// 다리
+				TEXT("thigh_l"), TEXT("calf_l"), TEXT("foot_l"), TEXT("ball_l"),
+				TEXT("thigh_r"), TEXT("calf_r"), TEXT("foot_r"), TEXT("ball_r"),
+				// 왼쪽 손가락
+				TEXT("thumb_01_l"), TEXT("thumb_02_l"), TEXT("thumb_03_l"),
+				TEXT("index_01_l"), TEXT("index_02_l"), TEXT("index_03_l"),
+				TEXT("middle_01_l"), TEXT("middle_02_l"), TEXT("middle_03_l"),
+				TEXT("ring_01_l"), TEXT("ring_02_l"), TEXT("ring_03_l"),
+				TEXT("pinky_01_l"), TEXT("pinky_02_l"), TEXT("pinky_03_l"),
+				// 오른쪽 손가락
+				TEXT("thumb_01_r"), TEXT("thumb_02_r"), TEXT("thumb_03_r"),
+				TEXT("index_01_r"), TEXT("index_02_r"), TEXT("index_03_r"),
+				TEXT("middle_01_r"), TEXT("middle_02_r"), TEXT("middle_03_r"),
+				TEXT("ring_01_r"), TEXT("ring_02_r"), TEXT("ring_03_r"),
+				TEXT("pinky_01_r"), TEXT("pinky_02_r"), TEXT("pinky_03_r"),
+				// IK 본 (템플릿 전용)
+				TEXT("ik_foot_root"), TEXT("ik_foot_l"), TEXT("ik_foot_r"),
+				TEXT("ik_hand_root"), TEXT("ik_hand_gun"), TEXT("ik_hand_l"), TEXT("ik_hand_r"),
+				TEXT("heel_l"), TEXT("heel_r"), TEXT("tip_l"), TEXT("tip_r")
+			} },
+
+			// 액세서리 (컨트롤러 생성 O) - 의상, 머리카락, 무기 등
+			{ TEXT("accessory"), EBoneKeyword::Accessory, {
+				// 의상/망토
+				TEXT("skirt"), TEXT("cape"), TEXT("cloak"), TEXT("cloth"), TEXT("ribbon"), TEXT("tassel"),
+				TEXT("coat"), TEXT("jacket"), TEXT("robe"), TEXT("scarf"), TEXT("collar_cloth"), TEXT("sleeve"),
+				// 머리카락
+				TEXT("hair"), TEXT("ponytail"), TEXT("pigtail"), TEXT("braid"), TEXT("longhair"), TEXT("bangs"),
+				// 가슴/물리
+				TEXT("breast"), TEXT("boob"), TEXT("chest_physics"),
+				// 무기/악세서리
+				TEXT("weapon"), TEXT("sword"), TEXT("shield"), TEXT("bow"), TEXT("quiver"),
+				TEXT("earring"), TEXT("necklace"), TEXT("accessory"), TEXT("ornament"),
+				TEXT("belt"), TEXT("pouch"), TEXT("bag"),
+				// 기타 부속
+				TEXT("tail"), TEXT("wing"), TEXT("antenna"),
+				// 일반 접두사
+				TEXT("bone_acc"), TEXT("_acc_"), TEXT("acc_"), TEXT("bone_"),
+				// 얼굴 관련 (세컨더리로 생성)
+				TEXT("eye"), TEXT("jaw"), TEXT("mouth"), TEXT("eyebrow"), TEXT("eyelid"), TEXT("brow"),
+				TEXT("tongue"), TEXT("teeth"), TEXT("lip"), TEXT("nose"), TEXT("cheek"), TEXT("ear_"),
+				TEXT("facial"), TEXT("face_")
+			}, {} },
+
+			// 헬퍼 (컨트롤러 생성 X) - 너무 일반적인 키워드는 제외 (얼굴 본 등에 영향)
+			{ TEXT("helper"), EBoneKeyword::Helper, {
+				// 트위스트/롤 본
+				TEXT("twist"), TEXT("roll"), TEXT("_tw"),
+				// 보정 본
+				TEXT("corrective"), TEXT("blend"),
+				// 더미/종단 본
+				TEXT("nub"), TEXT("dummy"),
+				// IK 관련
+				TEXT("ik_"), TEXT("_ik"), TEXT("ikgoal"), TEXT("ikpole"),
+				// 컨트롤/가이드 (이미 컨트롤러인 것)
+				TEXT("ctrl"), TEXT("control"), TEXT("helper"), TEXT("guide"),
+				// 보조 본
+				TEXT("lookat"), TEXT("aim_"), TEXT("target"),
+				TEXT("aux_"), TEXT("add_"),
+				TEXT("_dm_"), TEXT("_ph_"),
+				TEXT("metacarpal"), TEXT("attach"),
+				TEXT("interpolate"), TEXT("driver")
+			}, {} },
+
+			// 세컨더리 Space 대상 최상위 본
+			{ TEXT("bip_root"), EBoneKeyword::BipRoot, { TEXT("bip001"), TEXT("bip_001"), TEXT("bip-001") }, { TEXT("bip") } },
+			{ TEXT("scene_root"), EBoneKeyword::SceneRoot, { TEXT("armature") }, { TEXT("root") } },
+
+			// Physics Asset 캡슐 규칙
+			{ TEXT("physics_skip"), EBoneKeyword::PhysicsSkip, { TEXT("root") }, {} },
+			{ TEXT("physics_upright"), EBoneKeyword::PhysicsUpright, { TEXT("spine"), TEXT("pelvis"), TEXT("hips") }, {} },
+			{ TEXT("physics_finger"), EBoneKeyword::PhysicsFinger, { TEXT("finger"), TEXT("thumb"), TEXT("index"), TEXT("middle"), TEXT("ring"), TEXT("pinky") }, {} },
+			{ TEXT("physics_hand"), EBoneKeyword::PhysicsHand, { TEXT("hand"), TEXT("wrist") }, {} },
+			{ TEXT("physics_clavicle"), EBoneKeyword::PhysicsClavicle, { TEXT("clavicle"), TEXT("shoulder") }, {} },
+			{ TEXT("physics_spine"), EBoneKeyword::PhysicsSpine, { TEXT("spine") }, {} },
+			{ TEXT("physics_upperarm"), EBoneKeyword::PhysicsUpperArm, { TEXT("upperarm"), TEXT("upper_arm") }, {} },
+			{ TEXT("physics_lowerarm"), EBoneKeyword::PhysicsLowerArm, { TEXT("forearm"), TEXT("lowerarm"), TEXT("lower_arm") }, {} },
+
+			// 팔/다리 본 방향 강제 캡슐
+			{ TEXT("chain_upperarm"), EBoneKeyword::ChainUpperArm, { TEXT("upperarm"), TEXT("upper_arm") }, {} },
+			{ TEXT("chain_forearm"), EBoneKeyword::ChainForearm, { TEXT("forearm"), TEXT("lower_arm") }, {} },
+			{ TEXT("chain_thigh"), EBoneKeyword::ChainThigh, { TEXT("thigh") }, {} },
+			{ TEXT("chain_calf"), EBoneKeyword::ChainCalf, { TEXT("calf"), TEXT("shin"), TEXT("lowerleg") }, {} },
+		};
+		return Tables;
+	}
+}
+
+TUniquePtr<FBoneKeywordClassifier>& FBoneKeywordClassifier::GetInstance()
+{
+	static TUniquePtr<FBoneKeywordClassifier> Instance;
+	return Instance;
+}
+
+const FBoneKeywordClassifier& FBoneKeywordClassifier::Get()
+{
+	TUniquePtr<FBoneKeywordClassifier>& Instance = GetInstance();
+	if (!Instance.IsValid())
+	{
+		Instance.Reset(new FBoneKeywordClassifier());
+	}
+	return *Instance;
+}
+
+void FBoneKeywordClassifier::Reload()
+{
+	GetInstance().Reset(new FBoneKeywordClassifier());
+}
+
+FBoneKeywordClassifier::FBoneKeywordClassifier()
+{
+	Nodes.AddDefaulted();  // 루트 노드
+
+	for (const BoneKeywordTables::FCategoryTable& Table : BoneKeywordTables::GetDefaultTables())
+	{
+		for (const TCHAR* Keyword : Table.Contains)
+		{
+			AddContains(Keyword, Table.Category);
+		}
+		for (const TCHAR* Keyword : Table.Exact)
+		{
+			AddExact(Keyword, Table.Category);
+		}
+	}
+
+	LoadConfigFile(FPaths::ProjectConfigDir() / TEXT("AIRigSetup") / TEXT("BoneKeywords.json"));
+	Compile();
+
+	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Bone keyword classifier compiled: %d states, %d exact names"),
+		Nodes.Num(), ExactMatches.Num());
+}
+
+void FBoneKeywordClassifier::AddContains(const FString& Keyword, EBoneKeyword Category)
+{
+	const FString Lower = Keyword.ToLower();
+	if (Lower.IsEmpty()) return;
+
+	int32 State = 0;
+	for (TCHAR Ch : Lower)
+	{
+		int32* NextState = Nodes[State].Next.Find(Ch);
+		if (NextState)
+		{
+			State = *NextState;
+		}
+		else
+		{
+			const int32 NewState = Nodes.AddDefaulted();
+			Nodes[State].Next.Add(Ch, NewState);
+			State = NewState;
+		}
+	}
+	Nodes[State].Output |= Category;
+}
+
+void FBoneKeywordClassifier::AddExact(const FString& Keyword, EBoneKeyword Category)
+{
+	const FString Lower = Keyword.ToLower();
+	if (Lower.IsEmpty()) return;
+
+	ExactMatches.FindOrAdd(Lower) |= Category;
+}
+
+// ============================================================================
+// 프로젝트 설정 파일 (선택)
+// { "helper": { "contains": ["_jnt_end"] }, "zero": { "exact": ["hip"] } }
+// ============================================================================
+void FBoneKeywordClassifier::LoadConfigFile(const FString& FilePath)
+{
+	FString JsonString;
+	if (!FFileHelper::LoadFileToString(JsonString, *FilePath))
+	{
+		return;
+	}
+
+	TSharedPtr<FJsonObject> Root;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] Failed to parse bone keyword config: %s"), *FilePath);
+		return;
+	}
+
+	int32 Added = 0;
+	for (const auto& Pair : Root->Values)
+	{
+		const BoneKeywordTables::FCategoryTable* Table = BoneKeywordTables::GetDefaultTables().FindByPredicate(
+			[&Pair](const BoneKeywordTables::FCategoryTable& T) { return Pair.Key.Equals(T.ConfigName, ESearchCase::IgnoreCase); });
+
+		const TSharedPtr<FJsonObject>* CategoryObj;
+		if (!Table || !Pair.Value->TryGetObject(CategoryObj))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] Unknown bone keyword category in %s: %s"), *FilePath, *Pair.Key);
+			continue;
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* Keywords;
+		if ((*CategoryObj)->TryGetArrayField(TEXT("contains"), Keywords))
+		{
+			for (const TSharedPtr<FJsonValue>& Value : *Keywords)
+			{
+				AddContains(Value->AsString(), Table->Category);
+				++Added;
+			}
+		}
+		if ((*CategoryObj)->TryGetArrayField(TEXT("exact"), Keywords))
+		{
+			for (const TSharedPtr<FJsonValue>& Value : *Keywords)
+			{
+				AddExact(Value->AsString(), Table->Category);
+				++Added;
+			}
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Loaded %d bone keywords from %s"), Added, *FilePath);
+}
+
+void FBoneKeywordClassifier::Compile()
+{
+	// BFS로 실패 링크 계산, 실패 링크 출력은 미리 합쳐서 매칭 시 추가 탐색 없음
+	TArray<int32> Queue;
+	for (const auto& Pair : Nodes[0].Next)
+	{
+		Nodes[Pair.Value].Fail = 0;
+		Queue.Add(Pair.Value);
+	}
+
+	for (int32 Head = 0; Head < Queue.Num(); ++Head)
+	{
+		const int32 State = Queue[Head];
+		for (const auto& Pair : Nodes[State].Next)
+		{
+			const TCHAR Ch = Pair.Key;
+			const int32 Child = Pair.Value;
+
+			int32 Fallback = Nodes[State].Fail;
+			while (Fallback != 0 && !Nodes[Fallback].Next.Contains(Ch))
+			{
+				Fallback = Nodes[Fallback].Fail;
+			}
+			const int32* Target = Nodes[Fallback].Next.Find(Ch);
+			Nodes[Child].Fail = (Target && *Target != Child) ? *Target : 0;
+			Nodes[Child].Output |= Nodes[Nodes[Child].Fail].Output;
+
+			Queue.Add(Child);
+		}
+	}
+}
+
+EBoneKeyword FBoneKeywordClassifier::Classify(const FString& BoneName) const
+{
+	const FString Lower = BoneName.ToLower();
+
+	EBoneKeyword Result = EBoneKeyword::None;
+	if (const EBoneKeyword* Exact = ExactMatches.Find(Lower))
+	{
+		Result |= *Exact;
+	}
+
+	int32 State = 0;
+	for (TCHAR Ch : Lower)
+	{
+		const int32* NextState = Nodes[State].Next.Find(Ch);
+		while (!NextState && State != 0)
+		{
+			State = Nodes[State].Fail;
+			NextState = Nodes[State].Next.Find(Ch);
+		}
+		State = NextState ? *NextState : 0;
+		Result |= Nodes[State].Output;
+	}
+	return Result;
+}
@@ -0,0 +1,214 @@
+#include "BoneMappingBatch.h"
+#include "BoneMappingCache.h"
+#include "BoneMappingPayload.h"
+#include "NativeBoneMapper.h"
+#include "AIServerLauncher.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/ScopeLock.h"
+
+void FBoneMappingBatch::Add(const FString& Key, const FString& SkeletonName, const FReferenceSkeleton& RefSkeleton)
+{
+	// 본 순서와 무관한 해시 → 메쉬 RefSkeleton / 스켈레톤 에셋 어느 쪽을 넘겨도 세션과 같은 키
+	const FString Hash = FBoneMappingCache::ComputeSkeletonHash(RefSkeleton);
+
+	// 같은 스켈레톤이 이미 요청 대상이면 Key만 추가
+	if (const int32* ExistingIndex = SkeletonIndexByHash.Find(Hash))
+	{
+		Skeletons[*ExistingIndex].Keys.Add(Key);
+		return;
+	}
+
+	TMap<FName, FName> CachedMapping;
+	if (FBoneMappingCache::Get().Find(Hash, CachedMapping))
+	{
+		Resolved.Add({ Key, MoveTemp(CachedMapping), TEXT("cached") });
+		return;
+	}
+
+	TMap<FName, FName> NativeMapping = FNativeBoneMapper::MapSkeleton(RefSkeleton);
+	if (FNativeBoneMapper::IsCoreMappingComplete(NativeMapping))
+	{
+		Resolved.Add({ Key, MoveTemp(NativeMapping), TEXT("native") });
+		return;
+	}
+
+	SkeletonIndexByHash.Add(Hash, Skeletons.Num());
+	FSkeletonEntry& Entry = Skeletons.AddDefaulted_GetRef();
+	Entry.Hash = Hash;
+	Entry.SkeletonName = SkeletonName;
+	Entry.RefSkeleton = RefSkeleton;
+	Entry.NativeMapping = MoveTemp(NativeMapping);
+	Entry.Keys.Add(Key);
+}
+
+bool FBoneMappingBatch::Send(FOnSkeletonMapped InOnMapped, FOnBatchFinished InOnFinished)
+{
+	OnMapped = MoveTemp(InOnMapped);
+	OnFinished = MoveTemp(InOnFinished);
+
+	for (const FResolved& Result : Resolved)
+	{
+		OnMapped.ExecuteIfBound(Result.Key, Result.Mapping, Result.Method);
+	}
+	Resolved.Reset();
+
+	if (Skeletons.Num() == 0)
+	{
+		Finish(true);
+		return false;
+	}
+
+	TArray<const FReferenceSkeleton*> RefSkeletons;
+	RefSkeletons.Reserve(Skeletons.Num());
+	for (const FSkeletonEntry& Entry : Skeletons)
+	{
+		RefSkeletons.Add(&Entry.RefSkeleton);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Batch mapping request: %d unique skeletons"), Skeletons.Num());
+
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Req = FHttpModule::Get().CreateRequest();
+	Req->SetVerb(TEXT("POST"));
+	FBoneMappingPayload::SetJsonBody(Req, FBoneMappingPayload::BuildPredictBatchRequest(RefSkeletons));
+	Req->SetTimeout(120.0f + 10.0f * Skeletons.Num());
+
+	// 본문은 누적하지 않고 받는 대로 줄 단위 처리
+	TWeakPtr<FBoneMappingBatch> WeakThis = AsShared();
+	Req->SetResponseBodyReceiveStreamDelegateV2(FHttpRequestStreamDelegateV2::CreateLambda([WeakThis](void* Ptr, int64& Length)
+	{
+		if (TSharedPtr<FBoneMappingBatch> This = WeakThis.Pin())
+		{
+			This->OnBodyChunk(Ptr, Length);
+		}
+	}));
+	Req->OnRequestProgress64().BindLambda([WeakThis](FHttpRequestPtr, uint64, uint64)
+	{
+		if (TSharedPtr<FBoneMappingBatch> This = WeakThis.Pin())
+		{
+			This->DrainLines(false);
+		}
+	});
+	Req->OnProcessRequestComplete().BindLambda([WeakThis](FHttpRequestPtr, FHttpResponsePtr Res, bool Ok)
+	{
+		TSharedPtr<FBoneMappingBatch> This = WeakThis.Pin();
+		if (!This) return;
+
+		const bool bServerOk = Ok && Res.IsValid() && Res->GetResponseCode() == 200;
+		if (bServerOk)
+		{
+			This->DrainLines(true);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] Batch mapping request failed (%d)"), Res.IsValid() ? Res->GetResponseCode() : 0);
+		}
+		This->Finish(bServerOk);
+	});
+
+	HttpRequest = Req;
+	return FAIServerLauncher::Get().Send(Req, TEXT("/predict_batch"));
+}
+
+void FBoneMappingBatch::Cancel()
+{
+	OnMapped.Unbind();
+	OnFinished.Unbind();
+	bFinished = true;
+
+	if (HttpRequest.IsValid())
+	{
+		HttpRequest->OnProcessRequestComplete().Unbind();
+		HttpRequest->CancelRequest();
+		HttpRequest.Reset();
+	}
+}
+
+void FBoneMappingBatch::OnBodyChunk(const void* Data, int64 Length)
+{
+	FScopeLock Lock(&BufferLock);
+	PendingBytes.Append(static_cast<const uint8*>(Data), Length);
+}
+
+void FBoneMappingBatch::DrainLines(bool bFinal)
+{
+	TArray<FString> Lines;
+	{
+		FScopeLock Lock(&BufferLock);
+		int32 LineStart = 0;
+		for (int32 i = 0; i < PendingBytes.Num(); ++i)
+		{
+			if (PendingBytes[i] == '\n')
+			{
+				Lines.Add(FString(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(PendingBytes.GetData() + LineStart), i - LineStart)));
+				LineStart = i + 1;
+			}
+		}
+		// 마지막 줄은 개행 없이 끝날 수 있음
+		if (bFinal && LineStart < PendingBytes.Num())
+		{
+			Lines.Add(FString(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(PendingBytes.GetData() + LineStart), PendingBytes.Num() - LineStart)));
+			LineStart = PendingBytes.Num();
+		}
+		PendingBytes.RemoveAt(0, LineStart, EAllowShrinking::No);
+	}
+
+	for (const FString& Line : Lines)
+	{
+		if (!Line.TrimStartAndEnd().IsEmpty())
+		{
+			HandleLine(Line);
+		}
+	}
+}
+
+void FBoneMappingBatch::HandleLine(const FString& Line)
+{
+	TMap<FName, FName> ServerMapping;
+	FString ModelVersion;
+	int32 Index = INDEX_NONE;
+	if (!FBoneMappingPayload::ParsePredictResponse(Line, ServerMapping, ModelVersion, &Index) || !Skeletons.IsValidIndex(Index))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] Batch mapping: bad response line"));
+		return;
+	}
+
+	FSkeletonEntry& Entry = Skeletons[Index];
+	if (Entry.bDone) return;
+	Entry.bDone = true;
+
+	// 네이티브 결과 우선, 빈 target만 서버 결과로 채움 (단일 요청과 동일)
+	TMap<FName, FName> MergedMapping = Entry.NativeMapping;
+	FNativeBoneMapper::MergeServerMapping(MergedMapping, ServerMapping);
+
+	if (!ModelVersion.IsEmpty())
+	{
+		FBoneMappingCache::Get().SetModelVersion(ModelVersion);
+	}
+	FBoneMappingCache::Get().Store(Entry.Hash, Entry.SkeletonName, MergedMapping);
+
+	for (const FString& Key : Entry.Keys)
+	{
+		OnMapped.ExecuteIfBound(Key, MergedMapping, TEXT("native + server"));
+	}
+}
+
+void FBoneMappingBatch::Finish(bool bServerOk)
+{
+	if (bFinished) return;
+	bFinished = true;
+	HttpRequest.Reset();
+
+	// 서버 결과가 없는 스켈레톤은 네이티브 부분 매핑으로 전달
+	for (FSkeletonEntry& Entry : Skeletons)
+	{
+		if (Entry.bDone || Entry.NativeMapping.Num() == 0) continue;
+		Entry.bDone = true;
+		for (const FString& Key : Entry.Keys)
+		{
+			OnMapped.ExecuteIfBound(Key, Entry.NativeMapping, TEXT("native only, server unavailable"));
+		}
+	}
+
+	OnFinished.ExecuteIfBound(bServerOk);
+}
@@ -0,0 +1,236 @@
+#include "BoneMappingCache.h"
+#include "ReferenceSkeleton.h"
+#include "Hash/CityHash.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+
+// 캐시 파일 포맷 버전 (포맷 변경 시 증가 → 기존 파일 무시)
+// 2: 스켈레톤 해시를 본 순서와 무관하게 변경
+static constexpr int32 BoneMappingCacheFormatVersion = 2;
+
+FBoneMappingCache& FBoneMappingCache::Get()
+{
+	static FBoneMappingCache Instance;
+	return Instance;
+}
+
+FBoneMappingCache::FBoneMappingCache()
+{
+	Load();
+}
+
+FString FBoneMappingCache::ComputeSkeletonHash(const FReferenceSkeleton& RefSkeleton)
+{
+	// 스켈레톤 에셋은 본 인덱스 순서가 메쉬와 다를 수 있음 → 이름 순 정렬, 부모도 이름으로
+	// 가상 본은 메쉬 / 스켈레톤마다 있을 수도 없을 수도 있으므로 Raw 본만
+	const TArray<FMeshBoneInfo>& BoneInfos = RefSkeleton.GetRawRefBoneInfo();
+	
+	// FName 인덱스는 세션마다 달라지므로 문자열로 해시
+	TArray<TPair<FString, FString>> Bones;
+	Bones.Reserve(BoneInfos.Num());
+	for (const FMeshBoneInfo& Info : BoneInfos)
+	{
+		const FString ParentName = BoneInfos.IsValidIndex(Info.ParentIndex) ? BoneInfos[Info.ParentIndex].Name.ToString() : FString();
+		Bones.Emplace(Info.Name.ToString(), ParentName);
+	}
+	Bones.Sort([](const TPair<FString, FString>& A, const TPair<FString, FString>& B)
+	{
+		return A.Key.Compare(B.Key, ESearchCase::CaseSensitive) < 0;
+	});
+	
+	const int32 NumBones = Bones.Num();
+	uint64 Hash = CityHash64(reinterpret_cast<const char*>(&NumBones), sizeof(NumBones));
+	
+	for (const TPair<FString, FString>& Bone : Bones)
+	{
+		Hash = CityHash64WithSeed(reinterpret_cast<const char*>(*Bone.Key), Bone.Key.Len() * sizeof(TCHAR), Hash);
+		Hash = CityHash64WithSeed(reinterpret_cast<const char*>(*Bone.Value), Bone.Value.Len() * sizeof(TCHAR), Hash);
+	}
+	
+	return FString::Printf(TEXT("%016llx"), Hash);
+}
+
+bool FBoneMappingCache::Find(const FString& SkeletonHash, TMap<FName, FName>& OutMapping) const
+{
+	const FEntry* Entry = Entries.Find(SkeletonHash);
+	if (!Entry || Entry->Mapping.Num() == 0)
+	{
+		return false;
+	}
+	
+	OutMapping = Entry->Mapping;
+	return true;
+}
+
+bool FBoneMappingCache::IsApproved(const FString& SkeletonHash) const
+{
+	const FEntry* Entry = Entries.Find(SkeletonHash);
+	return Entry && Entry->bApproved;
+}
+
+void FBoneMappingCache::Store(const FString& SkeletonHash, const FString& SkeletonName, const TMap<FName, FName>& Mapping, bool bApproved)
+{
+	if (SkeletonHash.IsEmpty() || Mapping.Num() == 0)
+	{
+		return;
+	}
+	
+	// 승인 매핑은 자동 매핑으로 덮어쓰지 않음
+	const FEntry* Existing = Entries.Find(SkeletonHash);
+	if (Existing && Existing->bApproved && !bApproved)
+	{
+		return;
+	}
+	
+	FEntry& Entry = Entries.FindOrAdd(SkeletonHash);
+	Entry.SkeletonName = SkeletonName;
+	Entry.ModelVersion = ModelVersion;
+	Entry.bApproved = bApproved;
+	Entry.Mapping = Mapping;
+	
+	Save();
+	
+	UE_LOG(LogTemp, Log, TEXT("[BoneMappingCache] Stored %s (%s, %d bones%s)"),
+		*SkeletonHash, *SkeletonName, Mapping.Num(), bApproved ? TEXT(", approved") : TEXT(""));
+}
+
+void FBoneMappingCache::SetModelVersion(const FString& NewModelVersion)
+{
+	if (NewModelVersion.IsEmpty() || NewModelVersion == ModelVersion)
+	{
+		return;
+	}
+	
+	// 첫 연결 전(버전 미상)에 저장된 엔트리도 함께 무효화
+	int32 Removed = 0;
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().bApproved && It.Value().ModelVersion != NewModelVersion)
+		{
+			It.RemoveCurrent();
+			++Removed;
+		}
+	}
+	
+	UE_LOG(LogTemp, Log, TEXT("[BoneMappingCache] Model version %s -> %s, invalidated %d entries"),
+		ModelVersion.IsEmpty() ? TEXT("(none)") : *ModelVersion, *NewModelVersion, Removed);
+	
+	ModelVersion = NewModelVersion;
+	Save();
+}
+
+FString FBoneMappingCache::GetCacheFilePath() const
+{
+	return FPaths::ProjectSavedDir() / TEXT("AIRigSetup") / TEXT("BoneMappingCache.json");
+}
+
+void FBoneMappingCache::Load()
+{
+	Entries.Empty();
+	
+	FString JsonString;
+	if (!FFileHelper::LoadFileToString(JsonString, *GetCacheFilePath()))
+	{
+		return;
+	}
+	
+	TSharedPtr<FJsonObject> Root;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[BoneMappingCache] Failed to parse %s, starting empty"), *GetCacheFilePath());
+		return;
+	}
+	
+	int32 FormatVersion = 0;
+	if (!Root->TryGetNumberField(TEXT("format_version"), FormatVersion) || FormatVersion != BoneMappingCacheFormatVersion)
+	{
+		return;
+	}
+	
+	Root->TryGetStringField(TEXT("model_version"), ModelVersion);
+	
+	const TSharedPtr<FJsonObject>* EntriesObj;
+	if (!Root->TryGetObjectField(TEXT("entries"), EntriesObj))
+	{
+		return;
+	}
+	
+	for (const auto& EntryPair : (*EntriesObj)->Values)
+	{
+		const TSharedPtr<FJsonObject>* EntryObj;
+		if (!EntryPair.Value->TryGetObject(EntryObj))
+		{
+			continue;
+		}
+		
+		FEntry Entry;
+		(*EntryObj)->TryGetStringField(TEXT("skeleton"), Entry.SkeletonName);
+		(*EntryObj)->TryGetStringField(TEXT("model_version"), Entry.ModelVersion);
+		(*EntryObj)->TryGetBoolField(TEXT("approved"), Entry.bApproved);
+		
+		const TSharedPtr<FJsonObject>* MappingObj;
+		if ((*EntryObj)->TryGetObjectField(TEXT("mapping"), MappingObj))
+		{
+			for (const auto& Pair : (*MappingObj)->Values)
+			{
+				FString Source;
+				if (Pair.Value->TryGetString(Source))
+				{
+					Entry.Mapping.Add(FName(*Pair.Key), FName(*Source));
+				}
+			}
+		}
+		
+		if (Entry.Mapping.Num() > 0)
+		{
+			Entries.Add(EntryPair.Key, MoveTemp(Entry));
+		}
+	}
+	
+	UE_LOG(LogTemp, Log, TEXT("[BoneMappingCache] Loaded %d entries (model %s)"),
+		Entries.Num(), ModelVersion.IsEmpty() ? TEXT("(none)") : *ModelVersion);
+}
+
+void FBoneMappingCache::Save() const
+{
+	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetNumberField(TEXT("format_version"), BoneMappingCacheFormatVersion);
+	Root->SetStringField(TEXT("model_version"), ModelVersion);
+	
+	TSharedPtr<FJsonObject> EntriesObj = MakeShared<FJsonObject>();
+	for (const auto& EntryPair : Entries)
+	{
+		const FEntry& Entry = EntryPair.Value;
+		TSharedPtr<FJsonObject> EntryObj = MakeShared<FJsonObject>();
+		EntryObj->SetStringField(TEXT("skeleton"), Entry.SkeletonName);
+		EntryObj->SetStringField(TEXT("model_version"), Entry.ModelVersion);
+		EntryObj->SetBoolField(TEXT("approved"), Entry.bApproved);
+		
+		TSharedPtr<FJsonObject> MappingObj = MakeShared<FJsonObject>();
+		for (const auto& Pair : Entry.Mapping)
+		{
+			MappingObj->SetStringField(Pair.Key.ToString(), Pair.Value.ToString());
+		}
+		EntryObj->SetObjectField(TEXT("mapping"), MappingObj);
+		
+		EntriesObj->SetObjectField(EntryPair.Key, EntryObj);
+	}
+	Root->SetObjectField(TEXT("entries"), EntriesObj);
+	
+	FString JsonString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
+	FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
+	
+	const FString FilePath = GetCacheFilePath();
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+	if (!FFileHelper::SaveStringToFile(JsonString, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[BoneMappingCache] Failed to write %s"), *FilePath);
+	}
+}
@@ -0,0 +1,188 @@
+#include "BoneMappingPayload.h"
+#include "ReferenceSkeleton.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Misc/Compression.h"
+
+// 이보다 작은 본문은 압축 비용이 더 큼
+static constexpr int32 GzipThresholdBytes = 16 * 1024;
+
+using FCondensedJsonWriter = TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+
+// "names":[...], "parents":[...] (현재 객체에 필드로 기록)
+static void WriteSkeletonArrays(FCondensedJsonWriter& Writer, const FReferenceSkeleton& RefSkeleton)
+{
+	const int32 NumBones = RefSkeleton.GetNum();
+
+	Writer.WriteArrayStart(TEXT("names"));
+	for (int32 i = 0; i < NumBones; ++i)
+	{
+		Writer.WriteValue(RefSkeleton.GetBoneName(i).ToString());
+	}
+	Writer.WriteArrayEnd();
+
+	Writer.WriteArrayStart(TEXT("parents"));
+	for (int32 i = 0; i < NumBones; ++i)
+	{
+		Writer.WriteValue(RefSkeleton.GetParentIndex(i));
+	}
+	Writer.WriteArrayEnd();
+}
+
+FString FBoneMappingPayload::BuildPredictRequest(const FReferenceSkeleton& RefSkeleton, bool bUseAI)
+{
+	FString Body;
+	Body.Reserve(RefSkeleton.GetNum() * 24);
+
+	TSharedRef<FCondensedJsonWriter> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Body);
+	Writer->WriteObjectStart();
+	WriteSkeletonArrays(*Writer, RefSkeleton);
+	Writer->WriteValue(TEXT("use_ai"), bUseAI);
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	return Body;
+}
+
+FString FBoneMappingPayload::BuildPredictBatchRequest(TConstArrayView<const FReferenceSkeleton*> RefSkeletons, bool bUseAI)
+{
+	int32 TotalBones = 0;
+	for (const FReferenceSkeleton* RefSkeleton : RefSkeletons)
+	{
+		TotalBones += RefSkeleton->GetNum();
+	}
+
+	FString Body;
+	Body.Reserve(TotalBones * 24);
+
+	TSharedRef<FCondensedJsonWriter> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Body);
+	Writer->WriteObjectStart();
+	Writer->WriteArrayStart(TEXT("skeletons"));
+	for (const FReferenceSkeleton* RefSkeleton : RefSkeletons)
+	{
+		Writer->WriteObjectStart();
+		WriteSkeletonArrays(*Writer, *RefSkeleton);
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+	Writer->WriteValue(TEXT("use_ai"), bUseAI);
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	return Body;
+}
+
+FString FBoneMappingPayload::BuildApproveRequest(const FString& SkeletonName, const FReferenceSkeleton& RefSkeleton, const TMap<FName, FName>& Mapping)
+{
+	FString Body;
+	Body.Reserve(RefSkeleton.GetNum() * 24 + Mapping.Num() * 32);
+
+	TSharedRef<FCondensedJsonWriter> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Body);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("skeleton_name"), SkeletonName);
+	WriteSkeletonArrays(*Writer, RefSkeleton);
+	Writer->WriteObjectStart(TEXT("mapping"));
+	for (const TPair<FName, FName>& Pair : Mapping)
+	{
+		Writer->WriteValue(Pair.Key.ToString(), Pair.Value.ToString());
+	}
+	Writer->WriteObjectEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	return Body;
+}
+
+void FBoneMappingPayload::SetJsonBody(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request, const FString& Body)
+{
+	Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	Request->SetHeader(TEXT("Connection"), TEXT("keep-alive"));
+
+	FTCHARToUTF8 Utf8(*Body);
+	const int32 RawSize = Utf8.Length();
+
+	if (RawSize >= GzipThresholdBytes)
+	{
+		int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Gzip, RawSize);
+		TArray<uint8> Compressed;
+		Compressed.SetNumUninitialized(CompressedSize);
+		if (FCompression::CompressMemory(NAME_Gzip, Compressed.GetData(), CompressedSize, Utf8.Get(), RawSize))
+		{
+			Compressed.SetNum(CompressedSize);
+			UE_LOG(LogTemp, Verbose, TEXT("[ControlRigTool] Request body gzip: %d -> %d bytes"), RawSize, CompressedSize);
+			Request->SetHeader(TEXT("Content-Encoding"), TEXT("gzip"));
+			Request->SetContent(MoveTemp(Compressed));
+			return;
+		}
+	}
+
+	TArray<uint8> Raw;
+	Raw.Append(reinterpret_cast<const uint8*>(Utf8.Get()), RawSize);
+	Request->SetContent(MoveTemp(Raw));
+}
+
+bool FBoneMappingPayload::ParsePredictResponse(const FString& Content, TMap<FName, FName>& OutMapping, FString& OutModelVersion, int32* OutIndex)
+{
+	OutMapping.Reset();
+	OutModelVersion.Reset();
+	if (OutIndex)
+	{
+		*OutIndex = INDEX_NONE;
+	}
+
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Content);
+
+	// 루트 객체 = 깊이 1, "mapping" 객체 안 = 깊이 2
+	int32 Depth = 0;
+	bool bInMapping = false;
+	EJsonNotation Notation;
+	while (Reader->ReadNext(Notation))
+	{
+		switch (Notation)
+		{
+		case EJsonNotation::ObjectStart:
+			if (Depth == 1 && Reader->GetIdentifier() == TEXT("mapping"))
+			{
+				bInMapping = true;
+			}
+			++Depth;
+			break;
+		case EJsonNotation::ObjectEnd:
+			--Depth;
+			if (Depth == 1)
+			{
+				bInMapping = false;
+			}
+			break;
+		case EJsonNotation::ArrayStart:
+			++Depth;
+			break;
+		case EJsonNotation::ArrayEnd:
+			--Depth;
+			break;
+		case EJsonNotation::String:
+			if (bInMapping && Depth == 2)
+			{
+				OutMapping.Add(FName(*Reader->GetIdentifier()), FName(*Reader->GetValueAsString()));
+			}
+			else if (Depth == 1 && Reader->GetIdentifier() == TEXT("model_version"))
+			{
+				OutModelVersion = Reader->GetValueAsString();
+			}
+			break;
+		case EJsonNotation::Number:
+			if (OutIndex && Depth == 1 && Reader->GetIdentifier() == TEXT("index"))
+			{
+				*OutIndex = FMath::TruncToInt32(Reader->GetValueAsNumber());
+			}
+			break;
+		case EJsonNotation::Error:
+			return false;
+		default:
+			break;
+		}
+	}
+
+	return Reader->GetErrorMessage().IsEmpty();
+}
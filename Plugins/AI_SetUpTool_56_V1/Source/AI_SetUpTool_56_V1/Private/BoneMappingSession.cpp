@@ -0,0 +1,189 @@
+#include "BoneMappingSession.h"
+#include "BoneMappingCache.h"
+#include "BoneMappingPayload.h"
+#include "NativeBoneMapper.h"
+#include "MeshBoneHierarchy.h"
+#include "FeedbackJournal.h"
+#include "AIServerLauncher.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/PackageName.h"
+#include "ReferenceSkeleton.h"
+
+// 메쉬 패키지 경로 → 세션 (세션 수명은 잡고 있는 탭이 결정)
+static TMap<FString, TWeakPtr<FBoneMappingSession>> GBoneMappingSessions;
+
+TSharedRef<FBoneMappingSession> FBoneMappingSession::FindOrCreate(const FString& MeshPath)
+{
+	// 오브젝트 경로(/Game/A/B.B)와 패키지 경로(/Game/A/B)를 같은 세션으로
+	const FString Key = FPackageName::ObjectPathToPackageName(MeshPath);
+
+	if (TWeakPtr<FBoneMappingSession>* Existing = GBoneMappingSessions.Find(Key))
+	{
+		if (TSharedPtr<FBoneMappingSession> Session = Existing->Pin())
+		{
+			return Session.ToSharedRef();
+		}
+	}
+
+	// 해제된 세션 정리
+	for (auto It = GBoneMappingSessions.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	TSharedRef<FBoneMappingSession> Session = MakeShareable(new FBoneMappingSession(Key));
+	GBoneMappingSessions.Add(Key, Session);
+	return Session;
+}
+
+FBoneMappingSession::FBoneMappingSession(const FString& InMeshPath)
+	: MeshPath(InMeshPath)
+	, MeshName(FPackageName::GetShortName(InMeshPath))
+{
+}
+
+bool FBoneMappingSession::RequestMapping()
+{
+	if (State == EBoneMappingSessionState::Ready && !bPartial)
+	{
+		return true;
+	}
+	if (State == EBoneMappingSessionState::Requesting)
+	{
+		return false;  // 다른 탭이 보낸 요청 완료 대기
+	}
+
+	// 매핑은 본 계층만 필요 → 메쉬 로드 없이 읽기
+	FMeshBoneHierarchy::ESource HierarchySource;
+	const FReferenceSkeleton* SkelPtr = FMeshBoneHierarchy::Read(MeshPath, &HierarchySource);
+	if (!SkelPtr)
+	{
+		SetFailed(FString::Printf(TEXT("Failed to load mesh: %s"), *MeshPath));
+		return false;
+	}
+	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Mapping session %s: bone hierarchy from %s"), *MeshName, FMeshBoneHierarchy::GetSourceName(HierarchySource));
+
+	// Read 결과는 프레임 안에서만 유효 → 승인 시 같은 계층을 쓰도록 복사
+	Hierarchy = *SkelPtr;
+	const FReferenceSkeleton& Skel = Hierarchy;
+	SkeletonHash = FBoneMappingCache::ComputeSkeletonHash(Skel);
+
+	// 디스크 캐시 우선 (LOD/의상 변형/선택 시 프리페치로 이미 매핑한 스켈레톤)
+	// 부분 매핑 재시도 중에는 캐시를 건너뜀 (부분 매핑은 캐시에 저장되지 않음)
+	bApproved = false;
+	TMap<FName, FName> CachedMapping;
+	if (!bPartial && FBoneMappingCache::Get().Find(SkeletonHash, CachedMapping))
+	{
+		bApproved = FBoneMappingCache::Get().IsApproved(SkeletonHash);
+		SetReady(MoveTemp(CachedMapping), TEXT("cached"));
+		return false;
+	}
+
+	// 네이티브 체인 분석 - 코어 본이 모두 잡히면 서버 요청 생략
+	TMap<FName, FName> NativeMapping = FNativeBoneMapper::MapSkeleton(Skel);
+	if (FNativeBoneMapper::IsCoreMappingComplete(NativeMapping))
+	{
+		SetReady(MoveTemp(NativeMapping), TEXT("native"));
+		return false;
+	}
+
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Req = FHttpModule::Get().CreateRequest();
+	Req->SetVerb(TEXT("POST"));
+	FBoneMappingPayload::SetJsonBody(Req, FBoneMappingPayload::BuildPredictRequest(Skel));
+	Req->SetTimeout(120.0f);
+
+	TWeakPtr<FBoneMappingSession> WeakThis = AsShared();
+	Req->OnProcessRequestComplete().BindLambda([WeakThis, NativeMapping](FHttpRequestPtr, FHttpResponsePtr Res, bool Ok)
+	{
+		if (TSharedPtr<FBoneMappingSession> This = WeakThis.Pin())
+		{
+			This->OnPredictResponse(NativeMapping, Res, Ok);
+		}
+	});
+
+	State = EBoneMappingSessionState::Requesting;
+	Error.Reset();
+	ChangedEvent.Broadcast(*this, EBoneMappingSessionChange::State);
+	FAIServerLauncher::Get().Send(Req, TEXT("/predict"));
+	return false;
+}
+
+void FBoneMappingSession::OnPredictResponse(const TMap<FName, FName>& NativeMapping, FHttpResponsePtr Response, bool bSucceeded)
+{
+	TMap<FName, FName> ServerMapping;
+	FString ModelVersion;
+	const bool bServerOk = bSucceeded && Response.IsValid() && Response->GetResponseCode() == 200
+		&& FBoneMappingPayload::ParsePredictResponse(Response->GetContentAsString(), ServerMapping, ModelVersion);
+
+	if (!bServerOk)
+	{
+		// 서버 없이도 네이티브 결과가 있으면 부분 매핑으로 진행
+		if (NativeMapping.Num() > 0)
+		{
+			TMap<FName, FName> PartialMapping = NativeMapping;
+			SetReady(MoveTemp(PartialMapping), TEXT("native only, server unavailable"), true);
+			return;
+		}
+		SetFailed(Response.IsValid() ? FString::Printf(TEXT("AI server error (%d)"), Response->GetResponseCode()) : TEXT("AI server connection failed"));
+		return;
+	}
+
+	// 네이티브 결과 우선, 빈 target만 서버 결과로 채움
+	TMap<FName, FName> MergedMapping = NativeMapping;
+	FNativeBoneMapper::MergeServerMapping(MergedMapping, ServerMapping);
+
+	if (!ModelVersion.IsEmpty())
+	{
+		FBoneMappingCache::Get().SetModelVersion(ModelVersion);
+	}
+	FBoneMappingCache::Get().Store(SkeletonHash, MeshName, MergedMapping);
+	SetReady(MoveTemp(MergedMapping), TEXT("native + server"));
+}
+
+void FBoneMappingSession::SetReady(TMap<FName, FName>&& InMapping, const FString& InMethod, bool bInPartial)
+{
+	Mapping = MoveTemp(InMapping);
+	Method = InMethod;
+	Error.Reset();
+	bPartial = bInPartial;
+	State = EBoneMappingSessionState::Ready;
+
+	MainBones.Reset(Mapping.Num());
+	for (const auto& Pair : Mapping)
+	{
+		MainBones.AddUnique(Pair.Value);
+	}
+
+	ChangedEvent.Broadcast(*this, EBoneMappingSessionChange::State);
+}
+
+void FBoneMappingSession::SetFailed(const FString& InError)
+{
+	Error = InError;
+	State = EBoneMappingSessionState::Failed;
+	UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] Mapping session %s: %s"), *MeshName, *Error);
+	ChangedEvent.Broadcast(*this, EBoneMappingSessionChange::State);
+}
+
+bool FBoneMappingSession::Approve()
+{
+	if (!IsReady() || Mapping.Num() == 0 || SkeletonHash.IsEmpty())
+	{
+		return false;
+	}
+
+	// 승인된 매핑은 캐시 엔트리를 덮어씀 (모델 버전이 바뀌어도 유지)
+	FBoneMappingCache::Get().Store(SkeletonHash, MeshName, Mapping, true);
+
+	// 저널에 기록 후 바로 반환 (서버 전송은 백그라운드, 서버가 꺼져 있어도 유실 없음)
+	FFeedbackJournal::Get().Append(TEXT("/approve"), FBoneMappingPayload::BuildApproveRequest(MeshName, Hierarchy, Mapping));
+
+	bApproved = true;
+	bPartial = false;  // 사용자가 확정한 매핑 → 서버 재시도 안 함
+	ChangedEvent.Broadcast(*this, EBoneMappingSessionChange::Approved);
+	return true;
+}
@@ -0,0 +1,647 @@
+#include "BoneVertexAnalysis.h"
+#include "Engine/SkeletalMesh.h"
+#include "Rendering/SkeletalMeshModel.h"
+#include "Rendering/SkeletalMeshLODModel.h"
+#include "Algo/BinarySearch.h"
+#include "UObject/UObjectGlobals.h"
+#include "Editor.h"
+#include "Subsystems/ImportSubsystem.h"
+#include "Async/ParallelFor.h"
+#include "Async/Async.h"
+
+// 아래 "지배 본 버텍스 수집" / "버텍스 리덕션 커널"
+namespace BoneVertexAnalysis
+{
+	struct FSkinSnapshot;
+	static TSharedRef<FSkinSnapshot> TakeSnapshot(USkeletalMesh* Mesh);
+	static TSharedRef<const FMeshVertexAnalysis> AnalyzeSnapshot(FSkinSnapshot& Snapshot, const std::atomic<bool>* bCancelled);
+}
+
+FBoneVertexAnalysisCache& FBoneVertexAnalysisCache::Get()
+{
+	static FBoneVertexAnalysisCache Instance;
+	return Instance;
+}
+
+void FBoneVertexAnalysisCache::RegisterInvalidationHooks()
+{
+	if (!PropertyChangedHandle.IsValid())
+	{
+		PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FBoneVertexAnalysisCache::OnObjectPropertyChanged);
+	}
+	
+	if (!ReimportHandle.IsValid() && GEditor)
+	{
+		if (UImportSubsystem* ImportSubsystem = GEditor->GetEditorSubsystem<UImportSubsystem>())
+		{
+			ReimportHandle = ImportSubsystem->OnAssetReimport.AddRaw(this, &FBoneVertexAnalysisCache::OnAssetReimport);
+		}
+	}
+}
+
+void FBoneVertexAnalysisCache::UnregisterInvalidationHooks()
+{
+	if (PropertyChangedHandle.IsValid())
+	{
+		FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+		PropertyChangedHandle.Reset();
+	}
+	
+	if (ReimportHandle.IsValid())
+	{
+		if (GEditor)
+		{
+			if (UImportSubsystem* ImportSubsystem = GEditor->GetEditorSubsystem<UImportSubsystem>())
+			{
+				ImportSubsystem->OnAssetReimport.Remove(ReimportHandle);
+			}
+		}
+		ReimportHandle.Reset();
+	}
+	
+	InvalidateAll();
+}
+
+TSharedRef<const FMeshVertexAnalysis> FBoneVertexAnalysisCache::GetAnalysis(USkeletalMesh* Mesh)
+{
+	if (!Mesh)
+	{
+		return MakeShared<FMeshVertexAnalysis>();
+	}
+	
+	// 본 수가 달라졌으면 (델리게이트 없이 수정된 경우) 다시 계산
+	if (IsCached(Mesh))
+	{
+		return Entries.FindChecked(Mesh);
+	}
+	
+	// 프리페치 등에서 진행 중인 분석 → 중복 계산 대신 완료 대기
+	if (const TSharedRef<FVertexAnalysisTask>* Pending = InFlight.Find(Mesh))
+	{
+		const TSharedRef<FVertexAnalysisTask> PendingRef = *Pending;
+		PendingRef->Task.Wait();
+		if (CompleteAsync(PendingRef))
+		{
+			return Entries.FindChecked(Mesh);
+		}
+	}
+	
+	TSharedRef<const FMeshVertexAnalysis> Analysis = Analyze(Mesh);
+	Store(Mesh, Analysis);
+	return Analysis;
+}
+
+bool FBoneVertexAnalysisCache::IsCached(const USkeletalMesh* Mesh) const
+{
+	const TSharedRef<const FMeshVertexAnalysis>* Cached = Mesh ? Entries.Find(Mesh) : nullptr;
+	return Cached && (*Cached)->Num() == Mesh->GetRefSkeleton().GetNum();
+}
+
+void FBoneVertexAnalysisCache::Store(USkeletalMesh* Mesh, TSharedRef<const FMeshVertexAnalysis> Analysis)
+{
+	if (!Mesh) return;
+	
+	// GC된 메쉬 엔트리 정리
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+	
+	Entries.Add(Mesh, MoveTemp(Analysis));
+}
+
+TSharedPtr<FVertexAnalysisTask> FBoneVertexAnalysisCache::AnalyzeAsync(USkeletalMesh* Mesh)
+{
+	if (!Mesh || IsCached(Mesh)) return nullptr;
+	
+	if (const TSharedRef<FVertexAnalysisTask>* Pending = InFlight.Find(Mesh))
+	{
+		return *Pending;
+	}
+	
+	TSharedRef<FVertexAnalysisTask> Pending = MakeShared<FVertexAnalysisTask>();
+	Pending->Mesh = Mesh;
+	InFlight.Add(Mesh, Pending);
+	
+	// 메쉬 데이터는 여기서 복사 → 워커가 도는 동안 리임포트 / 수정돼도 안전
+	TSharedRef<BoneVertexAnalysis::FSkinSnapshot> Snapshot = BoneVertexAnalysis::TakeSnapshot(Mesh);
+	
+	Pending->Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Pending, Snapshot]()
+	{
+		if (!Pending->bCancelled)
+		{
+			Pending->Result = BoneVertexAnalysis::AnalyzeSnapshot(*Snapshot, &Pending->bCancelled);
+		}
+		
+		// 캐시 저장은 게임 스레드에서
+		AsyncTask(ENamedThreads::GameThread, [Pending]()
+		{
+			FBoneVertexAnalysisCache::Get().CompleteAsync(Pending);
+		});
+	});
+	
+	return Pending;
+}
+
+bool FBoneVertexAnalysisCache::CompleteAsync(const TSharedRef<FVertexAnalysisTask>& Pending)
+{
+	// GetAnalysis가 먼저 가져갔거나 취소 / 무효화로 목록에서 빠진 작업
+	const USkeletalMesh* Mesh = Pending->Mesh.Get();
+	const TSharedRef<FVertexAnalysisTask>* Current = Mesh ? InFlight.Find(Mesh) : nullptr;
+	if (!Current || *Current != Pending)
+	{
+		return false;
+	}
+	
+	InFlight.Remove(Mesh);
+	if (Pending->bCancelled || !Pending->Result.IsValid())
+	{
+		return false;
+	}
+	
+	Store(Pending->Mesh.Get(), Pending->Result.ToSharedRef());
+	return true;
+}
+
+void FBoneVertexAnalysisCache::CancelAsync(const TSharedPtr<FVertexAnalysisTask>& Pending)
+{
+	if (!Pending.IsValid()) return;
+	
+	Pending->bCancelled = true;
+	if (const USkeletalMesh* Mesh = Pending->Mesh.Get())
+	{
+		const TSharedRef<FVertexAnalysisTask>* Current = InFlight.Find(Mesh);
+		if (Current && *Current == Pending)
+		{
+			InFlight.Remove(Mesh);
+		}
+	}
+}
+
+void FBoneVertexAnalysisCache::InvalidateAll()
+{
+	for (const TPair<TWeakObjectPtr<const USkeletalMesh>, TSharedRef<FVertexAnalysisTask>>& Pair : InFlight)
+	{
+		Pair.Value->bCancelled = true;
+	}
+	InFlight.Empty();
+	Entries.Empty();
+}
+
+void FBoneVertexAnalysisCache::Invalidate(const USkeletalMesh* Mesh)
+{
+	// 수정 전 메쉬를 읽은 분석 결과는 버림
+	if (const TSharedRef<FVertexAnalysisTask>* Pending = InFlight.Find(Mesh))
+	{
+		(*Pending)->bCancelled = true;
+		InFlight.Remove(Mesh);
+	}
+	
+	if (Entries.Remove(Mesh) > 0)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("[ControlRigTool] Vertex analysis invalidated: %s"), *GetNameSafe(Mesh));
+	}
+}
+
+void FBoneVertexAnalysisCache::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+	if (const USkeletalMesh* Mesh = Cast<USkeletalMesh>(Object))
+	{
+		Invalidate(Mesh);
+	}
+}
+
+void FBoneVertexAnalysisCache::OnAssetReimport(UObject* Object)
+{
+	if (const USkeletalMesh* Mesh = Cast<USkeletalMesh>(Object))
+	{
+		Invalidate(Mesh);
+	}
+}
+
+// ============================================================================
+// 지배 본 버텍스 수집 (CalcBoneVertInfos 대체, 병렬)
+// LOD0 소프트 버텍스 → 가중치가 가장 큰 본의 로컬 스페이스로 변환 → 본별로 연속 저장 (SoA)
+// 1패스 (게임 스레드): 메쉬에서 위치 / 노멀 / 지배 본 복사 + 청크별 본 개수 → 스냅샷
+//   리임포트 / PostEditChange는 게임 스레드에서 LODModels를 다시 만들므로
+//   워커는 메쉬를 읽지 않고 스냅샷만 사용
+// 2패스 (워커): 청크별 쓰기 위치로 변환/분배
+// 청크 → 버텍스 순서로 쓰므로 본 안의 버텍스 순서는 직렬 처리와 같음
+// ============================================================================
+namespace BoneVertexAnalysis
+{
+	static constexpr int32 GatherChunkSize = 4096;
+	static constexpr int32 FlushBlockSize = 4096;
+	
+	struct FSkinSnapshot
+	{
+		FString MeshName;
+		int32 NumBones = 0;     // RefSkeleton 본 수 (가상 본 포함) = 결과 크기
+		int32 NumRawBones = 0;
+		int32 NumChunks = 0;
+		TArray<FMatrix44f> InvRefMatrices;
+		
+		// 버텍스별 (컴포넌트 스페이스), 지배 본이 없으면 INDEX_NONE
+		TArray<FVector3f> Positions;
+		TArray<FVector3f> Normals;
+		TArray<int32> DominantBones;
+		
+		// 청크 × 본 개수 → 2패스에서 청크별 쓰기 위치로 바뀜
+		TArray<int32> ChunkCounts;
+	};
+	
+	struct FBoneVertexBuckets
+	{
+		// 본 b의 버텍스 = [Offsets[b], Offsets[b + 1])
+		TArray<int32> Offsets;
+		TArray<float> X, Y, Z;
+		TArray<float> NX, NY, NZ;
+	};
+	
+	// 메쉬 RefBasesInvMatrix와 같은 값 (메쉬를 수정하지 않도록 직접 계산)
+	static void ComputeInvRefMatrices(const FReferenceSkeleton& RefSkeleton, TArray<FMatrix44f>& OutInvMatrices)
+	{
+		const TArray<FTransform>& RefPose = RefSkeleton.GetRawRefBonePose();
+		TArray<FMatrix> Composed;
+		Composed.SetNum(RefPose.Num());
+		OutInvMatrices.SetNum(RefPose.Num());
+		
+		for (int32 b = 0; b < RefPose.Num(); ++b)
+		{
+			FTransform BoneTransform = RefPose[b];
+			BoneTransform.NormalizeRotation();
+			Composed[b] = BoneTransform.ToMatrixWithScale();
+			const int32 Parent = RefSkeleton.GetRawParentIndex(b);
+			if (Parent != INDEX_NONE)
+			{
+				Composed[b] *= Composed[Parent];
+			}
+			OutInvMatrices[b] = FMatrix44f(Composed[b].Inverse());
+		}
+	}
+	
+	// 게임 스레드 전용 (메쉬 읽기). 청크 병렬이지만 끝날 때까지 게임 스레드가 기다리므로 메쉬는 그대로
+	static TSharedRef<FSkinSnapshot> TakeSnapshot(USkeletalMesh* Mesh)
+	{
+		check(IsInGameThread());
+		
+		TSharedRef<FSkinSnapshot> Snapshot = MakeShared<FSkinSnapshot>();
+		Snapshot->MeshName = Mesh->GetName();
+		Snapshot->NumBones = Mesh->GetRefSkeleton().GetNum();
+		
+		const FSkeletalMeshModel* ImportedModel = Mesh->GetImportedModel();
+		if (!ImportedModel || ImportedModel->LODModels.Num() == 0) return Snapshot;
+		
+		const FSkeletalMeshLODModel& LODModel = ImportedModel->LODModels[0];
+		const int32 NumRawBones = Mesh->GetRefSkeleton().GetRawBoneNum();
+		Snapshot->NumRawBones = NumRawBones;
+		ComputeInvRefMatrices(Mesh->GetRefSkeleton(), Snapshot->InvRefMatrices);
+		
+		// 섹션을 이어 붙인 버텍스 인덱스 (청크가 섹션 경계를 넘을 수 있음)
+		TArray<int32> SectionStarts;
+		int32 NumVertices = 0;
+		for (const FSkelMeshSection& Section : LODModel.Sections)
+		{
+			SectionStarts.Add(NumVertices);
+			NumVertices += Section.SoftVertices.Num();
+		}
+		
+		const int32 NumChunks = FMath::DivideAndRoundUp(NumVertices, GatherChunkSize);
+		Snapshot->NumChunks = NumChunks;
+		Snapshot->Positions.SetNumUninitialized(NumVertices);
+		Snapshot->Normals.SetNumUninitialized(NumVertices);
+		Snapshot->DominantBones.SetNumUninitialized(NumVertices);
+		Snapshot->ChunkCounts.SetNumZeroed(NumChunks * NumRawBones);
+		
+		FSkinSnapshot& Out = *Snapshot;
+		
+		// 지배 본 (CalcBoneVertInfos와 같은 규칙 - 가중치 동률이면 앞쪽 인플루언스)
+		ParallelFor(NumChunks, [&](int32 Chunk)
+		{
+			const int32 Begin = Chunk * GatherChunkSize;
+			const int32 End = FMath::Min(Begin + GatherChunkSize, NumVertices);
+			int32* Counts = Out.ChunkCounts.GetData() + Chunk * NumRawBones;
+			
+			int32 SectionIdx = FMath::Max(0, Algo::UpperBound(SectionStarts, Begin) - 1);
+			for (int32 v = Begin; v < End; ++v)
+			{
+				while (SectionIdx + 1 < SectionStarts.Num() && v >= SectionStarts[SectionIdx + 1])
+				{
+					++SectionIdx;
+				}
+				const FSkelMeshSection& Section = LODModel.Sections[SectionIdx];
+				const FSoftSkinVertex& Vert = Section.SoftVertices[v - SectionStarts[SectionIdx]];
+				
+				int32 MaxInfIdx = 0;
+				int32 MaxInfWeight = 0;
+				for (int32 j = 0; j < MAX_TOTAL_INFLUENCES; ++j)
+				{
+					if (Vert.InfluenceWeights[j] > MaxInfWeight)
+					{
+						MaxInfWeight = Vert.InfluenceWeights[j];
+						MaxInfIdx = j;
+					}
+				}
+				
+				const int32 BoneMapIdx = Vert.InfluenceBones[MaxInfIdx];
+				const int32 BoneIdx = Section.BoneMap.IsValidIndex(BoneMapIdx) ? Section.BoneMap[BoneMapIdx] : INDEX_NONE;
+				if (BoneIdx >= 0 && BoneIdx < NumRawBones)
+				{
+					Out.DominantBones[v] = BoneIdx;
+					++Counts[BoneIdx];
+				}
+				else
+				{
+					Out.DominantBones[v] = INDEX_NONE;
+				}
+				
+				Out.Positions[v] = Vert.Position;
+				Out.Normals[v] = FVector3f(Vert.TangentZ);
+			}
+		});
+		
+		return Snapshot;
+	}
+	
+	// 아무 스레드. 스냅샷의 ChunkCounts를 쓰기 위치로 바꿔 씀
+	static void BucketVertices(FSkinSnapshot& Snapshot, FBoneVertexBuckets& Out)
+	{
+		const int32 NumRawBones = Snapshot.NumRawBones;
+		const int32 NumChunks = Snapshot.NumChunks;
+		const int32 NumVertices = Snapshot.DominantBones.Num();
+		
+		// 본별 시작 위치 + 청크별 쓰기 위치 (본 안에서 청크 순서대로)
+		Out.Offsets.SetNumUninitialized(NumRawBones + 1);
+		int32 Total = 0;
+		for (int32 b = 0; b < NumRawBones; ++b)
+		{
+			Out.Offsets[b] = Total;
+			for (int32 Chunk = 0; Chunk < NumChunks; ++Chunk)
+			{
+				int32& Count = Snapshot.ChunkCounts[Chunk * NumRawBones + b];
+				const int32 ChunkCount = Count;
+				Count = Total;
+				Total += ChunkCount;
+			}
+		}
+		Out.Offsets[NumRawBones] = Total;
+		
+		for (TArray<float>* Lane : { &Out.X, &Out.Y, &Out.Z, &Out.NX, &Out.NY, &Out.NZ })
+		{
+			Lane->SetNumUninitialized(Total);
+		}
+		
+		// 본 로컬 스페이스로 변환해서 분배
+		ParallelFor(NumChunks, [&](int32 Chunk)
+		{
+			const int32 Begin = Chunk * GatherChunkSize;
+			const int32 End = FMath::Min(Begin + GatherChunkSize, NumVertices);
+			int32* Cursors = Snapshot.ChunkCounts.GetData() + Chunk * NumRawBones;
+			
+			for (int32 v = Begin; v < End; ++v)
+			{
+				const int32 BoneIdx = Snapshot.DominantBones[v];
+				if (BoneIdx == INDEX_NONE) continue;
+				
+				const FMatrix44f& InvRef = Snapshot.InvRefMatrices[BoneIdx];
+				const FVector3f LocalPos(InvRef.TransformPosition(Snapshot.Positions[v]));
+				const FVector3f LocalNormal(InvRef.TransformVector(Snapshot.Normals[v]));
+				
+				const int32 Dst = Cursors[BoneIdx]++;
+				Out.X[Dst] = LocalPos.X;
+				Out.Y[Dst] = LocalPos.Y;
+				Out.Z[Dst] = LocalPos.Z;
+				Out.NX[Dst] = LocalNormal.X;
+				Out.NY[Dst] = LocalNormal.Y;
+				Out.NZ[Dst] = LocalNormal.Z;
+			}
+		});
+	}
+}
+
+// ============================================================================
+// 버텍스 리덕션 커널 (SIMD, SoA)
+// 한 레지스터 = 버텍스 4개의 같은 축 → 최소/최대/합/2차 모멘트/최대 거리를 한 번의 순회로 누적
+// 2차 모멘트는 첫 버텍스를 원점으로 옮겨서 누적 (E[xx] - mu^2의 자릿수 손실 방지)
+// 4개가 안 되는 꼬리는 실제 버텍스로 채운 뒤 합만 마스크 (최소/최대/최대 거리는 영향 없음)
+// float 합은 블록 단위로 double에 넘겨서 1M 버텍스에서도 정밀도 유지
+// ============================================================================
+namespace BoneVertexAnalysis
+{
+	static double HorizontalSum(const VectorRegister4Float& V)
+	{
+		FVector4f Lanes;
+		VectorStore(V, &Lanes.X);
+		return (double)Lanes.X + Lanes.Y + Lanes.Z + Lanes.W;
+	}
+	
+	static float HorizontalMin(const VectorRegister4Float& V)
+	{
+		FVector4f Lanes;
+		VectorStore(V, &Lanes.X);
+		return FMath::Min(FMath::Min(Lanes.X, Lanes.Y), FMath::Min(Lanes.Z, Lanes.W));
+	}
+	
+	static float HorizontalMax(const VectorRegister4Float& V)
+	{
+		FVector4f Lanes;
+		VectorStore(V, &Lanes.X);
+		return FMath::Max(FMath::Max(Lanes.X, Lanes.Y), FMath::Max(Lanes.Z, Lanes.W));
+	}
+	
+	// [i, i + 4) 로드. 범위를 넘는 레인은 남은 마지막 값으로 채움 (합은 호출부에서 마스크)
+	static VectorRegister4Float LoadLanes(const float* Values, int32 i, int32 Count)
+	{
+		if (i + 4 <= Count)
+		{
+			return VectorLoad(Values + i);
+		}
+		float Padded[4];
+		for (int32 Lane = 0; Lane < 4; ++Lane)
+		{
+			Padded[Lane] = Values[i + FMath::Min(Lane, Count - i - 1)];
+		}
+		return VectorLoad(Padded);
+	}
+	
+	static VectorRegister4Float MakeTailMask(int32 Remaining)
+	{
+		// Lane < Remaining
+		return VectorCompareGT(VectorSetFloat1((float)Remaining), MakeVectorRegisterFloat(0.0f, 1.0f, 2.0f, 3.0f));
+	}
+	
+	static void ReducePositions(const float* X, const float* Y, const float* Z, int32 Count, FBoneVertexStats& OutStats)
+	{
+		VectorRegister4Float MinX = VectorSetFloat1(UE_BIG_NUMBER), MinY = MinX, MinZ = MinX;
+		VectorRegister4Float MaxX = VectorSetFloat1(-UE_BIG_NUMBER), MaxY = MaxX, MaxZ = MaxX;
+		
+		// 레인별 가장 먼 버텍스 (거리 제곱 + 좌표)
+		VectorRegister4Float MaxDistSq = VectorZeroFloat();
+		VectorRegister4Float FurthestX = VectorZeroFloat(), FurthestY = VectorZeroFloat(), FurthestZ = VectorZeroFloat();
+		
+		const VectorRegister4Float AllLanes = VectorCompareEQ(VectorZeroFloat(), VectorZeroFloat());
+		FVector Sum = FVector::ZeroVector;
+		
+		// 2차 모멘트 기준점
+		const FVector Pivot(X[0], Y[0], Z[0]);
+		const VectorRegister4Float PivotX = VectorSetFloat1(X[0]), PivotY = VectorSetFloat1(Y[0]), PivotZ = VectorSetFloat1(Z[0]);
+		FVector SumSqDiagonal = FVector::ZeroVector;     // (dx*dx, dy*dy, dz*dz)
+		FVector SumSqOffDiagonal = FVector::ZeroVector;  // (dx*dy, dx*dz, dy*dz)
+		
+		for (int32 BlockStart = 0; BlockStart < Count; BlockStart += FlushBlockSize)
+		{
+			const int32 BlockEnd = FMath::Min(BlockStart + FlushBlockSize, Count);
+			
+			VectorRegister4Float SumX = VectorZeroFloat(), SumY = VectorZeroFloat(), SumZ = VectorZeroFloat();
+			VectorRegister4Float SumXX = VectorZeroFloat(), SumYY = VectorZeroFloat(), SumZZ = VectorZeroFloat();
+			VectorRegister4Float SumXY = VectorZeroFloat(), SumXZ = VectorZeroFloat(), SumYZ = VectorZeroFloat();
+			
+			for (int32 i = BlockStart; i < BlockEnd; i += 4)
+			{
+				const VectorRegister4Float Mask = i + 4 <= Count ? AllLanes : MakeTailMask(Count - i);
+				const VectorRegister4Float VX = LoadLanes(X, i, Count);
+				const VectorRegister4Float VY = LoadLanes(Y, i, Count);
+				const VectorRegister4Float VZ = LoadLanes(Z, i, Count);
+				
+				MinX = VectorMin(MinX, VX);
+				MinY = VectorMin(MinY, VY);
+				MinZ = VectorMin(MinZ, VZ);
+				MaxX = VectorMax(MaxX, VX);
+				MaxY = VectorMax(MaxY, VY);
+				MaxZ = VectorMax(MaxZ, VZ);
+				
+				SumX = VectorAdd(SumX, VectorBitwiseAnd(VX, Mask));
+				SumY = VectorAdd(SumY, VectorBitwiseAnd(VY, Mask));
+				SumZ = VectorAdd(SumZ, VectorBitwiseAnd(VZ, Mask));
+				
+				// 채운 레인은 0 → 곱도 0
+				const VectorRegister4Float DX = VectorBitwiseAnd(VectorSubtract(VX, PivotX), Mask);
+				const VectorRegister4Float DY = VectorBitwiseAnd(VectorSubtract(VY, PivotY), Mask);
+				const VectorRegister4Float DZ = VectorBitwiseAnd(VectorSubtract(VZ, PivotZ), Mask);
+				SumXX = VectorMultiplyAdd(DX, DX, SumXX);
+				SumYY = VectorMultiplyAdd(DY, DY, SumYY);
+				SumZZ = VectorMultiplyAdd(DZ, DZ, SumZZ);
+				SumXY = VectorMultiplyAdd(DX, DY, SumXY);
+				SumXZ = VectorMultiplyAdd(DX, DZ, SumXZ);
+				SumYZ = VectorMultiplyAdd(DY, DZ, SumYZ);
+				
+				const VectorRegister4Float DistSq = VectorMultiplyAdd(VZ, VZ, VectorMultiplyAdd(VY, VY, VectorMultiply(VX, VX)));
+				const VectorRegister4Float Further = VectorCompareGT(DistSq, MaxDistSq);
+				MaxDistSq = VectorSelect(Further, DistSq, MaxDistSq);
+				FurthestX = VectorSelect(Further, VX, FurthestX);
+				FurthestY = VectorSelect(Further, VY, FurthestY);
+				FurthestZ = VectorSelect(Further, VZ, FurthestZ);
+			}
+			
+			Sum += FVector(HorizontalSum(SumX), HorizontalSum(SumY), HorizontalSum(SumZ));
+			SumSqDiagonal += FVector(HorizontalSum(SumXX), HorizontalSum(SumYY), HorizontalSum(SumZZ));
+			SumSqOffDiagonal += FVector(HorizontalSum(SumXY), HorizontalSum(SumXZ), HorizontalSum(SumYZ));
+		}
+		
+		OutStats.Bounds = FBox(
+			FVector(HorizontalMin(MinX), HorizontalMin(MinY), HorizontalMin(MinZ)),
+			FVector(HorizontalMax(MaxX), HorizontalMax(MaxY), HorizontalMax(MaxZ)));
+		
+		OutStats.VertexCount = Count;
+		OutStats.Centroid = Sum / Count;
+		
+		// 공분산 = E[d d^T] - m m^T (d = x - Pivot, m = Centroid - Pivot)
+		const FVector M = OutStats.Centroid - Pivot;
+		OutStats.CovarianceDiagonal = SumSqDiagonal / Count - M * M;
+		OutStats.CovarianceOffDiagonal = SumSqOffDiagonal / Count - FVector(M.X * M.Y, M.X * M.Z, M.Y * M.Z);
+		
+		// 레인 중 가장 먼 버텍스 (동률이면 앞 레인)
+		FVector4f LaneDistSq, LaneX, LaneY, LaneZ;
+		VectorStore(MaxDistSq, &LaneDistSq.X);
+		VectorStore(FurthestX, &LaneX.X);
+		VectorStore(FurthestY, &LaneY.X);
+		VectorStore(FurthestZ, &LaneZ.X);
+		
+		int32 BestLane = 0;
+		for (int32 Lane = 1; Lane < 4; ++Lane)
+		{
+			if (LaneDistSq[Lane] > LaneDistSq[BestLane])
+			{
+				BestLane = Lane;
+			}
+		}
+		
+		if (LaneDistSq[BestLane] > 0.0f)
+		{
+			const FVector Furthest(LaneX[BestLane], LaneY[BestLane], LaneZ[BestLane]);
+			OutStats.MaxDistance = Furthest.Size();
+			OutStats.FurthestDirection = Furthest.GetSafeNormal();
+		}
+	}
+	
+	static double SumLanes(const float* Values, int32 Count)
+	{
+		const VectorRegister4Float AllLanes = VectorCompareEQ(VectorZeroFloat(), VectorZeroFloat());
+		double Sum = 0.0;
+		
+		for (int32 BlockStart = 0; BlockStart < Count; BlockStart += FlushBlockSize)
+		{
+			const int32 BlockEnd = FMath::Min(BlockStart + FlushBlockSize, Count);
+			
+			VectorRegister4Float SumV = VectorZeroFloat();
+			for (int32 i = BlockStart; i < BlockEnd; i += 4)
+			{
+				const VectorRegister4Float Mask = i + 4 <= Count ? AllLanes : MakeTailMask(Count - i);
+				SumV = VectorAdd(SumV, VectorBitwiseAnd(LoadLanes(Values, i, Count), Mask));
+			}
+			Sum += HorizontalSum(SumV);
+		}
+		return Sum;
+	}
+	
+	// 아무 스레드 (메쉬 접근 없음)
+	static TSharedRef<const FMeshVertexAnalysis> AnalyzeSnapshot(FSkinSnapshot& Snapshot, const std::atomic<bool>* bCancelled)
+	{
+		TSharedRef<FMeshVertexAnalysis> Analysis = MakeShared<FMeshVertexAnalysis>();
+		
+		// 가상 본은 버텍스 없음 → Raw 본까지만 채움
+		const int32 NumBones = Snapshot.NumBones;
+		Analysis->Bones.SetNum(NumBones);
+		
+		FBoneVertexBuckets Buckets;
+		BucketVertices(Snapshot, Buckets);
+		if (bCancelled && *bCancelled)
+		{
+			return Analysis;
+		}
+		
+		// 본별 리덕션은 서로 독립 → 본 단위 병렬 처리
+		const int32 NumGathered = FMath::Min(NumBones, Buckets.Offsets.Num() - 1);
+		TArray<FBoneVertexStats>& Bones = Analysis->Bones;
+		ParallelFor(NumGathered, [&Buckets, &Bones](int32 BoneIdx)
+		{
+			const int32 Begin = Buckets.Offsets[BoneIdx];
+			const int32 Count = Buckets.Offsets[BoneIdx + 1] - Begin;
+			if (Count == 0) return;
+			
+			FBoneVertexStats& Stats = Bones[BoneIdx];
+			ReducePositions(&Buckets.X[Begin], &Buckets.Y[Begin], &Buckets.Z[Begin], Count, Stats);
+			
+			FVector NormalSum(
+				SumLanes(&Buckets.NX[Begin], Count),
+				SumLanes(&Buckets.NY[Begin], Count),
+				SumLanes(&Buckets.NZ[Begin], Count));
+			if (NormalSum.Normalize())
+			{
+				Stats.MeanNormal = NormalSum;
+			}
+		});
+		
+		UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Vertex analysis computed: %s (%d bones)"), *Snapshot.MeshName, NumBones);
+		return Analysis;
+	}
+}
+
+TSharedRef<const FMeshVertexAnalysis> FBoneVertexAnalysisCache::Analyze(USkeletalMesh* Mesh)
+{
+	TSharedRef<BoneVertexAnalysis::FSkinSnapshot> Snapshot = BoneVertexAnalysis::TakeSnapshot(Mesh);
+	return BoneVertexAnalysis::AnalyzeSnapshot(*Snapshot, nullptr);
+}
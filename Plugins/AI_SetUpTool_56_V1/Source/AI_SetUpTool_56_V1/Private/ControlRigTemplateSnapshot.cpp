@@ -0,0 +1,470 @@
+#include "ControlRigTemplateSnapshot.h"
+#include "RigHierarchyBatchEdit.h"
+#include "ControlRigBlueprint.h"
+#include "Rigs/RigHierarchy.h"
+#include "RigVMModel/RigVMController.h"
+#include "RigVMModel/RigVMGraph.h"
+#include "RigVMModel/RigVMNode.h"
+#include "RigVMModel/RigVMPin.h"
+#include "RigVMModel/RigVMLink.h"
+#include "EditorAssetLibrary.h"
+#include "Misc/OutputDeviceNull.h"
+#include "Misc/PackageName.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "UObject/Package.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+
+// 베이크 형식 버전 (템플릿 전용 본 / 슬롯 / 앵커 규칙 변경 시 증가 → 전부 다시 베이크)
+static constexpr int32 TemplateSnapshotFormatVersion = 1;
+
+const TCHAR* FControlRigTemplateSnapshotCache::SnapshotFolder = TEXT("/Game/AIRigSetup/TemplateSnapshots");
+
+// ============================================================================
+// 스냅샷 구성 요소 수집
+// ============================================================================
+bool FControlRigTemplateSnapshot::IsTemplateOnlyBone(const FName& BoneName)
+{
+	// FName 비교는 대소문자 무시
+	static const TSet<FName> TemplateOnlyBones = {
+		TEXT("heel_l"), TEXT("heel_r"),
+		TEXT("tip_l"), TEXT("tip_r"),
+		TEXT("ik_foot_l"), TEXT("ik_foot_r"),
+		TEXT("ik_hand_l"), TEXT("ik_hand_r"),
+		TEXT("ik_foot_root"), TEXT("ik_hand_root"), TEXT("ik_hand_gun")
+	};
+	return TemplateOnlyBones.Contains(BoneName);
+}
+
+int32 FControlRigTemplateSnapshot::RemoveMeshBones(UControlRigBlueprint* Rig)
+{
+	if (!Rig || !Rig->Hierarchy) return 0;
+
+	FRigHierarchyBatchEdit Batch(Rig);
+
+	// 역순 삭제 (자식 먼저)
+	TArray<FRigBoneElement*> OldBones = Rig->Hierarchy->GetBones();
+	int32 RemovedCount = 0;
+	for (int32 i = OldBones.Num() - 1; i >= 0; --i)
+	{
+		const FRigElementKey Key = OldBones[i]->GetKey();
+		if (IsTemplateOnlyBone(Key.Name))
+		{
+			UE_LOG(LogTemp, Log, TEXT("  Preserved: %s"), *Key.Name.ToString());
+			continue;
+		}
+		Batch.RemoveElement(Key);
+		RemovedCount++;
+	}
+	Batch.Flush();
+
+	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Removed %d bones, preserved %d"), RemovedCount, OldBones.Num() - RemovedCount);
+	return RemovedCount;
+}
+
+// 본을 참조하는 핀 수집
+// - FRigElementKey 핀: Type이 Bone인 것만 (Control 등은 템플릿 이름 그대로)
+// - BoneName 위젯 FName 핀: 값 자체가 본 이름
+// - 배열/구조체 핀은 하위 핀으로 재귀 (FRigElementKeyCollection, TArray<FRigElementKey> 등)
+static void CollectPinBoneSlots(URigVMPin* Pin, TArray<FControlRigBoneSlot>& OutSlots)
+{
+	if (!Pin) return;
+
+	if (Pin->GetCPPTypeObject() == FRigElementKey::StaticStruct())
+	{
+		const FString DefaultValue = Pin->GetDefaultValue();
+		if (DefaultValue.IsEmpty()) return;
+
+		FRigElementKey Key;
+		FOutputDeviceNull ImportErrors;
+		FRigElementKey::StaticStruct()->ImportText(*DefaultValue, &Key, nullptr, PPF_None, &ImportErrors, FRigElementKey::StaticStruct()->GetName());
+		if (Key.Type == ERigElementType::Bone && !Key.Name.IsNone())
+		{
+			OutSlots.Add({ Pin->GetPinPath(), Key.Name, true });
+		}
+		return;
+	}
+
+	if (Pin->GetCPPType() == TEXT("FName") && Pin->GetCustomWidgetName() == TEXT("BoneName"))
+	{
+		const FName BoneName(*Pin->GetDefaultValue());
+		if (!BoneName.IsNone())
+		{
+			OutSlots.Add({ Pin->GetPinPath(), BoneName, false });
+		}
+		return;
+	}
+
+	for (URigVMPin* SubPin : Pin->GetSubPins())
+	{
+		CollectPinBoneSlots(SubPin, OutSlots);
+	}
+}
+
+TArray<FControlRigBoneSlot> FControlRigTemplateSnapshot::CollectBoneSlots(URigVMGraph* Graph)
+{
+	TArray<FControlRigBoneSlot> Slots;
+	if (!Graph) return Slots;
+
+	for (URigVMNode* Node : Graph->GetNodes())
+	{
+		if (!Node) continue;
+		for (URigVMPin* Pin : Node->GetPins())
+		{
+			CollectPinBoneSlots(Pin, Slots);
+		}
+	}
+	return Slots;
+}
+
+TMap<FString, FControlRigFunctionAnchor> FControlRigTemplateSnapshot::FindFunctionAnchors(URigVMGraph* Graph)
+{
+	TMap<FString, FControlRigFunctionAnchor> Anchors;
+	if (!Graph) return Anchors;
+
+	// 빈 템플릿 함수 = 정확히 일치하거나 숫자 suffix만 있는 것 (Weapon 전용 노드 제외)
+	static const TCHAR* Kinds[] = { TEXT("Setup"), TEXT("Forward"), TEXT("Backward") };
+
+	for (URigVMNode* Node : Graph->GetNodes())
+	{
+		if (!Node) continue;
+		const FString NodeName = Node->GetName();
+
+		for (const TCHAR* Kind : Kinds)
+		{
+			const FString Prefix = FString(TEXT("AI_")) + Kind;
+			if (!NodeName.StartsWith(Prefix) || NodeName.Contains(TEXT("Weapon"))) continue;
+
+			FControlRigFunctionAnchor& Anchor = Anchors.FindOrAdd(Prefix);
+
+			// Execute 입력에 연결된 앞 노드 (Neck 또는 같은 종류 노드)
+			for (URigVMPin* Pin : Node->GetPins())
+			{
+				if (!Pin->GetName().Contains(TEXT("Execute"))) continue;
+				for (URigVMLink* Link : Pin->GetLinks())
+				{
+					URigVMPin* OtherPin = Link->GetSourcePin();
+					if (!OtherPin || OtherPin->GetNode() == Node) continue;
+
+					const FString PrevName = OtherPin->GetNode()->GetName();
+					if (PrevName.Contains(TEXT("Neck")) || PrevName.Contains(Kind))
+					{
+						Anchor.PrevNode = OtherPin->GetNode()->GetFName();
+					}
+				}
+			}
+			Anchor.Position = Node->GetPosition();
+			Anchor.EmptyNodes.Add(Node->GetFName());
+		}
+	}
+	return Anchors;
+}
+
+static URigVMGraph* FindMainGraph(UControlRigBlueprint* Rig)
+{
+	for (URigVMGraph* Graph : Rig->GetAllModels())
+	{
+		if (Graph && Graph->GetName().Equals(TEXT("RigVMModel")))
+		{
+			return Graph;
+		}
+	}
+	return nullptr;
+}
+
+// ============================================================================
+// 스냅샷 캐시
+// ============================================================================
+FControlRigTemplateSnapshotCache& FControlRigTemplateSnapshotCache::Get()
+{
+	static FControlRigTemplateSnapshotCache Instance;
+	return Instance;
+}
+
+FControlRigTemplateSnapshotCache::FControlRigTemplateSnapshotCache()
+{
+	Load();
+}
+
+FString FControlRigTemplateSnapshotCache::ComputeTemplateVersion(const FString& TemplatePath)
+{
+	const FString PackageName = FPackageName::ObjectPathToPackageName(TemplatePath);
+
+	// 저장 안 된 편집이 있으면 파일과 내용이 다름 → 스냅샷 사용 안 함
+	if (UPackage* Package = FindPackage(nullptr, *PackageName); Package && Package->IsDirty())
+	{
+		return FString();
+	}
+
+	FString Filename;
+	if (!FPackageName::DoesPackageExist(PackageName, &Filename))
+	{
+		return FString();
+	}
+
+	const FFileStatData Stat = IFileManager::Get().GetStatData(*Filename);
+	if (!Stat.bIsValid)
+	{
+		return FString();
+	}
+	return FString::Printf(TEXT("%d-%lld-%lld"), TemplateSnapshotFormatVersion, Stat.ModificationTime.GetTicks(), Stat.FileSize);
+}
+
+FString FControlRigTemplateSnapshotCache::GetBakedAssetPath(const FString& TemplatePath)
+{
+	// 이름이 같은 템플릿이 다른 폴더에 있어도 겹치지 않도록 경로 해시 추가
+	const FString PackageName = FPackageName::ObjectPathToPackageName(TemplatePath);
+	return FString::Printf(TEXT("%s/%s_%08x"), SnapshotFolder, *FPackageName::GetShortName(PackageName), GetTypeHash(PackageName));
+}
+
+TSharedPtr<const FControlRigTemplateSnapshot> FControlRigTemplateSnapshotCache::FindOrBake(const FString& TemplatePath)
+{
+	const FString Version = ComputeTemplateVersion(TemplatePath);
+	if (Version.IsEmpty())
+	{
+		UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Template %s has unsaved changes, skipping snapshot"), *TemplatePath);
+		return nullptr;
+	}
+
+	if (const TSharedPtr<const FControlRigTemplateSnapshot>* Existing = Snapshots.Find(TemplatePath))
+	{
+		if ((*Existing)->Version == Version && UEditorAssetLibrary::DoesAssetExist((*Existing)->BakedAssetPath))
+		{
+			return *Existing;
+		}
+	}
+
+	TSharedPtr<const FControlRigTemplateSnapshot> Snapshot = Bake(TemplatePath, Version);
+	if (Snapshot.IsValid())
+	{
+		Snapshots.Add(TemplatePath, Snapshot);
+		Save();
+	}
+	return Snapshot;
+}
+
+TSharedPtr<const FControlRigTemplateSnapshot> FControlRigTemplateSnapshotCache::Bake(const FString& TemplatePath, const FString& Version)
+{
+	const FString BakedPath = GetBakedAssetPath(TemplatePath);
+	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Baking template snapshot: %s -> %s"), *TemplatePath, *BakedPath);
+
+	if (UEditorAssetLibrary::DoesAssetExist(BakedPath))
+	{
+		UEditorAssetLibrary::DeleteAsset(BakedPath);
+	}
+	if (!UEditorAssetLibrary::DuplicateAsset(TemplatePath, BakedPath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] Template snapshot duplication failed: %s"), *BakedPath);
+		return nullptr;
+	}
+
+	UControlRigBlueprint* Rig = Cast<UControlRigBlueprint>(UEditorAssetLibrary::LoadAsset(BakedPath));
+	if (!Rig || !Rig->Hierarchy || !Rig->GetController())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] Failed to load template snapshot: %s"), *BakedPath);
+		return nullptr;
+	}
+
+	TSharedPtr<FControlRigTemplateSnapshot> Snapshot = MakeShared<FControlRigTemplateSnapshot>();
+	Snapshot->TemplatePath = TemplatePath;
+	Snapshot->Version = Version;
+	Snapshot->BakedAssetPath = BakedPath;
+
+	// 메쉬 본은 캐릭터마다 새로 임포트 → 템플릿 전용 본만 남김
+	FControlRigTemplateSnapshot::RemoveMeshBones(Rig);
+
+	Snapshot->BoneSlots = FControlRigTemplateSnapshot::CollectBoneSlots(Rig->GetController()->GetGraph());
+	Snapshot->FunctionAnchors = FControlRigTemplateSnapshot::FindFunctionAnchors(FindMainGraph(Rig));
+	Rig->Hierarchy->ForEach<FRigControlElement>([&Snapshot](FRigControlElement* ControlElement) -> bool
+	{
+		Snapshot->Controls.Add(ControlElement->GetFName());
+		return true;
+	});
+
+	if (!UEditorAssetLibrary::SaveAsset(BakedPath, false))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] Failed to save template snapshot: %s"), *BakedPath);
+		return nullptr;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Template snapshot ready: %d bone slots, %d controls, %d function anchors"),
+		Snapshot->BoneSlots.Num(), Snapshot->Controls.Num(), Snapshot->FunctionAnchors.Num());
+	return Snapshot;
+}
+
+// ============================================================================
+// 인덱스 파일 (Saved/AIRigSetup/TemplateSnapshots.json)
+// ============================================================================
+FString FControlRigTemplateSnapshotCache::GetIndexFilePath() const
+{
+	return FPaths::ProjectSavedDir() / TEXT("AIRigSetup") / TEXT("TemplateSnapshots.json");
+}
+
+void FControlRigTemplateSnapshotCache::Load()
+{
+	Snapshots.Empty();
+
+	FString JsonString;
+	if (!FFileHelper::LoadFileToString(JsonString, *GetIndexFilePath()))
+	{
+		return;
+	}
+
+	TSharedPtr<FJsonObject> Root;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] Failed to parse %s, snapshots will be rebaked"), *GetIndexFilePath());
+		return;
+	}
+
+	const TSharedPtr<FJsonObject>* TemplatesObj;
+	if (!Root->TryGetObjectField(TEXT("templates"), TemplatesObj))
+	{
+		return;
+	}
+
+	for (const auto& TemplatePair : (*TemplatesObj)->Values)
+	{
+		const TSharedPtr<FJsonObject>* EntryObj;
+		if (!TemplatePair.Value->TryGetObject(EntryObj))
+		{
+			continue;
+		}
+
+		TSharedPtr<FControlRigTemplateSnapshot> Snapshot = MakeShared<FControlRigTemplateSnapshot>();
+		Snapshot->TemplatePath = TemplatePair.Key;
+		(*EntryObj)->TryGetStringField(TEXT("version"), Snapshot->Version);
+		(*EntryObj)->TryGetStringField(TEXT("baked_asset"), Snapshot->BakedAssetPath);
+
+		const TArray<TSharedPtr<FJsonValue>>* SlotsArray;
+		if ((*EntryObj)->TryGetArrayField(TEXT("bone_slots"), SlotsArray))
+		{
+			for (const TSharedPtr<FJsonValue>& SlotValue : *SlotsArray)
+			{
+				const TSharedPtr<FJsonObject>* SlotObj;
+				if (!SlotValue->TryGetObject(SlotObj)) continue;
+
+				FControlRigBoneSlot& Slot = Snapshot->BoneSlots.AddDefaulted_GetRef();
+				FString BoneName;
+				(*SlotObj)->TryGetStringField(TEXT("pin"), Slot.PinPath);
+				(*SlotObj)->TryGetStringField(TEXT("bone"), BoneName);
+				(*SlotObj)->TryGetBoolField(TEXT("key"), Slot.bElementKey);
+				Slot.BoneName = FName(*BoneName);
+			}
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* ControlsArray;
+		if ((*EntryObj)->TryGetArrayField(TEXT("controls"), ControlsArray))
+		{
+			for (const TSharedPtr<FJsonValue>& ControlValue : *ControlsArray)
+			{
+				Snapshot->Controls.Add(FName(*ControlValue->AsString()));
+			}
+		}
+
+		const TSharedPtr<FJsonObject>* AnchorsObj;
+		if ((*EntryObj)->TryGetObjectField(TEXT("anchors"), AnchorsObj))
+		{
+			for (const auto& AnchorPair : (*AnchorsObj)->Values)
+			{
+				const TSharedPtr<FJsonObject>* AnchorObj;
+				if (!AnchorPair.Value->TryGetObject(AnchorObj)) continue;
+
+				FControlRigFunctionAnchor& Anchor = Snapshot->FunctionAnchors.Add(AnchorPair.Key);
+				FString PrevNode;
+				(*AnchorObj)->TryGetStringField(TEXT("prev"), PrevNode);
+				Anchor.PrevNode = PrevNode.IsEmpty() ? NAME_None : FName(*PrevNode);
+				(*AnchorObj)->TryGetNumberField(TEXT("x"), Anchor.Position.X);
+				(*AnchorObj)->TryGetNumberField(TEXT("y"), Anchor.Position.Y);
+
+				const TArray<TSharedPtr<FJsonValue>>* NodesArray;
+				if ((*AnchorObj)->TryGetArrayField(TEXT("nodes"), NodesArray))
+				{
+					for (const TSharedPtr<FJsonValue>& NodeValue : *NodesArray)
+					{
+						Anchor.EmptyNodes.Add(FName(*NodeValue->AsString()));
+					}
+				}
+			}
+		}
+
+		if (!Snapshot->Version.IsEmpty() && !Snapshot->BakedAssetPath.IsEmpty())
+		{
+			Snapshots.Add(TemplatePair.Key, Snapshot);
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Loaded %d template snapshots"), Snapshots.Num());
+}
+
+void FControlRigTemplateSnapshotCache::Save() const
+{
+	TSharedPtr<FJsonObject> TemplatesObj = MakeShared<FJsonObject>();
+	for (const auto& Pair : Snapshots)
+	{
+		const FControlRigTemplateSnapshot& Snapshot = *Pair.Value;
+		TSharedPtr<FJsonObject> EntryObj = MakeShared<FJsonObject>();
+		EntryObj->SetStringField(TEXT("version"), Snapshot.Version);
+		EntryObj->SetStringField(TEXT("baked_asset"), Snapshot.BakedAssetPath);
+
+		TArray<TSharedPtr<FJsonValue>> SlotsArray;
+		SlotsArray.Reserve(Snapshot.BoneSlots.Num());
+		for (const FControlRigBoneSlot& Slot : Snapshot.BoneSlots)
+		{
+			TSharedPtr<FJsonObject> SlotObj = MakeShared<FJsonObject>();
+			SlotObj->SetStringField(TEXT("pin"), Slot.PinPath);
+			SlotObj->SetStringField(TEXT("bone"), Slot.BoneName.ToString());
+			SlotObj->SetBoolField(TEXT("key"), Slot.bElementKey);
+			SlotsArray.Add(MakeShared<FJsonValueObject>(SlotObj));
+		}
+		EntryObj->SetArrayField(TEXT("bone_slots"), SlotsArray);
+
+		TArray<TSharedPtr<FJsonValue>> ControlsArray;
+		ControlsArray.Reserve(Snapshot.Controls.Num());
+		for (const FName& Control : Snapshot.Controls)
+		{
+			ControlsArray.Add(MakeShared<FJsonValueString>(Control.ToString()));
+		}
+		EntryObj->SetArrayField(TEXT("controls"), ControlsArray);
+
+		TSharedPtr<FJsonObject> AnchorsObj = MakeShared<FJsonObject>();
+		for (const auto& AnchorPair : Snapshot.FunctionAnchors)
+		{
+			const FControlRigFunctionAnchor& Anchor = AnchorPair.Value;
+			TSharedPtr<FJsonObject> AnchorObj = MakeShared<FJsonObject>();
+			AnchorObj->SetStringField(TEXT("prev"), Anchor.PrevNode.IsNone() ? FString() : Anchor.PrevNode.ToString());
+			AnchorObj->SetNumberField(TEXT("x"), Anchor.Position.X);
+			AnchorObj->SetNumberField(TEXT("y"), Anchor.Position.Y);
+
+			TArray<TSharedPtr<FJsonValue>> NodesArray;
+			for (const FName& NodeName : Anchor.EmptyNodes)
+			{
+				NodesArray.Add(MakeShared<FJsonValueString>(NodeName.ToString()));
+			}
+			AnchorObj->SetArrayField(TEXT("nodes"), NodesArray);
+			AnchorsObj->SetObjectField(AnchorPair.Key, AnchorObj);
+		}
+		EntryObj->SetObjectField(TEXT("anchors"), AnchorsObj);
+
+		TemplatesObj->SetObjectField(Pair.Key, EntryObj);
+	}
+
+	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetObjectField(TEXT("templates"), TemplatesObj);
+
+	FString JsonString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
+	FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
+
+	const FString FilePath = GetIndexFilePath();
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+	if (!FFileHelper::SaveStringToFile(JsonString, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] Failed to write %s"), *FilePath);
+	}
+}
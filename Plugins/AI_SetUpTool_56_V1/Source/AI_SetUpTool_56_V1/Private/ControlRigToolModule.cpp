@@ -1,12 +1,13 @@
 #include "ControlRigToolModule.h"
 #include "ControlRigToolCommands.h"
 #include "SControlRigToolWidget.h"
+#include "BoneVertexAnalysis.h"
+#include "AssetCatalog.h"
+#include "AIServerLauncher.h"
+#include "FeedbackJournal.h"
 #include "ToolMenus.h"
 #include "Widgets/Docking/SDockTab.h"
 #include "Framework/Docking/TabManager.h"
-#include "HAL/PlatformProcess.h"
-#include "Misc/Paths.h"
-#include "Interfaces/IPluginManager.h"
 
 static const FName ControlRigToolTabName("ControlRigTool");
 
@@ -37,110 +38,16 @@ void FControlRigToolModule::StartupModule()
 	
 	UToolMenus::RegisterStartupCallback(FSimpleMulticastDelegate::FDelegate::CreateRaw(this, &FControlRigToolModule::RegisterMenus));
 	
-	// API 서버 자동 시작
-	StartAPIServer();
-}
-
-void FControlRigToolModule::StartAPIServer()
-{
-	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] ========== Starting API Server =========="));
-	
-	// 포트 8000 사용 중인 기존 프로세스 정리
-	FString KillCmd = TEXT("powershell -Command \"Get-NetTCPConnection -LocalPort 8000 -ErrorAction SilentlyContinue | ForEach-Object { Stop-Process -Id $_.OwningProcess -Force -ErrorAction SilentlyContinue }\"");
-	FPlatformProcess::CreateProc(TEXT("cmd.exe"), *FString::Printf(TEXT("/c %s"), *KillCmd), true, true, true, nullptr, 0, nullptr, nullptr);
-	FPlatformProcess::Sleep(0.5f);  // 프로세스 종료 대기
-	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Cleaned up port 8000"));
-	
-	FString PluginDir;
-	FString ServerScript;
-	FString EmbeddedPython;
-	
-	// 1. IPluginManager를 통해 플러그인 실제 경로 가져오기
-	TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("AI_SetUpTool_56_V1"));
-	if (Plugin.IsValid())
-	{
-		PluginDir = Plugin->GetBaseDir();
-		ServerScript = PluginDir / TEXT("BoneMapping_AI/04_inference/api_server.py");
-		EmbeddedPython = PluginDir / TEXT("BoneMapping_AI/python/python.exe");
-		UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Plugin BaseDir: %s"), *PluginDir);
-	}
-	
-	// 2. 못 찾으면 프로젝트 플러그인 폴더 시도
-	if (!FPaths::FileExists(ServerScript))
-	{
-		PluginDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectPluginsDir() / TEXT("AI_SetUpTool_56_V1"));
-		ServerScript = PluginDir / TEXT("BoneMapping_AI/04_inference/api_server.py");
-		EmbeddedPython = PluginDir / TEXT("BoneMapping_AI/python/python.exe");
-		UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Try ProjectPlugins: %s"), *ServerScript);
-	}
-	
-	// 3. 엔진 플러그인 폴더 시도
-	if (!FPaths::FileExists(ServerScript))
-	{
-		PluginDir = FPaths::ConvertRelativePathToFull(FPaths::EnginePluginsDir() / TEXT("AI_SetUpTool_56_V1"));
-		ServerScript = PluginDir / TEXT("BoneMapping_AI/04_inference/api_server.py");
-		EmbeddedPython = PluginDir / TEXT("BoneMapping_AI/python/python.exe");
-		UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Try EnginePlugins: %s"), *ServerScript);
-	}
-	
-	// 4. 프로젝트 루트 Plugins 폴더 시도
-	if (!FPaths::FileExists(ServerScript))
-	{
-		PluginDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir()) / TEXT("Plugins/AI_SetUpTool_56_V1");
-		ServerScript = PluginDir / TEXT("BoneMapping_AI/04_inference/api_server.py");
-		EmbeddedPython = PluginDir / TEXT("BoneMapping_AI/python/python.exe");
-		UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Try ProjectDir/Plugins: %s"), *ServerScript);
-	}
+	// 메쉬 리임포트 / PostEditChange 시 버텍스 분석 캐시 무효화
+	FBoneVertexAnalysisCache::Get().RegisterInvalidationHooks();
 	
-	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] ServerScript Exists: %s"), FPaths::FileExists(ServerScript) ? TEXT("YES") : TEXT("NO"));
+	// 에셋 카탈로그 증분 갱신 (Asset Registry 추가/삭제/이름 변경 이벤트)
+	FAssetCatalog::Get().RegisterHooks();
 	
-	if (!FPaths::FileExists(ServerScript))
-	{
-		UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] API server script not found!"));
-		return;
-	}
+	// API 서버는 첫 매핑 요청 때 실행 (FAIServerLauncher)
 	
-	// Python 경로 확인
-	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] EmbeddedPython: %s"), *EmbeddedPython);
-	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] EmbeddedPython Exists: %s"), FPaths::FileExists(EmbeddedPython) ? TEXT("YES") : TEXT("NO"));
-	
-	FString PythonPath = EmbeddedPython;
-	
-	if (!FPaths::FileExists(PythonPath))
-	{
-		PythonPath = TEXT("python");
-		UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] Embedded Python not found, using system python"));
-	}
-	
-	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Final Python: %s"), *PythonPath);
-	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Final Script: %s"), *ServerScript);
-	
-	// 서버 시작 (배치 파일 사용)
-	FString BatchFile = PluginDir / TEXT("BoneMapping_AI/start_server.bat");
-	FString WorkingDir = PluginDir / TEXT("BoneMapping_AI");
-	
-	uint32 ProcessID = 0;
-	FProcHandle Handle = FPlatformProcess::CreateProc(
-		TEXT("cmd.exe"),
-		*FString::Printf(TEXT("/c \"%s\""), *BatchFile),
-		true,   // bLaunchDetached
-		true,   // bLaunchHidden
-		true,   // bLaunchReallyHidden
-		&ProcessID,
-		0,      // Priority
-		*WorkingDir, // WorkingDirectory
-		nullptr  // PipeWriteChild
-	);
-	
-	if (Handle.IsValid())
-	{
-		ServerProcessHandle = Handle;
-		UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] API server started (PID: %d)"), ProcessID);
-	}
-	else
-	{
-		UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] Failed to start API server"));
-	}
+	// 이전 세션에서 못 보낸 승인/피드백 로드 (서버가 준비되면 재전송)
+	FFeedbackJournal::Get();
 }
 
 void FControlRigToolModule::ShutdownModule()
@@ -150,13 +57,14 @@ void FControlRigToolModule::ShutdownModule()
 	FControlRigToolCommands::Unregister();
 	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(ControlRigToolTabName);
 	
-	// API 서버 종료
-	if (ServerProcessHandle.IsValid())
-	{
-		FPlatformProcess::TerminateProc(ServerProcessHandle, true);
-		FPlatformProcess::CloseProc(ServerProcessHandle);
-		UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] API server stopped"));
-	}
+	FBoneVertexAnalysisCache::Get().UnregisterInvalidationHooks();
+	FAssetCatalog::Get().UnregisterHooks();
+	
+	// 미전송 저널은 파일에 남겨두고 다음 세션에 재전송
+	FFeedbackJournal::Get().Shutdown();
+	
+	// API 서버 종료 (실행한 경우에만)
+	FAIServerLauncher::Get().Shutdown();
 }
 
 void FControlRigToolModule::RegisterMenus()
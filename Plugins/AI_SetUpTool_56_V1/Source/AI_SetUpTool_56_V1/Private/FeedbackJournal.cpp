@@ -0,0 +1,335 @@
+#include "FeedbackJournal.h"
+#include "AIServerLauncher.h"
+#include "BoneMappingPayload.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+
+// 전송 실패 후 재시도 간격
+static constexpr double JournalRetryInterval = 15.0;
+static constexpr float JournalTickInterval = 1.0f;
+// 같은 엔트리에서 5xx가 이 횟수만큼 반복되면 분리 / 격리
+static constexpr int32 JournalMaxServerErrors = 5;
+
+FFeedbackJournal& FFeedbackJournal::Get()
+{
+	static FFeedbackJournal Instance;
+	return Instance;
+}
+
+FFeedbackJournal::FFeedbackJournal()
+{
+	Load();
+}
+
+FString FFeedbackJournal::GetJournalFilePath() const
+{
+	return FPaths::ProjectSavedDir() / TEXT("AIRigSetup") / TEXT("FeedbackJournal.jsonl");
+}
+
+FString FFeedbackJournal::GetDeadLetterFilePath() const
+{
+	return FPaths::ProjectSavedDir() / TEXT("AIRigSetup") / TEXT("FeedbackJournal.dead.jsonl");
+}
+
+FString FFeedbackJournal::ToLine(const FEntry& Entry)
+{
+	return FString::Printf(TEXT("%llu\t%s\t%s\n"), Entry.Id, *Entry.Endpoint, *Entry.Body);
+}
+
+void FFeedbackJournal::Load()
+{
+	Entries.Empty();
+
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *GetJournalFilePath()))
+	{
+		return;
+	}
+
+	for (const FString& Line : Lines)
+	{
+		// 쓰다가 끊긴 줄 등 형식이 안 맞으면 건너뜀
+		FString IdStr, Rest, Endpoint, Body;
+		if (!Line.Split(TEXT("\t"), &IdStr, &Rest) || !Rest.Split(TEXT("\t"), &Endpoint, &Body))
+		{
+			continue;
+		}
+		uint64 Id = 0;
+		if (!LexTryParseString(Id, *IdStr) || Body.IsEmpty())
+		{
+			continue;
+		}
+
+		FEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.Id = Id;
+		Entry.Endpoint = Endpoint;
+		Entry.Body = Body;
+		NextId = FMath::Max(NextId, Id + 1);
+	}
+
+	if (Entries.Num() > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Feedback journal: %d entries pending from previous session"), Entries.Num());
+		EnsureTicker();
+	}
+}
+
+// 다시 쓰기는 .tmp에 완성한 뒤 교체 → 쓰는 도중 크래시 / 전원 차단이 나도 기존 파일은 온전
+static bool SaveFileReplacing(const FString& Content, const FString& FilePath)
+{
+	const FString TempPath = FilePath + TEXT(".tmp");
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+	if (!FFileHelper::SaveStringToFile(Content, *TempPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		IFileManager::Get().Delete(*TempPath, false, true, true);
+		return false;
+	}
+	return IFileManager::Get().Move(*FilePath, *TempPath, true);
+}
+
+void FFeedbackJournal::Compact() const
+{
+	const FString FilePath = GetJournalFilePath();
+	if (Entries.Num() == 0)
+	{
+		IFileManager::Get().Delete(*FilePath, false, true, true);
+		return;
+	}
+
+	FString Content;
+	for (const FEntry& Entry : Entries)
+	{
+		Content += ToLine(Entry);
+	}
+	if (!SaveFileReplacing(Content, FilePath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] Failed to rewrite feedback journal: %s"), *FilePath);
+	}
+}
+
+void FFeedbackJournal::Append(const FString& Endpoint, const FString& Body)
+{
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Id = NextId++;
+	Entry.Endpoint = Endpoint;
+	Entry.Body = Body;
+	Entry.bThisSession = true;
+
+	// 추가만 (기존 내용 재기록 없음)
+	const FString FilePath = GetJournalFilePath();
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+	if (!FFileHelper::SaveStringToFile(ToLine(Entry), *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] Failed to write feedback journal: %s"), *FilePath);
+	}
+
+	// 새 기록은 바로 전송 시도
+	NextAttemptTime = 0.0;
+	EnsureTicker();
+}
+
+void FFeedbackJournal::EnsureTicker()
+{
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FFeedbackJournal::Tick), JournalTickInterval);
+	}
+	if (!bInFlight && NextAttemptTime == 0.0)
+	{
+		SendNext();
+	}
+}
+
+bool FFeedbackJournal::Tick(float DeltaTime)
+{
+	if (Entries.Num() == 0)
+	{
+		TickerHandle.Reset();
+		return false;
+	}
+	if (!bInFlight && FPlatformTime::Seconds() >= NextAttemptTime)
+	{
+		SendNext();
+	}
+	return true;
+}
+
+void FFeedbackJournal::SendNext()
+{
+	if (Entries.Num() == 0) return;
+
+	const FString Endpoint = Entries[0].Endpoint;
+	TArray<uint64> SentIds;
+	FString Body;
+	bool bStartServer = false;
+
+	if (Endpoint == TEXT("/classify_batch"))
+	{
+		// 앞쪽의 연속된 분류 피드백 배열을 하나로 합침
+		TArray<FString> Items;
+		for (const FEntry& Entry : Entries)
+		{
+			// 단독 전송 대상은 묶음에 넣지 않음 (맨 앞이면 혼자 전송)
+			if (Entry.Endpoint != Endpoint || (Entry.bSendAlone && SentIds.Num() > 0)) break;
+			FString Inner = Entry.Body.TrimStartAndEnd();
+			Inner.RemoveFromStart(TEXT("["));
+			Inner.RemoveFromEnd(TEXT("]"));
+			if (!Inner.IsEmpty())
+			{
+				Items.Add(MoveTemp(Inner));
+			}
+			SentIds.Add(Entry.Id);
+			bStartServer |= Entry.bThisSession;
+			if (Entry.bSendAlone) break;
+		}
+		Body = TEXT("[") + FString::Join(Items, TEXT(",")) + TEXT("]");
+	}
+	else
+	{
+		SentIds.Add(Entries[0].Id);
+		Body = Entries[0].Body;
+		bStartServer = Entries[0].bThisSession;
+	}
+
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Req = FHttpModule::Get().CreateRequest();
+	Req->SetVerb(TEXT("POST"));
+	Req->SetTimeout(30.0f);
+	FBoneMappingPayload::SetJsonBody(Req, Body);
+	Req->OnProcessRequestComplete().BindLambda([this, SentIds](FHttpRequestPtr, FHttpResponsePtr Res, bool Ok)
+	{
+		OnSendComplete(SentIds, Ok && Res.IsValid() ? Res->GetResponseCode() : 0, Res.IsValid() ? Res->GetContentAsString() : FString());
+	});
+
+	// 이전 세션 기록만 남았으면 서버를 띄우지 않고 준비될 때까지 대기
+	if (FAIServerLauncher::Get().Send(Req, Endpoint, bStartServer))
+	{
+		bInFlight = true;
+	}
+	else
+	{
+		NextAttemptTime = FPlatformTime::Seconds() + JournalRetryInterval;
+	}
+}
+
+void FFeedbackJournal::OnSendComplete(const TArray<uint64>& SentIds, int32 ResponseCode, const FString& Response)
+{
+	bInFlight = false;
+
+	const bool bDelivered = ResponseCode == 200;
+	// 4xx = 서버가 거부한 본문 → 재시도해도 같으므로 버림
+	const bool bRejected = ResponseCode >= 400 && ResponseCode < 500;
+
+	// 5xx = 서버가 받았지만 처리 실패 → 같은 엔트리가 계속 실패하면 뒤 엔트리를 막지 않도록 분리
+	if (ResponseCode >= 500)
+	{
+		int32 ServerErrors = 0;
+		for (FEntry& Entry : Entries)
+		{
+			if (SentIds.Contains(Entry.Id))
+			{
+				ServerErrors = FMath::Max(ServerErrors, ++Entry.ServerErrors);
+			}
+		}
+
+		if (ServerErrors >= JournalMaxServerErrors)
+		{
+			if (SentIds.Num() > 1)
+			{
+				// 묶음 중 어느 엔트리가 원인인지 모름 → 하나씩 전송해서 원인만 격리
+				for (FEntry& Entry : Entries)
+				{
+					if (SentIds.Contains(Entry.Id))
+					{
+						Entry.bSendAlone = true;
+						Entry.ServerErrors = 0;
+					}
+				}
+				UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] Feedback journal: batch of %d keeps failing (%d), sending entries one by one"), SentIds.Num(), ResponseCode);
+			}
+			else
+			{
+				MoveToDeadLetter(SentIds, ResponseCode, Response);
+			}
+
+			// 뒤 엔트리 바로 이어서 전송
+			NextAttemptTime = 0.0;
+			SendNext();
+			return;
+		}
+	}
+
+	if (!bDelivered && !bRejected)
+	{
+		NextAttemptTime = FPlatformTime::Seconds() + JournalRetryInterval;
+		UE_LOG(LogTemp, Verbose, TEXT("[ControlRigTool] Feedback journal: server unavailable, %d entries pending"), Entries.Num());
+		return;
+	}
+
+	if (bDelivered)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Feedback journal: delivered %d entries (%s)"), SentIds.Num(), *Response.Left(200));
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] Feedback journal: server rejected %d entries (%d): %s"), SentIds.Num(), ResponseCode, *Response.Left(200));
+	}
+
+	Entries.RemoveAll([&SentIds](const FEntry& Entry) { return SentIds.Contains(Entry.Id); });
+	Compact();
+
+	// 남은 엔트리 바로 이어서 전송
+	NextAttemptTime = 0.0;
+	if (Entries.Num() > 0)
+	{
+		SendNext();
+	}
+}
+
+void FFeedbackJournal::MoveToDeadLetter(const TArray<uint64>& Ids, int32 ResponseCode, const FString& Response)
+{
+	// 같은 줄 형식으로 보관 (서버 수정 후 저널 파일로 옮기면 재전송)
+	FString Content;
+	for (const FEntry& Entry : Entries)
+	{
+		if (Ids.Contains(Entry.Id))
+		{
+			Content += ToLine(Entry);
+		}
+	}
+
+	// 기존 내용 + 새 줄을 통째로 교체 (저널과 같은 방식)
+	const FString FilePath = GetDeadLetterFilePath();
+	FString Existing;
+	FFileHelper::LoadFileToString(Existing, *FilePath);
+	if (!SaveFileReplacing(Existing + Content, FilePath))
+	{
+		// 저널에서 지우지 않음 → 다음 실패 때 다시 시도
+		UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] Failed to write feedback dead-letter file: %s"), *FilePath);
+		for (FEntry& Entry : Entries)
+		{
+			if (Ids.Contains(Entry.Id))
+			{
+				Entry.ServerErrors = 0;
+			}
+		}
+		return;
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] Feedback journal: moved %d entries to %s after %d server errors (%d): %s"),
+		Ids.Num(), *FilePath, JournalMaxServerErrors, ResponseCode, *Response.Left(200));
+
+	Entries.RemoveAll([&Ids](const FEntry& Entry) { return Ids.Contains(Entry.Id); });
+	Compact();
+}
+
+void FFeedbackJournal::Shutdown()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+}
@@ -0,0 +1,153 @@
+#include "GenerationPipeline.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Tasks/Task.h"
+#include "ObjectTools.h"
+#include "Editor.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+
+FGenerationPipeline::FGenerationPipeline(const FString& InTitle, bool bInHeadless, TFunction<void(const FString&)> InStatusSink)
+	: Title(InTitle)
+	, bHeadless(bInHeadless)
+	, StatusSink(MoveTemp(InStatusSink))
+	, StartTime(FPlatformTime::Seconds())
+{
+	SlowTask = MakeUnique<FScopedSlowTask>(static_cast<float>(EGenerationStage::Num), FText::FromString(Title));
+	if (!bHeadless)
+	{
+		SlowTask->MakeDialog(true);
+	}
+}
+
+FGenerationPipeline::~FGenerationPipeline()
+{
+	// 진행 바를 먼저 닫고 롤백 (삭제 확인 등 UI가 진행 바 뒤에 가려지지 않게)
+	SlowTask.Reset();
+
+	if (!bCommitted)
+	{
+		Rollback();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] %s: %s (%.2fs)"), *Title,
+		bCommitted ? TEXT("done") : (bCancelled ? TEXT("cancelled") : TEXT("failed")),
+		FPlatformTime::Seconds() - StartTime);
+}
+
+const TCHAR* FGenerationPipeline::GetStageName(EGenerationStage Stage)
+{
+	switch (Stage)
+	{
+	case EGenerationStage::Load:           return TEXT("Load");
+	case EGenerationStage::Analyze:        return TEXT("Analyze");
+	case EGenerationStage::Map:            return TEXT("Map");
+	case EGenerationStage::BuildHierarchy: return TEXT("Build Hierarchy");
+	case EGenerationStage::BuildGraph:     return TEXT("Build Graph");
+	case EGenerationStage::Compile:        return TEXT("Compile");
+	case EGenerationStage::Save:           return TEXT("Save");
+	default:                               return TEXT("Unknown");
+	}
+}
+
+bool FGenerationPipeline::EnterStage(EGenerationStage Stage)
+{
+	if (!Tick()) return false;
+
+	const double Now = FPlatformTime::Seconds();
+	if (CurrentStage != INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] %s: %s stage %.2fs"), *Title,
+			GetStageName(static_cast<EGenerationStage>(CurrentStage)), Now - StageStartTime);
+	}
+	StageStartTime = Now;
+
+	// 건너뛴 단계만큼 진행 바 이동 (단계 순서는 항상 증가)
+	const int32 NewStage = static_cast<int32>(Stage);
+	const int32 Frames = FMath::Max(1, NewStage - FMath::Max(CurrentStage, 0));
+	CurrentStage = NewStage;
+
+	const FString Message = FString::Printf(TEXT("%s: %s..."), *Title, GetStageName(Stage));
+	SlowTask->EnterProgressFrame(static_cast<float>(Frames), FText::FromString(Message));
+	if (StatusSink)
+	{
+		StatusSink(Message);
+	}
+	return true;
+}
+
+bool FGenerationPipeline::Tick()
+{
+	if (bCancelled) return false;
+
+	SlowTask->TickProgress();
+	if (SlowTask->ShouldCancel())
+	{
+		bCancelled = true;
+		if (StatusSink)
+		{
+			StatusSink(FString::Printf(TEXT("%s cancelled (partial assets rolled back)"), *Title));
+		}
+		return false;
+	}
+	return true;
+}
+
+bool FGenerationPipeline::RunInBackground(TFunction<bool()> Work)
+{
+	bool bResult = false;
+	UE::Tasks::FTask Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Work, &bResult]()
+	{
+		bResult = Work();
+	});
+
+	// 완료까지 진행 바 갱신 (취소 요청은 기록만 하고 작업 완료는 기다림)
+	while (!Task.IsCompleted())
+	{
+		Tick();
+		FPlatformProcess::Sleep(0.005f);
+	}
+	Task.Wait();
+
+	return bResult && !bCancelled;
+}
+
+void FGenerationPipeline::TrackCreatedAsset(UObject* Asset)
+{
+	if (Asset)
+	{
+		CreatedAssets.Add(Asset);
+	}
+}
+
+void FGenerationPipeline::AddRollback(TFunction<void()> InRollback)
+{
+	Rollbacks.Add(MoveTemp(InRollback));
+}
+
+void FGenerationPipeline::Rollback()
+{
+	for (int32 i = Rollbacks.Num() - 1; i >= 0; --i)
+	{
+		Rollbacks[i]();
+	}
+
+	TArray<UObject*> ObjectsToDelete;
+	for (const TWeakObjectPtr<UObject>& Asset : CreatedAssets)
+	{
+		if (UObject* Object = Asset.Get())
+		{
+			if (GEditor)
+			{
+				GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->CloseAllEditorsForAsset(Object);
+			}
+			ObjectsToDelete.Add(Object);
+		}
+	}
+
+	if (ObjectsToDelete.Num() > 0)
+	{
+		ObjectTools::ForceDeleteObjects(ObjectsToDelete, false);
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] %s rolled back: %d assets deleted, %d rollback steps"),
+		*Title, ObjectsToDelete.Num(), Rollbacks.Num());
+}
@@ -0,0 +1,86 @@
+#include "MeshBoneHierarchy.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/SkeletalMesh.h"
+#include "Animation/Skeleton.h"
+#include "Misc/PackageName.h"
+
+static FSoftObjectPath ToObjectPath(const FString& Path)
+{
+	// "/Game/A/SK_Mesh" → "/Game/A/SK_Mesh.SK_Mesh"
+	if (Path.Contains(TEXT(".")))
+	{
+		return FSoftObjectPath(Path);
+	}
+	return FSoftObjectPath(Path + TEXT(".") + FPackageName::GetShortName(Path));
+}
+
+FAssetData FMeshBoneHierarchy::GetAssetData(const FString& Path)
+{
+	if (Path.IsEmpty()) return FAssetData();
+
+	IAssetRegistry& AR = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	return AR.GetAssetByObjectPath(ToObjectPath(Path));
+}
+
+USkeletalMesh* FMeshBoneHierarchy::FindLoadedMesh(const FString& MeshPath)
+{
+	if (MeshPath.IsEmpty()) return nullptr;
+	return FindObject<USkeletalMesh>(nullptr, *ToObjectPath(MeshPath).ToString());
+}
+
+const FReferenceSkeleton* FMeshBoneHierarchy::Read(const FString& MeshPath, ESource* OutSource)
+{
+	if (MeshPath.IsEmpty()) return nullptr;
+
+	// 1. 이미 로드된 메쉬
+	if (USkeletalMesh* LoadedMesh = FindLoadedMesh(MeshPath))
+	{
+		if (OutSource) *OutSource = ESource::LoadedMesh;
+		return &LoadedMesh->GetRefSkeleton();
+	}
+
+	// 2. 레지스트리 태그 → 스켈레톤만 로드
+	const FAssetData MeshData = GetAssetData(MeshPath);
+	if (MeshData.IsValid())
+	{
+		FString SkeletonPath;
+		int32 MeshBoneCount = INDEX_NONE;
+		FString BoneCountTag;
+		if (MeshData.GetTagValue(USkeletalMesh::GetSkeletonMemberName(), SkeletonPath) &&
+			MeshData.GetTagValue(TEXT("Bones"), BoneCountTag) && LexTryParseString(MeshBoneCount, *BoneCountTag))
+		{
+			if (USkeleton* Skeleton = Cast<USkeleton>(FSoftObjectPath(FPackageName::ExportTextPathToObjectPath(SkeletonPath)).TryLoad()))
+			{
+				const FReferenceSkeleton& SkeletonRef = Skeleton->GetReferenceSkeleton();
+				// 태그 값이 가상 본 포함/제외 어느 쪽이어도 비교되도록 둘 다 확인
+				if (SkeletonRef.GetRawBoneNum() == MeshBoneCount || SkeletonRef.GetNum() == MeshBoneCount)
+				{
+					if (OutSource) *OutSource = ESource::Skeleton;
+					return &SkeletonRef;
+				}
+				UE_LOG(LogTemp, Verbose, TEXT("[ControlRigTool] %s: skeleton has %d bones, mesh %d → loading mesh"),
+					*MeshPath, SkeletonRef.GetRawBoneNum(), MeshBoneCount);
+			}
+		}
+	}
+
+	// 3. 폴백: 메쉬 로드
+	if (USkeletalMesh* Mesh = Cast<USkeletalMesh>(ToObjectPath(MeshPath).TryLoad()))
+	{
+		if (OutSource) *OutSource = ESource::MeshLoad;
+		return &Mesh->GetRefSkeleton();
+	}
+	return nullptr;
+}
+
+const TCHAR* FMeshBoneHierarchy::GetSourceName(ESource Source)
+{
+	switch (Source)
+	{
+	case ESource::LoadedMesh: return TEXT("loaded mesh");
+	case ESource::Skeleton:   return TEXT("skeleton");
+	case ESource::MeshLoad:   return TEXT("mesh load");
+	default:                  return TEXT("unknown");
+	}
+}
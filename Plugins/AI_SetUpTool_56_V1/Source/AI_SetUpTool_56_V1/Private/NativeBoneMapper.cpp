@@ -0,0 +1,574 @@
+#include "NativeBoneMapper.h"
+#include "ReferenceSkeleton.h"
+
+// ============================================================================
+// 키워드 테이블 (api_server.py와 동일하게 유지할 것)
+// ============================================================================
+namespace NativeBoneMapperTables
+{
+	// UE5 표준 본 이름
+	static const TSet<FString> UE5Bones = {
+		TEXT("root"), TEXT("pelvis"),
+		TEXT("spine_01"), TEXT("spine_02"), TEXT("spine_03"), TEXT("spine_04"), TEXT("spine_05"),
+		TEXT("neck_01"), TEXT("neck_02"), TEXT("head"),
+		TEXT("clavicle_l"), TEXT("clavicle_r"),
+		TEXT("upperarm_l"), TEXT("upperarm_r"), TEXT("lowerarm_l"), TEXT("lowerarm_r"),
+		TEXT("hand_l"), TEXT("hand_r"),
+		TEXT("thigh_l"), TEXT("thigh_r"), TEXT("calf_l"), TEXT("calf_r"),
+		TEXT("foot_l"), TEXT("foot_r"), TEXT("ball_l"), TEXT("ball_r"),
+		TEXT("thumb_01_l"), TEXT("thumb_02_l"), TEXT("thumb_03_l"),
+		TEXT("thumb_01_r"), TEXT("thumb_02_r"), TEXT("thumb_03_r"),
+		TEXT("index_01_l"), TEXT("index_02_l"), TEXT("index_03_l"),
+		TEXT("index_01_r"), TEXT("index_02_r"), TEXT("index_03_r"),
+		TEXT("middle_01_l"), TEXT("middle_02_l"), TEXT("middle_03_l"),
+		TEXT("middle_01_r"), TEXT("middle_02_r"), TEXT("middle_03_r"),
+		TEXT("ring_01_l"), TEXT("ring_02_l"), TEXT("ring_03_l"),
+		TEXT("ring_01_r"), TEXT("ring_02_r"), TEXT("ring_03_r"),
+		TEXT("pinky_01_l"), TEXT("pinky_02_l"), TEXT("pinky_03_l"),
+		TEXT("pinky_01_r"), TEXT("pinky_02_r"), TEXT("pinky_03_r")
+	};
+
+	// 세컨더리 본 키워드
+	static const TArray<FString> SecondaryKeywords = {
+		TEXT("skirt"), TEXT("cape"), TEXT("cloak"), TEXT("cloth"), TEXT("ribbon"), TEXT("tassel"),
+		TEXT("hair"), TEXT("ponytail"), TEXT("pigtail"), TEXT("breast"), TEXT("boob"),
+		TEXT("weapon"), TEXT("attach"), TEXT("socket"), TEXT("slot"), TEXT("mount"),
+		TEXT("ik_"), TEXT("_ik"), TEXT("ikgoal"), TEXT("ikpole"), TEXT("ctrl"), TEXT("control"), TEXT("helper"),
+		TEXT("twist"), TEXT("roll"), TEXT("_tw"), TEXT("nub"), TEXT("_end"), TEXT("dummy"), TEXT("_dm_"), TEXT("_ph_"), TEXT("_b_"),
+		TEXT("point_"), TEXT("lookat"), TEXT("aim_"), TEXT("extra"), TEXT("aux_"), TEXT("sub_"), TEXT("add_")
+	};
+
+	// 키워드 → 본 타입 (순서 중요: 첫 번째 일치 반환)
+	static const TArray<TPair<FString, TArray<FString>>> BoneTypeKeywords = {
+		{ TEXT("pelvis"),   { TEXT("pelvis"), TEXT("hip"), TEXT("hips"), TEXT("waist") } },
+		{ TEXT("spine"),    { TEXT("spine"), TEXT("chest"), TEXT("ribcage") } },
+		{ TEXT("neck"),     { TEXT("neck") } },
+		{ TEXT("head"),     { TEXT("head") } },
+		{ TEXT("clavicle"), { TEXT("clavicle"), TEXT("shoulder") } },
+		{ TEXT("upperarm"), { TEXT("upperarm"), TEXT("upper_arm"), TEXT("uparm"), TEXT("bicep"), TEXT("humerus") } },
+		{ TEXT("lowerarm"), { TEXT("forearm"), TEXT("fore_arm"), TEXT("lowerarm"), TEXT("lower_arm"), TEXT("radius") } },
+		{ TEXT("hand"),     { TEXT("hand"), TEXT("wrist"), TEXT("palm") } },
+		{ TEXT("thigh"),    { TEXT("thigh"), TEXT("upperleg"), TEXT("upper_leg"), TEXT("upleg"), TEXT("femur") } },
+		{ TEXT("calf"),     { TEXT("calf"), TEXT("shin"), TEXT("lowerleg"), TEXT("lower_leg"), TEXT("tibia") } },
+		{ TEXT("foot"),     { TEXT("foot"), TEXT("ankle") } },
+		{ TEXT("ball"),     { TEXT("ball"), TEXT("toe0"), TEXT("toes") } },
+		{ TEXT("finger"),   { TEXT("finger"), TEXT("thumb"), TEXT("index"), TEXT("middle"), TEXT("ring"), TEXT("pinky") } }
+	};
+
+	// L/R 사이드 패턴
+	static const TArray<FString> LeftPatterns = {
+		TEXT("-l-"), TEXT("_l_"), TEXT("-l"), TEXT("_l"), TEXT("left"), TEXT(".l."), TEXT(".l"), TEXT("l-"), TEXT("l_")
+	};
+	static const TArray<FString> RightPatterns = {
+		TEXT("-r-"), TEXT("_r_"), TEXT("-r"), TEXT("_r"), TEXT("right"), TEXT(".r."), TEXT(".r"), TEXT("r-"), TEXT("r_")
+	};
+
+	// 체인 타입별 제외 키워드 (소거법)
+	static const TArray<FString> ExcludeFromSpine = { TEXT("clavicle"), TEXT("shoulder"), TEXT("upperarm"), TEXT("arm"), TEXT("thigh"), TEXT("leg") };
+	static const TArray<FString> ExcludeFromLeg = { TEXT("spine"), TEXT("neck"), TEXT("head"), TEXT("arm"), TEXT("hand") };
+
+	// 코어 본 - 이 중 하나라도 없으면 서버에 나머지 요청
+	static const TArray<FName> CoreTargets = {
+		TEXT("pelvis"), TEXT("spine_01"), TEXT("head"),
+		TEXT("upperarm_l"), TEXT("lowerarm_l"), TEXT("hand_l"),
+		TEXT("upperarm_r"), TEXT("lowerarm_r"), TEXT("hand_r"),
+		TEXT("thigh_l"), TEXT("calf_l"), TEXT("foot_l"),
+		TEXT("thigh_r"), TEXT("calf_r"), TEXT("foot_r")
+	};
+
+	static bool ContainsAny(const FString& LowerName, const TArray<FString>& Keywords)
+	{
+		for (const FString& Keyword : Keywords)
+		{
+			if (LowerName.Contains(Keyword))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+// ============================================================================
+// 분석 헬퍼
+// ============================================================================
+bool FNativeBoneMapper::IsSecondaryBone(const FString& LowerName)
+{
+	return NativeBoneMapperTables::ContainsAny(LowerName, NativeBoneMapperTables::SecondaryKeywords);
+}
+
+TCHAR FNativeBoneMapper::DetectSide(const FString& LowerName)
+{
+	if (NativeBoneMapperTables::ContainsAny(LowerName, NativeBoneMapperTables::LeftPatterns))
+	{
+		return TEXT('l');
+	}
+	if (NativeBoneMapperTables::ContainsAny(LowerName, NativeBoneMapperTables::RightPatterns))
+	{
+		return TEXT('r');
+	}
+	return 0;
+}
+
+FString FNativeBoneMapper::GetBoneTypeFromKeyword(const FString& LowerName)
+{
+	for (const TPair<FString, TArray<FString>>& Entry : NativeBoneMapperTables::BoneTypeKeywords)
+	{
+		if (NativeBoneMapperTables::ContainsAny(LowerName, Entry.Value))
+		{
+			return Entry.Key;
+		}
+	}
+	return FString();
+}
+
+TArray<int32> FNativeBoneMapper::GetChainFromBone(const FSkeletonView& View, int32 BoneIndex, const FString& ChainType, int32 MaxDepth)
+{
+	TArray<int32> Chain;
+	Chain.Add(BoneIndex);
+	int32 Current = BoneIndex;
+
+	for (int32 Step = 0; Step < MaxDepth; ++Step)
+	{
+		// 1차 필터: 세컨더리 제외
+		TArray<int32> ValidChildren;
+		for (int32 Child : View.Children[Current])
+		{
+			if (!IsSecondaryBone(View.LowerNames[Child]))
+			{
+				ValidChildren.Add(Child);
+			}
+		}
+
+		if (ValidChildren.Num() == 0)
+		{
+			break;
+		}
+
+		// 2차 필터: 체인 타입에 따른 소거법 (전부 걸러지면 원래 목록 유지)
+		const TArray<FString>* ExcludeKeywords = nullptr;
+		if (ChainType == TEXT("spine"))
+		{
+			ExcludeKeywords = &NativeBoneMapperTables::ExcludeFromSpine;
+		}
+		else if (ChainType == TEXT("leg"))
+		{
+			ExcludeKeywords = &NativeBoneMapperTables::ExcludeFromLeg;
+		}
+
+		if (ExcludeKeywords)
+		{
+			TArray<int32> Filtered;
+			for (int32 Child : ValidChildren)
+			{
+				if (!NativeBoneMapperTables::ContainsAny(View.LowerNames[Child], *ExcludeKeywords))
+				{
+					Filtered.Add(Child);
+				}
+			}
+			if (Filtered.Num() > 0)
+			{
+				ValidChildren = MoveTemp(Filtered);
+			}
+		}
+
+		Chain.Add(ValidChildren[0]);
+		Current = ValidChildren[0];
+	}
+	return Chain;
+}
+
+TArray<int32> FNativeBoneMapper::GetParentChain(const FSkeletonView& View, int32 BoneIndex, int32 MaxDepth)
+{
+	// 루트 → 본 순서
+	TArray<int32> Chain;
+	Chain.Add(BoneIndex);
+	int32 Current = BoneIndex;
+	for (int32 Step = 0; Step < MaxDepth; ++Step)
+	{
+		const int32 Parent = View.Parents[Current];
+		if (Parent == INDEX_NONE)
+		{
+			break;
+		}
+		Chain.Insert(Parent, 0);
+		Current = Parent;
+	}
+	return Chain;
+}
+
+// ============================================================================
+// 체인 매핑
+// ============================================================================
+void FNativeBoneMapper::MapLegChain(const TArray<TPair<int32, TArray<int32>>>& Chains, const FString& Side, const FSkeletonView& View, FMappingState& State)
+{
+	if (Chains.Num() == 0)
+	{
+		return;
+	}
+
+	// 가장 긴 체인 선택 (thigh 키워드 보너스)
+	const TPair<int32, TArray<int32>>* BestChain = nullptr;
+	int32 BestScore = -1;
+	for (const TPair<int32, TArray<int32>>& Entry : Chains)
+	{
+		int32 Score = Entry.Value.Num();
+		if (GetBoneTypeFromKeyword(View.LowerNames[Entry.Key]) == TEXT("thigh"))
+		{
+			Score += 100;
+		}
+		if (Score > BestScore)
+		{
+			BestScore = Score;
+			BestChain = &Entry;
+		}
+	}
+
+	const TCHAR* LegTargets[] = { TEXT("thigh_"), TEXT("calf_"), TEXT("foot_"), TEXT("ball_") };
+	const TArray<int32>& Chain = BestChain->Value;
+	for (int32 i = 0; i < Chain.Num() && i < (int32)UE_ARRAY_COUNT(LegTargets); ++i)
+	{
+		State.AddIfMissing(FString(LegTargets[i]) + Side, Chain[i]);
+	}
+}
+
+void FNativeBoneMapper::MapArms(const FSkeletonView& View, FMappingState& State)
+{
+	// hand 본을 먼저 찾고 부모 체인 추적
+	for (const TCHAR Side : { TEXT('l'), TEXT('r') })
+	{
+		const FString SideStr = FString::Chr(Side);
+
+		int32 HandBone = INDEX_NONE;
+		for (int32 i = 0; i < View.Names.Num(); ++i)
+		{
+			const FString& Lower = View.LowerNames[i];
+			if (!IsSecondaryBone(Lower) && DetectSide(Lower) == Side && Lower.Contains(TEXT("hand")))
+			{
+				HandBone = i;
+				break;
+			}
+		}
+
+		if (HandBone == INDEX_NONE)
+		{
+			continue;
+		}
+
+		// 뒤에서부터: hand → lowerarm → upperarm → clavicle
+		const TArray<int32> ParentChain = GetParentChain(View, HandBone);
+		TArray<int32> ArmBones;
+		for (int32 i = ParentChain.Num() - 1; i >= 0; --i)
+		{
+			const int32 Bone = ParentChain[i];
+			const FString BoneType = GetBoneTypeFromKeyword(View.LowerNames[Bone]);
+			if (BoneType == TEXT("hand") || BoneType == TEXT("lowerarm") || BoneType == TEXT("upperarm") || BoneType == TEXT("clavicle"))
+			{
+				ArmBones.Insert(Bone, 0);
+			}
+			else if (BoneType == TEXT("spine") || BoneType == TEXT("neck") || BoneType == TEXT("head") || BoneType == TEXT("pelvis"))
+			{
+				break;
+			}
+			else if (ArmBones.Num() > 0)
+			{
+				// 이미 팔 본이 있으면 이름 없어도 체인에 추가
+				ArmBones.Insert(Bone, 0);
+			}
+
+			if (ArmBones.Num() >= 4)
+			{
+				break;
+			}
+		}
+
+		const int32 Num = ArmBones.Num();
+		if (Num >= 3)
+		{
+			State.AddIfMissing(TEXT("hand_") + SideStr, ArmBones[Num - 1]);
+			State.AddIfMissing(TEXT("lowerarm_") + SideStr, ArmBones[Num - 2]);
+			State.AddIfMissing(TEXT("upperarm_") + SideStr, ArmBones[Num - 3]);
+			if (Num >= 4)
+			{
+				State.AddIfMissing(TEXT("clavicle_") + SideStr, ArmBones[Num - 4]);
+			}
+		}
+	}
+}
+
+void FNativeBoneMapper::MapFingers(const TArray<int32>& FingerRoots, const FSkeletonView& View, const FString& Side, FMappingState& State)
+{
+	static const TCHAR* FingerNames[] = { TEXT("thumb"), TEXT("index"), TEXT("middle"), TEXT("ring"), TEXT("pinky") };
+
+	for (int32 Root : FingerRoots)
+	{
+		const FString& RootLower = View.LowerNames[Root];
+		if (IsSecondaryBone(RootLower))
+		{
+			continue;
+		}
+
+		const TArray<int32> Chain = GetChainFromBone(View, Root);
+
+		// 손가락 타입 감지
+		FString FingerType;
+		for (const TCHAR* FingerName : FingerNames)
+		{
+			if (RootLower.Contains(FingerName))
+			{
+				FingerType = FingerName;
+				break;
+			}
+		}
+
+		// Biped 형식: Finger0 = thumb, Finger1 = index ...
+		for (int32 FingerIdx = 0; FingerIdx < (int32)UE_ARRAY_COUNT(FingerNames); ++FingerIdx)
+		{
+			if (RootLower.Contains(FString::Printf(TEXT("finger%d"), FingerIdx)))
+			{
+				FingerType = FingerNames[FingerIdx];
+				break;
+			}
+		}
+
+		if (FingerType.IsEmpty())
+		{
+			continue;
+		}
+
+		for (int32 i = 0; i < Chain.Num() && i < 3; ++i)
+		{
+			State.AddIfMissing(FString::Printf(TEXT("%s_0%d_%s"), *FingerType, i + 1, *Side), Chain[i]);
+		}
+	}
+}
+
+// ============================================================================
+// 전체 스켈레톤 분석 및 매핑
+// ============================================================================
+TMap<FName, FName> FNativeBoneMapper::MapSkeleton(const FReferenceSkeleton& RefSkeleton)
+{
+	// 1회 패스로 이름/부모/자식 테이블 구성
+	FSkeletonView View;
+	const int32 NumBones = RefSkeleton.GetNum();
+	View.Names.Reserve(NumBones);
+	View.LowerNames.Reserve(NumBones);
+	View.Parents.Reserve(NumBones);
+	View.Children.SetNum(NumBones);
+	for (int32 i = 0; i < NumBones; ++i)
+	{
+		View.Names.Add(RefSkeleton.GetBoneName(i).ToString());
+		View.LowerNames.Add(View.Names[i].ToLower());
+		const int32 Parent = RefSkeleton.GetParentIndex(i);
+		View.Parents.Add(Parent);
+		if (Parent != INDEX_NONE)
+		{
+			View.Children[Parent].Add(i);
+		}
+	}
+
+	FMappingState State;
+	TMap<FName, FName> Result;
+	if (NumBones == 0)
+	{
+		return Result;
+	}
+
+	// 1. Root (부모 없는 본)
+	const int32 Root = View.Parents.IndexOfByKey(INDEX_NONE);
+	if (Root != INDEX_NONE)
+	{
+		State.Set(TEXT("root"), Root);
+	}
+
+	// 2. Pelvis
+	int32 Pelvis = INDEX_NONE;
+	for (int32 i = 0; i < NumBones; ++i)
+	{
+		const FString& Lower = View.LowerNames[i];
+		if ((Lower.Contains(TEXT("pelvis")) || Lower.Contains(TEXT("hip"))) && !IsSecondaryBone(Lower))
+		{
+			Pelvis = i;
+			break;
+		}
+	}
+	if (Pelvis == INDEX_NONE && Root != INDEX_NONE)
+	{
+		// Root의 첫 번째 자식을 pelvis로 추정
+		for (int32 Child : View.Children[Root])
+		{
+			if (!IsSecondaryBone(View.LowerNames[Child]))
+			{
+				Pelvis = Child;
+				break;
+			}
+		}
+	}
+
+	if (Pelvis != INDEX_NONE)
+	{
+		State.Set(TEXT("pelvis"), Pelvis);
+
+		// 3. Pelvis 자식 분석
+		int32 SpineChainStart = INDEX_NONE;
+		TArray<TPair<int32, TArray<int32>>> LegChainsL;
+		TArray<TPair<int32, TArray<int32>>> LegChainsR;
+		TArray<TPair<int32, TArray<int32>>> OtherChains;
+
+		for (int32 Child : View.Children[Pelvis])
+		{
+			const FString& Lower = View.LowerNames[Child];
+			if (IsSecondaryBone(Lower))
+			{
+				continue;
+			}
+
+			TArray<int32> ChildChain = GetChainFromBone(View, Child);
+			const FString ChildType = GetBoneTypeFromKeyword(Lower);
+			const TCHAR ChildSide = DetectSide(Lower);
+
+			if (ChildType == TEXT("spine"))
+			{
+				SpineChainStart = Child;
+			}
+			else if (ChildType == TEXT("thigh") || (ChildType.IsEmpty() && ChildChain.Num() >= 3))
+			{
+				if (ChildSide == TEXT('l'))
+				{
+					LegChainsL.Emplace(Child, MoveTemp(ChildChain));
+				}
+				else if (ChildSide == TEXT('r'))
+				{
+					LegChainsR.Emplace(Child, MoveTemp(ChildChain));
+				}
+				else
+				{
+					OtherChains.Emplace(Child, MoveTemp(ChildChain));
+				}
+			}
+		}
+
+		// 4. Spine 체인 (소거법: 팔/다리 분기 제외)
+		if (SpineChainStart != INDEX_NONE)
+		{
+			int32 SpineIndex = 1;
+			for (int32 Bone : GetChainFromBone(View, SpineChainStart, TEXT("spine")))
+			{
+				const FString& Lower = View.LowerNames[Bone];
+
+				// 3dsMax Biped 규칙: Spine, Spine1, Spine2 → spine_01, spine_02, spine_03
+				if (Lower.Contains(TEXT("spine2")))
+				{
+					State.Set(TEXT("spine_03"), Bone);
+				}
+				else if (Lower.Contains(TEXT("spine1")))
+				{
+					State.Set(TEXT("spine_02"), Bone);
+				}
+				else if (Lower.Contains(TEXT("spine")))
+				{
+					// 위치 기반 매핑 (SpineA, SpineB 같은 경우)
+					const FString Target = FString::Printf(TEXT("spine_0%d"), SpineIndex);
+					if (SpineIndex <= 5 && !State.Contains(Target))
+					{
+						State.Set(Target, Bone);
+						SpineIndex++;
+					}
+				}
+				else if (Lower.Contains(TEXT("neck")))
+				{
+					State.Set(TEXT("neck_01"), Bone);
+				}
+				else if (Lower.Contains(TEXT("head")))
+				{
+					State.Set(TEXT("head"), Bone);
+				}
+			}
+		}
+
+		// 5. 다리 체인
+		MapLegChain(LegChainsL, TEXT("l"), View, State);
+		MapLegChain(LegChainsR, TEXT("r"), View, State);
+
+		// 사이드 없는 체인 - 비어 있는 쪽에 순서대로 할당
+		if (OtherChains.Num() > 0 && (LegChainsL.Num() == 0 || LegChainsR.Num() == 0))
+		{
+			bool bHasLeftLeg = LegChainsL.Num() > 0;
+			for (const TPair<int32, TArray<int32>>& Entry : OtherChains)
+			{
+				if (!bHasLeftLeg && !State.Contains(TEXT("thigh_l")))
+				{
+					MapLegChain({ Entry }, TEXT("l"), View, State);
+					bHasLeftLeg = true;
+				}
+				else if (LegChainsR.Num() == 0 && !State.Contains(TEXT("thigh_r")))
+				{
+					MapLegChain({ Entry }, TEXT("r"), View, State);
+				}
+			}
+		}
+
+		// 6. 팔 체인
+		MapArms(View, State);
+
+		// 7. 손가락 (hand 자식에서 찾기)
+		for (const TCHAR* Side : { TEXT("l"), TEXT("r") })
+		{
+			if (const int32* Hand = State.Targets.Find(FString(TEXT("hand_")) + Side))
+			{
+				MapFingers(View.Children[*Hand], View, Side, State);
+			}
+		}
+
+		// 8. 나머지 키워드 기반 매핑
+		for (int32 i = 0; i < NumBones; ++i)
+		{
+			const FString& Lower = View.LowerNames[i];
+			if (State.MappedSources.Contains(i) || IsSecondaryBone(Lower))
+			{
+				continue;
+			}
+
+			const FString BoneType = GetBoneTypeFromKeyword(Lower);
+			const TCHAR Side = DetectSide(Lower);
+			if (!BoneType.IsEmpty() && Side != 0)
+			{
+				const FString Target = BoneType + TEXT("_") + FString::Chr(Side);
+				if (NativeBoneMapperTables::UE5Bones.Contains(Target) && !State.Contains(Target))
+				{
+					State.Set(Target, i);
+				}
+			}
+		}
+	}
+
+	Result.Reserve(State.Targets.Num());
+	for (const TPair<FString, int32>& Pair : State.Targets)
+	{
+		Result.Add(FName(*Pair.Key), RefSkeleton.GetBoneName(Pair.Value));
+	}
+	return Result;
+}
+
+bool FNativeBoneMapper::IsCoreMappingComplete(const TMap<FName, FName>& Mapping)
+{
+	for (const FName& Target : NativeBoneMapperTables::CoreTargets)
+	{
+		if (!Mapping.Contains(Target))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void FNativeBoneMapper::MergeServerMapping(TMap<FName, FName>& InOutMapping, const TMap<FName, FName>& ServerMapping)
+{
+	for (const TPair<FName, FName>& Pair : ServerMapping)
+	{
+		if (!InOutMapping.Contains(Pair.Key))
+		{
+			InOutMapping.Add(Pair.Key, Pair.Value);
+		}
+	}
+}
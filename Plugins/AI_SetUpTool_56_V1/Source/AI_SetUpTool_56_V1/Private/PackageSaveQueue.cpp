@@ -0,0 +1,116 @@
+#include "PackageSaveQueue.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "Misc/PackageName.h"
+#include "HAL/FileManager.h"
+
+TArray<FPackageSaveQueue*>& FPackageSaveQueue::GetActiveScopes()
+{
+	static TArray<FPackageSaveQueue*> ActiveScopes;
+	return ActiveScopes;
+}
+
+FPackageSaveQueue::FPackageSaveQueue(const FString& InTitle)
+	: Title(InTitle)
+{
+	// 바깥 스코프가 있으면 합류 (저장은 가장 바깥에서 한 번)
+	if (GetActiveScopes().Num() > 0)
+	{
+		OuterScope = GetActiveScopes().Last();
+	}
+	GetActiveScopes().Add(this);
+}
+
+FPackageSaveQueue::~FPackageSaveQueue()
+{
+	GetActiveScopes().Remove(this);
+
+	if (!OuterScope)
+	{
+		Flush();
+	}
+}
+
+bool FPackageSaveQueue::Save(UPackage* Package, UObject* Asset)
+{
+	if (!Package || !Asset) return false;
+
+	if (GetActiveScopes().Num() > 0)
+	{
+		FPackageSaveQueue& Root = GetActiveScopes().Last()->GetRoot();
+		if (!Root.Entries.ContainsByPredicate([Package](const FEntry& Entry) { return Entry.Package.Get() == Package; }))
+		{
+			Root.Entries.Add({ Package, Asset });
+		}
+		return true;
+	}
+
+	// 활성 큐 없음 → 임시 큐로 바로 저장
+	FPackageSaveQueue Immediate(Asset->GetName());
+	Immediate.Entries.Add({ Package, Asset });
+	const TArray<FPackageSaveResult>& ImmediateResults = Immediate.Flush();
+	return ImmediateResults.Num() > 0 && ImmediateResults.Last().bSuccess;
+}
+
+const TArray<FPackageSaveResult>& FPackageSaveQueue::Flush()
+{
+	FPackageSaveQueue& Root = GetRoot();
+	if (Root.Entries.Num() == 0) return Root.Results;
+
+	const double StartTime = FPlatformTime::Seconds();
+	const int32 FirstResult = Root.Results.Num();
+	TArray<FString> Filenames;
+
+	// 1. 직렬화 (게임 스레드) - 파일 쓰기는 비동기로 넘김
+	for (const FEntry& Entry : Root.Entries)
+	{
+		UPackage* Package = Entry.Package.Get();
+		UObject* Asset = Entry.Asset.Get();
+
+		FPackageSaveResult& Result = Root.Results.AddDefaulted_GetRef();
+		Result.PackageName = Package ? Package->GetName() : FString();
+		Filenames.Add(Package ? FPackageName::LongPackageNameToFilename(Result.PackageName, FPackageName::GetAssetPackageExtension()) : FString());
+
+		if (!Package || !Asset)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] Save skipped (object was deleted): %s"), *Result.PackageName);
+			continue;
+		}
+
+		const double PackageStartTime = FPlatformTime::Seconds();
+
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		SaveArgs.SaveFlags = SAVE_Async;
+		SaveArgs.Error = GError;
+		Result.bSuccess = UPackage::SavePackage(Package, Asset, *Filenames.Last(), SaveArgs);
+
+		Result.Seconds = FPlatformTime::Seconds() - PackageStartTime;
+	}
+	Root.Entries.Reset();
+
+	// 2. 비동기 파일 쓰기 완료 대기 (한 번)
+	const double WriteStartTime = FPlatformTime::Seconds();
+	UPackage::WaitForAsyncFileWrites();
+	const double WriteSeconds = FPlatformTime::Seconds() - WriteStartTime;
+
+	// 3. 크기 기록 + 리포트
+	int64 TotalBytes = 0;
+	for (int32 i = FirstResult; i < Root.Results.Num(); ++i)
+	{
+		FPackageSaveResult& Result = Root.Results[i];
+		if (Result.bSuccess)
+		{
+			Result.SizeBytes = FMath::Max<int64>(IFileManager::Get().FileSize(*Filenames[i - FirstResult]), 0);
+			TotalBytes += Result.SizeBytes;
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("[ControlRigTool]   Saved %-60s %.2fs %8.1f KB%s"),
+			*Result.PackageName, Result.Seconds, Result.SizeBytes / 1024.0, Result.bSuccess ? TEXT("") : TEXT(" FAILED"));
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] %s: saved %d packages, %.1f KB (%.2fs, async write wait %.2fs)"),
+		*Root.Title, Root.Results.Num() - FirstResult, TotalBytes / 1024.0, FPlatformTime::Seconds() - StartTime, WriteSeconds);
+
+	return Root.Results;
+}
@@ -0,0 +1,105 @@
+#include "RigHierarchyBatchEdit.h"
+#include "ControlRigBlueprint.h"
+#include "Rigs/RigHierarchy.h"
+#include "Rigs/RigHierarchyController.h"
+
+TArray<FRigHierarchyBatchEdit*>& FRigHierarchyBatchEdit::GetActiveScopes()
+{
+	static TArray<FRigHierarchyBatchEdit*> ActiveScopes;
+	return ActiveScopes;
+}
+
+FRigHierarchyBatchEdit::FRigHierarchyBatchEdit(UControlRigBlueprint* InBlueprint)
+	: Blueprint(InBlueprint)
+{
+	if (Blueprint)
+	{
+		Hierarchy = Blueprint->Hierarchy;
+		Controller = Blueprint->GetHierarchyController();
+	}
+
+	for (FRigHierarchyBatchEdit* Scope : GetActiveScopes())
+	{
+		if (Scope->Blueprint == Blueprint)
+		{
+			OuterScope = Scope;
+			break;
+		}
+	}
+	GetActiveScopes().Add(this);
+
+	if (OuterScope || !Hierarchy) return;
+
+	bPrevSuspendNotifications = Hierarchy->GetSuspendNotificationsFlag();
+	Hierarchy->GetSuspendNotificationsFlag() = true;
+}
+
+FRigHierarchyBatchEdit::~FRigHierarchyBatchEdit()
+{
+	GetActiveScopes().Remove(this);
+
+	if (OuterScope || !Hierarchy) return;
+
+	const int32 NumApplied = Flush();
+
+	Hierarchy->GetSuspendNotificationsFlag() = bPrevSuspendNotifications;
+
+	// 알림 없이 바뀐 계층 → 트랜스폼 한 번에 재계산 후 인스턴스에 전파
+	Hierarchy->ComputeAllTransforms();
+	Blueprint->PropagateHierarchyFromBPToInstances();
+
+	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Hierarchy batch applied (%d deferred changes)"), NumApplied);
+}
+
+void FRigHierarchyBatchEdit::RemoveElement(const FRigElementKey& Key)
+{
+	GetRoot().PendingRemoves.Add(Key);
+}
+
+void FRigHierarchyBatchEdit::SetParent(const FRigElementKey& Child, const FRigElementKey& Parent, bool bMaintainGlobalTransform)
+{
+	GetRoot().PendingParents.Emplace(Child, Parent, bMaintainGlobalTransform);
+}
+
+void FRigHierarchyBatchEdit::SetControlSettings(const FRigElementKey& Key, const FRigControlSettings& Settings)
+{
+	GetRoot().PendingSettings.Emplace(Key, Settings);
+}
+
+int32 FRigHierarchyBatchEdit::Flush(TSet<FRigElementKey>* OutFailed)
+{
+	FRigHierarchyBatchEdit& Root = GetRoot();
+	if (!Root.Controller) return 0;
+
+	int32 NumApplied = 0;
+
+	// 삭제 → 부모 변경 → 설정 순서 (삭제된 요소를 참조하는 변경은 자연히 실패)
+	auto Record = [&NumApplied, OutFailed](bool bSuccess, const FRigElementKey& Key)
+	{
+		if (bSuccess)
+		{
+			++NumApplied;
+		}
+		else if (OutFailed)
+		{
+			OutFailed->Add(Key);
+		}
+	};
+	for (const FRigElementKey& Key : Root.PendingRemoves)
+	{
+		Record(Root.Controller->RemoveElement(Key, false, false), Key);
+	}
+	for (const TTuple<FRigElementKey, FRigElementKey, bool>& Parent : Root.PendingParents)
+	{
+		Record(Root.Controller->SetParent(Parent.Get<0>(), Parent.Get<1>(), Parent.Get<2>()), Parent.Get<0>());
+	}
+	for (const TPair<FRigElementKey, FRigControlSettings>& Settings : Root.PendingSettings)
+	{
+		Record(Root.Controller->SetControlSettings(Settings.Key, Settings.Value, false), Settings.Key);
+	}
+
+	Root.PendingRemoves.Reset();
+	Root.PendingParents.Reset();
+	Root.PendingSettings.Reset();
+	return NumApplied;
+}
@@ -0,0 +1,78 @@
+#include "RigVMBulkEdit.h"
+#include "RigVMBlueprint.h"
+#include "RigVMModel/RigVMController.h"
+
+TArray<FRigVMBulkEdit*>& FRigVMBulkEdit::GetActiveScopes()
+{
+	static TArray<FRigVMBulkEdit*> ActiveScopes;
+	return ActiveScopes;
+}
+
+FRigVMBulkEdit::FRigVMBulkEdit(URigVMBlueprint* InBlueprint, URigVMController* InController, const FString& InTitle)
+	: Blueprint(InBlueprint)
+	, Controller(InController)
+	, Title(InTitle)
+	, StartTime(FPlatformTime::Seconds())
+{
+	// 같은 블루프린트의 바깥 스코프가 있으면 합류
+	for (FRigVMBulkEdit* Scope : GetActiveScopes())
+	{
+		if (Scope->Blueprint == Blueprint)
+		{
+			OuterScope = Scope;
+			break;
+		}
+	}
+	GetActiveScopes().Add(this);
+
+	if (OuterScope || !Blueprint || !Controller) return;
+
+	Controller->OpenUndoBracket(Title);
+
+	bPrevAutoVMRecompile = Blueprint->GetAutoVMRecompile();
+	Blueprint->SetAutoVMRecompile(false);
+	Blueprint->SuspendNotifications(true);
+}
+
+FRigVMBulkEdit::~FRigVMBulkEdit()
+{
+	GetActiveScopes().Remove(this);
+
+	if (OuterScope)
+	{
+		OuterScope->OperationCount += OperationCount;
+		return;
+	}
+
+	if (!Blueprint || !Controller) return;
+
+	// 알림 재개 시 EdGraph를 모델에서 한 번에 재구성 (자동 재컴파일은 아직 꺼둔 상태)
+	Blueprint->SuspendNotifications(false);
+	Controller->CloseUndoBracket();
+
+	Blueprint->RecompileVM();
+	Blueprint->SetAutoVMRecompile(bPrevAutoVMRecompile);
+
+	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] %s: %d controller operations, 1 VM compile (%.2fs)"),
+		*Title, OperationCount, FPlatformTime::Seconds() - StartTime);
+}
+
+bool FRigVMBulkEdit::SetArrayPinDefaultValue(const FString& ArrayPinPath, const TArray<FString>& Elements)
+{
+	if (Elements.Num() == 0) return true;
+
+	// ((Elem0),(Elem1),...) → bResizeArrays로 배열 크기까지 한 번에 맞춤
+	const FString ArrayValue = FString::Printf(TEXT("(%s)"), *FString::Join(Elements, TEXT(",")));
+	return (*this)->SetPinDefaultValue(ArrayPinPath, ArrayValue, true, false, false);
+}
+
+TArray<FString> FRigVMBulkEdit::MakeElementKeys(const TCHAR* ElementType, const TArray<FName>& Names)
+{
+	TArray<FString> Elements;
+	Elements.Reserve(Names.Num());
+	for (const FName& Name : Names)
+	{
+		Elements.Add(FString::Printf(TEXT("(Type=%s,Name=\"%s\")"), ElementType, *Name.ToString()));
+	}
+	return Elements;
+}
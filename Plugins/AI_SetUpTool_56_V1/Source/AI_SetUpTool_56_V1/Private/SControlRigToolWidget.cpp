@@ -1,4 +1,18 @@
 #include "SControlRigToolWidget.h"
+#include "BoneMappingCache.h"
+#include "SkeletonTopology.h"
+#include "BoneKeywordClassifier.h"
+#include "BoneVertexAnalysis.h"
+#include "RigVMBulkEdit.h"
+#include "RigHierarchyBatchEdit.h"
+#include "ControlRigTemplateSnapshot.h"
+#include "GenerationPipeline.h"
+#include "PackageSaveQueue.h"
+#include "AssetCatalog.h"
+#include "MeshBoneHierarchy.h"
+#include "AIServerLauncher.h"
+#include "FeedbackJournal.h"
+#include "BoneMappingBatch.h"
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/Layout/SBorder.h"
 #include "Widgets/Layout/SScrollBox.h"
@@ -6,7 +20,9 @@
 #include "Widgets/Text/STextBlock.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Input/SSearchBox.h"
 #include "Widgets/SBoxPanel.h"
+#include "Widgets/SOverlay.h"
 #include "Widgets/Images/SImage.h"
 #include "Styling/AppStyle.h"
 #include "Styling/StyleColors.h"
@@ -18,11 +34,13 @@
 #include "IContentBrowserSingleton.h"
 #include "Framework/Application/SlateApplication.h"
 #include "HttpModule.h"
+#include "HttpManager.h"
 #include "Interfaces/IHttpRequest.h"
 #include "Interfaces/IHttpResponse.h"
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
 #include "AssetToolsModule.h"
 #include "Engine/SkeletalMesh.h"
 #include "Animation/Skeleton.h"
@@ -42,13 +60,11 @@
 #include "RigVMModel/RigVMGraph.h"
 #include "RigVMModel/RigVMNode.h"
 #include "RigVMModel/RigVMPin.h"
+#include "Misc/OutputDeviceNull.h"
 #include "RigVMFunctions/RigVMDispatch_Array.h"
 #include "HAL/PlatformApplicationMisc.h"
 #include "Widgets/Input/SMultiLineEditableTextBox.h"
 #include "Widgets/Layout/SWidgetSwitcher.h"
-#include "MeshUtilitiesCommon.h"
-#include "MeshUtilitiesEngine.h"
-#include "UObject/SavePackage.h"
 // IK Rig
 #include "Rig/IKRigDefinition.h"
 #include "RigEditor/IKRigController.h"
@@ -94,6 +110,13 @@
 // ============================================================================
 static void ShowDebugPopup(const FString& Title, const FString& Content)
 {
+	// 헤드리스 실행(Commandlet)에서는 Slate가 없으므로 로그로 대체
+	if (!FSlateApplication::IsInitialized())
+	{
+		UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] %s\n%s"), *Title, *Content);
+		return;
+	}
+	
 	TSharedRef<SWindow> DebugWindow = SNew(SWindow)
 		.Title(FText::FromString(Title))
 		.ClientSize(FVector2D(600, 400))
@@ -149,148 +172,52 @@ static void ShowDebugPopup(const FString& Title, const FString& Content)
 	FSlateApplication::Get().AddWindow(DebugWindow);
 }
 
-// ============================================================================
-// 제로 뼈구조 정의 (UE5 표준 본) - 소문자로 비교
-// ============================================================================
-const TSet<FString> SControlRigToolWidget::ZeroBones = {
-	// 루트/몸통
-	TEXT("root"), TEXT("pelvis"),
-	TEXT("spine_01"), TEXT("spine_02"), TEXT("spine_03"), TEXT("spine_04"), TEXT("spine_05"),
-	TEXT("neck_01"), TEXT("neck_02"), TEXT("head"),
-	// 왼쪽 팔
-	TEXT("clavicle_l"), TEXT("upperarm_l"), TEXT("lowerarm_l"), TEXT("hand_l"),
-	// 오른쪽 팔
-	TEXT("clavicle_r"), TEXT("upperarm_r"), TEXT("lowerarm_r"), TEXT("hand_r"),
-	// 왼쪽 다리
-	TEXT("thigh_l"), TEXT("calf_l"), TEXT("foot_l"), TEXT("ball_l"),
-	// 오른쪽 다리
-	TEXT("thigh_r"), TEXT("calf_r"), TEXT("foot_r"), TEXT("ball_r"),
-	// 왼쪽 손가락
-	TEXT("thumb_01_l"), TEXT("thumb_02_l"), TEXT("thumb_03_l"),
-	TEXT("index_01_l"), TEXT("index_02_l"), TEXT("index_03_l"),
-	TEXT("middle_01_l"), TEXT("middle_02_l"), TEXT("middle_03_l"),
-	TEXT("ring_01_l"), TEXT("ring_02_l"), TEXT("ring_03_l"),
-	TEXT("pinky_01_l"), TEXT("pinky_02_l"), TEXT("pinky_03_l"),
-	// 오른쪽 손가락
-	TEXT("thumb_01_r"), TEXT("thumb_02_r"), TEXT("thumb_03_r"),
-	TEXT("index_01_r"), TEXT("index_02_r"), TEXT("index_03_r"),
-	TEXT("middle_01_r"), TEXT("middle_02_r"), TEXT("middle_03_r"),
-	TEXT("ring_01_r"), TEXT("ring_02_r"), TEXT("ring_03_r"),
-	TEXT("pinky_01_r"), TEXT("pinky_02_r"), TEXT("pinky_03_r"),
-	// IK 본 (템플릿 전용)
-	TEXT("ik_foot_root"), TEXT("ik_foot_l"), TEXT("ik_foot_r"),
-	TEXT("ik_hand_root"), TEXT("ik_hand_gun"), TEXT("ik_hand_l"), TEXT("ik_hand_r"),
-	TEXT("heel_l"), TEXT("heel_r"), TEXT("tip_l"), TEXT("tip_r")
-};
-
-// ============================================================================
-// 액세서리 키워드 (컨트롤러 생성 O) - 의상, 머리카락, 무기 등
-// ============================================================================
-const TArray<FString> SControlRigToolWidget::AccessoryKeywords = {
-	// 의상/망토
-	TEXT("skirt"), TEXT("cape"), TEXT("cloak"), TEXT("cloth"), TEXT("ribbon"), TEXT("tassel"),
-	TEXT("coat"), TEXT("jacket"), TEXT("robe"), TEXT("scarf"), TEXT("collar_cloth"), TEXT("sleeve"),
-	// 머리카락
-	TEXT("hair"), TEXT("ponytail"), TEXT("pigtail"), TEXT("braid"), TEXT("longhair"), TEXT("bangs"),
-	// 가슴/물리
-	TEXT("breast"), TEXT("boob"), TEXT("chest_physics"),
-	// 무기/악세서리
-	TEXT("weapon"), TEXT("sword"), TEXT("shield"), TEXT("bow"), TEXT("quiver"),
-	TEXT("earring"), TEXT("necklace"), TEXT("accessory"), TEXT("ornament"),
-	TEXT("belt"), TEXT("pouch"), TEXT("bag"),
-	// 기타 부속
-	TEXT("tail"), TEXT("wing"), TEXT("antenna"),
-	// 일반 접두사
-	TEXT("bone_acc"), TEXT("_acc_"), TEXT("acc_"), TEXT("bone_"),
-	// 얼굴 관련 (세컨더리로 생성)
-	TEXT("eye"), TEXT("jaw"), TEXT("mouth"), TEXT("eyebrow"), TEXT("eyelid"), TEXT("brow"),
-	TEXT("tongue"), TEXT("teeth"), TEXT("lip"), TEXT("nose"), TEXT("cheek"), TEXT("ear_"),
-	TEXT("facial"), TEXT("face_")
-};
-
-// ============================================================================
-// 헬퍼 키워드 (컨트롤러 생성 X) - 트위스트, 보정, IK 등
-// 주의: 너무 일반적인 키워드는 제외 (얼굴 본 등에 영향)
-// ============================================================================
-const TArray<FString> SControlRigToolWidget::HelperKeywords = {
-	// 트위스트/롤 본
-	TEXT("twist"), TEXT("roll"), TEXT("_tw"),
-	// 보정 본
-	TEXT("corrective"), TEXT("blend"),
-	// 더미/종단 본
-	TEXT("nub"), TEXT("dummy"),
-	// IK 관련
-	TEXT("ik_"), TEXT("_ik"), TEXT("ikgoal"), TEXT("ikpole"),
-	// 컨트롤/가이드 (이미 컨트롤러인 것)
-	TEXT("ctrl"), TEXT("control"), TEXT("helper"), TEXT("guide"),
-	// 보조 본
-	TEXT("lookat"), TEXT("aim_"), TEXT("target"),
-	TEXT("aux_"), TEXT("add_"),
-	TEXT("_dm_"), TEXT("_ph_"),
-	TEXT("metacarpal"), TEXT("attach"),
-	TEXT("interpolate"), TEXT("driver")
-};
-
 // ============================================================================
 // 본 분류 함수들
 // ============================================================================
+// 키워드 테이블은 BoneKeywordClassifier.cpp (+ 프로젝트 Config/AIRigSetup/BoneKeywords.json)
 bool SControlRigToolWidget::IsZeroBone(const FString& BoneName) const
 {
-	// LastBoneMapping에 매핑된 본인지 확인 (소스 본)
-	for (const auto& Pair : LastBoneMapping)
+	// 제로 뼈구조 (UE5 표준 본)인지 확인
+	if (FBoneKeywordClassifier::Get().HasAny(BoneName, EBoneKeyword::Zero))
 	{
-		if (Pair.Value.ToString().Equals(BoneName, ESearchCase::IgnoreCase))
-		{
-			return true;
-		}
+		return true;
 	}
 	
-	// ZeroBones 세트에 있는지 확인
-	FString LowerName = BoneName.ToLower();
-	return ZeroBones.Contains(LowerName);
+	// LastBoneMapping에 매핑된 본인지 확인 (소스 본, 역방향 인덱스)
+	return LastBoneMapping.ContainsSource(FName(*BoneName, FNAME_Find));
 }
 
 bool SControlRigToolWidget::IsAccessoryBone(const FString& BoneName) const
 {
-	FString LowerName = BoneName.ToLower();
-	
-	// 먼저 헬퍼 본인지 확인 (헬퍼가 우선)
-	if (IsHelperBone(BoneName))
-	{
-		return false;
-	}
-	
-	// 액세서리 키워드 포함 여부
-	for (const FString& Keyword : AccessoryKeywords)
-	{
-		if (LowerName.Contains(Keyword))
-		{
-			return true;
-		}
-	}
-	
-	return false;
+	// 헬퍼가 우선 (한 번의 스캔으로 두 카테고리 모두 확인)
+	const EBoneKeyword Keywords = FBoneKeywordClassifier::Get().Classify(BoneName);
+	return EnumHasAnyFlags(Keywords, EBoneKeyword::Accessory) && !EnumHasAnyFlags(Keywords, EBoneKeyword::Helper);
 }
 
 bool SControlRigToolWidget::IsHelperBone(const FString& BoneName) const
 {
-	FString LowerName = BoneName.ToLower();
-	
-	for (const FString& Keyword : HelperKeywords)
-	{
-		if (LowerName.Contains(Keyword))
-		{
-			return true;
-		}
-	}
-	
-	return false;
+	return FBoneKeywordClassifier::Get().HasAny(BoneName, EBoneKeyword::Helper);
 }
 
 void SControlRigToolWidget::Construct(const FArguments& InArgs)
 {
+	bHeadless = InArgs._Headless;
+	if (bHeadless)
+	{
+		// 헤드리스: 에셋 목록만 로드 (위젯/썸네일 생성 X)
+		LoadAssetData();
+		LoadIKRigTemplates();
+		RefreshMappingCacheModelVersion();
+		return;
+	}
+	
 	ThumbnailPool = MakeShared<FAssetThumbnailPool>(24);
 	LoadAssetData();
+	RefreshMappingCacheModelVersion();
+	
+	// 에셋 추가/삭제/이름 변경 시 목록 자동 갱신 (새로고침 버튼 불필요)
+	CatalogChangedHandle = FAssetCatalog::Get().OnChanged().AddSP(this, &SControlRigToolWidget::OnAssetCatalogChanged);
 
 	// 프로페셔널 색상 팔레트
 	const FLinearColor HeaderBgColor(0.02f, 0.02f, 0.025f, 1.0f);     // 거의 검정
@@ -582,10 +509,14 @@ FReply SControlRigToolWidget::OnResetAllClicked()
 	{
 		MeshComboBox->ClearSelection();
 	}
+	SetTabMappingSession(ControlRigMappingSession, nullptr);
+	bMappingRequestInFlight = false;
 	LastBoneMapping.Empty();
 	BoneDisplayList.Empty();
 	CachedMesh.Reset();
 	PendingControlRig.Reset();
+	PendingTemplateSnapshot.Reset();
+	ResetSecondaryBuildState();
 	CurrentStep = EControlRigWorkflowStep::Step1_Setup;
 	if (OutputNameBox.IsValid())
 	{
@@ -614,6 +545,7 @@ FReply SControlRigToolWidget::OnResetAllClicked()
 	{
 		IKMeshComboBox->ClearSelection();
 	}
+	SetTabMappingSession(IKMappingSession, nullptr);
 	IKBoneMapping.Empty();
 	if (IKOutputNameBox.IsValid())
 	{
@@ -671,6 +603,7 @@ FReply SControlRigToolWidget::OnResetAllClicked()
 	{
 		PhysAssetMeshComboBox->ClearSelection();
 	}
+	SetTabMappingSession(PhysAssetMappingSession, nullptr);
 	PhysAssetBoneMapping.Empty();
 	PhysAssetMainBones.Empty();
 	if (PhysAssetOutputNameBox.IsValid())
@@ -856,11 +789,18 @@ TSharedRef<SWidget> SControlRigToolWidget::CreateControlRigTab()
 						[
 							SNew(SBox).MinDesiredHeight(150).MaxDesiredHeight(300)
 							[
-								SAssignNew(BoneScrollBox, SScrollBox)
-								+ SScrollBox::Slot()
+								SNew(SVerticalBox)
+								+ SVerticalBox::Slot().AutoHeight()
 								[
 									SAssignNew(BoneSelectionBox, SVerticalBox)
 								]
+								+ SVerticalBox::Slot().FillHeight(1.0f)
+								[
+									SAssignNew(BoneListView, SListView<TSharedPtr<int32>>)
+									.ListItemsSource(&BoneListItems)
+									.SelectionMode(ESelectionMode::None)
+									.OnGenerateRow(this, &SControlRigToolWidget::OnGenerateBoneRow)
+								]
 							]
 						]
 					]
@@ -885,7 +825,12 @@ TSharedRef<SWidget> SControlRigToolWidget::CreateControlRigTab()
 							+ SHorizontalBox::Slot().Padding(12, 0, 0, 0).VAlign(VAlign_Center)
 							[
 								SNew(STextBlock)
-								.Text(LOCTEXT("FinalCreate", "3. Create Final Control Rig"))
+								.Text_Lambda([this]()
+								{
+									return CanUpdateSecondaryIncrementally()
+										? FText::Format(LOCTEXT("FinalUpdate", "3. Update Control Rig ({0} bones changed)"), DirtyClassificationBones.Num())
+										: LOCTEXT("FinalCreate", "3. Create Final Control Rig");
+								})
 								.Font(FCoreStyle::GetDefaultFontStyle("Bold", 14))
 							]
 						]
@@ -1681,10 +1626,26 @@ TSharedRef<SWidget> SControlRigToolWidget::CreateKawaiiPhysicsTab()
 				.BorderBackgroundColor(FLinearColor(0.04f, 0.04f, 0.05f, 1.0f))
 				.Padding(8)  // 더 큰 패딩
 				[
-					SNew(SScrollBox)
-					+ SScrollBox::Slot()
+					SNew(SBox).MinDesiredHeight(200.0f)
 					[
-						SAssignNew(KawaiiBoneTreeBox, SVerticalBox)
+						SNew(SOverlay)
+						+ SOverlay::Slot()
+						[
+							SAssignNew(KawaiiBoneTreeView, STreeView<TSharedPtr<int32>>)
+							.TreeItemsSource(&KawaiiBoneRootItems)
+							.SelectionMode(ESelectionMode::None)
+							.OnGenerateRow(this, &SControlRigToolWidget::OnGenerateKawaiiBoneRow)
+							.OnGetChildren(this, &SControlRigToolWidget::OnGetKawaiiBoneChildren)
+							.OnExpansionChanged(this, &SControlRigToolWidget::OnKawaiiBoneExpansionChanged)
+						]
+						+ SOverlay::Slot().HAlign(HAlign_Left).VAlign(VAlign_Top)
+						[
+							SNew(STextBlock)
+							.Text(LOCTEXT("NoBones", "No bones to display"))
+							.Font(FCoreStyle::GetDefaultFontStyle("Regular", 9))
+							.ColorAndOpacity(FLinearColor(0.4f, 0.4f, 0.45f, 1.0f))
+							.Visibility_Lambda([this]() { return KawaiiBoneDisplayList.Num() == 0 ? EVisibility::Visible : EVisibility::Collapsed; })
+						]
 					]
 				]
 			]
@@ -1863,6 +1824,10 @@ TSharedRef<SWidget> SControlRigToolWidget::CreateKawaiiPhysicsTab()
 
 SControlRigToolWidget::~SControlRigToolWidget()
 {
+	// 탭 닫힘 - 대기 중인 분류 피드백 전송
+	FlushClassificationFeedback();
+	FBoneVertexAnalysisCache::Get().CancelAsync(PrefetchVertexTask);
+	FAssetCatalog::Get().OnChanged().Remove(CatalogChangedHandle);
 	ThumbnailPool.Reset();
 }
 
@@ -1907,17 +1872,31 @@ TSharedRef<SWidget> SControlRigToolWidget::CreateTemplateSection()
 					]
 				]
 			]
-			// 드롭다운
+			// 필터 + 드롭다운 (입력한 글자로 목록을 좁힘)
 			+ SHorizontalBox::Slot().FillWidth(1.0f).VAlign(VAlign_Center)
 			[
-				SAssignNew(TemplateComboBox, SComboBox<TSharedPtr<FString>>)
-				.OptionsSource(&TemplateOptions)
-				.OnSelectionChanged(this, &SControlRigToolWidget::OnTemplateSelectionChanged)
-				.OnGenerateWidget(this, &SControlRigToolWidget::OnGenerateTemplateWidget)
+				SNew(SVerticalBox)
+				+ SVerticalBox::Slot().AutoHeight().Padding(0, 0, 0, 4)
 				[
-					SNew(STextBlock)
-					.Text(this, &SControlRigToolWidget::GetSelectedTemplateName)
-					.Font(FCoreStyle::GetDefaultFontStyle("Regular", 9))
+					SNew(SSearchBox)
+					.HintText(LOCTEXT("TemplateFilterHint", "Filter templates..."))
+					.OnTextChanged_Lambda([this](const FText& Text)
+					{
+						TemplateFilterText = Text.ToString();
+						ApplyAssetFilters();
+					})
+				]
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					SAssignNew(TemplateComboBox, SComboBox<TSharedPtr<FString>>)
+					.OptionsSource(&FilteredTemplateOptions)
+					.OnSelectionChanged(this, &SControlRigToolWidget::OnTemplateSelectionChanged)
+					.OnGenerateWidget(this, &SControlRigToolWidget::OnGenerateTemplateWidget)
+					[
+						SNew(STextBlock)
+						.Text(this, &SControlRigToolWidget::GetSelectedTemplateName)
+						.Font(FCoreStyle::GetDefaultFontStyle("Regular", 9))
+					]
 				]
 			]
 			// 화살표 버튼 (선택된 에셋 사용)
@@ -1978,17 +1957,31 @@ TSharedRef<SWidget> SControlRigToolWidget::CreateMeshSection()
 					]
 				]
 			]
-			// 드롭다운
+			// 필터 + 드롭다운 (입력한 글자로 목록을 좁힘)
 			+ SHorizontalBox::Slot().FillWidth(1.0f).VAlign(VAlign_Center)
 			[
-				SAssignNew(MeshComboBox, SComboBox<TSharedPtr<FString>>)
-				.OptionsSource(&MeshOptions)
-				.OnSelectionChanged(this, &SControlRigToolWidget::OnMeshSelectionChanged)
-				.OnGenerateWidget(this, &SControlRigToolWidget::OnGenerateMeshWidget)
+				SNew(SVerticalBox)
+				+ SVerticalBox::Slot().AutoHeight().Padding(0, 0, 0, 4)
 				[
-					SNew(STextBlock)
-					.Text(this, &SControlRigToolWidget::GetSelectedMeshName)
-					.Font(FCoreStyle::GetDefaultFontStyle("Regular", 9))
+					SNew(SSearchBox)
+					.HintText(LOCTEXT("MeshFilterHint", "Filter meshes..."))
+					.OnTextChanged_Lambda([this](const FText& Text)
+					{
+						MeshFilterText = Text.ToString();
+						ApplyAssetFilters();
+					})
+				]
+				+ SVerticalBox::Slot().AutoHeight()
+				[
+					SAssignNew(MeshComboBox, SComboBox<TSharedPtr<FString>>)
+					.OptionsSource(&FilteredMeshOptions)
+					.OnSelectionChanged(this, &SControlRigToolWidget::OnMeshSelectionChanged)
+					.OnGenerateWidget(this, &SControlRigToolWidget::OnGenerateMeshWidget)
+					[
+						SNew(STextBlock)
+						.Text(this, &SControlRigToolWidget::GetSelectedMeshName)
+						.Font(FCoreStyle::GetDefaultFontStyle("Regular", 9))
+					]
 				]
 			]
 			// 화살표 버튼
@@ -2187,74 +2180,86 @@ TSharedRef<SWidget> SControlRigToolWidget::CreateButtonSection()
 
 void SControlRigToolWidget::LoadAssetData()
 {
-	ControlRigs.Empty();
-	SkeletalMeshes.Empty();
-	TemplateOptions.Empty();
-	MeshOptions.Empty();
+	// 에셋 목록은 공유 카탈로그에서 (Asset Registry 재스캔 없음, 바뀐 게 없으면 그대로)
+	FAssetCatalog& Catalog = FAssetCatalog::Get();
+	const TArray<FAssetCatalogEntry>& RigEntries = Catalog.GetSorted(EAssetCatalogClass::ControlRig);
+	const TArray<FAssetCatalogEntry>& MeshEntries = Catalog.GetSorted(EAssetCatalogClass::SkeletalMesh);
+	if (LoadedCatalogRevision == Catalog.GetRevision())
+	{
+		return;
+	}
+	LoadedCatalogRevision = Catalog.GetRevision();
 
-	FAssetRegistryModule& ARM = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AR = ARM.Get();
+	ControlRigs.Reset(RigEntries.Num());
+	SkeletalMeshes.Reset(MeshEntries.Num());
+	TemplateOptions.Reset(RigEntries.Num());
+	MeshOptions.Reset(MeshEntries.Num());
 
-	// Control Rig
+	// 옵션은 카탈로그 항목의 공유 문자열 → 갱신돼도 기존 선택 포인터가 그대로 유효
+	for (const FAssetCatalogEntry& Entry : RigEntries)
 	{
-		FARFilter Filter;
-		Filter.ClassPaths.Add(FTopLevelAssetPath(TEXT("/Script/ControlRigDeveloper"), TEXT("ControlRigBlueprint")));
-		Filter.bRecursiveClasses = true;
-		Filter.bRecursivePaths = true;
-		TArray<FAssetData> Assets;
-		AR.GetAssets(Filter, Assets);
-		for (const FAssetData& A : Assets)
-		{
-			FAssetInfo Info;
-			Info.Name = A.AssetName.ToString();
-			Info.Path = A.PackageName.ToString();
-			ControlRigs.Add(Info);
-		}
+		ControlRigs.Add({ Entry.Name, Entry.PackagePath });
+		TemplateOptions.Add(Entry.NameOption);
 	}
-
-	// Skeletal Mesh
+	for (const FAssetCatalogEntry& Entry : MeshEntries)
 	{
-		FARFilter Filter;
-		Filter.ClassPaths.Add(FTopLevelAssetPath(TEXT("/Script/Engine"), TEXT("SkeletalMesh")));
-		Filter.bRecursiveClasses = true;
-		Filter.bRecursivePaths = true;
-		TArray<FAssetData> Assets;
-		AR.GetAssets(Filter, Assets);
-		for (const FAssetData& A : Assets)
-		{
-			FAssetInfo Info;
-			Info.Name = A.AssetName.ToString();
-			Info.Path = A.PackageName.ToString();
-			SkeletalMeshes.Add(Info);
-		}
+		SkeletalMeshes.Add({ Entry.Name, Entry.PackagePath });
+		MeshOptions.Add(Entry.NameOption);
 	}
 
-	// 정렬
-	ControlRigs.Sort([](const FAssetInfo& A, const FAssetInfo& B) { return A.Name < B.Name; });
-	SkeletalMeshes.Sort([](const FAssetInfo& A, const FAssetInfo& B) { return A.Name < B.Name; });
-
-	// 옵션 생성
-	for (const FAssetInfo& Info : ControlRigs)
-		TemplateOptions.Add(MakeShared<FString>(Info.Name));
-	for (const FAssetInfo& Info : SkeletalMeshes)
-		MeshOptions.Add(MakeShared<FString>(Info.Name));
+	// 선택된 에셋이 사라졌으면 선택 해제
+	if (SelectedMesh.IsValid() && !MeshOptions.Contains(SelectedMesh))
+	{
+		SelectedMesh.Reset();
+	}
+	if (SelectedTemplate.IsValid() && !TemplateOptions.Contains(SelectedTemplate))
+	{
+		SelectedTemplate.Reset();
+	}
 
 	// 기본 선택 (Template 포함된 것)
-	for (int32 i = 0; i < ControlRigs.Num(); ++i)
+	if (!SelectedTemplate.IsValid())
 	{
-		if (ControlRigs[i].Name.Contains(TEXT("Template")))
+		for (int32 i = 0; i < ControlRigs.Num(); ++i)
 		{
-			SelectedTemplate = TemplateOptions[i];
-			break;
+			if (ControlRigs[i].Name.Contains(TEXT("Template")))
+			{
+				SelectedTemplate = TemplateOptions[i];
+				break;
+			}
 		}
 	}
+
+	ApplyAssetFilters();
 }
 
-void SControlRigToolWidget::RefreshData()
+void SControlRigToolWidget::ApplyAssetFilters()
 {
-	LoadAssetData();
+	FAssetCatalog::FilterOptions(TemplateOptions, TemplateFilterText, FilteredTemplateOptions);
+	FAssetCatalog::FilterOptions(MeshOptions, MeshFilterText, FilteredMeshOptions);
+
 	if (TemplateComboBox.IsValid()) TemplateComboBox->RefreshOptions();
 	if (MeshComboBox.IsValid()) MeshComboBox->RefreshOptions();
+}
+
+void SControlRigToolWidget::OnAssetCatalogChanged()
+{
+	// 에셋 추가/삭제/이름 변경 → 옵션만 다시 구성 (선택은 유지)
+	LoadAssetData();
+	LoadIKRigTemplates();
+	LoadRetargeterIKRigs();
+
+	if (IKRigTemplateComboBox.IsValid()) IKRigTemplateComboBox->RefreshOptions();
+	if (IKMeshComboBox.IsValid()) IKMeshComboBox->RefreshOptions();
+	if (KawaiiMeshComboBox.IsValid()) KawaiiMeshComboBox->RefreshOptions();
+	if (PhysAssetMeshComboBox.IsValid()) PhysAssetMeshComboBox->RefreshOptions();
+	UpdateTemplateThumbnail();
+	UpdateMeshThumbnail();
+}
+
+void SControlRigToolWidget::RefreshData()
+{
+	LoadAssetData();
 	UpdateTemplateThumbnail();
 	UpdateMeshThumbnail();
 	SetStatus(FString::Printf(TEXT("Refreshed: %d templates, %d meshes"), ControlRigs.Num(), SkeletalMeshes.Num()));
@@ -2305,17 +2310,13 @@ void SControlRigToolWidget::UpdateMeshThumbnail()
 FString SControlRigToolWidget::GetSelectedTemplatePath() const
 {
 	if (!SelectedTemplate.IsValid()) return FString();
-	for (const FAssetInfo& Info : ControlRigs)
-		if (Info.Name == *SelectedTemplate) return Info.Path;
-	return FString();
+	return FAssetCatalog::Get().FindPackagePathByName(EAssetCatalogClass::ControlRig, *SelectedTemplate);
 }
 
 FString SControlRigToolWidget::GetSelectedMeshPath() const
 {
 	if (!SelectedMesh.IsValid()) return FString();
-	for (const FAssetInfo& Info : SkeletalMeshes)
-		if (Info.Name == *SelectedMesh) return Info.Path;
-	return FString();
+	return FAssetCatalog::Get().FindPackagePathByName(EAssetCatalogClass::SkeletalMesh, *SelectedMesh);
 }
 
 TSharedRef<SWidget> SControlRigToolWidget::OnGenerateTemplateWidget(TSharedPtr<FString> InItem)
@@ -2345,6 +2346,10 @@ void SControlRigToolWidget::OnMeshSelectionChanged(TSharedPtr<FString> NewValue,
 	UpdateMeshThumbnail();
 	if (SelectedMesh.IsValid() && OutputNameBox.IsValid())
 		OutputNameBox->SetText(FText::FromString(FString::Printf(TEXT("CTR_%s_Rig"), **SelectedMesh)));
+	// 이전 메쉬 세션 해제 (다른 탭이 그 메쉬를 매핑해도 이 탭에 반영되지 않도록)
+	SetTabMappingSession(ControlRigMappingSession, nullptr);
+	bMappingRequestInFlight = false;
+	StartSelectionPrefetch(GetSelectedMeshPath());
 }
 
 FText SControlRigToolWidget::GetSelectedMeshName() const
@@ -2366,17 +2371,13 @@ FReply SControlRigToolWidget::OnUseSelectedTemplateClicked()
 	{
 		if (A.AssetClassPath.GetAssetName() == TEXT("ControlRigBlueprint"))
 		{
-			FString Path = A.PackageName.ToString();
-			for (int32 i = 0; i < ControlRigs.Num(); ++i)
+			if (const FAssetCatalogEntry* Entry = FAssetCatalog::Get().FindByPackage(EAssetCatalogClass::ControlRig, A.PackageName.ToString()))
 			{
-				if (ControlRigs[i].Path == Path)
-				{
-					SelectedTemplate = TemplateOptions[i];
-					if (TemplateComboBox.IsValid()) TemplateComboBox->SetSelectedItem(SelectedTemplate);
-					UpdateTemplateThumbnail();
-					SetStatus(FString::Printf(TEXT("Template: %s"), *A.AssetName.ToString()));
-					return FReply::Handled();
-				}
+				SelectedTemplate = Entry->NameOption;
+				if (TemplateComboBox.IsValid()) TemplateComboBox->SetSelectedItem(SelectedTemplate);
+				UpdateTemplateThumbnail();
+				SetStatus(FString::Printf(TEXT("Template: %s"), *A.AssetName.ToString()));
+				return FReply::Handled();
 			}
 		}
 	}
@@ -2392,19 +2393,15 @@ FReply SControlRigToolWidget::OnUseSelectedMeshClicked()
 	{
 		if (A.AssetClassPath.GetAssetName() == TEXT("SkeletalMesh"))
 		{
-			FString Path = A.PackageName.ToString();
-			for (int32 i = 0; i < SkeletalMeshes.Num(); ++i)
+			if (const FAssetCatalogEntry* Entry = FAssetCatalog::Get().FindByPackage(EAssetCatalogClass::SkeletalMesh, A.PackageName.ToString()))
 			{
-				if (SkeletalMeshes[i].Path == Path)
-				{
-					SelectedMesh = MeshOptions[i];
-					if (MeshComboBox.IsValid()) MeshComboBox->SetSelectedItem(SelectedMesh);
-					UpdateMeshThumbnail();
-					if (OutputNameBox.IsValid())
-						OutputNameBox->SetText(FText::FromString(FString::Printf(TEXT("CTR_%s_Rig"), *A.AssetName.ToString())));
-					SetStatus(FString::Printf(TEXT("Mesh: %s"), *A.AssetName.ToString()));
-					return FReply::Handled();
-				}
+				SelectedMesh = Entry->NameOption;
+				if (MeshComboBox.IsValid()) MeshComboBox->SetSelectedItem(SelectedMesh);
+				UpdateMeshThumbnail();
+				if (OutputNameBox.IsValid())
+					OutputNameBox->SetText(FText::FromString(FString::Printf(TEXT("CTR_%s_Rig"), *A.AssetName.ToString())));
+				SetStatus(FString::Printf(TEXT("Mesh: %s"), *A.AssetName.ToString()));
+				return FReply::Handled();
 			}
 		}
 	}
@@ -2465,70 +2462,186 @@ void SControlRigToolWidget::RequestAIBoneMapping()
 		return;
 	}
 	CachedMesh = Mesh;
-	SetStatus(TEXT("Requesting AI mapping..."));
-
-	const FReferenceSkeleton& Skel = Mesh->GetRefSkeleton();
-	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-	TArray<TSharedPtr<FJsonValue>> Bones;
-
-	for (int32 i = 0; i < Skel.GetNum(); i++)
+	
+	// 다른 탭에서 이미 매핑했거나 요청 중인 메쉬면 그 결과를 공유
+	TSharedRef<FBoneMappingSession> Session = AcquireMappingSession(ControlRigMappingSession, MeshPath);
+	if (Session->RequestMapping() || Session->GetState() == EBoneMappingSessionState::Requesting)
 	{
-		const FMeshBoneInfo& Info = Skel.GetRefBoneInfo()[i];
-		TSharedPtr<FJsonObject> Bone = MakeShared<FJsonObject>();
-		Bone->SetStringField("name", Info.Name.ToString());
-		if (Info.ParentIndex >= 0)
-			Bone->SetStringField("parent", Skel.GetBoneName(Info.ParentIndex).ToString());
-		TArray<TSharedPtr<FJsonValue>> Children;
-		for (int32 j = 0; j < Skel.GetNum(); j++)
-			if (Skel.GetRefBoneInfo()[j].ParentIndex == i)
-				Children.Add(MakeShared<FJsonValueString>(Skel.GetBoneName(j).ToString()));
-		Bone->SetArrayField("children", Children);
-		Bones.Add(MakeShared<FJsonValueObject>(Bone));
+		ApplyMappingSessionToControlRigTab(EBoneMappingSessionChange::State);
 	}
-	Root->SetArrayField("bones", Bones);
-	Root->SetBoolField("use_ai", true);
+}
 
-	FString Body;
-	TSharedRef<TJsonWriter<>> W = TJsonWriterFactory<>::Create(&Body);
-	FJsonSerializer::Serialize(Root.ToSharedRef(), W);
+void SControlRigToolWidget::OnAIBoneMappingCompleted(const FString& Method)
+{
+	SetStatus(FString::Printf(TEXT("SUCCESS: %d mappings (%s)"), LastBoneMapping.Num(), *Method));
+	DisplayMappingResults();
+	
+	// 본 매핑 완료 후 본 선택 UI 표시 및 세컨더리 버튼 활성화
+	BuildBoneDisplayList();
+	UpdateBoneSelectionUI();
+	if (SecondaryOnlyButton.IsValid())
+	{
+		SecondaryOnlyButton->SetEnabled(true);
+	}
+}
 
+// ============================================================================
+// 본 매핑 디스크 캐시 (Saved/AIRigSetup/BoneMappingCache.json)
+// ============================================================================
+void SControlRigToolWidget::RefreshMappingCacheModelVersion()
+{
+	// 서버 재학습 여부 확인 → 모델 버전이 바뀌면 캐시 무효화
 	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Req = FHttpModule::Get().CreateRequest();
-	Req->SetURL(TEXT("http://localhost:8000/predict"));
-	Req->SetVerb(TEXT("POST"));
-	Req->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-	Req->SetContentAsString(Body);
-	Req->SetTimeout(120.0f);
-
-	Req->OnProcessRequestComplete().BindLambda([this](FHttpRequestPtr, FHttpResponsePtr Res, bool Ok)
+	Req->SetVerb(TEXT("GET"));
+	Req->OnProcessRequestComplete().BindLambda([](FHttpRequestPtr, FHttpResponsePtr Res, bool Ok)
 	{
-		if (!Ok || !Res.IsValid()) { SetStatus(TEXT("ERROR: Server connection failed")); return; }
+		if (!Ok || !Res.IsValid()) return;  // 서버 꺼져 있으면 기존 캐시 그대로 사용
+		
 		TSharedPtr<FJsonObject> J;
 		TSharedRef<TJsonReader<>> R = TJsonReaderFactory<>::Create(Res->GetContentAsString());
-		if (!FJsonSerializer::Deserialize(R, J)) { SetStatus(TEXT("ERROR: Parse failed")); return; }
-
-		LastBoneMapping.Empty();
-		const TSharedPtr<FJsonObject>* Map;
-		if (J->TryGetObjectField(TEXT("mapping"), Map))
-		{
-			for (const auto& P : (*Map)->Values)
-			{
-				FString V;
-				if (P.Value->TryGetString(V))
-					LastBoneMapping.Add(FName(*P.Key), FName(*V));
-			}
-		}
-		SetStatus(FString::Printf(TEXT("SUCCESS: %d mappings"), LastBoneMapping.Num()));
-		DisplayMappingResults();
-		
-		// 본 매핑 완료 후 본 선택 UI 표시 및 세컨더리 버튼 활성화
-		BuildBoneDisplayList();
-		UpdateBoneSelectionUI();
-		if (SecondaryOnlyButton.IsValid())
+		FString ModelVersion;
+		if (FJsonSerializer::Deserialize(R, J) && J.IsValid() && J->TryGetStringField(TEXT("model_version"), ModelVersion))
 		{
-			SecondaryOnlyButton->SetEnabled(true);
+			FBoneMappingCache::Get().SetModelVersion(ModelVersion);
 		}
 	});
-	Req->ProcessRequest();
+	// 서버가 이미 떠 있을 때만 확인 (툴을 열었다고 서버를 띄우지 않음)
+	FAIServerLauncher::Get().Send(Req, TEXT("/health"), false);
+}
+
+// ============================================================================
+// 탭 공유 매핑 세션 (Control Rig / IK Rig / Physics Asset)
+// 같은 메쉬를 고른 탭은 같은 FBoneMappingSession → 요청 / 승인 결과가 모든 탭에 반영
+// 탭의 매핑 멤버(LastBoneMapping 등)는 세션 결과의 사본 (생성 함수는 그대로 사용)
+// ============================================================================
+TSharedRef<FBoneMappingSession> SControlRigToolWidget::AcquireMappingSession(TSharedPtr<FBoneMappingSession>& TabSession, const FString& MeshPath)
+{
+	TSharedRef<FBoneMappingSession> Session = FBoneMappingSession::FindOrCreate(MeshPath);
+	SetTabMappingSession(TabSession, Session);
+	return Session;
+}
+
+void SControlRigToolWidget::SetTabMappingSession(TSharedPtr<FBoneMappingSession>& TabSession, const TSharedPtr<FBoneMappingSession>& NewSession)
+{
+	if (TabSession == NewSession) return;
+	
+	TSharedPtr<FBoneMappingSession> Previous = MoveTemp(TabSession);
+	TabSession = NewSession;
+	
+	auto CountTabsHolding = [this](const TSharedPtr<FBoneMappingSession>& Session)
+	{
+		return int32(ControlRigMappingSession == Session) + int32(IKMappingSession == Session) + int32(PhysAssetMappingSession == Session);
+	};
+	
+	// 위젯당 한 번만 구독 (여러 탭이 같은 세션을 잡아도 OnMappingSessionChanged에서 탭별로 분배)
+	if (NewSession.IsValid() && CountTabsHolding(NewSession) == 1)
+	{
+		NewSession->OnChanged().AddSP(this, &SControlRigToolWidget::OnMappingSessionChanged);
+	}
+	if (Previous.IsValid() && CountTabsHolding(Previous) == 0)
+	{
+		Previous->OnChanged().RemoveAll(this);
+	}
+}
+
+void SControlRigToolWidget::OnMappingSessionChanged(FBoneMappingSession& Session, EBoneMappingSessionChange Change)
+{
+	if (ControlRigMappingSession.Get() == &Session)
+	{
+		ApplyMappingSessionToControlRigTab(Change);
+	}
+	if (IKMappingSession.Get() == &Session)
+	{
+		ApplyMappingSessionToIKTab(Change);
+	}
+	if (PhysAssetMappingSession.Get() == &Session)
+	{
+		ApplyMappingSessionToPhysAssetTab(Change);
+	}
+}
+
+void SControlRigToolWidget::ApplyMappingSessionToControlRigTab(EBoneMappingSessionChange Change)
+{
+	const FBoneMappingSession& Session = *ControlRigMappingSession;
+	if (Change == EBoneMappingSessionChange::Approved)
+	{
+		SetStatus(FString::Printf(TEXT("APPROVED! %d mappings saved for AI training"), Session.GetMapping().Num()));
+		return;
+	}
+	
+	switch (Session.GetState())
+	{
+	case EBoneMappingSessionState::Requesting:
+		bMappingRequestInFlight = true;
+		SetStatus(TEXT("Requesting AI mapping..."));
+		break;
+	case EBoneMappingSessionState::Ready:
+		bMappingRequestInFlight = false;
+		LastBoneMapping = Session.GetMapping();
+		OnAIBoneMappingCompleted(Session.GetMethod());
+		break;
+	case EBoneMappingSessionState::Failed:
+		bMappingRequestInFlight = false;
+		SetStatus(FString::Printf(TEXT("ERROR: %s"), *Session.GetError()));
+		break;
+	default:
+		break;
+	}
+}
+
+void SControlRigToolWidget::ApplyMappingSessionToIKTab(EBoneMappingSessionChange Change)
+{
+	const FBoneMappingSession& Session = *IKMappingSession;
+	if (Change == EBoneMappingSessionChange::Approved)
+	{
+		SetIKStatus(TEXT("Mapping approved for AI training!"));
+		return;
+	}
+	
+	switch (Session.GetState())
+	{
+	case EBoneMappingSessionState::Requesting:
+		SetIKStatus(TEXT("Requesting AI Bone Mapping..."));
+		break;
+	case EBoneMappingSessionState::Ready:
+		IKBoneMapping = Session.GetMapping();
+		DisplayIKMappingResults();
+		SetIKStatus(FString::Printf(TEXT("Mapped %d bones (%s)"), IKBoneMapping.Num(), *Session.GetMethod()));
+		break;
+	case EBoneMappingSessionState::Failed:
+		SetIKStatus(FString::Printf(TEXT("Error: %s"), *Session.GetError()));
+		break;
+	default:
+		break;
+	}
+}
+
+void SControlRigToolWidget::ApplyMappingSessionToPhysAssetTab(EBoneMappingSessionChange Change)
+{
+	const FBoneMappingSession& Session = *PhysAssetMappingSession;
+	if (Change == EBoneMappingSessionChange::Approved)
+	{
+		SetPhysAssetStatus(TEXT("Mapping approved for AI training!"));
+		return;
+	}
+	
+	switch (Session.GetState())
+	{
+	case EBoneMappingSessionState::Requesting:
+		SetPhysAssetStatus(TEXT("Running AI Bone Mapping..."));
+		break;
+	case EBoneMappingSessionState::Ready:
+		PhysAssetBoneMapping = Session.GetMapping();
+		PhysAssetMainBones = Session.GetMainBones();
+		UpdatePhysAssetBoneListUI();
+		SetPhysAssetStatus(FString::Printf(TEXT("Found %d main bones (%s)"), PhysAssetMainBones.Num(), *Session.GetMethod()));
+		break;
+	case EBoneMappingSessionState::Failed:
+		SetPhysAssetStatus(FString::Printf(TEXT("API Error - %s"), *Session.GetError()));
+		break;
+	default:
+		break;
+	}
 }
 
 // ============================================================================
@@ -2579,8 +2692,8 @@ bool SControlRigToolWidget::CreateBodyControlRig()
 		return false;
 	}
 
-	FString OutputName = OutputNameBox->GetText().ToString();
-	FString OutputFolder = OutputFolderBox->GetText().ToString();
+	FString OutputName = OutputNameBox.IsValid() ? OutputNameBox->GetText().ToString() : FString::Printf(TEXT("CTR_%s_Rig"), **SelectedMesh);
+	FString OutputFolder = OutputFolderBox.IsValid() ? OutputFolderBox->GetText().ToString() : DefaultOutputFolder;
 	PendingOutputPath = OutputFolder / OutputName;
 
 	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Creating Body Rig: %s"), *PendingOutputPath);
@@ -2597,16 +2710,22 @@ bool SControlRigToolWidget::CreateBodyControlRig()
 		return false;
 	}
 
-	// 3. 기존 에셋 삭제 + 템플릿 복제
+	// 새 Body = 새 빌드 (이전 최종 생성 기록은 증분 대상 아님)
+	ResetSecondaryBuildState();
+
+	// 3. 기존 에셋 삭제 + 템플릿 스냅샷 복제
+	// 스냅샷 = 메쉬 본을 미리 지운 템플릿 (버전별 1회 베이크). 없으면 템플릿을 직접 복제 후 본 삭제
 	if (UEditorAssetLibrary::DoesAssetExist(PendingOutputPath))
 	{
 		UEditorAssetLibrary::DeleteAsset(PendingOutputPath);
 	}
 
-	UObject* Duplicated = UEditorAssetLibrary::DuplicateAsset(TemplatePath, PendingOutputPath);
+	PendingTemplateSnapshot = FControlRigTemplateSnapshotCache::Get().FindOrBake(TemplatePath);
+	const FString SourcePath = PendingTemplateSnapshot.IsValid() ? PendingTemplateSnapshot->BakedAssetPath : TemplatePath;
+	UObject* Duplicated = UEditorAssetLibrary::DuplicateAsset(SourcePath, PendingOutputPath);
 	if (!Duplicated) { SetStatus(TEXT("ERROR: Duplication failed")); return false; }
 
-	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Template duplicated"));
+	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] %s duplicated"), PendingTemplateSnapshot.IsValid() ? TEXT("Template snapshot") : TEXT("Template"));
 
 	// 4. Control Rig 로드
 	UControlRigBlueprint* Rig = Cast<UControlRigBlueprint>(UEditorAssetLibrary::LoadAsset(PendingOutputPath));
@@ -2617,32 +2736,15 @@ bool SControlRigToolWidget::CreateBodyControlRig()
 	URigHierarchyController* HC = Rig->GetHierarchyController();
 	URigHierarchy* Hierarchy = Rig->Hierarchy;
 
-	// 5. 기존 본 삭제 (역순) - 단, 템플릿 전용 본은 유지
-	TSet<FString> PreserveBones = {
-		TEXT("heel_l"), TEXT("heel_r"), 
-		TEXT("tip_l"), TEXT("tip_r"),
-		TEXT("ik_foot_l"), TEXT("ik_foot_r"),
-		TEXT("ik_hand_l"), TEXT("ik_hand_r"),
-		TEXT("ik_foot_root"), TEXT("ik_hand_root"), TEXT("ik_hand_gun")
-	};
+	// 본 교체 / 오토스케일은 계층 알림 없이 일괄 처리 (함수 종료 시 트랜스폼 1회 재계산)
+	FRigHierarchyBatchEdit Batch(Rig);
 	
-	TArray<FRigBoneElement*> OldBones = Hierarchy->GetBones();
-	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Removing old bones (preserving template-only bones)"));
-	int32 RemovedCount = 0;
-	for (int32 i = OldBones.Num() - 1; i >= 0; --i)
+	// 5. 기존 본 삭제 (스냅샷이면 베이크 때 이미 삭제됨) - 템플릿 전용 본은 유지
+	if (!PendingTemplateSnapshot.IsValid())
 	{
-		FString BoneName = OldBones[i]->GetKey().Name.ToString().ToLower();
-		if (!PreserveBones.Contains(BoneName))
-		{
-			HC->RemoveElement(OldBones[i]->GetKey(), false, false);
-			RemovedCount++;
-		}
-		else
-		{
-			UE_LOG(LogTemp, Log, TEXT("  Preserved: %s"), *OldBones[i]->GetKey().Name.ToString());
-		}
+		UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Removing old bones (preserving template-only bones)"));
+		FControlRigTemplateSnapshot::RemoveMeshBones(Rig);
 	}
-	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Removed %d bones, preserved %d"), RemovedCount, OldBones.Num() - RemovedCount);
 
 	// 6. 메시 교체 + 새 본 임포트
 	Rig->SetPreviewMesh(Mesh, true);
@@ -2680,10 +2782,11 @@ bool SControlRigToolWidget::CreateBodyControlRig()
 		// IK 본이 있고 부모도 있으면 연결
 		if (Hierarchy->Contains(BoneKey) && Hierarchy->Contains(ParentKey))
 		{
-			HC->SetParent(BoneKey, ParentKey, true);
+			Batch.SetParent(BoneKey, ParentKey, true);
 			UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] IK bone connected: %s -> %s"), *BoneName, *LogicalParent);
 		}
 	}
+	Batch.Flush();
 
 	// 7. 본 참조 리매핑 (LastBoneMapping 사용)
 	RemapBoneReferences(Rig);
@@ -2697,48 +2800,182 @@ bool SControlRigToolWidget::CreateBodyControlRig()
 	return true;
 }
 
-// ============================================================================
-// Step 2: 최종 Control Rig 생성 (세컨더리 추가 + 저장)
-// ============================================================================
-FReply SControlRigToolWidget::OnCreateFinalControlRigClicked()
+// Control Rig 메인 그래프 (RigVMModel)
+static URigVMGraph* FindMainGraph(UControlRigBlueprint* Rig)
 {
-	if (CreateFinalControlRig())
+	if (!Rig) return nullptr;
+	for (URigVMGraph* Graph : Rig->GetAllModels())
 	{
-		SetStatus(TEXT("Control Rig created and saved!"));
-		
-		// 컨트롤릭 생성 성공 = 매핑 성공이므로 자동으로 AI 학습 데이터 전송
-		if (LastBoneMapping.Num() > 0)
+		if (Graph && Graph->GetName().Equals(TEXT("RigVMModel")))
 		{
-			SendApproveRequest();
-			UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Auto-approved mapping after Control Rig creation"));
+			return Graph;
 		}
 	}
-	return FReply::Handled();
+	return nullptr;
 }
 
-bool SControlRigToolWidget::CreateFinalControlRig()
+// ============================================================================
+// 버텍스 분석 선계산 (워커 스레드) → 이후 GetAnalysis는 캐시 히트
+// 선택 프리페치가 이미 분석 중이면 새로 시작하지 않고 그 작업을 기다림
+// ============================================================================
+static bool PrewarmVertexAnalysis(FGenerationPipeline& Pipeline, USkeletalMesh* Mesh)
 {
-	if (!PendingControlRig.IsValid())
+	TSharedPtr<FVertexAnalysisTask> Pending = FBoneVertexAnalysisCache::Get().AnalyzeAsync(Mesh);
+	if (!Pending.IsValid()) return true;
+	
+	if (!Pipeline.RunInBackground([Pending]()
+	{
+		Pending->Task.Wait();
+		return true;
+	}))
 	{
-		SetStatus(TEXT("ERROR: Create Body Control Rig first"));
 		return false;
 	}
 	
-	if (!CachedMesh.IsValid())
+	// 완료된 결과를 바로 캐시에 저장 (완료 콜백 틱을 기다리지 않음)
+	FBoneVertexAnalysisCache::Get().GetAnalysis(Mesh);
+	return true;
+}
+
+// ============================================================================
+// 메쉬 선택 선행 작업 (비동기 로드 → 본 매핑 요청 + 버텍스 분석)
+// 버튼을 누를 때는 매핑 캐시 / 버텍스 분석 캐시 적중
+// ============================================================================
+void SControlRigToolWidget::StartSelectionPrefetch(const FString& MeshPath)
+{
+	if (bHeadless || MeshPath.IsEmpty()) return;
+	
+	// 같은 메쉬가 다른 탭에서 다시 선택되면 진행 중인 작업 유지
+	const FString PackageName = FPackageName::ObjectPathToPackageName(MeshPath);
+	if (PackageName == PrefetchMeshPath) return;
+	
+	// 이전 선택 작업 취소 (로드 완료 콜백은 Serial로 무시)
+	const uint32 Serial = ++PrefetchSerial;
+	PrefetchMeshPath = PackageName;
+	if (PrefetchMappingBatch.IsValid())
 	{
-		SetStatus(TEXT("ERROR: Mesh not found"));
-		return false;
+		PrefetchMappingBatch->Cancel();
+		PrefetchMappingBatch.Reset();
+	}
+	FBoneVertexAnalysisCache::Get().CancelAsync(PrefetchVertexTask);
+	PrefetchVertexTask.Reset();
+	
+	// 이미 로드된 메쉬면 다음 틱에 바로 콜백
+	TWeakPtr<SControlRigToolWidget> WeakThis = StaticCastWeakPtr<SControlRigToolWidget>(AsWeak());
+	LoadPackageAsync(PackageName, FLoadPackageAsyncDelegate::CreateLambda(
+		[WeakThis, PackageName, Serial](const FName&, UPackage*, EAsyncLoadingResult::Type Result)
+		{
+			TSharedPtr<SControlRigToolWidget> Widget = WeakThis.Pin();
+			if (Widget.IsValid() && Result == EAsyncLoadingResult::Succeeded)
+			{
+				Widget->OnPrefetchMeshLoaded(PackageName, Serial);
+			}
+		}));
+}
+
+void SControlRigToolWidget::OnPrefetchMeshLoaded(const FString& MeshPath, uint32 Serial)
+{
+	// 그 사이 선택이 바뀜
+	if (Serial != PrefetchSerial) return;
+	
+	USkeletalMesh* Mesh = FMeshBoneHierarchy::FindLoadedMesh(MeshPath);
+	if (!Mesh) return;
+	
+	// 1. 본 매핑 (캐시 / 네이티브로 충분하면 요청 없음, 서버 결과는 디스크 캐시에 저장)
+	PrefetchMappingBatch = MakeShared<FBoneMappingBatch>();
+	PrefetchMappingBatch->Add(MeshPath, Mesh->GetName(), Mesh->GetRefSkeleton());
+	if (PrefetchMappingBatch->Send(FBoneMappingBatch::FOnSkeletonMapped(), FBoneMappingBatch::FOnBatchFinished()))
+	{
+		UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Prefetching bone mapping: %s"), *Mesh->GetName());
+	}
+	
+	// 2. 버텍스 분석 (워커 스레드, 캐시 저장은 게임 스레드)
+	// 이 선택의 작업 핸들 보관 → 선택이 바뀌면 취소, 버튼 클릭 시에는 같은 작업을 기다림
+	PrefetchVertexTask = FBoneVertexAnalysisCache::Get().AnalyzeAsync(Mesh);
+	
+	// 3. Kawaii 탭 본 목록이 스켈레톤에서 읽은 것이면 스킨 웨이트 반영
+	if (bKawaiiSkinWeightsPending && FMeshBoneHierarchy::FindLoadedMesh(GetSelectedKawaiiMeshPath()) == Mesh)
+	{
+		SyncKawaiiBoneDisplayListToMesh(Mesh);
+	}
+}
+
+// ============================================================================
+// Step 2: 최종 Control Rig 생성 (세컨더리 추가 + 저장)
+// ============================================================================
+FReply SControlRigToolWidget::OnCreateFinalControlRigClicked()
+{
+	// 최종 생성 후 분류만 바꾼 경우: 변경분만 반영 (매핑은 그대로 → 재승인 없음)
+	if (CanUpdateSecondaryIncrementally())
+	{
+		UpdateSecondaryControlRig();
+		return FReply::Handled();
+	}
+	
+	if (CreateFinalControlRig())
+	{
+		SetStatus(TEXT("Control Rig created and saved!"));
+		
+		// 컨트롤릭 생성 성공 = 매핑 성공이므로 자동으로 AI 학습 데이터 전송
+		if (LastBoneMapping.Num() > 0)
+		{
+			SendApproveRequest();
+			UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Auto-approved mapping after Control Rig creation"));
+		}
+	}
+	return FReply::Handled();
+}
+
+bool SControlRigToolWidget::CreateFinalControlRig()
+{
+	if (!PendingControlRig.IsValid())
+	{
+		SetStatus(TEXT("ERROR: Create Body Control Rig first"));
+		return false;
+	}
+	
+	if (!CachedMesh.IsValid())
+	{
+		SetStatus(TEXT("ERROR: Mesh not found"));
+		return false;
 	}
 	
 	UControlRigBlueprint* Rig = PendingControlRig.Get();
 	USkeletalMesh* Mesh = CachedMesh.Get();
 	
-	// 사용자가 선택한 세컨더리 본으로 컨트롤러 생성
-	CreateSecondaryControlsFromSelection(Rig, Mesh);
+	// Body 리그는 Step 2에서 만든 것 → 취소/실패 시 삭제하지 않고 세컨더리 편집만 되돌림 (다시 시도 가능)
+	const TSet<FRigElementKey> BodyElements(Rig->Hierarchy ? Rig->Hierarchy->GetAllKeys() : TArray<FRigElementKey>());
+	TSet<FName> BodyNodes;
+	if (URigVMGraph* MainGraph = FindMainGraph(Rig))
+	{
+		for (const URigVMNode* Node : MainGraph->GetNodes())
+		{
+			BodyNodes.Add(Node->GetFName());
+		}
+	}
+	
+	FGenerationPipeline Pipeline(TEXT("Create Control Rig"), bHeadless, [this](const FString& Message) { SetStatus(Message); });
+	Pipeline.AddRollback([this, WeakRig = TWeakObjectPtr<UControlRigBlueprint>(Rig), BodyElements, BodyNodes]()
+	{
+		RevertSecondaryEdits(WeakRig.Get(), BodyElements, BodyNodes);
+		ResetSecondaryBuildState();
+		LastSecondaryControlCount = 0;
+		UpdateWorkflowUI();
+	});
+	
+	// 버텍스 분석은 워커 스레드에서 (Shape Info / 웨폰 박스가 캐시 사용)
+	if (!Pipeline.EnterStage(EGenerationStage::Analyze)) return false;
+	if (!PrewarmVertexAnalysis(Pipeline, Mesh)) return false;
+	
+	// 사용자가 선택한 세컨더리 본으로 컨트롤러 생성 (계층 + 함수 노드, VM 컴파일 1회)
+	if (!Pipeline.EnterStage(EGenerationStage::BuildHierarchy)) return false;
+	if (!CreateSecondaryControlsFromSelection(Pipeline, Rig, Mesh)) return false;
 
-	// 저장
+	// 저장 - 템플릿 빈 함수 노드를 지운 뒤라 여기서부터는 취소해도 끝까지 진행
+	Pipeline.EnterStage(EGenerationStage::Save);
 	Rig->MarkPackageDirty();
-	UEditorAssetLibrary::SaveAsset(PendingOutputPath);
+	FPackageSaveQueue::Save(Rig->GetPackage(), Rig);
+	Pipeline.Commit();
 
 	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Saved: %s"), *PendingOutputPath);
 
@@ -2749,7 +2986,398 @@ bool SControlRigToolWidget::CreateFinalControlRig()
 	// 결과 다이얼로그
 	FString Msg = FString::Printf(TEXT("Control Rig Created!\n\nPath: %s\nCore Mappings: %d\nSecondary Controls: %d"), 
 		*PendingOutputPath, LastBoneMapping.Num(), LastSecondaryControlCount);
-	FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Msg));
+	if (!bHeadless)
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Msg));
+	}
+	return true;
+}
+
+// 최종 생성 취소/실패 시 Body 리그 상태로 복구 (이번에 추가된 요소 / 노드만 삭제)
+void SControlRigToolWidget::RevertSecondaryEdits(UControlRigBlueprint* Rig, const TSet<FRigElementKey>& BodyElements, const TSet<FName>& BodyNodes)
+{
+	if (!Rig || !Rig->Hierarchy) return;
+	
+	int32 NumElements = 0;
+	int32 NumNodes = 0;
+	{
+		// 계층 순회 역순 → 자식부터 삭제
+		FRigHierarchyBatchEdit Batch(Rig);
+		const TArray<FRigElementKey> Keys = Rig->Hierarchy->GetAllKeys(true);
+		for (int32 i = Keys.Num() - 1; i >= 0; --i)
+		{
+			if (!BodyElements.Contains(Keys[i]))
+			{
+				Batch.RemoveElement(Keys[i]);
+				NumElements++;
+			}
+		}
+	}
+	
+	URigVMGraph* MainGraph = FindMainGraph(Rig);
+	if (URigVMController* Controller = MainGraph ? Rig->GetController(MainGraph) : nullptr)
+	{
+		FRigVMBulkEdit BulkEdit(Rig, Controller, TEXT("Revert Secondary Function Nodes"));
+		const TArray<URigVMNode*> Nodes = MainGraph->GetNodes();
+		for (URigVMNode* Node : Nodes)
+		{
+			if (!BodyNodes.Contains(Node->GetFName()))
+			{
+				BulkEdit->RemoveNode(Node, false, false);
+				NumNodes++;
+			}
+		}
+	}
+	
+	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Reverted secondary edits: %d elements, %d nodes (body rig kept)"), NumElements, NumNodes);
+}
+
+// ============================================================================
+// 분류 변경분 증분 반영 (최종 생성 이후)
+// - 마지막 생성 이후 분류가 바뀐 본이 속한 Space만 다시 계산
+// - 컨트롤: 추가/삭제된 본만 생성/삭제, 남은 본은 부모 컨트롤만 다시 연결
+// - 함수 노드: 바뀐 Space의 bones/ctrls 배열만 패치, 빈 Space는 노드 삭제 후 Execute 체인 재연결,
+//   새 Space는 체인 끝에 추가
+// - 웨폰 분류 변경은 보조 노드 구성이 달라 Body부터 다시 생성하도록 안내
+// ============================================================================
+bool SControlRigToolWidget::CanUpdateSecondaryIncrementally() const
+{
+	return CurrentStep == EControlRigWorkflowStep::Step4_Complete
+		&& !PendingControlRig.IsValid()
+		&& LastSecondaryBuild.Rig.IsValid()
+		&& LastSecondaryBuild.Mesh.IsValid()
+		&& LastSecondaryBuild.Mesh == CachedMesh;
+}
+
+void SControlRigToolWidget::ResetSecondaryBuildState()
+{
+	LastSecondaryBuild = FSecondaryBuildState();
+	DirtyClassificationBones.Reset();
+}
+
+void SControlRigToolWidget::MarkClassificationDirty(const FBoneDisplayInfo& Info)
+{
+	if (!LastSecondaryBuild.Rig.IsValid()) return;
+	
+	// 마지막 생성 때와 같은 분류로 되돌리면 변경 목록에서 제외
+	const EBoneClassification* Built = LastSecondaryBuild.Classifications.Find(Info.BoneName);
+	if (Info.Classification != (Built ? *Built : EBoneClassification::Helper))
+	{
+		DirtyClassificationBones.Add(Info.BoneName);
+	}
+	else
+	{
+		DirtyClassificationBones.Remove(Info.BoneName);
+	}
+}
+
+bool SControlRigToolWidget::UpdateSecondaryControlRig()
+{
+	UControlRigBlueprint* Rig = LastSecondaryBuild.Rig.Get();
+	USkeletalMesh* Mesh = CachedMesh.Get();
+	if (!Rig || !Mesh)
+	{
+		SetStatus(TEXT("ERROR: Control Rig not found - create Body Control Rig again"));
+		return false;
+	}
+	
+	if (DirtyClassificationBones.Num() == 0)
+	{
+		SetStatus(TEXT("No classification changes since last build"));
+		return true;
+	}
+	
+	const double StartTime = FPlatformTime::Seconds();
+	const FReferenceSkeleton& RefSkel = Mesh->GetRefSkeleton();
+	const FSkeletonTopology& Topology = GetSkeletonTopology(Mesh);
+	
+	// BoneDisplayList는 스켈레톤 순서 (인덱스 = 본 인덱스)
+	auto GetClassification = [this, &Topology](const FName& BoneName)
+	{
+		const int32 BoneIndex = Topology.FindBoneIndex(BoneName);
+		return BoneDisplayList.IsValidIndex(BoneIndex) ? BoneDisplayList[BoneIndex].Classification : EBoneClassification::Helper;
+	};
+	
+	// 웨폰 체인은 world 채널 / Get Bool Channel 등 보조 노드가 붙어 있어 패치 대신 전체 재생성
+	const TArray<FName> DirtyBones = DirtyClassificationBones.Array();
+	for (const FName& BoneName : DirtyBones)
+	{
+		if (GetClassification(BoneName) == EBoneClassification::Weapon
+			|| LastSecondaryBuild.Classifications.FindRef(BoneName) == EBoneClassification::Weapon)
+		{
+			SetStatus(FString::Printf(TEXT("Weapon classification changed (%s) - recreate from Body Control Rig"), *BoneName.ToString()));
+			return false;
+		}
+	}
+	
+	// 변경 본이 속한 Space만 새 체인 계산 (Space는 분류와 무관 → 기존 체인 ± 변경 본)
+	TMap<FName, TArray<FName>> NewChains;
+	const TArray<FName> SpaceParents = FindZeroBoneParents(DirtyBones, Mesh);
+	for (int32 i = 0; i < DirtyBones.Num(); ++i)
+	{
+		const FName SpaceParent = SpaceParents[i].IsNone() ? FName(TEXT("root")) : SpaceParents[i];
+		TArray<FName>* Chain = NewChains.Find(SpaceParent);
+		if (!Chain)
+		{
+			Chain = &NewChains.Add(SpaceParent, LastSecondaryBuild.ChainsBySpace.FindRef(SpaceParent));
+		}
+		
+		if (GetClassification(DirtyBones[i]) == EBoneClassification::Secondary)
+		{
+			Chain->AddUnique(DirtyBones[i]);
+		}
+		else
+		{
+			Chain->Remove(DirtyBones[i]);
+		}
+	}
+	
+	// 스켈레톤 순서 유지 (부모 본의 컨트롤이 먼저 생성되도록)
+	for (auto& Pair : NewChains)
+	{
+		Pair.Value.Sort([&Topology](const FName& A, const FName& B) {
+			return Topology.FindBoneIndex(A) < Topology.FindBoneIndex(B);
+		});
+	}
+	
+	URigHierarchyController* HC = Rig->GetHierarchyController();
+	URigHierarchy* Hierarchy = Rig->Hierarchy;
+	if (!HC || !Hierarchy)
+	{
+		SetStatus(TEXT("ERROR: Control Rig hierarchy not available"));
+		return false;
+	}
+	
+	// 새 컨트롤의 Shape 계산 (버텍스 분석은 메쉬별 캐시 재사용)
+	CalculateBoneShapeInfos(Mesh);
+	
+	auto ControlKeyOf = [](const FName& BoneName)
+	{
+		return FRigElementKey(FName(*(BoneName.ToString() + TEXT("_ctrl"))), ERigElementType::Control);
+	};
+	
+	// ========== 계층: 바뀐 Space의 컨트롤만 추가/삭제 ==========
+	const int32 ControlCountBefore = LastSecondaryControlCount;
+	int32 RemovedControls = 0;
+	{
+		FRigHierarchyBatchEdit Batch(Rig);
+		TArray<FRigElementKey> KeysToRemove;
+		
+		for (const auto& Pair : NewChains)
+		{
+			const FName SpaceName(*(Pair.Key.ToString() + TEXT("_space")));
+			const FRigElementKey SpaceKey(SpaceName, ERigElementType::Null);
+			const TArray<FName>& NewChain = Pair.Value;
+			const TArray<FName> OldChain = LastSecondaryBuild.ChainsBySpace.FindRef(Pair.Key);
+			
+			// 새 본 컨트롤 추가 (이미 있는 컨트롤은 CreateChainControls가 건너뜀)
+			if (NewChain.Num() > 0)
+			{
+				CreateSpaceNull(HC, SpaceName, GetSecondarySpaceTransform(Pair.Key, RefSkel));
+				CreateChainControls(HC, Hierarchy, SpaceName, NewChain, RefSkel);
+			}
+			
+			// 남은 본: 부모 본이 추가/삭제됐으면 부모 컨트롤 다시 연결 (전체 생성과 같은 규칙)
+			for (const FName& BoneName : NewChain)
+			{
+				if (!OldChain.Contains(BoneName)) continue;
+				
+				const int32 ParentIndex = Topology.GetParent(Topology.FindBoneIndex(BoneName));
+				const FName ParentBone = ParentIndex != INDEX_NONE ? RefSkel.GetBoneName(ParentIndex) : NAME_None;
+				const FRigElementKey ExpectedParent = NewChain.Contains(ParentBone) ? ControlKeyOf(ParentBone) : SpaceKey;
+				if (Hierarchy->GetFirstParent(ControlKeyOf(BoneName)) != ExpectedParent)
+				{
+					Batch.SetParent(ControlKeyOf(BoneName), ExpectedParent, false);
+				}
+			}
+			
+			// 빠진 본 컨트롤 삭제 (자식부터), 빈 Space는 Null까지 삭제
+			for (int32 i = OldChain.Num() - 1; i >= 0; --i)
+			{
+				if (!NewChain.Contains(OldChain[i]) && Hierarchy->Contains(ControlKeyOf(OldChain[i])))
+				{
+					KeysToRemove.Add(ControlKeyOf(OldChain[i]));
+				}
+			}
+			if (NewChain.Num() == 0 && Hierarchy->Contains(SpaceKey))
+			{
+				KeysToRemove.Add(SpaceKey);
+			}
+		}
+		
+		// 부모 변경을 먼저 적용 (삭제되는 컨트롤 밑에 남은 컨트롤이 없도록)
+		Batch.Flush();
+		for (const FRigElementKey& Key : KeysToRemove)
+		{
+			Batch.RemoveElement(Key);
+			RemovedControls += Key.Type == ERigElementType::Control ? 1 : 0;
+		}
+	}
+	const int32 AddedControls = LastSecondaryControlCount - ControlCountBefore;
+	LastSecondaryControlCount -= RemovedControls;
+	
+	// ========== 함수 노드: 바뀐 Space만 (VM 컴파일 1회) ==========
+	URigVMGraph* MainGraph = FindMainGraph(Rig);
+	URigVMController* Controller = MainGraph ? Rig->GetController(MainGraph) : nullptr;
+	if (!Controller)
+	{
+		SetStatus(TEXT("ERROR: Control Rig main graph not found"));
+		return false;
+	}
+	
+	FSecondaryFunctionLayout& Layout = LastSecondaryBuild.Layout;
+	if (!Layout.bResolved)
+	{
+		// 처음 생성 때 세컨더리가 없었음 → 템플릿 빈 노드 처리부터 일반 경로로
+		TMap<FName, TArray<FName>> NonEmptyChains;
+		for (const auto& Pair : NewChains)
+		{
+			if (Pair.Value.Num() > 0)
+			{
+				NonEmptyChains.Add(Pair.Key, Pair.Value);
+			}
+		}
+		if (NonEmptyChains.Num() > 0)
+		{
+			ConnectSecondaryFunctionNodes(Rig, NonEmptyChains, &Layout);
+		}
+	}
+	else
+	{
+		FRigVMBulkEdit BulkEdit(Rig, Controller, TEXT("Update Secondary Function Nodes"));
+		FString DebugInfo;
+		
+		// Execute 체인에서 같은 종류의 앞/뒤 노드 (노드 생성에 실패한 Space는 건너뜀)
+		auto FindChainNode = [&Layout](int32 FromOrder, int32 Kind, int32 Step) -> FName
+		{
+			for (int32 i = FromOrder + Step; Layout.SpaceOrder.IsValidIndex(i); i += Step)
+			{
+				const TArray<FName>* Nodes = Layout.NodesBySpace.Find(Layout.SpaceOrder[i]);
+				if (Nodes && !(*Nodes)[Kind].IsNone())
+				{
+					return (*Nodes)[Kind];
+				}
+			}
+			return Step < 0 ? Layout.PrevNode[Kind] : NAME_None;
+		};
+		
+		for (const auto& Pair : NewChains)
+		{
+			const FName SpaceParent = Pair.Key;
+			const FName SpaceName(*(SpaceParent.ToString() + TEXT("_space")));
+			const TArray<FName>& ChainBones = Pair.Value;
+			
+			TArray<FName> ControlNames;
+			for (const FName& BoneName : ChainBones)
+			{
+				ControlNames.Add(ControlKeyOf(BoneName).Name);
+			}
+			
+			FName ActualBoneName = LastBoneMapping.FindRef(SpaceParent);
+			if (ActualBoneName.IsNone()) ActualBoneName = SpaceParent;
+			
+			const int32 OrderIndex = Layout.SpaceOrder.IndexOfByKey(SpaceParent);
+			if (OrderIndex != INDEX_NONE && ChainBones.Num() > 0)
+			{
+				// 기존 Space: bones / ctrls 배열만 교체
+				for (const FName& NodeName : Layout.NodesBySpace.FindRef(SpaceParent))
+				{
+					if (NodeName.IsNone()) continue;
+					if (!PatchFunctionNodeArrays(BulkEdit, MainGraph, NodeName, ChainBones, ControlNames))
+					{
+						// 배열 노드 연결이 끊겨 있으면 핀을 다시 구성
+						SetFunctionNodePins(BulkEdit, MainGraph->FindNodeByName(NodeName), ActualBoneName, SpaceName, ChainBones, ControlNames);
+					}
+				}
+			}
+			else if (OrderIndex != INDEX_NONE)
+			{
+				// 빈 Space: 노드 삭제 후 앞뒤 노드 Execute 재연결
+				const TArray<FName> SpaceNodes = Layout.NodesBySpace.FindRef(SpaceParent);
+				for (int32 Kind = 0; Kind < FSecondaryFunctionLayout::NumKinds; ++Kind)
+				{
+					if (SpaceNodes[Kind].IsNone()) continue;
+					
+					const FName PrevNode = FindChainNode(OrderIndex, Kind, -1);
+					const FName NextNode = FindChainNode(OrderIndex, Kind, 1);
+					RemoveFunctionNodeWithArrays(BulkEdit, MainGraph, SpaceNodes[Kind]);
+					if (!PrevNode.IsNone() && !NextNode.IsNone())
+					{
+						LinkExecutePins(BulkEdit, PrevNode.ToString(), NextNode.ToString());
+					}
+				}
+				Layout.SpaceOrder.RemoveAt(OrderIndex);
+				Layout.NodesBySpace.Remove(SpaceParent);
+			}
+			else if (ChainBones.Num() > 0)
+			{
+				// 새 Space: Execute 체인 끝에 추가
+				TArray<FName> SpaceNodes;
+				SpaceNodes.Init(NAME_None, FSecondaryFunctionLayout::NumKinds);
+				for (int32 Kind = 0; Kind < FSecondaryFunctionLayout::NumKinds; ++Kind)
+				{
+					const FVector2D Position(Layout.StartPos[Kind].X + Layout.NextSpaceIndex * FSecondaryFunctionLayout::XSpacing, Layout.StartPos[Kind].Y);
+					URigVMNode* FuncNode = AddFunctionReferenceNode(BulkEdit, FSecondaryFunctionLayout::KindNames[Kind], Position, DebugInfo);
+					if (!FuncNode) continue;
+					
+					SetFunctionNodePins(BulkEdit, FuncNode, ActualBoneName, SpaceName, ChainBones, ControlNames);
+					
+					const FName PrevNode = FindChainNode(Layout.SpaceOrder.Num(), Kind, -1);
+					if (!PrevNode.IsNone())
+					{
+						LinkExecutePins(BulkEdit, PrevNode.ToString(), FuncNode->GetName());
+					}
+					SpaceNodes[Kind] = FuncNode->GetFName();
+				}
+				Layout.SpaceOrder.Add(SpaceParent);
+				Layout.NodesBySpace.Add(SpaceParent, MoveTemp(SpaceNodes));
+				Layout.NextSpaceIndex++;
+			}
+		}
+		
+		if (!DebugInfo.IsEmpty())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] Secondary function node update:\n%s"), *DebugInfo);
+		}
+	}
+	
+	// 저장
+	Rig->MarkPackageDirty();
+	FPackageSaveQueue::Save(Rig->GetPackage(), Rig);
+	
+	// 빌드 상태 갱신 → 이후 변경은 이번 결과 기준
+	const int32 NumChangedSpaces = NewChains.Num();
+	for (auto& Pair : NewChains)
+	{
+		if (Pair.Value.Num() > 0)
+		{
+			LastSecondaryBuild.ChainsBySpace.Add(Pair.Key, MoveTemp(Pair.Value));
+		}
+		else
+		{
+			LastSecondaryBuild.ChainsBySpace.Remove(Pair.Key);
+		}
+	}
+	for (const FName& BoneName : DirtyBones)
+	{
+		const EBoneClassification Classification = GetClassification(BoneName);
+		if (Classification == EBoneClassification::Helper)
+		{
+			LastSecondaryBuild.Classifications.Remove(BoneName);
+		}
+		else
+		{
+			LastSecondaryBuild.Classifications.Add(BoneName, Classification);
+		}
+	}
+	DirtyClassificationBones.Reset();
+	UpdateWorkflowUI();
+	
+	const double Elapsed = FPlatformTime::Seconds() - StartTime;
+	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Incremental update: %d bones, %d spaces, +%d/-%d controls (%.2fs)"),
+		DirtyBones.Num(), NumChangedSpaces, AddedControls, RemovedControls, Elapsed);
+	SetStatus(FString::Printf(TEXT("Control Rig updated: %d bones changed, %d spaces, +%d / -%d controls (%.1fs)"),
+		DirtyBones.Num(), NumChangedSpaces, AddedControls, RemovedControls, Elapsed));
 	return true;
 }
 
@@ -2874,43 +3502,47 @@ bool SControlRigToolWidget::CreateSecondaryOnlyControlRig()
 	
 	// 7. Space별로 세컨더리 본 그룹화
 	TMap<FName, TArray<FName>> ChainsBySpace;
-	for (const FName& BoneName : SelectedSecondaryBones)
+	const TArray<FName> SpaceParents = FindZeroBoneParents(SelectedSecondaryBones, Mesh);
+	for (int32 i = 0; i < SelectedSecondaryBones.Num(); ++i)
 	{
-		FName SpaceParent = FindZeroBoneParent(BoneName, RefSkel);
+		FName SpaceParent = SpaceParents[i];
 		if (SpaceParent.IsNone())
 		{
 			SpaceParent = FName(TEXT("root"));
 		}
-		ChainsBySpace.FindOrAdd(SpaceParent).Add(BoneName);
+		ChainsBySpace.FindOrAdd(SpaceParent).Add(SelectedSecondaryBones[i]);
 	}
 	
 	UE_LOG(LogTemp, Log, TEXT("[SecondaryOnly] Grouped into %d spaces"), ChainsBySpace.Num());
 	
-	// 8. Space 및 Control 생성
+	// 8. Space 및 Control 생성 (계층 알림 없이 일괄 추가, 저장 전에 스코프 종료)
 	LastSecondaryControlCount = 0;
-	for (const auto& Pair : ChainsBySpace)
 	{
-		FName SpaceParentName = Pair.Key;
-		const TArray<FName>& ChainBones = Pair.Value;
-		
-		// Space Null 생성
-		FString SpaceNameStr = SpaceParentName.ToString() + TEXT("_space");
-		FName SpaceFName(*SpaceNameStr);
-		
-		// Space 트랜스폼 (부모 본 위치)
-		FTransform SpaceTransform = FTransform::Identity;
-		int32 SpaceBoneIdx = RefSkel.FindBoneIndex(SpaceParentName);
-		if (SpaceBoneIdx != INDEX_NONE)
+		FRigHierarchyBatchEdit Batch(NewRig);
+		for (const auto& Pair : ChainsBySpace)
 		{
-			SpaceTransform = RefSkel.GetRefBonePose()[SpaceBoneIdx];
+			FName SpaceParentName = Pair.Key;
+			const TArray<FName>& ChainBones = Pair.Value;
+			
+			// Space Null 생성
+			FString SpaceNameStr = SpaceParentName.ToString() + TEXT("_space");
+			FName SpaceFName(*SpaceNameStr);
+			
+			// Space 트랜스폼 (부모 본 위치)
+			FTransform SpaceTransform = FTransform::Identity;
+			int32 SpaceBoneIdx = RefSkel.FindBoneIndex(SpaceParentName);
+			if (SpaceBoneIdx != INDEX_NONE)
+			{
+				SpaceTransform = RefSkel.GetRefBonePose()[SpaceBoneIdx];
+			}
+			
+			CreateSpaceNull(HC, SpaceFName, SpaceTransform);
+			
+			// 각 본에 컨트롤러 생성
+			CreateChainControls(HC, Hierarchy, SpaceFName, ChainBones, RefSkel);
+			
+			UE_LOG(LogTemp, Log, TEXT("[SecondaryOnly] Created space '%s' with %d controls"), *SpaceNameStr, ChainBones.Num());
 		}
-		
-		CreateSpaceNull(HC, SpaceFName, SpaceTransform);
-		
-		// 각 본에 컨트롤러 생성
-		CreateChainControls(HC, Hierarchy, SpaceFName, ChainBones, RefSkel);
-		
-		UE_LOG(LogTemp, Log, TEXT("[SecondaryOnly] Created space '%s' with %d controls"), *SpaceNameStr, ChainBones.Num());
 	}
 	
 	// 9. AI 함수 노드 연결 (AI_Setup, AI_Forward, AI_Backward)
@@ -2920,9 +3552,7 @@ bool SControlRigToolWidget::CreateSecondaryOnlyControlRig()
 	FBlueprintEditorUtils::MarkBlueprintAsModified(NewRig);
 	NewRig->MarkPackageDirty();
 	
-	FSavePackageArgs SaveArgs;
-	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
-	UPackage::SavePackage(Package, NewRig, *FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension()), SaveArgs);
+	FPackageSaveQueue::Save(Package, NewRig);
 	
 	UE_LOG(LogTemp, Log, TEXT("[SecondaryOnly] Saved: %s"), *OutputPath);
 	
@@ -2937,54 +3567,67 @@ bool SControlRigToolWidget::CreateSecondaryOnlyControlRig()
 // ============================================================================
 // 세컨더리 본에서 가장 가까운 "Space 대상" 부모 찾기
 // Space 대상: 제로본 + root + bip001 등 최상위 본
-// 반환값: Space 이름으로 사용할 본 이름 (예: head, pelvis, bip001, root 등)
+// 반환값: BoneNames와 같은 순서의 Space 이름 (예: head, pelvis, bip001, root 등)
 // ============================================================================
-FName SControlRigToolWidget::FindZeroBoneParent(const FName& BoneName, const FReferenceSkeleton& RefSkel) const
+TArray<FName> SControlRigToolWidget::FindZeroBoneParents(const TArray<FName>& BoneNames, const USkeletalMesh* Mesh) const
 {
-	int32 BoneIndex = RefSkel.FindBoneIndex(BoneName);
-	if (BoneIndex == INDEX_NONE) return NAME_None;
+	const FReferenceSkeleton& RefSkel = Mesh->GetRefSkeleton();
+	const FSkeletonTopology& Topology = GetSkeletonTopology(Mesh);
+	const int32 NumBones = Topology.Num();
 	
-	// 부모를 따라 올라가면서 Space 대상 본을 찾음
-	int32 ParentIndex = RefSkel.GetParentIndex(BoneIndex);
-	while (ParentIndex != INDEX_NONE)
+	// 1. 본마다 Space 이름 계산 (Space 대상이 아니면 NAME_None)
+	TArray<FName> SpaceNameByBone;
+	SpaceNameByBone.SetNum(NumBones);
+	TBitArray<> IsSpaceBone(false, NumBones);
+	const FBoneKeywordClassifier& Classifier = FBoneKeywordClassifier::Get();
+	for (int32 i = 0; i < NumBones; ++i)
 	{
-		FName ParentName = RefSkel.GetBoneName(ParentIndex);
-		FString ParentNameStr = ParentName.ToString();
-		FString LowerName = ParentNameStr.ToLower();
+		const FName BoneName = RefSkel.GetBoneName(i);
+		FString LowerName = BoneName.ToString().ToLower();
+		const EBoneKeyword Keywords = Classifier.Classify(LowerName);
 		
-		// 1. 제로본 (UE5 표준 본)인지 확인 - UE5 표준 이름으로 반환
-		if (IsZeroBone(ParentNameStr))
+		// 제로본 (UE5 표준 본) - UE5 표준 이름으로, 매핑 없으면 원래 이름 (소문자로 정규화)
+		if (const FName* Target = LastBoneMapping.FindTarget(BoneName))
 		{
-			// LastBoneMapping에서 UE5 표준 이름 찾기 (source -> target)
-			for (const auto& Pair : LastBoneMapping)
-			{
-				if (Pair.Value.ToString().Equals(ParentNameStr, ESearchCase::IgnoreCase))
-				{
-					return Pair.Key;
-				}
-			}
-			// 매핑 없으면 원래 이름 (소문자로 정규화)
-			return FName(*LowerName);
+			SpaceNameByBone[i] = *Target;
 		}
-		
-		// 2. bip001 계열 본 - "bip001"로 Space 생성
-		if (LowerName.Contains(TEXT("bip001")) || LowerName.Contains(TEXT("bip_001")) ||
-			LowerName.Contains(TEXT("bip-001")) || LowerName.Equals(TEXT("bip")))
+		else if (EnumHasAnyFlags(Keywords, EBoneKeyword::Zero))
 		{
-			return FName(TEXT("bip001"));
+			SpaceNameByBone[i] = FName(*LowerName);
 		}
-		
-		// 3. root 본 - "root"로 Space 생성
-		if (LowerName.Equals(TEXT("root")) || LowerName.Contains(TEXT("armature")))
+		// bip001 계열 본 - "bip001"로 Space 생성
+		else if (EnumHasAnyFlags(Keywords, EBoneKeyword::BipRoot))
+		{
+			SpaceNameByBone[i] = FName(TEXT("bip001"));
+		}
+		// root 본 - "root"로 Space 생성
+		else if (EnumHasAnyFlags(Keywords, EBoneKeyword::SceneRoot))
 		{
-			return FName(TEXT("root"));
+			SpaceNameByBone[i] = FName(TEXT("root"));
 		}
 		
-		ParentIndex = RefSkel.GetParentIndex(ParentIndex);
+		IsSpaceBone[i] = !SpaceNameByBone[i].IsNone();
 	}
 	
-	// 최상위까지 갔는데 못 찾으면 root로
-	return FName(TEXT("root"));
+	// 2. 가장 가까운 Space 대상 조상 (한 번의 패스)
+	const TArray<int32> NearestSpaceBone = Topology.BuildNearestMarkedAncestors(IsSpaceBone);
+	
+	TArray<FName> Result;
+	Result.Reserve(BoneNames.Num());
+	for (const FName& BoneName : BoneNames)
+	{
+		const int32 BoneIndex = Topology.FindBoneIndex(BoneName);
+		if (BoneIndex == INDEX_NONE)
+		{
+			Result.Add(NAME_None);
+			continue;
+		}
+		
+		// 최상위까지 갔는데 못 찾으면 root로
+		const int32 SpaceBone = NearestSpaceBone[BoneIndex];
+		Result.Add(SpaceBone != INDEX_NONE ? SpaceNameByBone[SpaceBone] : FName(TEXT("root")));
+	}
+	return Result;
 }
 
 // ============================================================================
@@ -3021,6 +3664,31 @@ bool SControlRigToolWidget::HasSkinWeight(USkeletalMesh* Mesh, const FName& Bone
 	return false;
 }
 
+// ============================================================================
+// 스켈레톤 토폴로지 인덱스 (자식/깊이/서브트리) - 스켈레톤당 한 번만 빌드
+// ============================================================================
+const FSkeletonTopology& SControlRigToolWidget::GetSkeletonTopology(const USkeletalMesh* Mesh) const
+{
+	// GC된 메쉬 엔트리 정리
+	for (auto It = SkeletonTopologies.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+	
+	const FReferenceSkeleton& RefSkel = Mesh->GetRefSkeleton();
+	TSharedPtr<FSkeletonTopology>& Topology = SkeletonTopologies.FindOrAdd(Mesh);
+	if (!Topology.IsValid() || !Topology->IsBuiltFrom(RefSkel))
+	{
+		// 리임포트 등으로 본 구성이 바뀌면 재빌드
+		Topology = MakeShared<FSkeletonTopology>(RefSkel);
+		UE_LOG(LogTemp, Verbose, TEXT("[ControlRigTool] Built skeleton topology: %d bones"), Topology->Num());
+	}
+	return *Topology;
+}
+
 void SControlRigToolWidget::BuildSecondaryChains(USkeletalMesh* Mesh, TMap<FName, TArray<FName>>& OutChainsBySpace)
 {
 	OutChainsBySpace.Empty();
@@ -3064,9 +3732,11 @@ void SControlRigToolWidget::BuildSecondaryChains(USkeletalMesh* Mesh, TMap<FName
 	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Collected %d secondary bones"), SecondaryBones.Num());
 	
 	// 2. 각 세컨더리 본의 제로본 부모 찾아서 그룹화
-	for (const FName& BoneName : SecondaryBones)
+	// SecondaryBones가 본 인덱스 순서로 수집되므로 각 Space 내 본들도 계층 순서 (부모가 먼저)
+	const TArray<FName> ZeroParents = FindZeroBoneParents(SecondaryBones, Mesh);
+	for (int32 i = 0; i < SecondaryBones.Num(); ++i)
 	{
-		FName ZeroParent = FindZeroBoneParent(BoneName, RefSkel);
+		FName ZeroParent = ZeroParents[i];
 		if (ZeroParent.IsNone())
 		{
 			// 제로본 부모가 없으면 root_space에 넣음
@@ -3074,19 +3744,7 @@ void SControlRigToolWidget::BuildSecondaryChains(USkeletalMesh* Mesh, TMap<FName
 		}
 		
 		FName SpaceName = FName(*FString::Printf(TEXT("%s_space"), *ZeroParent.ToString()));
-		OutChainsBySpace.FindOrAdd(SpaceName).Add(BoneName);
-	}
-	
-	// 3. 각 Space 내 본들을 계층 순서로 정렬 (부모가 먼저)
-	for (auto& Pair : OutChainsBySpace)
-	{
-		TArray<FName>& Bones = Pair.Value;
-		
-		// 인덱스 기준 정렬 (본 계층 순서)
-		Bones.Sort([&RefSkel](const FName& A, const FName& B)
-		{
-			return RefSkel.FindBoneIndex(A) < RefSkel.FindBoneIndex(B);
-		});
+		OutChainsBySpace.FindOrAdd(SpaceName).Add(SecondaryBones[i]);
 	}
 }
 
@@ -3134,6 +3792,20 @@ void SControlRigToolWidget::CreateSpaceNull(URigHierarchyController* HC, const F
 	}
 }
 
+// Space 트랜스폼 = 매핑된 부모 본의 레퍼런스 포즈 (매핑 없으면 원점)
+FTransform SControlRigToolWidget::GetSecondarySpaceTransform(const FName& SpaceParent, const FReferenceSkeleton& RefSkel) const
+{
+	if (const FName* MappedBone = LastBoneMapping.Find(SpaceParent))
+	{
+		const int32 BoneIdx = RefSkel.FindBoneIndex(*MappedBone);
+		if (BoneIdx != INDEX_NONE)
+		{
+			return RefSkel.GetRefBonePose()[BoneIdx];
+		}
+	}
+	return FTransform::Identity;
+}
+
 // ============================================================================
 // 체인 컨트롤러 생성 - Space 아래에 체인 구조로 컨트롤러 생성
 // ============================================================================
@@ -3276,95 +3948,73 @@ void SControlRigToolWidget::RemapBoneReferences(UControlRigBlueprint* Rig)
 	URigVMGraph* Graph = VMController->GetGraph();
 	if (!Graph) return;
 
-	int32 RemappedCount = 0;
-
-	// 먼저 모든 핀 값 형식 로깅 (디버깅용)
-	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] === Scanning all pins ==="));
-	for (URigVMNode* Node : Graph->GetNodes())
+	// 모든 핀 값 형식 로깅 (디버깅용, Verbose 로그에서만)
+	if (UE_LOG_ACTIVE(LogTemp, Verbose))
 	{
-		if (!Node) continue;
-
-		for (URigVMPin* Pin : Node->GetPins())
+		UE_LOG(LogTemp, Verbose, TEXT("[ControlRigTool] === Scanning all pins ==="));
+		for (URigVMNode* Node : Graph->GetNodes())
 		{
-			if (!Pin) continue;
+			if (!Node) continue;
 
-			FString PinName = Pin->GetName();
-			FString DefaultValue = Pin->GetDefaultValue();
+			for (URigVMPin* Pin : Node->GetPins())
+			{
+				if (!Pin) continue;
 
-			if (DefaultValue.IsEmpty()) continue;
+				FString DefaultValue = Pin->GetDefaultValue();
+				if (DefaultValue.IsEmpty()) continue;
 
-			// 매핑 테이블의 본 이름을 포함하는 핀만 로깅
-			for (const auto& Pair : LastBoneMapping)
-			{
-				if (DefaultValue.Contains(Pair.Key.ToString()))
+				// 매핑 테이블의 본 이름을 포함하는 핀만 로깅
+				for (const auto& Pair : LastBoneMapping)
 				{
-					UE_LOG(LogTemp, Log, TEXT("  [DEBUG] Node=%s, Pin=%s, Value=%s"), 
-						*Node->GetName(), *PinName, *DefaultValue.Left(200));
-					break;
+					if (DefaultValue.Contains(Pair.Key.ToString()))
+					{
+						UE_LOG(LogTemp, Verbose, TEXT("  [DEBUG] Node=%s, Pin=%s, Value=%s"), 
+							*Node->GetName(), *Pin->GetName(), *DefaultValue.Left(200));
+						break;
+					}
 				}
 			}
 		}
+		UE_LOG(LogTemp, Verbose, TEXT("[ControlRigTool] === End scan ==="));
 	}
-	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] === End scan ==="));
 
-	for (URigVMNode* Node : Graph->GetNodes())
+	// 1. 변경할 핀 수집 (그래프를 수정하기 전에 전부 모음)
+	// 템플릿 스냅샷에서 만든 리그면 베이크 때 찾아둔 본 슬롯만 확인 (핀 트리 순회 없음)
+	const FControlRigTemplateSnapshot* Snapshot = PendingControlRig.Get() == Rig ? PendingTemplateSnapshot.Get() : nullptr;
+	const TArray<FControlRigBoneSlot> GraphSlots = Snapshot ? TArray<FControlRigBoneSlot>() : FControlRigTemplateSnapshot::CollectBoneSlots(Graph);
+	const TArray<FControlRigBoneSlot>& BoneSlots = Snapshot ? Snapshot->BoneSlots : GraphSlots;
+
+	TArray<TPair<FString, FString>> PinEdits;
+	for (const FControlRigBoneSlot& Slot : BoneSlots)
 	{
-		if (!Node) continue;
+		const FName* SourceBone = LastBoneMapping.Find(Slot.BoneName);
+		if (!SourceBone) continue;
 
-		for (URigVMPin* Pin : Node->GetPins())
+		UE_LOG(LogTemp, Log, TEXT("  [%s] %s -> %s"), *Slot.PinPath, *Slot.BoneName.ToString(), *SourceBone->ToString());
+		if (Slot.bElementKey)
 		{
-			if (!Pin) continue;
-
-			FString PinName = Pin->GetName();
-			FString DefaultValue = Pin->GetDefaultValue();
-
-			if (DefaultValue.IsEmpty()) continue;
-
-			// Control 타입이면 스킵 (컨트롤러 참조는 변경하지 않음)
-			if (DefaultValue.Contains(TEXT("Type=Control")) ||
-				DefaultValue.Contains(TEXT("ERigElementType::Control")))
-			{
-				continue;
-			}
-
-			// 매핑 테이블에서 찾기
-			FString NewValue = DefaultValue;
-			bool AnyRemapped = false;
-
-			for (const auto& Pair : LastBoneMapping)
-			{
-				FString TargetBone = Pair.Key.ToString();  // UE5 표준 (템플릿에서 사용)
-				FString SourceBone = Pair.Value.ToString(); // 실제 메시 본
-
-				// 다양한 패턴으로 매칭
-				TArray<TPair<FString, FString>> Patterns = {
-					{FString::Printf(TEXT("Name=\"%s\""), *TargetBone), FString::Printf(TEXT("Name=\"%s\""), *SourceBone)},
-					{FString::Printf(TEXT("Name=%s,"), *TargetBone), FString::Printf(TEXT("Name=%s,"), *SourceBone)},
-					{FString::Printf(TEXT("Name=%s)"), *TargetBone), FString::Printf(TEXT("Name=%s)"), *SourceBone)},
-					{FString::Printf(TEXT("\"Name\":\"%s\""), *TargetBone), FString::Printf(TEXT("\"Name\":\"%s\""), *SourceBone)},
-					{FString::Printf(TEXT("Bone(%s)"), *TargetBone), FString::Printf(TEXT("Bone(%s)"), *SourceBone)},
-				};
-
-				for (const auto& P : Patterns)
-				{
-					if (NewValue.Contains(P.Key))
-					{
-						NewValue = NewValue.Replace(*P.Key, *P.Value);
-						AnyRemapped = true;
-						UE_LOG(LogTemp, Log, TEXT("  [%s.%s] %s -> %s"), *Node->GetName(), *PinName, *TargetBone, *SourceBone);
-					}
-				}
-			}
+			FRigElementKey Key(*SourceBone, ERigElementType::Bone);
+			FString NewValue;
+			FRigElementKey::StaticStruct()->ExportText(NewValue, &Key, nullptr, nullptr, PPF_None, nullptr);
+			PinEdits.Emplace(Slot.PinPath, NewValue);
+		}
+		else
+		{
+			PinEdits.Emplace(Slot.PinPath, SourceBone->ToString());
+		}
+	}
 
-			if (AnyRemapped)
-			{
-				VMController->SetPinDefaultValue(Pin->GetPinPath(), NewValue, true, false, false);
-				RemappedCount++;
-			}
+	// 2. 한 번의 컴파일 브래킷 안에서 적용 (핀마다 VM 재컴파일 방지)
+	if (PinEdits.Num() > 0)
+	{
+		FRigVMControllerCompileBracketScope CompileBracket(VMController);
+		for (const TPair<FString, FString>& Edit : PinEdits)
+		{
+			VMController->SetPinDefaultValue(Edit.Key, Edit.Value, true, false, false);
 		}
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Remapped %d bone references"), RemappedCount);
+	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Remapped %d bone references"), PinEdits.Num());
 }
 
 void SControlRigToolWidget::SetStatus(const FString& Message)
@@ -3415,181 +4065,102 @@ void SControlRigToolWidget::SendApproveRequest()
 		return;
 	}
 	
-	// 메시 로드
-	USkeletalMesh* Mesh = LoadObject<USkeletalMesh>(nullptr, *MeshPath);
-	if (!Mesh)
+	// 승인은 세션 단위 (캐시 고정 + 저널 기록) → 같은 메쉬를 잡은 다른 탭에도 반영
+	TSharedRef<FBoneMappingSession> Session = AcquireMappingSession(ControlRigMappingSession, MeshPath);
+	if (!Session->Approve())
 	{
-		SetStatus(TEXT("ERROR: Failed to load mesh"));
-		return;
+		SetStatus(TEXT("ERROR: Run AI Bone Mapping for the selected mesh first"));
 	}
-	
-	const FReferenceSkeleton& RefSkel = Mesh->GetRefSkeleton();
-	
-	// JSON 요청 생성
-	TSharedPtr<FJsonObject> RequestObj = MakeShared<FJsonObject>();
-	RequestObj->SetStringField(TEXT("skeleton_name"), Mesh->GetName());
-	
-	// 본 정보 배열
-	TArray<TSharedPtr<FJsonValue>> BonesArray;
-	for (int32 i = 0; i < RefSkel.GetNum(); ++i)
+}
+
+// ============================================================================
+// 분류 피드백 함수들 (AI 학습용)
+// ============================================================================
+// 라디오 변경이 멈춘 뒤 이 시간 후에 일괄 전송 (shift 선택으로 여러 본을 바꾸는 동안은 대기)
+static constexpr float ClassificationFeedbackDelay = 2.0f;
+
+void SControlRigToolWidget::QueueClassificationFeedback(FName BoneName, const FString& Classification)
+{
+	// 다른 메쉬의 피드백이 남아 있으면 먼저 전송 (부모/자식 정보는 전송 시점 메쉬 기준)
+	if (PendingClassificationFeedback.Num() > 0 && PendingFeedbackMesh != CachedMesh)
 	{
-		TSharedPtr<FJsonObject> BoneObj = MakeShared<FJsonObject>();
-		FName BoneName = RefSkel.GetBoneName(i);
-		int32 ParentIdx = RefSkel.GetParentIndex(i);
-		
-		BoneObj->SetStringField(TEXT("name"), BoneName.ToString());
-		
-		if (ParentIdx >= 0)
-		{
-			BoneObj->SetStringField(TEXT("parent"), RefSkel.GetBoneName(ParentIdx).ToString());
-		}
-		else
-		{
-			BoneObj->SetField(TEXT("parent"), MakeShared<FJsonValueNull>());
-		}
-		
-		// 자식 본 수집
-		TArray<TSharedPtr<FJsonValue>> ChildrenArray;
-		for (int32 j = 0; j < RefSkel.GetNum(); ++j)
-		{
-			if (RefSkel.GetParentIndex(j) == i)
-			{
-				ChildrenArray.Add(MakeShared<FJsonValueString>(RefSkel.GetBoneName(j).ToString()));
-			}
-		}
-		BoneObj->SetArrayField(TEXT("children"), ChildrenArray);
-		
-		BonesArray.Add(MakeShared<FJsonValueObject>(BoneObj));
+		FlushClassificationFeedback();
 	}
-	RequestObj->SetArrayField(TEXT("bones"), BonesArray);
+	PendingFeedbackMesh = CachedMesh;
+	PendingClassificationFeedback.Add(BoneName, Classification);
 	
-	// 매핑 정보 (역전: ue5_bone -> source_bone)
-	TSharedPtr<FJsonObject> MappingObj = MakeShared<FJsonObject>();
-	for (const auto& Pair : LastBoneMapping)
+	// 디바운스 - 마지막 변경 기준으로 타이머 재시작
+	if (FeedbackFlushHandle.IsValid())
 	{
-		MappingObj->SetStringField(Pair.Key.ToString(), Pair.Value.ToString());
+		FTSTicker::GetCoreTicker().RemoveTicker(FeedbackFlushHandle);
 	}
-	RequestObj->SetObjectField(TEXT("mapping"), MappingObj);
-	
-	// JSON 문자열로 변환
-	FString RequestBody;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&RequestBody);
-	FJsonSerializer::Serialize(RequestObj.ToSharedRef(), Writer);
-	
-	// HTTP 요청 전송
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
-	HttpRequest->SetURL(TEXT("http://localhost:8000/approve"));
-	HttpRequest->SetVerb(TEXT("POST"));
-	HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-	HttpRequest->SetContentAsString(RequestBody);
-	
-	HttpRequest->OnProcessRequestComplete().BindLambda([this](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
-	{
-		if (!bWasSuccessful || !Response.IsValid())
-		{
-			SetStatus(TEXT("ERROR: Failed to send approve request"));
-			return;
-		}
-		
-		TSharedPtr<FJsonObject> JsonResponse;
-		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
-		
-		if (FJsonSerializer::Deserialize(Reader, JsonResponse) && JsonResponse.IsValid())
-		{
-			int32 TotalSamples = JsonResponse->GetIntegerField(TEXT("total_samples"));
-			bool AutoTrain = JsonResponse->GetBoolField(TEXT("auto_train_triggered"));
-			FString Message = JsonResponse->GetStringField(TEXT("message"));
-			
-			if (AutoTrain)
-			{
-				SetStatus(FString::Printf(TEXT("APPROVED! %s (Auto-training started!)"), *Message));
-			}
-			else
-			{
-				SetStatus(FString::Printf(TEXT("APPROVED! %s"), *Message));
-			}
-			
-			FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(
-				FString::Printf(TEXT("Mapping Approved!\n\nTotal Samples: %d\n%s"), TotalSamples, *Message)));
-		}
-		else
-		{
-			SetStatus(TEXT("ERROR: Invalid response from server"));
-		}
-	});
-	
-	HttpRequest->ProcessRequest();
-	SetStatus(TEXT("Sending approve request..."));
+	FeedbackFlushHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateSP(this, &SControlRigToolWidget::OnClassificationFeedbackTimer), ClassificationFeedbackDelay);
 }
 
-// ============================================================================
-// 분류 피드백 함수들 (AI 학습용)
-// ============================================================================
-void SControlRigToolWidget::SendClassificationFeedback(const FString& BoneName, const FString& Classification)
+bool SControlRigToolWidget::OnClassificationFeedbackTimer(float DeltaTime)
 {
-	// JSON 요청 생성
-	TSharedPtr<FJsonObject> RequestObj = MakeShared<FJsonObject>();
-	RequestObj->SetStringField(TEXT("bone_name"), BoneName);
-	RequestObj->SetStringField(TEXT("classification"), Classification);
-	
-	// 부모/자식 정보 추가 (캐시된 메시에서)
-	if (CachedMesh.IsValid())
+	FeedbackFlushHandle.Reset();
+	FlushClassificationFeedback();
+	return false;
+}
+
+void SControlRigToolWidget::FlushClassificationFeedback()
+{
+	if (FeedbackFlushHandle.IsValid())
 	{
-		const FReferenceSkeleton& RefSkel = CachedMesh->GetRefSkeleton();
-		int32 BoneIndex = RefSkel.FindBoneIndex(FName(*BoneName));
-		if (BoneIndex != INDEX_NONE)
-		{
-			int32 ParentIndex = RefSkel.GetParentIndex(BoneIndex);
-			if (ParentIndex != INDEX_NONE)
-			{
-				RequestObj->SetStringField(TEXT("parent"), RefSkel.GetBoneName(ParentIndex).ToString());
-			}
-			
-			// 자식 본 수집
-			TArray<TSharedPtr<FJsonValue>> ChildrenArray;
-			for (int32 i = 0; i < RefSkel.GetNum(); ++i)
-			{
-				if (RefSkel.GetParentIndex(i) == BoneIndex)
-				{
-					ChildrenArray.Add(MakeShared<FJsonValueString>(RefSkel.GetBoneName(i).ToString()));
-				}
-			}
-			RequestObj->SetArrayField(TEXT("children"), ChildrenArray);
-		}
-		RequestObj->SetStringField(TEXT("skeleton_name"), CachedMesh->GetName());
+		FTSTicker::GetCoreTicker().RemoveTicker(FeedbackFlushHandle);
+		FeedbackFlushHandle.Reset();
 	}
+	if (PendingClassificationFeedback.Num() == 0) return;
 	
-	// JSON 문자열로 변환
-	FString RequestBody;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&RequestBody);
-	FJsonSerializer::Serialize(RequestObj.ToSharedRef(), Writer);
+	TMap<FName, FString> Feedback = MoveTemp(PendingClassificationFeedback);
+	PendingClassificationFeedback.Reset();
+	USkeletalMesh* Mesh = PendingFeedbackMesh.Get();
+	PendingFeedbackMesh.Reset();
 	
-	// HTTP 요청 전송
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
-	HttpRequest->SetURL(TEXT("http://localhost:8000/classify_feedback"));
-	HttpRequest->SetVerb(TEXT("POST"));
-	HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-	HttpRequest->SetContentAsString(RequestBody);
+	const FReferenceSkeleton* RefSkel = Mesh ? &Mesh->GetRefSkeleton() : nullptr;
+	const FSkeletonTopology* Topology = Mesh ? &GetSkeletonTopology(Mesh) : nullptr;
+	const FString SkeletonName = Mesh ? Mesh->GetName() : FString();
 	
-	HttpRequest->OnProcessRequestComplete().BindLambda([this, BoneName, Classification](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+	// [{bone_name, classification, parent, children, skeleton_name}, ...]
+	FString RequestBody;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&RequestBody);
+	Writer->WriteArrayStart();
+	for (const TPair<FName, FString>& Pair : Feedback)
 	{
-		if (bWasSuccessful && Response.IsValid())
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("bone_name"), Pair.Key.ToString());
+		Writer->WriteValue(TEXT("classification"), Pair.Value);
+		
+		// 부모/자식 정보 (토폴로지 캐시에서 본 하나당 O(자식 수))
+		const int32 BoneIndex = RefSkel ? RefSkel->FindBoneIndex(Pair.Key) : INDEX_NONE;
+		if (BoneIndex != INDEX_NONE)
 		{
-			TSharedPtr<FJsonObject> JsonResponse;
-			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
-			if (FJsonSerializer::Deserialize(Reader, JsonResponse))
+			const int32 ParentIndex = RefSkel->GetParentIndex(BoneIndex);
+			if (ParentIndex != INDEX_NONE)
+			{
+				Writer->WriteValue(TEXT("parent"), RefSkel->GetBoneName(ParentIndex).ToString());
+			}
+			Writer->WriteArrayStart(TEXT("children"));
+			for (int32 i : Topology->GetChildren(BoneIndex))
 			{
-				FString Message = JsonResponse->GetStringField(TEXT("message"));
-				SetStatus(FString::Printf(TEXT("Feedback: %s -> %s. %s"), *BoneName, *Classification, *Message));
+				Writer->WriteValue(RefSkel->GetBoneName(i).ToString());
 			}
+			Writer->WriteArrayEnd();
 		}
-		else
+		if (!SkeletonName.IsEmpty())
 		{
-			UE_LOG(LogTemp, Warning, TEXT("[ControlRigTool] Failed to send classification feedback"));
+			Writer->WriteValue(TEXT("skeleton_name"), SkeletonName);
 		}
-	});
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+	Writer->Close();
 	
-	HttpRequest->ProcessRequest();
+	// 저널 기록 → 백그라운드 전송 (탭을 닫거나 서버가 꺼져 있어도 유실 없음)
+	FFeedbackJournal::Get().Append(TEXT("/classify_batch"), RequestBody);
+	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Classification feedback queued: %d bones"), Feedback.Num());
 }
 
 // ============================================================================
@@ -3604,25 +4175,15 @@ void SControlRigToolWidget::BuildBoneDisplayList()
 	USkeletalMesh* Mesh = CachedMesh.Get();
 	const FReferenceSkeleton& RefSkel = Mesh->GetRefSkeleton();
 	
-	// 각 본의 깊이 계산을 위한 함수
-	auto GetBoneDepth = [&RefSkel](int32 BoneIndex) -> int32 {
-		int32 Depth = 0;
-		int32 ParentIndex = RefSkel.GetParentIndex(BoneIndex);
-		while (ParentIndex != INDEX_NONE)
-		{
-			Depth++;
-			ParentIndex = RefSkel.GetParentIndex(ParentIndex);
-		}
-		return Depth;
-	};
+	const FSkeletonTopology& Topology = GetSkeletonTopology(Mesh);
 	
 	for (int32 i = 0; i < RefSkel.GetNum(); ++i)
 	{
 		FBoneDisplayInfo Info;
 		Info.BoneName = RefSkel.GetBoneName(i);
 		Info.BoneIndex = i;
-		Info.ParentIndex = RefSkel.GetParentIndex(i);
-		Info.Depth = GetBoneDepth(i);
+		Info.ParentIndex = Topology.GetParent(i);
+		Info.Depth = Topology.GetDepth(i);
 		
 		FString BoneNameStr = Info.BoneName.ToString();
 		
@@ -3645,10 +4206,34 @@ void SControlRigToolWidget::BuildBoneDisplayList()
 		BoneDisplayList.Add(Info);
 	}
 	
+	// 목록을 다시 만들면 분류가 기본값으로 돌아감 → 마지막 생성과의 차이 재계산
+	DirtyClassificationBones.Reset();
+	for (const FBoneDisplayInfo& Info : BoneDisplayList)
+	{
+		MarkClassificationDirty(Info);
+	}
+	
 	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Built bone display list: %d bones"), BoneDisplayList.Num());
 }
 
 void SControlRigToolWidget::UpdateBoneSelectionUI()
+{
+	// 본 목록이 새로 만들어졌을 때만 호출 (분류 변경은 행 속성 바인딩으로 반영)
+	BoneListItems.Reset(BoneDisplayList.Num());
+	for (int32 i = 0; i < BoneDisplayList.Num(); ++i)
+	{
+		BoneListItems.Add(MakeShared<int32>(i));
+	}
+	
+	if (BoneListView.IsValid())
+	{
+		BoneListView->RequestListRefresh();
+	}
+	
+	UpdateBoneSelectionHeader();
+}
+
+void SControlRigToolWidget::UpdateBoneSelectionHeader()
 {
 	if (!BoneSelectionBox.IsValid()) return;
 	BoneSelectionBox->ClearChildren();
@@ -3713,44 +4298,42 @@ void SControlRigToolWidget::UpdateBoneSelectionUI()
 		]
 	];
 	
-	// 본 목록
-	for (int32 i = 0; i < BoneDisplayList.Num(); ++i)
-	{
-		BoneSelectionBox->AddSlot().AutoHeight()
+}
+
+TSharedRef<ITableRow> SControlRigToolWidget::OnGenerateBoneRow(TSharedPtr<int32> Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(STableRow<TSharedPtr<int32>>, OwnerTable)
+		.Style(&FAppStyle::Get().GetWidgetStyle<FTableRowStyle>("TableView.NoHoverTableRow"))
+		.Padding(0)
 		[
-			CreateBoneRow(i)
+			CreateBoneRow(*Item)
 		];
-	}
 }
 
-TSharedRef<SWidget> SControlRigToolWidget::CreateBoneRow(int32 Index)
+// 본 행 색상 (분류가 바뀌면 행 속성 람다에서 다시 계산)
+// 양쪽(Side) = 같은 색, 가운데(Center) = 더 투명
+struct FBoneRowColors
 {
-	FBoneDisplayInfo& Info = BoneDisplayList[Index];
-	
-	// 색상 결정
-	FLinearColor TextColor;
-	FLinearColor RowBgColor = FLinearColor(0.0f, 0.0f, 0.0f, 0.0f);  // 기본: 투명
-	
-	// 3단계 배경색: 양옆(SideBg) - 그라데이션(FadeBg) - 가운데(CenterBg)
-	FLinearColor SideBgColor = FLinearColor(0.0f, 0.0f, 0.0f, 0.0f);  // 양옆
-	FLinearColor FadeBgColor = FLinearColor(0.0f, 0.0f, 0.0f, 0.0f);  // 그라데이션 (중간)
-	FLinearColor CenterBgColor = FLinearColor(0.0f, 0.0f, 0.0f, 0.0f);  // 가운데 (메뉴+본이름)
+	FLinearColor TextColor = FLinearColor(0.8f, 0.8f, 0.8f);
+	FLinearColor SideBgColor = FLinearColor(0.0f, 0.0f, 0.0f, 0.0f);
+	FLinearColor CenterBgColor = FLinearColor(0.0f, 0.0f, 0.0f, 0.0f);
+};
+
+static FBoneRowColors GetBoneRowColors(const FBoneDisplayInfo& Info)
+{
+	FBoneRowColors Colors;
 	
-	// 양쪽(Side+Fade) = 같은 색, 가운데(Center) = 더 투명
-	// 전체적으로 더 투명하게 (alpha 줄임)
 	if (Info.bIsZeroBone)
 	{
-		TextColor = FLinearColor(1.0f, 0.4f, 0.4f);  // 빨강 (제로본)
-		SideBgColor = FLinearColor(1.0f, 0.3f, 0.3f, 0.12f);   // 양쪽 (같은색)
-		FadeBgColor = FLinearColor(1.0f, 0.3f, 0.3f, 0.12f);   // 페이드도 양쪽과 동일
-		CenterBgColor = FLinearColor(1.0f, 0.3f, 0.3f, 0.03f); // 가운데 더 투명
+		Colors.TextColor = FLinearColor(1.0f, 0.4f, 0.4f);  // 빨강 (제로본)
+		Colors.SideBgColor = FLinearColor(1.0f, 0.3f, 0.3f, 0.12f);
+		Colors.CenterBgColor = FLinearColor(1.0f, 0.3f, 0.3f, 0.03f);
 	}
 	else if (!Info.bHasSkinWeight)
 	{
-		TextColor = FLinearColor(0.4f, 0.4f, 0.4f);  // 진한 회색 (스킨 없음)
-		SideBgColor = FLinearColor(0.3f, 0.3f, 0.3f, 0.08f);
-		FadeBgColor = FLinearColor(0.3f, 0.3f, 0.3f, 0.08f);
-		CenterBgColor = FLinearColor(0.3f, 0.3f, 0.3f, 0.02f);
+		Colors.TextColor = FLinearColor(0.4f, 0.4f, 0.4f);  // 진한 회색 (스킨 없음)
+		Colors.SideBgColor = FLinearColor(0.3f, 0.3f, 0.3f, 0.08f);
+		Colors.CenterBgColor = FLinearColor(0.3f, 0.3f, 0.3f, 0.02f);
 	}
 	else
 	{
@@ -3758,31 +4341,42 @@ TSharedRef<SWidget> SControlRigToolWidget::CreateBoneRow(int32 Index)
 		switch (Info.Classification)
 		{
 		case EBoneClassification::Helper:
-			TextColor = FLinearColor(0.3f, 0.5f, 1.0f);  // 파란색 (Helper/X 선택)
-			SideBgColor = FLinearColor(0.2f, 0.4f, 0.9f, 0.12f);   // 양쪽 같은색
-			FadeBgColor = FLinearColor(0.2f, 0.4f, 0.9f, 0.12f);
-			CenterBgColor = FLinearColor(0.2f, 0.4f, 0.9f, 0.03f); // 가운데 더 투명
+			Colors.TextColor = FLinearColor(0.3f, 0.5f, 1.0f);  // 파란색 (Helper/X 선택)
+			Colors.SideBgColor = FLinearColor(0.2f, 0.4f, 0.9f, 0.12f);
+			Colors.CenterBgColor = FLinearColor(0.2f, 0.4f, 0.9f, 0.03f);
 			break;
 		case EBoneClassification::Secondary:
-			TextColor = FLinearColor(0.2f, 1.0f, 0.2f);  // 형광 초록
-			SideBgColor = FLinearColor(0.1f, 0.8f, 0.1f, 0.12f);
-			FadeBgColor = FLinearColor(0.1f, 0.8f, 0.1f, 0.12f);
-			CenterBgColor = FLinearColor(0.1f, 0.8f, 0.1f, 0.03f);
+			Colors.TextColor = FLinearColor(0.2f, 1.0f, 0.2f);  // 형광 초록
+			Colors.SideBgColor = FLinearColor(0.1f, 0.8f, 0.1f, 0.12f);
+			Colors.CenterBgColor = FLinearColor(0.1f, 0.8f, 0.1f, 0.03f);
 			break;
 		case EBoneClassification::Weapon:
-			TextColor = FLinearColor(1.0f, 0.8f, 0.0f);  // 쨍한 노랑/주황
-			SideBgColor = FLinearColor(0.9f, 0.7f, 0.0f, 0.12f);
-			FadeBgColor = FLinearColor(0.9f, 0.7f, 0.0f, 0.12f);
-			CenterBgColor = FLinearColor(0.9f, 0.7f, 0.0f, 0.03f);
+			Colors.TextColor = FLinearColor(1.0f, 0.8f, 0.0f);  // 쨍한 노랑/주황
+			Colors.SideBgColor = FLinearColor(0.9f, 0.7f, 0.0f, 0.12f);
+			Colors.CenterBgColor = FLinearColor(0.9f, 0.7f, 0.0f, 0.03f);
 			break;
 		default:
-			TextColor = FLinearColor(0.8f, 0.8f, 0.8f);  // 흰색
+			Colors.TextColor = FLinearColor(0.8f, 0.8f, 0.8f);  // 흰색
 			break;
 		}
 	}
+	return Colors;
+}
+
+TSharedRef<SWidget> SControlRigToolWidget::CreateBoneRow(int32 Index)
+{
+	const FBoneDisplayInfo& Info = BoneDisplayList[Index];
 	
-	// RowBgColor는 더 이상 사용 안함
-	RowBgColor = FLinearColor(0.0f, 0.0f, 0.0f, 0.0f);
+	// 행 위젯은 보이는 동안 재사용 → 분류 관련 표시는 모두 람다로 바인딩
+	auto GetRowColors = [this, Index]() -> FBoneRowColors
+	{
+		return BoneDisplayList.IsValidIndex(Index) ? GetBoneRowColors(BoneDisplayList[Index]) : FBoneRowColors();
+	};
+	auto IsClassification = [this, Index](EBoneClassification Classification) -> ECheckBoxState
+	{
+		return BoneDisplayList.IsValidIndex(Index) && BoneDisplayList[Index].Classification == Classification
+			? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+	};
 	
 	// 들여쓰기
 	float Indent = Info.Depth * 12.0f;
@@ -3797,7 +4391,7 @@ TSharedRef<SWidget> SControlRigToolWidget::CreateBoneRow(int32 Index)
 		[
 			SNew(SBorder)
 			.BorderImage(FAppStyle::GetBrush("WhiteBrush"))
-			.BorderBackgroundColor(SideBgColor)
+			.BorderBackgroundColor_Lambda([GetRowColors]() -> FSlateColor { return GetRowColors().SideBgColor; })
 			.Padding(FMargin(0, 2))
 			[
 				SNew(SBox).WidthOverride(FMath::Max(Indent, 0.0f))
@@ -3808,7 +4402,7 @@ TSharedRef<SWidget> SControlRigToolWidget::CreateBoneRow(int32 Index)
 		[
 			SNew(SBorder)
 			.BorderImage(FAppStyle::GetBrush("WhiteBrush"))
-			.BorderBackgroundColor(CenterBgColor)
+			.BorderBackgroundColor_Lambda([GetRowColors]() -> FSlateColor { return GetRowColors().CenterBgColor; })
 			.Padding(FMargin(2, 2))
 			[
 				SNew(SHorizontalBox)
@@ -3817,7 +4411,7 @@ TSharedRef<SWidget> SControlRigToolWidget::CreateBoneRow(int32 Index)
 		[
 			SNew(SCheckBox)
 			.Style(FAppStyle::Get(), "RadioButton")
-			.IsChecked(Info.Classification == EBoneClassification::Helper ? ECheckBoxState::Checked : ECheckBoxState::Unchecked)
+			.IsChecked_Lambda([IsClassification]() { return IsClassification(EBoneClassification::Helper); })
 			.IsEnabled(bCanSelect)
 			.OnCheckStateChanged_Lambda([this, Index](ECheckBoxState NewState) {
 				if (NewState == ECheckBoxState::Checked)
@@ -3837,7 +4431,7 @@ TSharedRef<SWidget> SControlRigToolWidget::CreateBoneRow(int32 Index)
 		[
 			SNew(SCheckBox)
 			.Style(FAppStyle::Get(), "RadioButton")
-			.IsChecked(Info.Classification == EBoneClassification::Secondary ? ECheckBoxState::Checked : ECheckBoxState::Unchecked)
+			.IsChecked_Lambda([IsClassification]() { return IsClassification(EBoneClassification::Secondary); })
 			.IsEnabled(bCanSelect)
 			.OnCheckStateChanged_Lambda([this, Index](ECheckBoxState NewState) {
 				if (NewState == ECheckBoxState::Checked)
@@ -3857,7 +4451,7 @@ TSharedRef<SWidget> SControlRigToolWidget::CreateBoneRow(int32 Index)
 		[
 			SNew(SCheckBox)
 			.Style(FAppStyle::Get(), "RadioButton")
-			.IsChecked(Info.Classification == EBoneClassification::Weapon ? ECheckBoxState::Checked : ECheckBoxState::Unchecked)
+			.IsChecked_Lambda([IsClassification]() { return IsClassification(EBoneClassification::Weapon); })
 			.IsEnabled(bCanSelect)
 			.OnCheckStateChanged_Lambda([this, Index](ECheckBoxState NewState) {
 				if (NewState == ECheckBoxState::Checked)
@@ -3887,7 +4481,7 @@ TSharedRef<SWidget> SControlRigToolWidget::CreateBoneRow(int32 Index)
 				SNew(STextBlock)
 				.Text(FText::FromString(Info.BoneName.ToString()))
 				.Font(FCoreStyle::GetDefaultFontStyle("Regular", 9))
-				.ColorAndOpacity(TextColor)
+				.ColorAndOpacity_Lambda([GetRowColors]() -> FSlateColor { return GetRowColors().TextColor; })
 			]
 		]  // SButton Slot 끝
 		]  // 가운데 SHorizontalBox 끝
@@ -3897,7 +4491,7 @@ TSharedRef<SWidget> SControlRigToolWidget::CreateBoneRow(int32 Index)
 	[
 		SNew(SBorder)
 		.BorderImage(FAppStyle::GetBrush("WhiteBrush"))
-		.BorderBackgroundColor(SideBgColor)
+		.BorderBackgroundColor_Lambda([GetRowColors]() -> FSlateColor { return GetRowColors().SideBgColor; })
 		.Padding(FMargin(0, 2))
 	];  // 전체 SHorizontalBox 끝
 }
@@ -3922,10 +4516,12 @@ void SControlRigToolWidget::OnBoneClassificationChanged(EBoneClassification NewC
 			ClassificationStr = TEXT("helper");
 			break;
 		}
-		SendClassificationFeedback(BoneDisplayList[BoneIndex].BoneName.ToString(), ClassificationStr);
+		QueueClassificationFeedback(BoneDisplayList[BoneIndex].BoneName, ClassificationStr);
+		MarkClassificationDirty(BoneDisplayList[BoneIndex]);
 		
-		// UI 갱신 (라디오 버튼 상태 반영)
-		UpdateBoneSelectionUI();
+		// 통계 갱신 (라디오 버튼/색상은 행 속성 바인딩으로 반영)
+		UpdateBoneSelectionHeader();
+		UpdateWorkflowUI();
 	}
 }
 
@@ -3953,11 +4549,12 @@ void SControlRigToolWidget::OnBoneRowClicked(int32 BoneIndex, const FModifierKey
 			if (!Info.bIsZeroBone && Info.bHasSkinWeight)
 			{
 				Info.Classification = NewClassification;
+				MarkClassificationDirty(Info);
 			}
 		}
 		
-		// UI 갱신
-		UpdateBoneSelectionUI();
+		// 통계 갱신
+		UpdateBoneSelectionHeader();
 	}
 	else
 	{
@@ -3974,25 +4571,31 @@ void SControlRigToolWidget::OnBoneRowClicked(int32 BoneIndex, const FModifierKey
 			ClickedInfo.Classification = EBoneClassification::Helper;
 			break;
 		}
-		UpdateBoneSelectionUI();
+		MarkClassificationDirty(ClickedInfo);
+		UpdateBoneSelectionHeader();
 	}
 	
+	UpdateWorkflowUI();
 	LastSelectedBoneIndex = BoneIndex;
 }
 
 // ============================================================================
 // 사용자 선택 기반 세컨더리 컨트롤러 생성
 // ============================================================================
-void SControlRigToolWidget::CreateSecondaryControlsFromSelection(UControlRigBlueprint* Rig, USkeletalMesh* Mesh)
+bool SControlRigToolWidget::CreateSecondaryControlsFromSelection(FGenerationPipeline& Pipeline, UControlRigBlueprint* Rig, USkeletalMesh* Mesh)
 {
-	if (!Rig || !Mesh) return;
+	if (!Rig || !Mesh) return false;
 	
 	LastSecondaryControlCount = 0;
 	
 	URigHierarchyController* HC = Rig->GetHierarchyController();
 	URigHierarchy* Hierarchy = Rig->Hierarchy;
 	
-	if (!HC || !Hierarchy) return;
+	if (!HC || !Hierarchy)
+	{
+		SetStatus(TEXT("ERROR: Control Rig hierarchy not available"));
+		return false;
+	}
 	
 	const FReferenceSkeleton& RefSkel = Mesh->GetRefSkeleton();
 	
@@ -4015,19 +4618,25 @@ void SControlRigToolWidget::CreateSecondaryControlsFromSelection(UControlRigBlue
 	
 	// Space별로 그룹화
 	TMap<FName, TArray<FName>> ChainsBySpace;
-	for (const FName& BoneName : SelectedBones)
+	const TArray<FName> SpaceParents = FindZeroBoneParents(SelectedBones, Mesh);
+	for (int32 i = 0; i < SelectedBones.Num(); ++i)
 	{
-		FName SpaceParent = FindZeroBoneParent(BoneName, RefSkel);
+		FName SpaceParent = SpaceParents[i];
 		if (SpaceParent.IsNone())
 		{
 			SpaceParent = FName(TEXT("root"));
 		}
-		ChainsBySpace.FindOrAdd(SpaceParent).Add(BoneName);
+		ChainsBySpace.FindOrAdd(SpaceParent).Add(SelectedBones[i]);
 	}
 	
-	// Space 및 Control 생성
+	// Space 및 Control 생성 (계층 알림 없이 일괄 추가, 웨폰 컨트롤까지 같은 스코프)
+	FRigHierarchyBatchEdit Batch(Rig);
+	
 	for (const auto& Pair : ChainsBySpace)
 	{
+		// Space 단위로 취소 확인 (취소 시 호출부 롤백이 추가된 요소 삭제)
+		if (!Pipeline.Tick()) return false;
+		
 		FName SpaceParentName = Pair.Key;
 		const TArray<FName>& ChainBones = Pair.Value;
 		
@@ -4036,19 +4645,7 @@ void SControlRigToolWidget::CreateSecondaryControlsFromSelection(UControlRigBlue
 		FName SpaceFName(*SpaceNameStr);
 		
 		// Space 트랜스폼 (부모 본 위치)
-		FTransform SpaceTransform = FTransform::Identity;
-		
-		// 매핑에서 실제 본 이름 찾기
-		if (const FName* MappedBone = LastBoneMapping.Find(SpaceParentName))
-		{
-			int32 BoneIdx = RefSkel.FindBoneIndex(*MappedBone);
-			if (BoneIdx != INDEX_NONE)
-			{
-				SpaceTransform = RefSkel.GetRefBonePose()[BoneIdx];
-			}
-		}
-		
-		CreateSpaceNull(HC, SpaceFName, SpaceTransform);
+		CreateSpaceNull(HC, SpaceFName, GetSecondarySpaceTransform(SpaceParentName, RefSkel));
 		
 		// 각 본에 컨트롤러 생성
 		CreateChainControls(HC, Hierarchy, SpaceFName, ChainBones, RefSkel);
@@ -4056,11 +4653,35 @@ void SControlRigToolWidget::CreateSecondaryControlsFromSelection(UControlRigBlue
 	
 	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Created %d secondary controls"), LastSecondaryControlCount);
 	
+	// 함수 노드 단계는 템플릿 빈 노드를 지우므로 마지막 취소 지점
+	if (!Pipeline.EnterStage(EGenerationStage::BuildGraph)) return false;
+	
+	// 세컨더리 + 웨폰 함수 노드를 하나의 일괄 편집으로 (VM 컴파일 1회)
+	FRigVMBulkEdit BulkEdit(Rig, Rig->GetController(), TEXT("Create Secondary/Weapon Function Nodes"));
+	
+	// 이후 분류 변경을 증분 반영할 수 있도록 빌드 상태 기록
+	ResetSecondaryBuildState();
+	LastSecondaryBuild.Rig = Rig;
+	LastSecondaryBuild.Mesh = Mesh;
+	LastSecondaryBuild.ChainsBySpace = ChainsBySpace;
+	for (const FBoneDisplayInfo& Info : BoneDisplayList)
+	{
+		if (Info.Classification != EBoneClassification::Helper)
+		{
+			LastSecondaryBuild.Classifications.Add(Info.BoneName, Info.Classification);
+		}
+	}
+	
 	// AI 함수 노드 연결 (AI_Setup, AI_Forward, AI_Backward)
-	ConnectSecondaryFunctionNodes(Rig, ChainsBySpace);
+	if (!ConnectSecondaryFunctionNodes(Rig, ChainsBySpace, &LastSecondaryBuild.Layout))
+	{
+		SetStatus(TEXT("ERROR: Failed to connect secondary function nodes"));
+		return false;
+	}
 	
 	// Weapon 본 처리
 	CreateWeaponControlsFromSelection(Rig, Mesh);
+	return true;
 }
 
 void SControlRigToolWidget::UpdateWorkflowUI()
@@ -4080,8 +4701,9 @@ void SControlRigToolWidget::UpdateWorkflowUI()
 		break;
 		
 	case EControlRigWorkflowStep::Step4_Complete:
+		// 생성 후 분류를 바꿨으면 최종 버튼으로 변경분만 반영
 		if (BodyRigButton.IsValid()) BodyRigButton->SetEnabled(true);
-		if (FinalCreateButton.IsValid()) FinalCreateButton->SetEnabled(false);
+		if (FinalCreateButton.IsValid()) FinalCreateButton->SetEnabled(CanUpdateSecondaryIncrementally() && DirtyClassificationBones.Num() > 0);
 		break;
 	}
 }
@@ -4090,7 +4712,7 @@ void SControlRigToolWidget::UpdateWorkflowUI()
 // RigVM 함수 노드 연결 (AI_Setup, AI_Forward, AI_Backward)
 // 세컨더리 노드: Neck 관련 노드 뒤에 가로(X 방향)로 배치
 // ============================================================================
-void SControlRigToolWidget::ConnectSecondaryFunctionNodes(UControlRigBlueprint* Rig, 
+bool SControlRigToolWidget::ConnectSecondaryFunctionNodes(UControlRigBlueprint* Rig, 
 	const TMap<FName, TArray<FName>>& ChainsBySpace)
 {
 	FString DebugInfo;
@@ -4099,14 +4721,14 @@ void SControlRigToolWidget::ConnectSecondaryFunctionNodes(UControlRigBlueprint*
 	{
 		DebugInfo = TEXT("ERROR: Control Rig Blueprint is NULL!");
 		ShowDebugPopup(TEXT("RigVM Function Node Debug"), DebugInfo);
-		return;
+		return false;
 	}
 	
 	if (ChainsBySpace.Num() == 0)
 	{
 		DebugInfo = TEXT("No secondary bones selected!\n\nChainsBySpace is empty.");
 		ShowDebugPopup(TEXT("RigVM Function Node Debug"), DebugInfo);
-		return;
+		return true;  // 세컨더리 없음 = 연결할 노드 없음 (실패 아님)
 	}
 	
 	TArray<URigVMGraph*> AllGraphs = Rig->GetAllModels();
@@ -4125,7 +4747,7 @@ void SControlRigToolWidget::ConnectSecondaryFunctionNodes(UControlRigBlueprint*
 	{
 		DebugInfo = TEXT("[ERROR] Main graph not found!");
 		ShowDebugPopup(TEXT("RigVM Function Node Debug"), DebugInfo);
-		return;
+		return false;
 	}
 	
 	URigVMController* Controller = Rig->GetController(MainGraph);
@@ -4133,9 +4755,12 @@ void SControlRigToolWidget::ConnectSecondaryFunctionNodes(UControlRigBlueprint*
 	{
 		DebugInfo = TEXT("[ERROR] Controller not found!");
 		ShowDebugPopup(TEXT("RigVM Function Node Debug"), DebugInfo);
-		return;
+		return false;
 	}
 	
+	// 일괄 편집 (알림/자동 재컴파일 중단, 스코프 종료 시 VM 컴파일 1회)
+	FRigVMBulkEdit BulkEdit(Rig, Controller, TEXT("Connect Secondary Function Nodes"));
+	
 	DebugInfo += TEXT("=== Secondary Function Nodes (Neck 뒤) ===\n\n");
 	
 	// 템플릿의 빈 함수 노드 찾기 및 위치 저장 후 삭제
@@ -4147,110 +4772,57 @@ void SControlRigToolWidget::ConnectSecondaryFunctionNodes(UControlRigBlueprint*
 	URigVMNode* NeckForwardPrev = nullptr;
 	URigVMNode* NeckBackwardPrev = nullptr;
 	
-	// 빈 AI_Setup, AI_Forward, AI_Backward 노드 찾아서 위치 저장 및 삭제
+	// 빈 AI_Setup, AI_Forward, AI_Backward 노드 위치 / 앞 노드 (스냅샷 리그면 베이크 때 찾아둔 앵커)
+	const TMap<FString, FControlRigFunctionAnchor> Anchors = (PendingControlRig.Get() == Rig && PendingTemplateSnapshot.IsValid())
+		? PendingTemplateSnapshot->FunctionAnchors
+		: FControlRigTemplateSnapshot::FindFunctionAnchors(MainGraph);
+	
 	TArray<URigVMNode*> NodesToRemove;
-	for (URigVMNode* Node : MainGraph->GetNodes())
+	auto ApplyAnchor = [&](const TCHAR* Kind, FVector2D& OutPos, URigVMNode*& OutPrev)
 	{
-		FString NodeName = Node->GetName();
-		
-		// AI_Setup (정확히 일치하거나 숫자 suffix만 있는 것 - 빈 템플릿 함수)
-		if (NodeName.Equals(TEXT("AI_Setup")) || 
-			(NodeName.StartsWith(TEXT("AI_Setup")) && !NodeName.Contains(TEXT("Weapon"))))
-		{
-			// 이 노드에 연결된 이전 노드 찾기
-			for (URigVMPin* Pin : Node->GetPins())
-			{
-				if (Pin->GetName().Contains(TEXT("Execute")))
-				{
-					for (URigVMLink* Link : Pin->GetLinks())
-					{
-						URigVMPin* OtherPin = Link->GetSourcePin();
-						if (OtherPin && OtherPin->GetNode() != Node)
-						{
-							URigVMNode* PrevNode = OtherPin->GetNode();
-							// Neck 관련 노드인지 확인
-							if (PrevNode->GetName().Contains(TEXT("Neck")) || 
-								PrevNode->GetName().Contains(TEXT("Setup")))
-							{
-								NeckSetupPrev = PrevNode;
-							}
-						}
-					}
-				}
-			}
-			SetupStartPos = Node->GetPosition();
-			NodesToRemove.Add(Node);
-			DebugInfo += FString::Printf(TEXT("Found empty AI_Setup at (%.0f, %.0f)\n"), SetupStartPos.X, SetupStartPos.Y);
-		}
-		
-		// AI_Forward (Weapon 제외)
-		if (NodeName.Equals(TEXT("AI_Forward")) || 
-			(NodeName.StartsWith(TEXT("AI_Forward")) && !NodeName.Contains(TEXT("Weapon"))))
-		{
-			for (URigVMPin* Pin : Node->GetPins())
-			{
-				if (Pin->GetName().Contains(TEXT("Execute")))
-				{
-					for (URigVMLink* Link : Pin->GetLinks())
-					{
-						URigVMPin* OtherPin = Link->GetSourcePin();
-						if (OtherPin && OtherPin->GetNode() != Node)
-						{
-							URigVMNode* PrevNode = OtherPin->GetNode();
-							if (PrevNode->GetName().Contains(TEXT("Neck")) || 
-								PrevNode->GetName().Contains(TEXT("Forward")))
-							{
-								NeckForwardPrev = PrevNode;
-							}
-						}
-					}
-				}
-			}
-			ForwardStartPos = Node->GetPosition();
-			NodesToRemove.Add(Node);
-			DebugInfo += FString::Printf(TEXT("Found empty AI_Forward at (%.0f, %.0f)\n"), ForwardStartPos.X, ForwardStartPos.Y);
-		}
+		const FControlRigFunctionAnchor* Anchor = Anchors.Find(Kind);
+		if (!Anchor) return;
 		
-		// AI_Backward (Weapon 제외)
-		if (NodeName.Equals(TEXT("AI_Backward")) || 
-			(NodeName.StartsWith(TEXT("AI_Backward")) && !NodeName.Contains(TEXT("Weapon"))))
+		OutPos = Anchor->Position;
+		OutPrev = Anchor->PrevNode.IsNone() ? nullptr : MainGraph->FindNodeByName(Anchor->PrevNode);
+		for (const FName& NodeName : Anchor->EmptyNodes)
 		{
-			for (URigVMPin* Pin : Node->GetPins())
+			if (URigVMNode* Node = MainGraph->FindNodeByName(NodeName))
 			{
-				if (Pin->GetName().Contains(TEXT("Execute")))
-				{
-					for (URigVMLink* Link : Pin->GetLinks())
-					{
-						URigVMPin* OtherPin = Link->GetSourcePin();
-						if (OtherPin && OtherPin->GetNode() != Node)
-						{
-							URigVMNode* PrevNode = OtherPin->GetNode();
-							if (PrevNode->GetName().Contains(TEXT("Neck")) || 
-								PrevNode->GetName().Contains(TEXT("Backward")))
-							{
-								NeckBackwardPrev = PrevNode;
-							}
-						}
-					}
-				}
+				NodesToRemove.Add(Node);
 			}
-			BackwardStartPos = Node->GetPosition();
-			NodesToRemove.Add(Node);
-			DebugInfo += FString::Printf(TEXT("Found empty AI_Backward at (%.0f, %.0f)\n"), BackwardStartPos.X, BackwardStartPos.Y);
 		}
-	}
+		DebugInfo += FString::Printf(TEXT("Found empty %s at (%.0f, %.0f)\n"), Kind, OutPos.X, OutPos.Y);
+	};
+	ApplyAnchor(TEXT("AI_Setup"), SetupStartPos, NeckSetupPrev);
+	ApplyAnchor(TEXT("AI_Forward"), ForwardStartPos, NeckForwardPrev);
+	ApplyAnchor(TEXT("AI_Backward"), BackwardStartPos, NeckBackwardPrev);
 	
 	// 빈 노드 삭제
 	for (URigVMNode* Node : NodesToRemove)
 	{
 		DebugInfo += FString::Printf(TEXT("Removing empty node: %s\n"), *Node->GetName());
-		Controller->RemoveNode(Node, false, false);
+		BulkEdit->RemoveNode(Node, false, false);
 	}
 	
 	DebugInfo += TEXT("\n");
 	
 	// 노드 간격 (가로 방향)
-	const float XSpacing = 400.0f;
+	const float XSpacing = FSecondaryFunctionLayout::XSpacing;
+	
+	// 증분 재생성용 배치 기록 (빈 노드 삭제 후에는 시작 위치 / 앞 노드를 다시 찾을 수 없음)
+	if (OutLayout)
+	{
+		*OutLayout = FSecondaryFunctionLayout();
+		OutLayout->bResolved = true;
+		const FVector2D StartPositions[] = { SetupStartPos, ForwardStartPos, BackwardStartPos };
+		const URigVMNode* PrevNodes[] = { NeckSetupPrev, NeckForwardPrev, NeckBackwardPrev };
+		for (int32 Kind = 0; Kind < FSecondaryFunctionLayout::NumKinds; ++Kind)
+		{
+			OutLayout->StartPos[Kind] = StartPositions[Kind];
+			OutLayout->PrevNode[Kind] = PrevNodes[Kind] ? PrevNodes[Kind]->GetFName() : NAME_None;
+		}
+	}
 	
 	float SetupX = SetupStartPos.X;
 	float ForwardX = ForwardStartPos.X;
@@ -4281,70 +4853,85 @@ void SControlRigToolWidget::ConnectSecondaryFunctionNodes(UControlRigBlueprint*
 		
 		DebugInfo += FString::Printf(TEXT("--- Space: %s ---\n"), *SpaceNameStr);
 		
+		// 이 Space에 만든 노드 (종류별, 실패하면 None)
+		TArray<FName> SpaceNodes;
+		SpaceNodes.Init(NAME_None, FSecondaryFunctionLayout::NumKinds);
+		
 		// AI_Setup (가로 배치)
 		{
-			URigVMNode* FuncNode = AddFunctionReferenceNode(Controller, TEXT("AI_Setup"), 
+			URigVMNode* FuncNode = AddFunctionReferenceNode(BulkEdit, TEXT("AI_Setup"), 
 				FVector2D(SetupX + SpaceIndex * XSpacing, SetupStartPos.Y), DebugInfo);
 			if (FuncNode)
 			{
-				SetFunctionNodePins(Controller, FuncNode, ActualBoneName, SpaceName, ChainBones, ControlNames);
+				SetFunctionNodePins(BulkEdit, FuncNode, ActualBoneName, SpaceName, ChainBones, ControlNames);
 				
 				if (LastSetupNode)
 				{
 					// Execute 연결 시도 (여러 핀 이름)
-					bool bLinked = Controller->AddLink(LastSetupNode->GetName() + TEXT(".Execute"), FuncNode->GetName() + TEXT(".Execute"), false);
+					bool bLinked = BulkEdit->AddLink(LastSetupNode->GetName() + TEXT(".Execute"), FuncNode->GetName() + TEXT(".Execute"), false);
 					if (!bLinked)
-						bLinked = Controller->AddLink(LastSetupNode->GetName() + TEXT(".ExecuteContext"), FuncNode->GetName() + TEXT(".ExecuteContext"), false);
+						bLinked = BulkEdit->AddLink(LastSetupNode->GetName() + TEXT(".ExecuteContext"), FuncNode->GetName() + TEXT(".ExecuteContext"), false);
 					DebugInfo += FString::Printf(TEXT("  Setup: %s -> %s (%s)\n"), *LastSetupNode->GetName(), *FuncNode->GetName(), bLinked ? TEXT("OK") : TEXT("FAIL"));
 				}
 				LastSetupNode = FuncNode;
+				SpaceNodes[0] = FuncNode->GetFName();
 			}
 		}
 		
 		// AI_Forward (가로 배치)
 		{
-			URigVMNode* FuncNode = AddFunctionReferenceNode(Controller, TEXT("AI_Forward"), 
+			URigVMNode* FuncNode = AddFunctionReferenceNode(BulkEdit, TEXT("AI_Forward"), 
 				FVector2D(ForwardX + SpaceIndex * XSpacing, ForwardStartPos.Y), DebugInfo);
 			if (FuncNode)
 			{
-				SetFunctionNodePins(Controller, FuncNode, ActualBoneName, SpaceName, ChainBones, ControlNames);
+				SetFunctionNodePins(BulkEdit, FuncNode, ActualBoneName, SpaceName, ChainBones, ControlNames);
 				
 				if (LastForwardNode)
 				{
-					bool bLinked = Controller->AddLink(LastForwardNode->GetName() + TEXT(".Execute"), FuncNode->GetName() + TEXT(".Execute"), false);
+					bool bLinked = BulkEdit->AddLink(LastForwardNode->GetName() + TEXT(".Execute"), FuncNode->GetName() + TEXT(".Execute"), false);
 					if (!bLinked)
-						bLinked = Controller->AddLink(LastForwardNode->GetName() + TEXT(".ExecuteContext"), FuncNode->GetName() + TEXT(".ExecuteContext"), false);
+						bLinked = BulkEdit->AddLink(LastForwardNode->GetName() + TEXT(".ExecuteContext"), FuncNode->GetName() + TEXT(".ExecuteContext"), false);
 					DebugInfo += FString::Printf(TEXT("  Forward: %s -> %s (%s)\n"), *LastForwardNode->GetName(), *FuncNode->GetName(), bLinked ? TEXT("OK") : TEXT("FAIL"));
 				}
 				LastForwardNode = FuncNode;
+				SpaceNodes[1] = FuncNode->GetFName();
 			}
 		}
 		
 		// AI_Backward (가로 배치)
 		{
-			URigVMNode* FuncNode = AddFunctionReferenceNode(Controller, TEXT("AI_Backward"), 
+			URigVMNode* FuncNode = AddFunctionReferenceNode(BulkEdit, TEXT("AI_Backward"), 
 				FVector2D(BackwardX + SpaceIndex * XSpacing, BackwardStartPos.Y), DebugInfo);
 			if (FuncNode)
 			{
-				SetFunctionNodePins(Controller, FuncNode, ActualBoneName, SpaceName, ChainBones, ControlNames);
+				SetFunctionNodePins(BulkEdit, FuncNode, ActualBoneName, SpaceName, ChainBones, ControlNames);
 				
 				if (LastBackwardNode)
 				{
-					bool bLinked = Controller->AddLink(LastBackwardNode->GetName() + TEXT(".Execute"), FuncNode->GetName() + TEXT(".Execute"), false);
+					bool bLinked = BulkEdit->AddLink(LastBackwardNode->GetName() + TEXT(".Execute"), FuncNode->GetName() + TEXT(".Execute"), false);
 					if (!bLinked)
-						bLinked = Controller->AddLink(LastBackwardNode->GetName() + TEXT(".ExecuteContext"), FuncNode->GetName() + TEXT(".ExecuteContext"), false);
+						bLinked = BulkEdit->AddLink(LastBackwardNode->GetName() + TEXT(".ExecuteContext"), FuncNode->GetName() + TEXT(".ExecuteContext"), false);
 					DebugInfo += FString::Printf(TEXT("  Backward: %s -> %s (%s)\n"), *LastBackwardNode->GetName(), *FuncNode->GetName(), bLinked ? TEXT("OK") : TEXT("FAIL"));
 				}
 				LastBackwardNode = FuncNode;
+				SpaceNodes[2] = FuncNode->GetFName();
 			}
 		}
 		
+		if (OutLayout)
+		{
+			OutLayout->SpaceOrder.Add(SpaceParentName);
+			OutLayout->NodesBySpace.Add(SpaceParentName, MoveTemp(SpaceNodes));
+			OutLayout->NextSpaceIndex = SpaceIndex + 1;
+		}
+		
 		SpaceIndex++;
 		DebugInfo += TEXT("\n");
 	}
 	
-	DebugInfo += FString::Printf(TEXT("\n=== Result: %d spaces processed ===\n"), ChainsBySpace.Num());
+	DebugInfo += FString::Printf(TEXT("\n=== Result: %d spaces processed, %d controller operations ===\n"), ChainsBySpace.Num(), BulkEdit.GetOperationCount());
 	ShowDebugPopup(TEXT("Secondary Function Debug"), DebugInfo);
+	return true;
 }
 
 URigVMNode* SControlRigToolWidget::FindLastAIFunctionNode(URigVMGraph* Graph, const FString& FunctionPrefix)
@@ -4371,9 +4958,10 @@ URigVMNode* SControlRigToolWidget::FindLastAIFunctionNode(URigVMGraph* Graph, co
 	return LastNode;
 }
 
-URigVMNode* SControlRigToolWidget::AddFunctionReferenceNode(URigVMController* Controller, 
+URigVMNode* SControlRigToolWidget::AddFunctionReferenceNode(FRigVMBulkEdit& BulkEdit, 
 	const FString& FunctionName, const FVector2D& Position, FString& OutDebugInfo)
 {
+	URigVMController* Controller = BulkEdit.GetController();
 	if (!Controller)
 	{
 		OutDebugInfo += TEXT("    [ERROR] Controller is null!\n");
@@ -4442,7 +5030,7 @@ URigVMNode* SControlRigToolWidget::AddFunctionReferenceNode(URigVMController* Co
 	}
 	
 	// 함수 참조 노드 추가
-	URigVMNode* NewNode = Controller->AddFunctionReferenceNode(
+	URigVMNode* NewNode = BulkEdit->AddFunctionReferenceNode(
 		FunctionNode,
 		Position,
 		FString(),  // 자동 이름
@@ -4459,28 +5047,28 @@ URigVMNode* SControlRigToolWidget::AddFunctionReferenceNode(URigVMController* Co
 	return nullptr;
 }
 
-void SControlRigToolWidget::SetFunctionNodePins(URigVMController* Controller, URigVMNode* FuncNode,
+void SControlRigToolWidget::SetFunctionNodePins(FRigVMBulkEdit& BulkEdit, URigVMNode* FuncNode,
 	const FName& BoneName, const FName& SpaceName, 
 	const TArray<FName>& Bones, const TArray<FName>& Controls)
 {
-	if (!Controller || !FuncNode) return;
+	if (!BulkEdit.GetController() || !FuncNode) return;
 	
 	FString NodeName = FuncNode->GetName();
 	FVector2D NodePos = FuncNode->GetPosition();
 	
 	// bone 핀 설정 (단일 본) - FRigElementKey 형식
 	FString BoneValue = FString::Printf(TEXT("(Type=Bone,Name=\"%s\")"), *BoneName.ToString());
-	Controller->SetPinDefaultValue(NodeName + TEXT(".bone"), BoneValue, true, false, false);
+	BulkEdit->SetPinDefaultValue(NodeName + TEXT(".bone"), BoneValue, true, false, false);
 	
 	// space 핀 설정 (Null) - FRigElementKey 형식
 	FString SpaceValue = FString::Printf(TEXT("(Type=Null,Name=\"%s\")"), *SpaceName.ToString());
-	Controller->SetPinDefaultValue(NodeName + TEXT(".space"), SpaceValue, true, false, false);
+	BulkEdit->SetPinDefaultValue(NodeName + TEXT(".space"), SpaceValue, true, false, false);
 	
 	// ItemArray 노드 (Make Array) 생성 - 함수 노드 하단부에 배치
 	FName ArrayMakeNotation = FRigVMDispatch_ArrayMake().GetTemplateNotation();
 	
 	// Bones ItemArray 생성 (함수 노드 아래)
-	URigVMTemplateNode* BonesArrayNode = Controller->AddTemplateNode(
+	URigVMTemplateNode* BonesArrayNode = BulkEdit->AddTemplateNode(
 		ArrayMakeNotation,
 		FVector2D(NodePos.X - 100.0f, NodePos.Y + 180.0f),
 		FString(),
@@ -4492,23 +5080,20 @@ void SControlRigToolWidget::SetFunctionNodePins(URigVMController* Controller, UR
 		FString ArrayNodeName = BonesArrayNode->GetName();
 		FString ValuesPath = ArrayNodeName + TEXT(".Values");
 		
-		Controller->AddLink(
+		BulkEdit->AddLink(
 			ArrayNodeName + TEXT(".Array"),
 			NodeName + TEXT(".bones"),
 			false
 		);
 		
-		for (int32 i = 0; i < Bones.Num(); ++i)
-		{
-			FString BoneElementValue = FString::Printf(TEXT("(Type=Bone,Name=\"%s\")"), *Bones[i].ToString());
-			Controller->InsertArrayPin(ValuesPath, i, BoneElementValue, false, false);
-		}
+		// 배열 전체를 한 번에 설정
+		BulkEdit.SetArrayPinDefaultValue(ValuesPath, FRigVMBulkEdit::MakeElementKeys(TEXT("Bone"), Bones));
 		
-		Controller->SetPinExpansion(ValuesPath, false, false);
+		BulkEdit->SetPinExpansion(ValuesPath, false, false);
 	}
 	
 	// Ctrls ItemArray 생성 (Bones 아래)
-	URigVMTemplateNode* CtrlsArrayNode = Controller->AddTemplateNode(
+	URigVMTemplateNode* CtrlsArrayNode = BulkEdit->AddTemplateNode(
 		ArrayMakeNotation,
 		FVector2D(NodePos.X - 100.0f, NodePos.Y + 280.0f),
 		FString(),
@@ -4520,25 +5105,76 @@ void SControlRigToolWidget::SetFunctionNodePins(URigVMController* Controller, UR
 		FString ArrayNodeName = CtrlsArrayNode->GetName();
 		FString ValuesPath = ArrayNodeName + TEXT(".Values");
 		
-		Controller->AddLink(
+		BulkEdit->AddLink(
 			ArrayNodeName + TEXT(".Array"),
 			NodeName + TEXT(".ctrls"),
 			false
 		);
 		
-		for (int32 i = 0; i < Controls.Num(); ++i)
-		{
-			FString CtrlElementValue = FString::Printf(TEXT("(Type=Control,Name=\"%s\")"), *Controls[i].ToString());
-			Controller->InsertArrayPin(ValuesPath, i, CtrlElementValue, false, false);
-		}
+		BulkEdit.SetArrayPinDefaultValue(ValuesPath, FRigVMBulkEdit::MakeElementKeys(TEXT("Control"), Controls));
 		
-		Controller->SetPinExpansion(ValuesPath, false, false);
+		BulkEdit->SetPinExpansion(ValuesPath, false, false);
 	}
 	
 	UE_LOG(LogTemp, Log, TEXT("    Set pins for %s: bone=%s, space=%s, %d bones, %d ctrls"),
 		*NodeName, *BoneName.ToString(), *SpaceName.ToString(), Bones.Num(), Controls.Num());
 }
 
+// ============================================================================
+// 증분 재생성용 함수 노드 편집
+// ============================================================================
+bool SControlRigToolWidget::PatchFunctionNodeArrays(FRigVMBulkEdit& BulkEdit, URigVMGraph* Graph, const FName& NodeName,
+	const TArray<FName>& Bones, const TArray<FName>& Controls)
+{
+	URigVMNode* FuncNode = Graph ? Graph->FindNodeByName(NodeName) : nullptr;
+	if (!FuncNode) return false;
+	
+	// bones / ctrls 핀에 연결된 Make Array 노드의 Values만 교체 (노드 / 링크는 그대로)
+	auto PatchArray = [&BulkEdit, FuncNode](const TCHAR* PinName, const TCHAR* ElementType, const TArray<FName>& Names)
+	{
+		const URigVMPin* Pin = FuncNode->FindPin(PinName);
+		const TArray<URigVMPin*> Sources = Pin ? Pin->GetLinkedSourcePins() : TArray<URigVMPin*>();
+		if (Sources.Num() == 0) return false;
+		
+		return BulkEdit.SetArrayPinDefaultValue(Sources[0]->GetNode()->GetName() + TEXT(".Values"),
+			FRigVMBulkEdit::MakeElementKeys(ElementType, Names));
+	};
+	
+	return PatchArray(TEXT("bones"), TEXT("Bone"), Bones) && PatchArray(TEXT("ctrls"), TEXT("Control"), Controls);
+}
+
+void SControlRigToolWidget::RemoveFunctionNodeWithArrays(FRigVMBulkEdit& BulkEdit, URigVMGraph* Graph, const FName& NodeName)
+{
+	URigVMNode* FuncNode = Graph ? Graph->FindNodeByName(NodeName) : nullptr;
+	if (!FuncNode) return;
+	
+	// SetFunctionNodePins가 만든 Make Array 노드도 같이 삭제
+	TArray<URigVMNode*> NodesToRemove;
+	for (const TCHAR* PinName : { TEXT("bones"), TEXT("ctrls") })
+	{
+		if (const URigVMPin* Pin = FuncNode->FindPin(PinName))
+		{
+			for (URigVMPin* Source : Pin->GetLinkedSourcePins())
+			{
+				NodesToRemove.AddUnique(Source->GetNode());
+			}
+		}
+	}
+	NodesToRemove.Add(FuncNode);
+	
+	for (URigVMNode* Node : NodesToRemove)
+	{
+		BulkEdit->RemoveNode(Node, false, false);
+	}
+}
+
+bool SControlRigToolWidget::LinkExecutePins(FRigVMBulkEdit& BulkEdit, const FString& FromNode, const FString& ToNode)
+{
+	// 함수마다 Execute 핀 이름이 다름 (Execute / ExecuteContext)
+	return BulkEdit->AddLink(FromNode + TEXT(".Execute"), ToNode + TEXT(".Execute"), false)
+		|| BulkEdit->AddLink(FromNode + TEXT(".ExecuteContext"), ToNode + TEXT(".ExecuteContext"), false);
+}
+
 // ============================================================================
 // Weapon 본 처리 함수들
 // ============================================================================
@@ -4551,8 +5187,6 @@ void SControlRigToolWidget::CreateWeaponControlsFromSelection(UControlRigBluepri
 	
 	if (!HC || !Hierarchy) return;
 	
-	const FReferenceSkeleton& RefSkel = Mesh->GetRefSkeleton();
-	
 	// Weapon 본 수집 (L/R 구분)
 	TArray<FName> WeaponBonesL, WeaponBonesR;
 	
@@ -4583,23 +5217,28 @@ void SControlRigToolWidget::CreateWeaponControlsFromSelection(UControlRigBluepri
 	
 	UE_LOG(LogTemp, Log, TEXT("[ControlRigTool] Weapon bones - L: %d, R: %d"), WeaponBonesL.Num(), WeaponBonesR.Num());
 	
+	// Space / Control 추가는 계층 알림 없이 (세컨더리 스코프 안이면 합류)
+	FRigHierarchyBatchEdit Batch(Rig);
+	
 	// Weapon L 처리
 	if (WeaponBonesL.Num() > 0)
 	{
-		CreateWeaponSpaceAndControls(HC, Hierarchy, true, WeaponBonesL, RefSkel);
+		CreateWeaponSpaceAndControls(HC, Hierarchy, true, WeaponBonesL, Mesh);
 	}
 	
 	// Weapon R 처리
 	if (WeaponBonesR.Num() > 0)
 	{
-		CreateWeaponSpaceAndControls(HC, Hierarchy, false, WeaponBonesR, RefSkel);
+		CreateWeaponSpaceAndControls(HC, Hierarchy, false, WeaponBonesR, Mesh);
 	}
 }
 
 void SControlRigToolWidget::CreateWeaponSpaceAndControls(URigHierarchyController* HC, URigHierarchy* Hierarchy,
-	bool bIsLeft, const TArray<FName>& WeaponBones, const FReferenceSkeleton& RefSkel)
+	bool bIsLeft, const TArray<FName>& WeaponBones, USkeletalMesh* Mesh)
 {
-	if (!HC || !Hierarchy || WeaponBones.Num() == 0) return;
+	if (!HC || !Hierarchy || !Mesh || WeaponBones.Num() == 0) return;
+	
+	const FReferenceSkeleton& RefSkel = Mesh->GetRefSkeleton();
 	
 	// Space 이름: Weapon_l_space 또는 Weapon_r_space
 	FString SpaceNameStr = bIsLeft ? TEXT("Weapon_l_space") : TEXT("Weapon_r_space");
@@ -4624,29 +5263,22 @@ void SControlRigToolWidget::CreateWeaponSpaceAndControls(URigHierarchyController
 	}
 	
 	// 본들을 계층 순서로 정렬
+	const FSkeletonTopology& Topology = GetSkeletonTopology(Mesh);
 	TArray<FName> SortedBones = WeaponBones;
-	SortedBones.Sort([&RefSkel](const FName& A, const FName& B) {
-		return RefSkel.FindBoneIndex(A) < RefSkel.FindBoneIndex(B);
+	SortedBones.Sort([&Topology](const FName& A, const FName& B) {
+		return Topology.FindBoneIndex(A) < Topology.FindBoneIndex(B);
 	});
 	
 	// ========== 무기 전체 버텍스 바운딩 박스 계산 ==========
-	// 모든 웨폰 본의 버텍스를 합쳐서 무기 전체 크기 계산
-	TArray<FBoneVertInfo> BoneVertInfos;
-	FString MeshPath = GetSelectedMeshPath();
-	USkeletalMesh* Mesh = Cast<USkeletalMesh>(StaticLoadObject(USkeletalMesh::StaticClass(), nullptr, *MeshPath));
-	if (Mesh)
-	{
-		FMeshUtilitiesEngine::CalcBoneVertInfos(Mesh, BoneVertInfos, true);
-	}
+	// 모든 웨폰 본의 버텍스 바운드를 합쳐서 무기 전체 크기 계산 (L/R 모두 같은 캐시 사용)
+	const TSharedRef<const FMeshVertexAnalysis> VertexAnalysis = FBoneVertexAnalysisCache::Get().GetAnalysis(Mesh);
 	
 	FBox TotalWeaponBox(ForceInit);
 	for (const FName& BoneName : SortedBones)
 	{
 		int32 BoneIdx = RefSkel.FindBoneIndex(BoneName);
-		if (BoneIdx != INDEX_NONE && BoneIdx < BoneVertInfos.Num())
+		if (const FBoneVertexStats* Stats = VertexAnalysis->GetBone(BoneIdx))
 		{
-			const FBoneVertInfo& Info = BoneVertInfos[BoneIdx];
-			
 			// 본의 월드 트랜스폼 가져오기
 			FTransform BoneTransform = FTransform::Identity;
 			if (BoneIdx < RefSkel.GetRefBonePose().Num())
@@ -4654,12 +5286,8 @@ void SControlRigToolWidget::CreateWeaponSpaceAndControls(URigHierarchyController
 				BoneTransform = RefSkel.GetRefBonePose()[BoneIdx];
 			}
 			
-			for (const FVector3f& LocalPos : Info.Positions)
-			{
-				// 로컬 → 월드 변환 (대략적)
-				FVector WorldPos = BoneTransform.TransformPosition(FVector(LocalPos));
-				TotalWeaponBox += WorldPos;
-			}
+			// 로컬 바운드 → 월드 변환 (대략적, 8개 꼭짓점 기준)
+			TotalWeaponBox += Stats->Bounds.TransformBy(BoneTransform);
 		}
 	}
 	
@@ -4825,6 +5453,9 @@ void SControlRigToolWidget::ConnectWeaponFunctionNodes(UControlRigBlueprint* Rig
 		return;
 	}
 	
+	// 일괄 편집 (세컨더리 생성 중이면 바깥 스코프에 합류)
+	FRigVMBulkEdit BulkEdit(Rig, Controller, bIsLeft ? TEXT("Connect Weapon_l Function Nodes") : TEXT("Connect Weapon_r Function Nodes"));
+	
 	// Hand 본 이름
 	FName HandBoneName = bIsLeft ? FName(TEXT("hand_l")) : FName(TEXT("hand_r"));
 	FName ActualHandBone = LastBoneMapping.FindRef(HandBoneName);
@@ -4937,7 +5568,7 @@ void SControlRigToolWidget::ConnectWeaponFunctionNodes(UControlRigBlueprint* Rig
 		for (URigVMNode* Node : NodesToRemove)
 		{
 			DebugInfo += FString::Printf(TEXT("Removing: %s\n"), *Node->GetName());
-			Controller->RemoveNode(Node, false, false);
+			BulkEdit->RemoveNode(Node, false, false);
 		}
 	}
 	
@@ -4990,50 +5621,46 @@ void SControlRigToolWidget::ConnectWeaponFunctionNodes(UControlRigBlueprint* Rig
 	DebugInfo += FString::Printf(TEXT("Last ctrl (for GetBool): %s\n\n"), *LastCtrlName);
 	
 	// Execute 연결 헬퍼
-	auto TryLink = [Controller](URigVMNode* From, URigVMNode* To, FString& Dbg) -> bool {
+	auto TryLink = [&BulkEdit](URigVMNode* From, URigVMNode* To, FString& Dbg) -> bool {
 		if (!From || !To) return false;
-		bool ok = Controller->AddLink(From->GetName() + TEXT(".Execute"), To->GetName() + TEXT(".Execute"), false);
-		if (!ok) ok = Controller->AddLink(From->GetName() + TEXT(".ExecuteContext"), To->GetName() + TEXT(".ExecuteContext"), false);
+		bool ok = BulkEdit->AddLink(From->GetName() + TEXT(".Execute"), To->GetName() + TEXT(".Execute"), false);
+		if (!ok) ok = BulkEdit->AddLink(From->GetName() + TEXT(".ExecuteContext"), To->GetName() + TEXT(".ExecuteContext"), false);
 		Dbg += FString::Printf(TEXT("  Link: %s -> %s (%s)\n"), *From->GetName(), *To->GetName(), ok ? TEXT("OK") : TEXT("FAIL"));
 		return ok;
 	};
 	
 	// AI_Setup_Weapon
-	URigVMNode* SetupNode = AddFunctionReferenceNode(Controller, TEXT("AI_Setup_Weapon"), 
+	URigVMNode* SetupNode = AddFunctionReferenceNode(BulkEdit, TEXT("AI_Setup_Weapon"), 
 		FVector2D(SetupX, SetupStartPos.Y), DebugInfo);
 	if (SetupNode)
 	{
 		FString NodeName = SetupNode->GetName();
 		FVector2D NodePos = SetupNode->GetPosition();
 		
-		Controller->SetPinDefaultValue(NodeName + TEXT(".Handbone"), 
+		BulkEdit->SetPinDefaultValue(NodeName + TEXT(".Handbone"), 
 			FString::Printf(TEXT("(Type=Bone,Name=\"%s\")"), *ActualHandBone.ToString()), true, false, false);
-		Controller->SetPinDefaultValue(NodeName + TEXT(".Wp_space"), 
+		BulkEdit->SetPinDefaultValue(NodeName + TEXT(".Wp_space"), 
 			FString::Printf(TEXT("(Type=Null,Name=\"%s\")"), *WeaponSpaceName.ToString()), true, false, false);
 		
 		FName ArrayMakeNotation = FRigVMDispatch_ArrayMake().GetTemplateNotation();
 		
 		// 함수 노드 하단부에 배치
-		URigVMTemplateNode* BonesArr = Controller->AddTemplateNode(ArrayMakeNotation, 
+		URigVMTemplateNode* BonesArr = BulkEdit->AddTemplateNode(ArrayMakeNotation, 
 			FVector2D(NodePos.X - 80.0f, NodePos.Y + 160.0f), FString(), false, false);
 		if (BonesArr)
 		{
-			Controller->AddLink(BonesArr->GetName() + TEXT(".Array"), NodeName + TEXT(".Bone"), false);
-			for (int32 i = 0; i < WeaponBones.Num(); ++i)
-				Controller->InsertArrayPin(BonesArr->GetName() + TEXT(".Values"), i, 
-					FString::Printf(TEXT("(Type=Bone,Name=\"%s\")"), *WeaponBones[i].ToString()), false, false);
-			Controller->SetPinExpansion(BonesArr->GetName() + TEXT(".Values"), false, false);
+			BulkEdit->AddLink(BonesArr->GetName() + TEXT(".Array"), NodeName + TEXT(".Bone"), false);
+			BulkEdit.SetArrayPinDefaultValue(BonesArr->GetName() + TEXT(".Values"), FRigVMBulkEdit::MakeElementKeys(TEXT("Bone"), WeaponBones));
+			BulkEdit->SetPinExpansion(BonesArr->GetName() + TEXT(".Values"), false, false);
 		}
 		
-		URigVMTemplateNode* CtrlsArr = Controller->AddTemplateNode(ArrayMakeNotation, 
+		URigVMTemplateNode* CtrlsArr = BulkEdit->AddTemplateNode(ArrayMakeNotation, 
 			FVector2D(NodePos.X - 80.0f, NodePos.Y + 260.0f), FString(), false, false);
 		if (CtrlsArr)
 		{
-			Controller->AddLink(CtrlsArr->GetName() + TEXT(".Array"), NodeName + TEXT(".Ctrl"), false);
-			for (int32 i = 0; i < WeaponCtrls.Num(); ++i)
-				Controller->InsertArrayPin(CtrlsArr->GetName() + TEXT(".Values"), i, 
-					FString::Printf(TEXT("(Type=Control,Name=\"%s\")"), *WeaponCtrls[i].ToString()), false, false);
-			Controller->SetPinExpansion(CtrlsArr->GetName() + TEXT(".Values"), false, false);
+			BulkEdit->AddLink(CtrlsArr->GetName() + TEXT(".Array"), NodeName + TEXT(".Ctrl"), false);
+			BulkEdit.SetArrayPinDefaultValue(CtrlsArr->GetName() + TEXT(".Values"), FRigVMBulkEdit::MakeElementKeys(TEXT("Control"), WeaponCtrls));
+			BulkEdit->SetPinExpansion(CtrlsArr->GetName() + TEXT(".Values"), false, false);
 		}
 		
 		URigVMNode* PrevNode = bIsLeft ? FingerSetupPrev : PrevWeaponSetup;
@@ -5043,42 +5670,38 @@ void SControlRigToolWidget::ConnectWeaponFunctionNodes(UControlRigBlueprint* Rig
 	}
 	
 	// AI_Forward_Weapon
-	URigVMNode* ForwardNode = AddFunctionReferenceNode(Controller, TEXT("AI_Forward_Weapon"), 
+	URigVMNode* ForwardNode = AddFunctionReferenceNode(BulkEdit, TEXT("AI_Forward_Weapon"), 
 		FVector2D(ForwardX, ForwardStartPos.Y), DebugInfo);
 	if (ForwardNode)
 	{
 		FString NodeName = ForwardNode->GetName();
 		FVector2D NodePos = ForwardNode->GetPosition();
 		
-		Controller->SetPinDefaultValue(NodeName + TEXT(".handbone"), 
+		BulkEdit->SetPinDefaultValue(NodeName + TEXT(".handbone"), 
 			FString::Printf(TEXT("(Type=Bone,Name=\"%s\")"), *ActualHandBone.ToString()), true, false, false);
-		Controller->SetPinDefaultValue(NodeName + TEXT(".rootbone"), TEXT("(Type=Bone,Name=\"Root\")"), true, false, false);
-		Controller->SetPinDefaultValue(NodeName + TEXT(".wp_space"), 
+		BulkEdit->SetPinDefaultValue(NodeName + TEXT(".rootbone"), TEXT("(Type=Bone,Name=\"Root\")"), true, false, false);
+		BulkEdit->SetPinDefaultValue(NodeName + TEXT(".wp_space"), 
 			FString::Printf(TEXT("(Type=Null,Name=\"%s\")"), *WeaponSpaceName.ToString()), true, false, false);
 		
 		FName ArrayMakeNotation = FRigVMDispatch_ArrayMake().GetTemplateNotation();
 		
 		// 함수 노드 하단부에 배치
-		URigVMTemplateNode* BonesArr = Controller->AddTemplateNode(ArrayMakeNotation, 
+		URigVMTemplateNode* BonesArr = BulkEdit->AddTemplateNode(ArrayMakeNotation, 
 			FVector2D(NodePos.X - 80.0f, NodePos.Y + 200.0f), FString(), false, false);
 		if (BonesArr)
 		{
-			Controller->AddLink(BonesArr->GetName() + TEXT(".Array"), NodeName + TEXT(".bone"), false);
-			for (int32 i = 0; i < WeaponBones.Num(); ++i)
-				Controller->InsertArrayPin(BonesArr->GetName() + TEXT(".Values"), i, 
-					FString::Printf(TEXT("(Type=Bone,Name=\"%s\")"), *WeaponBones[i].ToString()), false, false);
-			Controller->SetPinExpansion(BonesArr->GetName() + TEXT(".Values"), false, false);
+			BulkEdit->AddLink(BonesArr->GetName() + TEXT(".Array"), NodeName + TEXT(".bone"), false);
+			BulkEdit.SetArrayPinDefaultValue(BonesArr->GetName() + TEXT(".Values"), FRigVMBulkEdit::MakeElementKeys(TEXT("Bone"), WeaponBones));
+			BulkEdit->SetPinExpansion(BonesArr->GetName() + TEXT(".Values"), false, false);
 		}
 		
-		URigVMTemplateNode* CtrlsArr = Controller->AddTemplateNode(ArrayMakeNotation, 
+		URigVMTemplateNode* CtrlsArr = BulkEdit->AddTemplateNode(ArrayMakeNotation, 
 			FVector2D(NodePos.X - 80.0f, NodePos.Y + 300.0f), FString(), false, false);
 		if (CtrlsArr)
 		{
-			Controller->AddLink(CtrlsArr->GetName() + TEXT(".Array"), NodeName + TEXT(".ctrl"), false);
-			for (int32 i = 0; i < WeaponCtrls.Num(); ++i)
-				Controller->InsertArrayPin(CtrlsArr->GetName() + TEXT(".Values"), i, 
-					FString::Printf(TEXT("(Type=Control,Name=\"%s\")"), *WeaponCtrls[i].ToString()), false, false);
-			Controller->SetPinExpansion(CtrlsArr->GetName() + TEXT(".Values"), false, false);
+			BulkEdit->AddLink(CtrlsArr->GetName() + TEXT(".Array"), NodeName + TEXT(".ctrl"), false);
+			BulkEdit.SetArrayPinDefaultValue(CtrlsArr->GetName() + TEXT(".Values"), FRigVMBulkEdit::MakeElementKeys(TEXT("Control"), WeaponCtrls));
+			BulkEdit->SetPinExpansion(CtrlsArr->GetName() + TEXT(".Values"), false, false);
 		}
 		
 		// Get Bool Channel (체인의 마지막 컨트롤러 사용)
@@ -5088,14 +5711,14 @@ void SControlRigToolWidget::ConnectWeaponFunctionNodes(UControlRigBlueprint* Rig
 		
 		if (GetBoolStruct && !LastCtrlName.Equals(TEXT("None")))
 		{
-			URigVMNode* GetBoolNode = Controller->AddUnitNode(GetBoolStruct, TEXT("Execute"),
+			URigVMNode* GetBoolNode = BulkEdit->AddUnitNode(GetBoolStruct, TEXT("Execute"),
 				FVector2D(NodePos.X - 150.0f, NodePos.Y + 420.0f), FString(), false, false);
 			if (GetBoolNode)
 			{
 				// Control 핀: FName 타입이므로 이름만 설정 (FRigElementKey 형식 아님)
-				Controller->SetPinDefaultValue(GetBoolNode->GetName() + TEXT(".Control"), LastCtrlName, true, false, false);
-				Controller->SetPinDefaultValue(GetBoolNode->GetName() + TEXT(".Channel"), TEXT("world"), true, false, false);
-				Controller->AddLink(GetBoolNode->GetName() + TEXT(".Value"), NodeName + TEXT(".world"), false);
+				BulkEdit->SetPinDefaultValue(GetBoolNode->GetName() + TEXT(".Control"), LastCtrlName, true, false, false);
+				BulkEdit->SetPinDefaultValue(GetBoolNode->GetName() + TEXT(".Channel"), TEXT("world"), true, false, false);
+				BulkEdit->AddLink(GetBoolNode->GetName() + TEXT(".Value"), NodeName + TEXT(".world"), false);
 				DebugInfo += FString::Printf(TEXT("  GetBool: Control=%s, Channel=world\n"), *LastCtrlName);
 			}
 		}
@@ -5107,41 +5730,37 @@ void SControlRigToolWidget::ConnectWeaponFunctionNodes(UControlRigBlueprint* Rig
 	}
 	
 	// AI_Backward_Weapon
-	URigVMNode* BackwardNode = AddFunctionReferenceNode(Controller, TEXT("AI_Backward_Weapon"), 
+	URigVMNode* BackwardNode = AddFunctionReferenceNode(BulkEdit, TEXT("AI_Backward_Weapon"), 
 		FVector2D(BackwardX, BackwardStartPos.Y), DebugInfo);
 	if (BackwardNode)
 	{
 		FString NodeName = BackwardNode->GetName();
 		FVector2D NodePos = BackwardNode->GetPosition();
 		
-		Controller->SetPinDefaultValue(NodeName + TEXT(".handbone"), 
+		BulkEdit->SetPinDefaultValue(NodeName + TEXT(".handbone"), 
 			FString::Printf(TEXT("(Type=Bone,Name=\"%s\")"), *ActualHandBone.ToString()), true, false, false);
-		Controller->SetPinDefaultValue(NodeName + TEXT(".wp_space"), 
+		BulkEdit->SetPinDefaultValue(NodeName + TEXT(".wp_space"), 
 			FString::Printf(TEXT("(Type=Null,Name=\"%s\")"), *WeaponSpaceName.ToString()), true, false, false);
 		
 		FName ArrayMakeNotation = FRigVMDispatch_ArrayMake().GetTemplateNotation();
 		
 		// 함수 노드 하단부에 배치
-		URigVMTemplateNode* BonesArr = Controller->AddTemplateNode(ArrayMakeNotation, 
+		URigVMTemplateNode* BonesArr = BulkEdit->AddTemplateNode(ArrayMakeNotation, 
 			FVector2D(NodePos.X - 80.0f, NodePos.Y + 160.0f), FString(), false, false);
 		if (BonesArr)
 		{
-			Controller->AddLink(BonesArr->GetName() + TEXT(".Array"), NodeName + TEXT(".bones"), false);
-			for (int32 i = 0; i < WeaponBones.Num(); ++i)
-				Controller->InsertArrayPin(BonesArr->GetName() + TEXT(".Values"), i, 
-					FString::Printf(TEXT("(Type=Bone,Name=\"%s\")"), *WeaponBones[i].ToString()), false, false);
-			Controller->SetPinExpansion(BonesArr->GetName() + TEXT(".Values"), false, false);
+			BulkEdit->AddLink(BonesArr->GetName() + TEXT(".Array"), NodeName + TEXT(".bones"), false);
+			BulkEdit.SetArrayPinDefaultValue(BonesArr->GetName() + TEXT(".Values"), FRigVMBulkEdit::MakeElementKeys(TEXT("Bone"), WeaponBones));
+			BulkEdit->SetPinExpansion(BonesArr->GetName() + TEXT(".Values"), false, false);
 		}
 		
-		URigVMTemplateNode* CtrlsArr = Controller->AddTemplateNode(ArrayMakeNotation, 
+		URigVMTemplateNode* CtrlsArr = BulkEdit->AddTemplateNode(ArrayMakeNotation, 
 			FVector2D(NodePos.X - 80.0f, NodePos.Y + 260.0f), FString(), false, false);
 		if (CtrlsArr)
 		{
-			Controller->AddLink(CtrlsArr->GetName() + TEXT(".Array"), NodeName + TEXT(".ctrls"), false);
-			for (int32 i = 0; i < WeaponCtrls.Num(); ++i)
-				Controller->InsertArrayPin(CtrlsArr->GetName() + TEXT(".Values"), i, 
-					FString::Printf(TEXT("(Type=Control,Name=\"%s\")"), *WeaponCtrls[i].ToString()), false, false);
-			Controller->SetPinExpansion(CtrlsArr->GetName() + TEXT(".Values"), false, false);
+			BulkEdit->AddLink(CtrlsArr->GetName() + TEXT(".Array"), NodeName + TEXT(".ctrls"), false);
+			BulkEdit.SetArrayPinDefaultValue(CtrlsArr->GetName() + TEXT(".Values"), FRigVMBulkEdit::MakeElementKeys(TEXT("Control"), WeaponCtrls));
+			BulkEdit->SetPinExpansion(CtrlsArr->GetName() + TEXT(".Values"), false, false);
 		}
 		
 		URigVMNode* PrevNode = bIsLeft ? FingerBackwardPrev : PrevWeaponBackward;
@@ -5150,7 +5769,7 @@ void SControlRigToolWidget::ConnectWeaponFunctionNodes(UControlRigBlueprint* Rig
 		DebugInfo += FString::Printf(TEXT("Created AI_Backward_Weapon at (%.0f, %.0f)\n"), NodePos.X, NodePos.Y);
 	}
 	
-	DebugInfo += TEXT("\n=== Complete ===\n");
+	DebugInfo += FString::Printf(TEXT("\n=== Complete: %d controller operations ===\n"), BulkEdit.GetOperationCount());
 	ShowDebugPopup(TEXT("Weapon Function Debug"), DebugInfo);
 }
 
@@ -5164,9 +5783,8 @@ void SControlRigToolWidget::CalculateBoneShapeInfos(USkeletalMesh* Mesh)
 	
 	if (!Mesh) return;
 	
-	// 본별 버텍스 정보 계산
-	TArray<FBoneVertInfo> BoneVertInfos;
-	FMeshUtilitiesEngine::CalcBoneVertInfos(Mesh, BoneVertInfos, true);
+	// 본별 버텍스 통계 (메쉬별 캐시 - 웨폰 박스 / Physics Asset과 공유)
+	const TSharedRef<const FMeshVertexAnalysis> VertexAnalysis = FBoneVertexAnalysisCache::Get().GetAnalysis(Mesh);
 	
 	const FReferenceSkeleton& RefSkel = Mesh->GetRefSkeleton();
 	
@@ -5184,7 +5802,8 @@ void SControlRigToolWidget::CalculateBoneShapeInfos(USkeletalMesh* Mesh)
 		FName BoneName = RefSkel.GetBoneName(BoneIdx);
 		FBoneShapeInfo ShapeInfo;
 		
-		if (BoneIdx >= BoneVertInfos.Num() || BoneVertInfos[BoneIdx].Positions.Num() == 0)
+		const FBoneVertexStats* Stats = VertexAnalysis->GetBone(BoneIdx);
+		if (!Stats)
 		{
 			// 버텍스 없음 (스킨 웨이트 없는 본) - 기본값
 			ShapeInfo.Scale = FVector(0.3f, 0.3f, 0.3f);
@@ -5194,54 +5813,18 @@ void SControlRigToolWidget::CalculateBoneShapeInfos(USkeletalMesh* Mesh)
 			continue;
 		}
 		
-		const FBoneVertInfo& Info = BoneVertInfos[BoneIdx];
-		
-		// 버텍스들의 중심 계산 (본 로컬 스페이스)
-		FVector VertexCenter = FVector::ZeroVector;
-		for (const FVector3f& Pos : Info.Positions)
-		{
-			VertexCenter += FVector(Pos);
-		}
-		VertexCenter /= Info.Positions.Num();
-		
-		// 버텍스 노멀 평균 계산 (메쉬 표면의 바깥 방향)
-		FVector AverageNormal = FVector::ZeroVector;
-		if (Info.Normals.Num() > 0)
-		{
-			for (const FVector3f& Normal : Info.Normals)
-			{
-				AverageNormal += FVector(Normal);
-			}
-			AverageNormal.Normalize();
-		}
-		else
-		{
-			// 노멀이 없으면 Z축 사용
-			AverageNormal = FVector(0.0f, 0.0f, 1.0f);
-		}
-		ShapeInfo.AverageNormal = AverageNormal;
+		// 버텍스들의 중심 (본 로컬 스페이스)
+		const FVector VertexCenter = Stats->Centroid;
 		
-		// 버텍스들의 바운딩 박스 계산
-		FBox BoneBox(ForceInit);
-		float MaxDistFromCenter = 0.0f;
-		FVector FurthestDirection = FVector::ZeroVector;
+		// 버텍스 노멀 평균 (메쉬 표면의 바깥 방향, 노멀이 없으면 Z축)
+		ShapeInfo.AverageNormal = Stats->MeanNormal;
 		
-		for (const FVector3f& Pos : Info.Positions)
-		{
-			FVector VPos(Pos);
-			BoneBox += VPos;
-			
-			// 본 원점에서 가장 먼 버텍스 방향 찾기
-			float Dist = VPos.Size();
-			if (Dist > MaxDistFromCenter)
-			{
-				MaxDistFromCenter = Dist;
-				FurthestDirection = VPos.GetSafeNormal();
-			}
-		}
+		// 본 원점에서 가장 먼 버텍스 방향
+		const float MaxDistFromCenter = Stats->MaxDistance;
+		const FVector FurthestDirection = Stats->FurthestDirection;
 		
 		// 박스 크기에서 XYZ 각각 스케일 계산 (직육면체)
-		FVector BoxSize = BoneBox.GetSize();
+		FVector BoxSize = Stats->Bounds.GetSize();
 		
 		// 스케일: BoxSize / 100 정도가 되도록 (BoxSize 100 -> Scale 1.0)
 		ShapeInfo.Scale.X = FMath::Clamp(BoxSize.X / ScaleDivisor, MinScale, MaxScale);
@@ -5271,7 +5854,7 @@ void SControlRigToolWidget::CalculateBoneShapeInfos(USkeletalMesh* Mesh)
 		BoneShapeInfoMap.Add(BoneName, ShapeInfo);
 		
 		DebugLog += FString::Printf(TEXT("  %s: Verts=%d, Scale=(%.2f, %.2f, %.2f), Offset=(%.1f, %.1f, %.1f)\n"),
-			*BoneName.ToString(), Info.Positions.Num(), 
+			*BoneName.ToString(), Stats->VertexCount, 
 			ShapeInfo.Scale.X, ShapeInfo.Scale.Y, ShapeInfo.Scale.Z,
 			ShapeInfo.Offset.X, ShapeInfo.Offset.Y, ShapeInfo.Offset.Z);
 	}
@@ -5315,16 +5898,39 @@ void SControlRigToolWidget::ApplyAutoScaleToBodyControls(UControlRigBlueprint* R
 	int32 UpdatedCount = 0;
 	FString DebugLog = TEXT("=== Body Controls Update ===\n");
 	
-	// 컨트롤러 키 목록 먼저 수집 (순회 중 수정 방지)
+	// 이 함수가 쌓은 설정 변경 (Flush 후 컨트롤별 결과 기록용)
+	struct FQueuedShape
+	{
+		FRigElementKey Key;
+		FString Line;        // 성공 시 로그
+		FString FailedLine;  // 실패 시 로그
+	};
+	TArray<FQueuedShape> QueuedShapes;
+	
+	// 설정 변경은 모았다가 알림 없이 한 번에 적용
+	FRigHierarchyBatchEdit Batch(Rig);
+	
+	// 컨트롤러 키 목록 먼저 수집 (순회 중 수정 방지, 스냅샷 리그면 베이크 때 목록 사용)
 	TArray<FRigElementKey> ControlKeys;
-	Hierarchy->ForEach<FRigControlElement>([&](FRigControlElement* ControlElement) -> bool
+	if (PendingControlRig.Get() == Rig && PendingTemplateSnapshot.IsValid())
 	{
-		if (ControlElement)
+		ControlKeys.Reserve(PendingTemplateSnapshot->Controls.Num());
+		for (const FName& ControlName : PendingTemplateSnapshot->Controls)
 		{
-			ControlKeys.Add(ControlElement->GetKey());
+			ControlKeys.Emplace(ControlName, ERigElementType::Control);
 		}
-		return true;
-	});
+	}
+	else
+	{
+		Hierarchy->ForEach<FRigControlElement>([&](FRigControlElement* ControlElement) -> bool
+		{
+			if (ControlElement)
+			{
+				ControlKeys.Add(ControlElement->GetKey());
+			}
+			return true;
+		});
+	}
 	
 	// 수집된 키로 설정 변경
 	for (const FRigElementKey& ControlKey : ControlKeys)
@@ -5355,15 +5961,8 @@ void SControlRigToolWidget::ApplyAutoScaleToBodyControls(UControlRigBlueprint* R
 		// 템플릿 본 이름 → 실제 메쉬 본 이름으로 매핑
 		// LastBoneMapping은 target(실제메쉬본) -> source(템플릿본) 구조
 		// 역으로 찾아야 함
-		FName MeshBoneName = TemplateBoneName;  // 기본값
-		for (const auto& Mapping : LastBoneMapping)
-		{
-			if (Mapping.Value == TemplateBoneName)
-			{
-				MeshBoneName = Mapping.Key;  // 실제 메쉬 본 이름
-				break;
-			}
-		}
+		const FName* MappedBoneName = LastBoneMapping.FindTarget(TemplateBoneName);
+		FName MeshBoneName = MappedBoneName ? *MappedBoneName : TemplateBoneName;  // 없으면 기본값
 		
 		// 해당 본의 Shape Info 가져오기 (실제 메쉬 본 이름으로)
 		FBoneShapeInfo ShapeInfo = GetBoneShapeInfo(MeshBoneName);
@@ -5375,23 +5974,30 @@ void SControlRigToolWidget::ApplyAutoScaleToBodyControls(UControlRigBlueprint* R
 		// ShapeTransform 스케일만 변경 (XYZ 각각)
 		NewSettings.ShapeTransform.SetScale3D(ShapeInfo.Scale);
 		
-		// SetControlSettings API로 적용
-		bool bSuccess = HC->SetControlSettings(ControlKey, NewSettings, false);
-		
-		if (bSuccess)
-		{
-			UpdatedCount++;
-			DebugLog += FString::Printf(TEXT("  %s: (%.2f,%.2f,%.2f) -> (%.2f,%.2f,%.2f) [%s -> %s] ✓\n"), 
+		// SetControlSettings는 Flush에서 일괄 적용
+		Batch.SetControlSettings(ControlKey, NewSettings);
+		QueuedShapes.Add({ ControlKey,
+			FString::Printf(TEXT("  %s: (%.2f,%.2f,%.2f) -> (%.2f,%.2f,%.2f) [%s -> %s] ✓\n"), 
 				*ControlNameStr, 
 				OldScale.X, OldScale.Y, OldScale.Z,
 				ShapeInfo.Scale.X, ShapeInfo.Scale.Y, ShapeInfo.Scale.Z,
-				*BoneNameStr, *MeshBoneName.ToString());
-		}
-		else
-		{
-			DebugLog += FString::Printf(TEXT("  %s: FAILED [%s -> %s]\n"), 
-				*ControlNameStr, *BoneNameStr, *MeshBoneName.ToString());
-		}
+				*BoneNameStr, *MeshBoneName.ToString()),
+			FString::Printf(TEXT("  %s: FAILED [%s -> %s]\n"), 
+				*ControlNameStr, *BoneNameStr, *MeshBoneName.ToString()) });
+	}
+	
+	// 바깥 스코프에 합류한 경우 Flush 반환값에는 다른 변경도 섞임 → 이 함수가 쌓은 설정만 판정
+	TSet<FRigElementKey> FailedKeys;
+	Batch.Flush(&FailedKeys);
+	for (const FQueuedShape& Queued : QueuedShapes)
+	{
+		const bool bSuccess = !FailedKeys.Contains(Queued.Key);
+		UpdatedCount += bSuccess ? 1 : 0;
+		DebugLog += bSuccess ? Queued.Line : Queued.FailedLine;
+	}
+	if (UpdatedCount < QueuedShapes.Num())
+	{
+		DebugLog += FString::Printf(TEXT("  FAILED: %d / %d controls\n"), QueuedShapes.Num() - UpdatedCount, QueuedShapes.Num());
 	}
 	
 	
@@ -5488,23 +6094,18 @@ TSharedRef<SWidget> SControlRigToolWidget::CreateIKRigSection()
 
 void SControlRigToolWidget::LoadIKRigTemplates()
 {
-	IKRigTemplateOptions.Empty();
+	IKRigTemplateOptions.Reset();
 	
-	// Asset Registry에서 IK Rig 에셋 검색
-	FAssetRegistryModule& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	
-	FARFilter Filter;
-	Filter.ClassPaths.Add(UIKRigDefinition::StaticClass()->GetClassPathName());
-	Filter.bRecursivePaths = true;
-	Filter.bRecursiveClasses = true;
-	
-	TArray<FAssetData> AssetList;
-	AssetRegistry.Get().GetAssets(Filter, AssetList);
+	// 공유 카탈로그의 IK Rig 목록 (옵션 문자열은 카탈로그 항목과 공유 → 갱신돼도 선택 유지)
+	for (const FAssetCatalogEntry& Entry : FAssetCatalog::Get().GetSorted(EAssetCatalogClass::IKRig))
+	{
+		IKRigTemplateOptions.Add(Entry.ObjectPathOption);
+	}
 	
-	for (const FAssetData& Asset : AssetList)
+	// 기존 선택이 아직 있으면 유지
+	if (SelectedIKRigTemplate.IsValid() && IKRigTemplateOptions.Contains(SelectedIKRigTemplate))
 	{
-		FString AssetPath = Asset.GetObjectPathString();
-		IKRigTemplateOptions.Add(MakeShared<FString>(AssetPath));
+		return;
 	}
 	
 	// 기본 선택 - "AI_IK_Rig_Template" 우선 선택
@@ -5587,7 +6188,8 @@ void SControlRigToolWidget::CreateIKRigFromTemplate()
 	
 	// 3. 새 에셋 경로 생성
 	FString OutputFolder = IKOutputFolderBox.IsValid() ? IKOutputFolderBox->GetText().ToString() : IKDefaultOutputFolder;
-	FString OutputName = IKOutputNameBox.IsValid() ? IKOutputNameBox->GetText().ToString() : TEXT("NewIKRig");
+	FString OutputName = IKOutputNameBox.IsValid() ? IKOutputNameBox->GetText().ToString() : 
+		(SelectedIKMesh.IsValid() ? *SelectedIKMesh + TEXT("_IK_Rig") : TEXT("NewIKRig"));
 	FString NewAssetPath = OutputFolder / OutputName;
 	FString PackagePath = NewAssetPath;
 	
@@ -5806,10 +6408,7 @@ void SControlRigToolWidget::CreateIKRigFromTemplate()
 	Package->MarkPackageDirty();
 	FAssetRegistryModule::AssetCreated(NewIKRig);
 	
-	FString PackageFileName = FPackageName::LongPackageNameToFilename(PackagePath, FPackageName::GetAssetPackageExtension());
-	FSavePackageArgs SaveArgs;
-	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
-	UPackage::SavePackage(Package, NewIKRig, *PackageFileName, SaveArgs);
+	FPackageSaveQueue::Save(Package, NewIKRig);
 	
 	DebugLog += FString::Printf(TEXT("\n=== IK Rig Created ===\nPath: %s\nChains: %d\n"), *NewAssetPath, Chains.Num());
 	
@@ -5840,6 +6439,8 @@ void SControlRigToolWidget::OnIKMeshSelectionChanged(TSharedPtr<FString> NewValu
 		FString AutoName = MeshName + TEXT("_IK_Rig");
 		IKOutputNameBox->SetText(FText::FromString(AutoName));
 	}
+	SetTabMappingSession(IKMappingSession, nullptr);
+	StartSelectionPrefetch(GetSelectedIKMeshPath());
 }
 
 FText SControlRigToolWidget::GetSelectedIKMeshName() const
@@ -5897,24 +6498,21 @@ FReply SControlRigToolWidget::OnUseSelectedIKMeshClicked()
 		if (A.AssetClassPath.GetAssetName() == TEXT("SkeletalMesh"))
 		{
 			FString Name = A.AssetName.ToString();
-			for (int32 i = 0; i < MeshOptions.Num(); ++i)
+			if (const FAssetCatalogEntry* Entry = FAssetCatalog::Get().FindByPackage(EAssetCatalogClass::SkeletalMesh, A.PackageName.ToString()))
 			{
-				if (*MeshOptions[i] == Name)
+				SelectedIKMesh = Entry->NameOption;
+				if (IKMeshComboBox.IsValid()) IKMeshComboBox->SetSelectedItem(SelectedIKMesh);
+				UpdateIKMeshThumbnail();
+				
+				// 자동으로 출력 이름 설정: {메쉬이름}_IK_Rig
+				if (IKOutputNameBox.IsValid())
 				{
-					SelectedIKMesh = MeshOptions[i];
-					if (IKMeshComboBox.IsValid()) IKMeshComboBox->SetSelectedItem(SelectedIKMesh);
-					UpdateIKMeshThumbnail();
-					
-					// 자동으로 출력 이름 설정: {메쉬이름}_IK_Rig
-					if (IKOutputNameBox.IsValid())
-					{
-						FString AutoName = Name + TEXT("_IK_Rig");
-						IKOutputNameBox->SetText(FText::FromString(AutoName));
-					}
-					
-					SetIKStatus(FString::Printf(TEXT("Mesh: %s"), *Name));
-					return FReply::Handled();
+					FString AutoName = Name + TEXT("_IK_Rig");
+					IKOutputNameBox->SetText(FText::FromString(AutoName));
 				}
+				
+				SetIKStatus(FString::Printf(TEXT("Mesh: %s"), *Name));
+				return FReply::Handled();
 			}
 		}
 	}
@@ -5942,41 +6540,19 @@ FReply SControlRigToolWidget::OnIKApproveMappingClicked()
 		return FReply::Handled();
 	}
 	
-	// Control Rig과 동일한 Approve 로직 사용
-	TSharedRef<IHttpRequest> Request = FHttpModule::Get().CreateRequest();
-	Request->SetURL(TEXT("http://127.0.0.1:8000/approve"));
-	Request->SetVerb(TEXT("POST"));
-	Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-	
-	// 매핑 데이터를 JSON으로 변환
-	TSharedPtr<FJsonObject> JsonObject = MakeShared<FJsonObject>();
-	TSharedPtr<FJsonObject> MappingsObject = MakeShared<FJsonObject>();
-	
-	for (const auto& Pair : IKBoneMapping)
+	const FString MeshPath = GetSelectedIKMeshPath();
+	if (MeshPath.IsEmpty())
 	{
-		MappingsObject->SetStringField(Pair.Key.ToString(), Pair.Value.ToString());
+		SetIKStatus(TEXT("Error: Mesh path not found"));
+		return FReply::Handled();
 	}
-	JsonObject->SetObjectField(TEXT("mappings"), MappingsObject);
-	
-	FString Content;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Content);
-	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
-	Request->SetContentAsString(Content);
 	
-	Request->OnProcessRequestComplete().BindLambda([this](FHttpRequestPtr, FHttpResponsePtr Response, bool bSuccess)
+	// Control Rig 탭과 같은 세션 승인 (캐시 고정 + 저널 기록)
+	TSharedRef<FBoneMappingSession> Session = AcquireMappingSession(IKMappingSession, MeshPath);
+	if (!Session->Approve())
 	{
-		if (bSuccess && Response.IsValid() && Response->GetResponseCode() == 200)
-		{
-			SetIKStatus(TEXT("Mapping approved for AI training!"));
-		}
-		else
-		{
-			SetIKStatus(TEXT("Approve request sent (server may be offline)"));
-		}
-	});
-	
-	Request->ProcessRequest();
-	SetIKStatus(TEXT("Sending approve request..."));
+		SetIKStatus(TEXT("Error: Run AI Bone Mapping for the selected mesh first"));
+	}
 	return FReply::Handled();
 }
 
@@ -6023,6 +6599,10 @@ void SControlRigToolWidget::CreateTPoseAnimSequence()
 		return;
 	}
 	
+	// 실패/취소 시 만든 AnimSequence 삭제
+	FGenerationPipeline Pipeline(TEXT("Create T-Pose Animation"), bHeadless, [this](const FString& Message) { SetIKStatus(Message); });
+	if (!Pipeline.EnterStage(EGenerationStage::Load)) return;
+	
 	// 2. 선택된 스켈레탈 메쉬 로드
 	if (!SelectedIKMesh.IsValid())
 	{
@@ -6058,6 +6638,7 @@ void SControlRigToolWidget::CreateTPoseAnimSequence()
 	UE_LOG(LogTemp, Warning, TEXT("[TPose] Template loaded successfully"));
 	
 	// 4. Jishuka 본 매핑 (UE5 표준 본 → Jishuka 템플릿 본)
+	if (!Pipeline.EnterStage(EGenerationStage::Map)) return;
 	// 템플릿 T-Pose가 Jishuka 스켈레톤을 사용하므로, 이 매핑으로 템플릿에서 회전값을 찾음
 	TMap<FName, FName> JishukaBoneMapping;
 	// 쇄골
@@ -6165,6 +6746,7 @@ void SControlRigToolWidget::CreateTPoseAnimSequence()
 	FString NewAssetPath = OutputFolder / AnimName;
 	
 	// 7. 패키지 생성
+	if (!Pipeline.EnterStage(EGenerationStage::BuildHierarchy)) return;
 	UPackage* Package = CreatePackage(*NewAssetPath);
 	if (!Package)
 	{
@@ -6179,6 +6761,7 @@ void SControlRigToolWidget::CreateTPoseAnimSequence()
 		SetIKStatus(TEXT("Error: Failed to create AnimSequence"));
 		return;
 	}
+	Pipeline.TrackCreatedAsset(AnimSequence);
 	
 	// 9. 스켈레톤 설정
 	AnimSequence->SetSkeleton(Skeleton);
@@ -6241,8 +6824,20 @@ void SControlRigToolWidget::CreateTPoseAnimSequence()
 	UE_LOG(LogTemp, Log, TEXT("[TPose] Applied T-Pose rotations to %d bones"), AppliedCount);
 	
 	// 15. 본 트랙 추가 및 키 설정 (2프레임: 0, 1)
+	if (!Pipeline.EnterStage(EGenerationStage::BuildGraph))
+	{
+		Controller.CloseBracket(false);
+		return;
+	}
 	for (int32 BoneIndex = 0; BoneIndex < NumBones; ++BoneIndex)
 	{
+		// 64본마다 진행 바 갱신 + 취소 확인
+		if ((BoneIndex & 63) == 0 && !Pipeline.Tick())
+		{
+			Controller.CloseBracket(false);
+			return;
+		}
+		
 		FName BoneName = TargetRefSkel.GetBoneName(BoneIndex);
 		const FTransform& BoneTransform = TPoseTransforms[BoneIndex];
 		
@@ -6270,16 +6865,15 @@ void SControlRigToolWidget::CreateTPoseAnimSequence()
 	Controller.CloseBracket(false);
 	
 	// 16. 저장
+	if (!Pipeline.EnterStage(EGenerationStage::Save)) return;
 	AnimSequence->MarkPackageDirty();
 	FAssetRegistryModule::AssetCreated(AnimSequence);
 	
-	FSavePackageArgs SaveArgs;
-	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
-	FString PackageFileName = FPackageName::LongPackageNameToFilename(NewAssetPath, FPackageName::GetAssetPackageExtension());
-	bool bSaved = UPackage::SavePackage(Package, AnimSequence, *PackageFileName, SaveArgs);
+	bool bSaved = FPackageSaveQueue::Save(Package, AnimSequence);
 	
 	if (bSaved)
 	{
+		Pipeline.Commit();
 		SetIKStatus(FString::Printf(TEXT("T-Pose created: %s (%d bones adjusted)"), *NewAssetPath, AppliedCount));
 		UE_LOG(LogTemp, Log, TEXT("[TPose] Created: %s with %d T-Pose bones"), *NewAssetPath, AppliedCount);
 	}
@@ -6310,84 +6904,12 @@ void SControlRigToolWidget::RequestIKAIBoneMapping()
 		return;
 	}
 	
-	USkeletalMesh* Mesh = LoadObject<USkeletalMesh>(nullptr, *MeshPath);
-	if (!Mesh)
-	{
-		SetIKStatus(FString::Printf(TEXT("Error: Failed to load mesh: %s"), *MeshPath));
-		return;
-	}
-	
-	// Control Rig 탭과 동일한 JSON 형식으로 본 정보 생성
-	const FReferenceSkeleton& Skel = Mesh->GetRefSkeleton();
-	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
-	TArray<TSharedPtr<FJsonValue>> Bones;
-	
-	for (int32 i = 0; i < Skel.GetNum(); i++)
+	// Control Rig / Physics Asset 탭에서 같은 메쉬를 이미 매핑했으면 요청 없이 재사용
+	TSharedRef<FBoneMappingSession> Session = AcquireMappingSession(IKMappingSession, MeshPath);
+	if (Session->RequestMapping() || Session->GetState() == EBoneMappingSessionState::Requesting)
 	{
-		const FMeshBoneInfo& Info = Skel.GetRefBoneInfo()[i];
-		TSharedPtr<FJsonObject> Bone = MakeShared<FJsonObject>();
-		Bone->SetStringField("name", Info.Name.ToString());
-		if (Info.ParentIndex >= 0)
-			Bone->SetStringField("parent", Skel.GetBoneName(Info.ParentIndex).ToString());
-		TArray<TSharedPtr<FJsonValue>> Children;
-		for (int32 j = 0; j < Skel.GetNum(); j++)
-			if (Skel.GetRefBoneInfo()[j].ParentIndex == i)
-				Children.Add(MakeShared<FJsonValueString>(Skel.GetBoneName(j).ToString()));
-		Bone->SetArrayField("children", Children);
-		Bones.Add(MakeShared<FJsonValueObject>(Bone));
+		ApplyMappingSessionToIKTab(EBoneMappingSessionChange::State);
 	}
-	Root->SetArrayField("bones", Bones);
-	Root->SetBoolField("use_ai", true);
-	
-	FString Body;
-	TSharedRef<TJsonWriter<>> W = TJsonWriterFactory<>::Create(&Body);
-	FJsonSerializer::Serialize(Root.ToSharedRef(), W);
-	
-	// Control Rig 탭과 동일한 URL 사용
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Req = FHttpModule::Get().CreateRequest();
-	Req->SetURL(TEXT("http://localhost:8000/predict"));
-	Req->SetVerb(TEXT("POST"));
-	Req->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-	Req->SetContentAsString(Body);
-	Req->SetTimeout(120.0f);
-	
-	Req->OnProcessRequestComplete().BindLambda([this](FHttpRequestPtr, FHttpResponsePtr Res, bool Ok)
-	{
-		if (!Ok || !Res.IsValid())
-		{
-			SetIKStatus(TEXT("Error: AI server connection failed"));
-			return;
-		}
-		
-		// 응답 파싱
-		TSharedPtr<FJsonObject> J;
-		TSharedRef<TJsonReader<>> R = TJsonReaderFactory<>::Create(Res->GetContentAsString());
-		if (!FJsonSerializer::Deserialize(R, J))
-		{
-			SetIKStatus(TEXT("Error: Failed to parse response"));
-			return;
-		}
-		
-		// 매핑 결과 저장 (Control Rig 탭과 동일한 형식)
-		IKBoneMapping.Empty();
-		const TSharedPtr<FJsonObject>* Map;
-		if (J->TryGetObjectField(TEXT("mapping"), Map))
-		{
-			for (const auto& Pair : (*Map)->Values)
-			{
-				FString Value;
-				if (Pair.Value->TryGetString(Value))
-				{
-					IKBoneMapping.Add(FName(*Pair.Key), FName(*Value));
-				}
-			}
-		}
-		
-		DisplayIKMappingResults();
-		SetIKStatus(FString::Printf(TEXT("Mapped %d bones"), IKBoneMapping.Num()));
-	});
-	
-	Req->ProcessRequest();
 }
 
 void SControlRigToolWidget::DisplayIKMappingResults()
@@ -6454,7 +6976,8 @@ void SControlRigToolWidget::UpdateIKTemplateThumbnail()
 		return;
 	}
 	
-	IKTemplateThumbnail = MakeShared<FAssetThumbnail>(FSoftObjectPath(Path).TryLoad(), ThumbnailSize, ThumbnailSize, ThumbnailPool);
+	// 에셋 데이터로 썸네일 (에셋 로드 없음)
+	IKTemplateThumbnail = MakeShared<FAssetThumbnail>(FMeshBoneHierarchy::GetAssetData(Path), ThumbnailSize, ThumbnailSize, ThumbnailPool);
 	IKTemplateThumbnailBox->SetContent(
 		SNew(SBorder)
 		.BorderImage(FAppStyle::GetBrush("ToolPanel.GroupBorder"))
@@ -6492,7 +7015,8 @@ void SControlRigToolWidget::UpdateIKMeshThumbnail()
 		return;
 	}
 	
-	IKMeshThumbnail = MakeShared<FAssetThumbnail>(FSoftObjectPath(Path).TryLoad(), ThumbnailSize, ThumbnailSize, ThumbnailPool);
+	// 에셋 데이터로 썸네일 (메쉬 로드 없음)
+	IKMeshThumbnail = MakeShared<FAssetThumbnail>(FMeshBoneHierarchy::GetAssetData(Path), ThumbnailSize, ThumbnailSize, ThumbnailPool);
 	IKMeshThumbnailBox->SetContent(
 		SNew(SBorder)
 		.BorderImage(FAppStyle::GetBrush("ToolPanel.GroupBorder"))
@@ -6513,15 +7037,7 @@ FString SControlRigToolWidget::GetSelectedIKTemplatePath() const
 FString SControlRigToolWidget::GetSelectedIKMeshPath() const
 {
 	if (!SelectedIKMesh.IsValid()) return FString();
-	
-	for (const FAssetInfo& Info : SkeletalMeshes)
-	{
-		if (Info.Name == *SelectedIKMesh)
-		{
-			return Info.Path;
-		}
-	}
-	return FString();
+	return FAssetCatalog::Get().FindPackagePathByName(EAssetCatalogClass::SkeletalMesh, *SelectedIKMesh);
 }
 
 void SControlRigToolWidget::SetIKStatus(const FString& Message)
@@ -6539,25 +7055,14 @@ void SControlRigToolWidget::SetIKStatus(const FString& Message)
 
 void SControlRigToolWidget::LoadRetargeterIKRigs()
 {
-	RetargeterSourceOptions.Empty();
-	RetargeterTargetOptions.Empty();
-	
-	// Asset Registry에서 IK Rig 에셋 검색
-	FAssetRegistryModule& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	
-	FARFilter Filter;
-	Filter.ClassPaths.Add(UIKRigDefinition::StaticClass()->GetClassPathName());
-	Filter.bRecursivePaths = true;
-	Filter.bRecursiveClasses = true;
-	
-	TArray<FAssetData> AssetList;
-	AssetRegistry.Get().GetAssets(Filter, AssetList);
+	RetargeterSourceOptions.Reset();
+	RetargeterTargetOptions.Reset();
 	
-	for (const FAssetData& Asset : AssetList)
+	// 공유 카탈로그의 IK Rig 목록 (Source/Target 콤보가 같은 옵션 문자열 공유)
+	for (const FAssetCatalogEntry& Entry : FAssetCatalog::Get().GetSorted(EAssetCatalogClass::IKRig))
 	{
-		FString AssetPath = Asset.GetObjectPathString();
-		RetargeterSourceOptions.Add(MakeShared<FString>(AssetPath));
-		RetargeterTargetOptions.Add(MakeShared<FString>(AssetPath));
+		RetargeterSourceOptions.Add(Entry.ObjectPathOption);
+		RetargeterTargetOptions.Add(Entry.ObjectPathOption);
 	}
 	
 	// ComboBox 갱신
@@ -6749,7 +7254,7 @@ void SControlRigToolWidget::UpdateRetargeterSourceThumbnail()
 		return;
 	}
 	
-	RetargeterSourceThumbnail = MakeShared<FAssetThumbnail>(FSoftObjectPath(Path).TryLoad(), 48, 48, ThumbnailPool);
+	RetargeterSourceThumbnail = MakeShared<FAssetThumbnail>(FMeshBoneHierarchy::GetAssetData(Path), 48, 48, ThumbnailPool);
 	RetargeterSourceThumbnailBox->SetContent(
 		SNew(SBorder)
 		.BorderImage(FAppStyle::GetBrush("ToolPanel.GroupBorder"))
@@ -6783,7 +7288,7 @@ void SControlRigToolWidget::UpdateRetargeterTargetThumbnail()
 		return;
 	}
 	
-	RetargeterTargetThumbnail = MakeShared<FAssetThumbnail>(FSoftObjectPath(Path).TryLoad(), 48, 48, ThumbnailPool);
+	RetargeterTargetThumbnail = MakeShared<FAssetThumbnail>(FMeshBoneHierarchy::GetAssetData(Path), 48, 48, ThumbnailPool);
 	RetargeterTargetThumbnailBox->SetContent(
 		SNew(SBorder)
 		.BorderImage(FAppStyle::GetBrush("ToolPanel.GroupBorder"))
@@ -6910,10 +7415,7 @@ void SControlRigToolWidget::CreateIKRetargeter()
 	Package->MarkPackageDirty();
 	FAssetRegistryModule::AssetCreated(NewRetargeter);
 	
-	FString PackageFileName = FPackageName::LongPackageNameToFilename(NewAssetPath, FPackageName::GetAssetPackageExtension());
-	FSavePackageArgs SaveArgs;
-	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
-	UPackage::SavePackage(Package, NewRetargeter, *PackageFileName, SaveArgs);
+	FPackageSaveQueue::Save(Package, NewRetargeter);
 	
 	SetIKStatus(FString::Printf(TEXT("IK Retargeter created: %s"), *AssetName));
 	UE_LOG(LogTemp, Log, TEXT("[IKRetargeter] Created: %s"), *NewAssetPath);
@@ -6949,6 +7451,7 @@ void SControlRigToolWidget::OnKawaiiMeshSelectionChanged(TSharedPtr<FString> New
 		BuildKawaiiBoneDisplayList();
 		
 		SetKawaiiStatus(FString::Printf(TEXT("Loaded: %s (%d bones)"), *MeshName, KawaiiBoneDisplayList.Num()));
+		StartSelectionPrefetch(GetSelectedKawaiiMeshPath());
 	}
 }
 
@@ -7074,118 +7577,163 @@ FReply SControlRigToolWidget::OnKawaiiBrowseFolderClicked()
 void SControlRigToolWidget::BuildKawaiiBoneDisplayList()
 {
 	KawaiiBoneDisplayList.Empty();
+	bKawaiiSkinWeightsPending = false;
 	
 	FString MeshPath = GetSelectedKawaiiMeshPath();
 	if (MeshPath.IsEmpty()) return;
 	
-	USkeletalMesh* Mesh = LoadObject<USkeletalMesh>(nullptr, *MeshPath);
-	if (!Mesh) return;
+	// 본 트리는 계층만 필요 → 메쉬 로드 없이 읽기
+	// 스킨 웨이트는 메쉬가 이미 메모리에 있을 때만 바로 확인, 아니면 생성 시 확인
+	const FReferenceSkeleton* RefSkel = FMeshBoneHierarchy::Read(MeshPath);
+	if (!RefSkel) return;
 	
-	const FReferenceSkeleton& RefSkel = Mesh->GetRefSkeleton();
+	USkeletalMesh* LoadedMesh = FMeshBoneHierarchy::FindLoadedMesh(MeshPath);
+	bKawaiiSkinWeightsPending = (LoadedMesh == nullptr);
+	
+	FillKawaiiBoneDisplayList(*RefSkel, LoadedMesh);
+	UpdateKawaiiBoneTreeUI();
+}
+
+void SControlRigToolWidget::FillKawaiiBoneDisplayList(const FReferenceSkeleton& RefSkel, USkeletalMesh* WeightMesh)
+{
+	KawaiiBoneDisplayList.Reset();
+	
+	// 로드된 메쉬 계층이면 캐시, 스켈레톤 에셋에서 읽은 계층(메쉬 미로드)은 이 목록용으로만 빌드
+	TOptional<FSkeletonTopology> SkeletonAssetTopology;
+	const FSkeletonTopology& Topology = WeightMesh && &WeightMesh->GetRefSkeleton() == &RefSkel
+		? GetSkeletonTopology(WeightMesh)
+		: SkeletonAssetTopology.Emplace(RefSkel);
+	
+	// Control Rig 탭에서 Secondary로 선택된 본
+	TSet<FName> SecondaryBoneNames;
+	for (const FBoneDisplayInfo& BDI : BoneDisplayList)
+	{
+		if (BDI.Classification == EBoneClassification::Secondary)
+		{
+			SecondaryBoneNames.Add(BDI.BoneName);
+		}
+	}
 	
+	// 행 인덱스 == 본 인덱스 (체인 탐색에서 토폴로지 인덱스로 바로 접근)
+	KawaiiBoneDisplayList.Reserve(RefSkel.GetNum());
 	for (int32 i = 0; i < RefSkel.GetNum(); ++i)
 	{
 		FKawaiiBoneDisplayInfo Info;
 		Info.BoneName = RefSkel.GetBoneName(i);
 		Info.BoneIndex = i;
-		Info.ParentIndex = RefSkel.GetParentIndex(i);
-		
-		// 깊이 계산
-		int32 Depth = 0;
-		int32 ParentIdx = Info.ParentIndex;
-		while (ParentIdx != INDEX_NONE)
-		{
-			Depth++;
-			ParentIdx = RefSkel.GetParentIndex(ParentIdx);
-		}
-		Info.Depth = Depth;
+		Info.ParentIndex = Topology.GetParent(i);
+		Info.Depth = Topology.GetDepth(i);
 		
-		// 웨이트 체크
-		Info.bHasSkinWeight = HasSkinWeight(Mesh, Info.BoneName);
+		// 웨이트 체크 (메쉬 없으면 일단 있음으로 표시)
+		Info.bHasSkinWeight = WeightMesh ? HasSkinWeight(WeightMesh, Info.BoneName) : true;
 		
-		// Control Rig 탭에서 Secondary로 선택됐는지 확인
-		Info.bIsSecondary = false;
-		for (const FBoneDisplayInfo& BDI : BoneDisplayList)
-		{
-			if (BDI.BoneName == Info.BoneName && BDI.Classification == EBoneClassification::Secondary)
-			{
-				Info.bIsSecondary = true;
-				break;
-			}
-		}
+		Info.bIsSecondary = SecondaryBoneNames.Contains(Info.BoneName);
 		
 		Info.TagIndex = INDEX_NONE;
 		Info.bExpanded = true;  // 기본 펼쳐진 상태
-		Info.bHasChildren = false;  // 아래서 계산
+		Info.bHasChildren = Topology.HasChildren(i);
 		
 		KawaiiBoneDisplayList.Add(Info);
 	}
-	
-	// 자식 본 여부 계산
-	for (int32 i = 0; i < KawaiiBoneDisplayList.Num(); ++i)
-	{
-		int32 BoneIdx = KawaiiBoneDisplayList[i].BoneIndex;
-		// 다른 본이 이 본을 부모로 가지는지 확인
-		for (int32 j = 0; j < KawaiiBoneDisplayList.Num(); ++j)
-		{
-			if (KawaiiBoneDisplayList[j].ParentIndex == BoneIdx)
-			{
-				KawaiiBoneDisplayList[i].bHasChildren = true;
-				break;
-			}
-		}
-	}
-	
-	UpdateKawaiiBoneTreeUI();
 }
 
-void SControlRigToolWidget::UpdateKawaiiBoneTreeUI()
+void SControlRigToolWidget::SyncKawaiiBoneDisplayListToMesh(USkeletalMesh* Mesh)
 {
-	if (!KawaiiBoneTreeBox.IsValid()) return;
+	if (!Mesh) return;
 	
-	KawaiiBoneTreeBox->ClearChildren();
+	const FReferenceSkeleton& RefSkel = Mesh->GetRefSkeleton();
 	
-	if (KawaiiBoneDisplayList.Num() == 0)
+	// 스켈레톤에서 읽은 목록은 본 순서가 메쉬와 다를 수 있음
+	bool bSameOrder = KawaiiBoneDisplayList.Num() == RefSkel.GetNum();
+	for (int32 i = 0; bSameOrder && i < KawaiiBoneDisplayList.Num(); ++i)
 	{
-		KawaiiBoneTreeBox->AddSlot()
-		[
-			SNew(STextBlock)
-			.Text(LOCTEXT("NoBones", "No bones to display"))
-			.Font(FCoreStyle::GetDefaultFontStyle("Regular", 9))
-			.ColorAndOpacity(FLinearColor(0.4f, 0.4f, 0.45f, 1.0f))
-		];
-		return;
+		bSameOrder = KawaiiBoneDisplayList[i].BoneName == RefSkel.GetBoneName(i);
 	}
+	if (bSameOrder && !bKawaiiSkinWeightsPending) return;
 	
-	for (int32 i = 0; i < KawaiiBoneDisplayList.Num(); ++i)
+	// 태그 / 펼침 상태는 본 이름으로 옮김
+	TMap<FName, FKawaiiBoneDisplayInfo> PreviousByName;
+	PreviousByName.Reserve(KawaiiBoneDisplayList.Num());
+	for (const FKawaiiBoneDisplayInfo& Info : KawaiiBoneDisplayList)
+	{
+		PreviousByName.Add(Info.BoneName, Info);
+	}
+	
+	FillKawaiiBoneDisplayList(RefSkel, Mesh);
+	for (FKawaiiBoneDisplayInfo& Info : KawaiiBoneDisplayList)
 	{
-		// 부모가 접혀있으면 표시하지 않음
-		bool bVisible = true;
-		int32 ParentIdx = KawaiiBoneDisplayList[i].ParentIndex;
-		while (ParentIdx != INDEX_NONE && bVisible)
+		if (const FKawaiiBoneDisplayInfo* Previous = PreviousByName.Find(Info.BoneName))
 		{
-			// ParentIndex(본 인덱스)를 배열에서 찾기
-			for (int32 j = 0; j < KawaiiBoneDisplayList.Num(); ++j)
-			{
-				if (KawaiiBoneDisplayList[j].BoneIndex == ParentIdx)
-				{
-					if (!KawaiiBoneDisplayList[j].bExpanded)
-					{
-						bVisible = false;
-					}
-					ParentIdx = KawaiiBoneDisplayList[j].ParentIndex;
-					break;
-				}
-			}
+			Info.TagIndex = Previous->TagIndex;
+			Info.bExpanded = Previous->bExpanded;
 		}
+	}
+	bKawaiiSkinWeightsPending = false;
+	
+	UE_LOG(LogTemp, Log, TEXT("[KawaiiPhysics] Synced bone list to mesh (%s order, skin weights checked)"), bSameOrder ? TEXT("same") : TEXT("remapped"));
+	UpdateKawaiiBoneTreeUI();
+}
+
+void SControlRigToolWidget::UpdateKawaiiBoneTreeUI()
+{
+	// 본 목록이 새로 만들어졌을 때만 호출 (태그/색상/펼침 변경은 행 속성 바인딩으로 반영)
+	KawaiiBoneItems.Reset(KawaiiBoneDisplayList.Num());
+	KawaiiBoneRootItems.Reset();
+	KawaiiBoneChildItems.Reset();
+	KawaiiBoneChildItems.SetNum(KawaiiBoneDisplayList.Num());
+	
+	for (int32 i = 0; i < KawaiiBoneDisplayList.Num(); ++i)
+	{
+		TSharedPtr<int32> Item = MakeShared<int32>(i);
+		KawaiiBoneItems.Add(Item);
 		
-		if (!bVisible) continue;
-		
-		KawaiiBoneTreeBox->AddSlot()
-		.AutoHeight()
+		const int32 ParentIdx = KawaiiBoneDisplayList[i].ParentIndex;
+		if (KawaiiBoneDisplayList.IsValidIndex(ParentIdx))
+		{
+			KawaiiBoneChildItems[ParentIdx].Add(Item);
+		}
+		else
+		{
+			KawaiiBoneRootItems.Add(Item);
+		}
+	}
+	
+	if (!KawaiiBoneTreeView.IsValid()) return;
+	
+	KawaiiBoneTreeView->ClearExpandedItems();
+	for (int32 i = 0; i < KawaiiBoneDisplayList.Num(); ++i)
+	{
+		if (KawaiiBoneDisplayList[i].bExpanded && KawaiiBoneDisplayList[i].bHasChildren)
+		{
+			KawaiiBoneTreeView->SetItemExpansion(KawaiiBoneItems[i], true);
+		}
+	}
+	KawaiiBoneTreeView->RequestTreeRefresh();
+}
+
+TSharedRef<ITableRow> SControlRigToolWidget::OnGenerateKawaiiBoneRow(TSharedPtr<int32> Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(STableRow<TSharedPtr<int32>>, OwnerTable)
+		.Style(&FAppStyle::Get().GetWidgetStyle<FTableRowStyle>("TableView.NoHoverTableRow"))
+		.Padding(0)
 		[
-			CreateKawaiiBoneRow(i)
+			CreateKawaiiBoneRow(*Item)
 		];
+}
+
+void SControlRigToolWidget::OnGetKawaiiBoneChildren(TSharedPtr<int32> Item, TArray<TSharedPtr<int32>>& OutChildren)
+{
+	if (Item.IsValid() && KawaiiBoneChildItems.IsValidIndex(*Item))
+	{
+		OutChildren = KawaiiBoneChildItems[*Item];
+	}
+}
+
+void SControlRigToolWidget::OnKawaiiBoneExpansionChanged(TSharedPtr<int32> Item, bool bExpanded)
+{
+	if (Item.IsValid() && KawaiiBoneDisplayList.IsValidIndex(*Item))
+	{
+		KawaiiBoneDisplayList[*Item].bExpanded = bExpanded;
 	}
 }
 
@@ -7198,11 +7746,8 @@ TSharedRef<SWidget> SControlRigToolWidget::CreateKawaiiBoneRow(int32 Index)
 	
 	FKawaiiBoneDisplayInfo& Info = KawaiiBoneDisplayList[Index];
 	
-	// 들여쓰기 (접기 버튼 공간 포함)
-	float IndentPadding = Info.Depth * 12.0f;  // 좀 더 조밀하게
-	bool bHasChildren = Info.bHasChildren;
-	
 	// SButton으로 전체 행을 감싸서 호버 효과 구현
+	// 들여쓰기 / 접기 화살표는 트리 행(STableRow의 SExpanderArrow)이 처리
 	return SNew(SButton)
 		.ButtonStyle(FAppStyle::Get(), "SimpleButton")  // 호버 시 배경 변경
 		.ContentPadding(FMargin(2, 1))  // 줄 간격 축소
@@ -7217,49 +7762,6 @@ TSharedRef<SWidget> SControlRigToolWidget::CreateKawaiiBoneRow(int32 Index)
 		})
 		[
 			SNew(SHorizontalBox)
-			// 들여쓰기
-			+ SHorizontalBox::Slot().AutoWidth()
-			[
-				SNew(SBox).WidthOverride(IndentPadding)
-			]
-			// 접기/펼치기 버튼 (자식 있을 때만)
-			+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center)
-			[
-				SNew(SBox)
-				.WidthOverride(16.0f)
-				.HeightOverride(16.0f)
-				[
-					bHasChildren ?
-					static_cast<TSharedRef<SWidget>>(
-						SNew(SButton)
-						.ButtonStyle(FAppStyle::Get(), "NoBorder")
-						.ContentPadding(0)
-						.OnClicked_Lambda([this, Index]() -> FReply
-						{
-							if (Index >= 0 && Index < KawaiiBoneDisplayList.Num())
-							{
-								KawaiiBoneDisplayList[Index].bExpanded = !KawaiiBoneDisplayList[Index].bExpanded;
-								UpdateKawaiiBoneTreeUI();
-							}
-							return FReply::Handled();
-						})
-						[
-							SNew(SImage)
-							.Image_Lambda([this, Index]() -> const FSlateBrush*
-							{
-								if (Index >= 0 && Index < KawaiiBoneDisplayList.Num() && KawaiiBoneDisplayList[Index].bExpanded)
-									return FAppStyle::GetBrush("TreeArrow_Expanded");
-								return FAppStyle::GetBrush("TreeArrow_Collapsed");
-							})
-							.ColorAndOpacity(FLinearColor(0.7f, 0.7f, 0.75f, 1.0f))
-						]
-					)
-					:
-					static_cast<TSharedRef<SWidget>>(
-						SNew(SSpacer)
-					)
-				]
-			]
 			// 본 이름
 			+ SHorizontalBox::Slot().FillWidth(1.0f).VAlign(VAlign_Center).Padding(2, 0, 0, 0)
 			[
@@ -7345,7 +7847,6 @@ TSharedRef<SWidget> SControlRigToolWidget::CreateKawaiiBoneRow(int32 Index)
 						KawaiiBoneDisplayList[Index].TagIndex = INDEX_NONE;
 						UE_LOG(LogTemp, Log, TEXT("[KawaiiPhysics] Removed tag from bone: %s"), 
 							*KawaiiBoneDisplayList[Index].BoneName.ToString());
-						UpdateKawaiiBoneTreeUI();
 					}
 					return FReply::Handled();
 				})
@@ -7376,7 +7877,6 @@ void SControlRigToolWidget::OnKawaiiBoneTagChanged(int32 BoneIndex, int32 NewTag
 	if (BoneIndex < 0 || BoneIndex >= KawaiiBoneDisplayList.Num()) return;
 	
 	KawaiiBoneDisplayList[BoneIndex].TagIndex = NewTagIndex;
-	UpdateKawaiiBoneTreeUI();
 }
 
 FReply SControlRigToolWidget::OnApplySelectedTagClicked(int32 BoneIndex)
@@ -7563,8 +8063,7 @@ void SControlRigToolWidget::OnKawaiiTagNameChanged(int32 TagIndex, const FText&
 	if (TagIndex >= 0 && TagIndex < KawaiiTags.Num())
 	{
 		KawaiiTags[TagIndex].Name = NewName.ToString();
-		UpdateKawaiiTagListUI();
-		UpdateKawaiiBoneTreeUI();  // 본 트리에서 태그 이름도 업데이트
+		UpdateKawaiiTagListUI();  // 본 트리의 태그 이름은 행 속성 바인딩으로 반영
 	}
 }
 
@@ -7573,8 +8072,7 @@ void SControlRigToolWidget::OnKawaiiTagColorChanged(int32 TagIndex, FLinearColor
 	if (TagIndex >= 0 && TagIndex < KawaiiTags.Num())
 	{
 		KawaiiTags[TagIndex].Color = NewColor;
-		UpdateKawaiiTagListUI();
-		UpdateKawaiiBoneTreeUI();  // 본 트리에서 컬러도 업데이트
+		UpdateKawaiiTagListUI();  // 본 트리의 컬러는 행 속성 바인딩으로 반영
 	}
 }
 
@@ -7606,16 +8104,14 @@ void SControlRigToolWidget::OnKawaiiTagDeleteClicked(int32 TagIndex)
 			SelectedKawaiiTagIndex--;
 		}
 		
-		UpdateKawaiiTagListUI();
-		UpdateKawaiiBoneTreeUI();
+		UpdateKawaiiTagListUI();  // 본 트리의 태그 표시는 행 속성 바인딩으로 반영
 	}
 }
 
 void SControlRigToolWidget::OnSelectKawaiiTag(int32 TagIndex)
 {
 	SelectedKawaiiTagIndex = TagIndex;
-	UpdateKawaiiTagListUI();
-	UpdateKawaiiBoneTreeUI();  // 화살표 버튼 표시 업데이트
+	UpdateKawaiiTagListUI();  // 본 트리의 화살표 버튼은 Visibility 바인딩으로 반영
 	
 	if (TagIndex >= 0 && TagIndex < KawaiiTags.Num())
 	{
@@ -7691,9 +8187,13 @@ bool SControlRigToolWidget::CreateKawaiiAnimBlueprint()
 {
 	SetKawaiiStatus(TEXT("Creating Kawaii AnimBlueprint..."));
 	
+	// 실패/취소 시 새로 만든 AnimBP 삭제
+	FGenerationPipeline Pipeline(TEXT("Create Kawaii AnimBP"), bHeadless, [this](const FString& Message) { SetKawaiiStatus(Message); });
+	
 	// ============================================================================
 	// 1. 스켈레탈 메쉬 및 스켈레톤 가져오기
 	// ============================================================================
+	if (!Pipeline.EnterStage(EGenerationStage::Load)) return false;
 	FString MeshPath = GetSelectedKawaiiMeshPath();
 	if (MeshPath.IsEmpty())
 	{
@@ -7715,11 +8215,65 @@ bool SControlRigToolWidget::CreateKawaiiAnimBlueprint()
 		return false;
 	}
 	
+	// 본 트리는 메쉬 로드 없이 만들었으므로 여기서 실제 본 순서 / 스킨 웨이트 반영
+	SyncKawaiiBoneDisplayListToMesh(SkeletalMesh);
+	
+	// 체인 분석용 토폴로지 (KawaiiBoneDisplayList와 같은 메쉬)
+	const FSkeletonTopology& KawaiiTopology = GetSkeletonTopology(SkeletalMesh);
+	
+	// 태그별 본 정보 수집
+	TMap<int32, TArray<FName>> TaggedBones;
+	for (const FKawaiiBoneDisplayInfo& Info : KawaiiBoneDisplayList)
+	{
+		if (Info.TagIndex != INDEX_NONE)
+		{
+			TaggedBones.FindOrAdd(Info.TagIndex).Add(Info.BoneName);
+		}
+	}
+	
+	// 체인 분석: 태그된 루트 본별로 서브트리에서 웨이트 없는 첫 번째 본 (CPU 전용 → 워커 스레드)
+	TMap<FName, FName> ChainDeadBones;
+	if (!Pipeline.EnterStage(EGenerationStage::Map)) return false;
+	if (KawaiiTopology.Num() == KawaiiBoneDisplayList.Num())
+	{
+		const bool bChainsBuilt = Pipeline.RunInBackground([&]()
+		{
+			for (const auto& Pair : TaggedBones)
+			{
+				for (const FName& BoneName : Pair.Value)
+				{
+					// KawaiiBoneDisplayList 행 인덱스 == 본 인덱스
+					const int32 RootBoneDispIdx = KawaiiTopology.FindBoneIndex(BoneName);
+					if (RootBoneDispIdx == INDEX_NONE) continue;
+					
+					// 루트 본 제외, 본 인덱스 순으로 가장 앞선 본
+					int32 DeadBoneIdx = INDEX_NONE;
+					for (int32 ChainIdx : KawaiiTopology.GetSubtree(RootBoneDispIdx))
+					{
+						if (ChainIdx != RootBoneDispIdx && !KawaiiBoneDisplayList[ChainIdx].bHasSkinWeight &&
+							(DeadBoneIdx == INDEX_NONE || ChainIdx < DeadBoneIdx))
+						{
+							DeadBoneIdx = ChainIdx;
+						}
+					}
+					
+					if (DeadBoneIdx != INDEX_NONE)
+					{
+						ChainDeadBones.Add(BoneName, KawaiiBoneDisplayList[DeadBoneIdx].BoneName);
+					}
+				}
+			}
+			return true;
+		});
+		if (!bChainsBuilt) return false;
+	}
+	
 	// ============================================================================
 	// 2. 출력 경로 설정
 	// ============================================================================
 	FString OutputFolder = KawaiiOutputFolderBox.IsValid() ? KawaiiOutputFolderBox->GetText().ToString() : KawaiiDefaultOutputFolder;
-	FString OutputName = KawaiiOutputNameBox.IsValid() ? KawaiiOutputNameBox->GetText().ToString() : TEXT("NewKawaiiAnimBP");
+	FString OutputName = KawaiiOutputNameBox.IsValid() ? KawaiiOutputNameBox->GetText().ToString() : 
+		(SelectedKawaiiMesh.IsValid() ? FString::Printf(TEXT("ABP_%s_Kawaii"), *FPaths::GetBaseFilename(*SelectedKawaiiMesh)) : TEXT("NewKawaiiAnimBP"));
 	FString NewAssetPath = OutputFolder / OutputName;
 	
 	// 패키지 경로 준비
@@ -7729,6 +8283,8 @@ bool SControlRigToolWidget::CreateKawaiiAnimBlueprint()
 	// ============================================================================
 	// 3. AnimBlueprint 생성
 	// ============================================================================
+	if (!Pipeline.EnterStage(EGenerationStage::BuildHierarchy)) return false;
+	
 	// 기존 에셋 확인 및 삭제
 	FString FullAssetPath = PackagePath + TEXT(".") + AssetName;
 	UObject* ExistingAsset = StaticLoadObject(UAnimBlueprint::StaticClass(), nullptr, *FullAssetPath);
@@ -7778,6 +8334,7 @@ bool SControlRigToolWidget::CreateKawaiiAnimBlueprint()
 		SetKawaiiStatus(TEXT("Error: Failed to create AnimBlueprint"));
 		return false;
 	}
+	Pipeline.TrackCreatedAsset(AnimBP);
 	
 	// 스켈레톤 설정
 	AnimBP->TargetSkeleton = Skeleton;
@@ -7811,6 +8368,8 @@ bool SControlRigToolWidget::CreateKawaiiAnimBlueprint()
 	// ============================================================================
 	// 5. A영역 기본 노드 생성 (Output Pose는 이미 존재)
 	// ============================================================================
+	if (!Pipeline.EnterStage(EGenerationStage::BuildGraph)) return false;
+	
 	
 	// 기존 Output Pose (Root) 노드 찾기
 	UAnimGraphNode_Root* RootNode = nullptr;
@@ -8084,16 +8643,6 @@ bool SControlRigToolWidget::CreateKawaiiAnimBlueprint()
 	// 7. B영역 - 태그별 Kawaii Physics 노드 동적 생성
 	// ============================================================================
 	
-	// 태그별 본 정보 수집
-	TMap<int32, TArray<FName>> TaggedBones;
-	for (const FKawaiiBoneDisplayInfo& Info : KawaiiBoneDisplayList)
-	{
-		if (Info.TagIndex != INDEX_NONE)
-		{
-			TaggedBones.FindOrAdd(Info.TagIndex).Add(Info.BoneName);
-		}
-	}
-	
 	// ============================================================================
 	// Kawaii Physics 모듈 강제 로드 및 클래스 찾기
 	// ============================================================================
@@ -8255,6 +8804,9 @@ bool SControlRigToolWidget::CreateKawaiiAnimBlueprint()
 	float CommentY = BaseY + 200.0f;
 	for (auto& Pair : TaggedBones)
 	{
+		// 태그 하나씩 진행 바 갱신 + 취소 확인
+		if (!Pipeline.Tick()) return false;
+		
 		int32 TagIdx = Pair.Key;
 		if (TagIdx < 0 || TagIdx >= KawaiiTags.Num()) continue;
 		
@@ -8397,57 +8949,16 @@ bool SControlRigToolWidget::CreateKawaiiAnimBlueprint()
 				// ============================================================================
 				// 체인 분석: 웨이트 없는 본 찾기
 				// ============================================================================
+				// 체인 분석 결과 (Map 단계에서 계산)
 				FName ExcludeBoneName = NAME_None;
 				bool bHasDeadBones = false;
 				
-				// 현재 본의 인덱스 찾기
-				int32 RootBoneDispIdx = INDEX_NONE;
-				for (int32 i = 0; i < KawaiiBoneDisplayList.Num(); ++i)
-				{
-					if (KawaiiBoneDisplayList[i].BoneName == BoneName)
-					{
-						RootBoneDispIdx = i;
-						break;
-					}
-				}
-				
-				if (RootBoneDispIdx != INDEX_NONE)
+				if (const FName* DeadBone = ChainDeadBones.Find(BoneName))
 				{
-					// 자식 체인 추적 (깊이 우선 탐색)
-					TArray<int32> ChainIndices;
-					ChainIndices.Add(RootBoneDispIdx);
-					
-					// 자식들 순차 탐색
-					for (int32 i = 0; i < KawaiiBoneDisplayList.Num(); ++i)
-					{
-						const FKawaiiBoneDisplayInfo& Info = KawaiiBoneDisplayList[i];
-						// 이 본의 부모가 체인에 있으면 체인에 추가
-						if (Info.ParentIndex != INDEX_NONE)
-						{
-							for (int32 ChainIdx : ChainIndices)
-							{
-								if (KawaiiBoneDisplayList[ChainIdx].BoneIndex == Info.ParentIndex)
-								{
-									ChainIndices.AddUnique(i);
-									break;
-								}
-							}
-						}
-					}
-					
-					// 체인에서 웨이트 없는 첫 번째 본 찾기 (루트 본 제외)
-					for (int32 i = 1; i < ChainIndices.Num(); ++i)
-					{
-						const FKawaiiBoneDisplayInfo& ChainInfo = KawaiiBoneDisplayList[ChainIndices[i]];
-						if (!ChainInfo.bHasSkinWeight)
-						{
-							ExcludeBoneName = ChainInfo.BoneName;
-							bHasDeadBones = true;
-							UE_LOG(LogTemp, Log, TEXT("  Chain %s: Found dead bone (no weight) at %s"), 
-								*BoneName.ToString(), *ExcludeBoneName.ToString());
-							break;
-						}
-					}
+					ExcludeBoneName = *DeadBone;
+					bHasDeadBones = true;
+					UE_LOG(LogTemp, Log, TEXT("  Chain %s: Found dead bone (no weight) at %s"), 
+						*BoneName.ToString(), *ExcludeBoneName.ToString());
 				}
 				
 				// 노드 위치 계산 (5x? 그리드)
@@ -8858,18 +9369,18 @@ bool SControlRigToolWidget::CreateKawaiiAnimBlueprint()
 	// ============================================================================
 	// 8. 블루프린트 컴파일 및 저장
 	// ============================================================================
+	if (!Pipeline.EnterStage(EGenerationStage::Compile)) return false;
 	FKismetEditorUtilities::CompileBlueprint(AnimBP);
 	
 	FBlueprintEditorUtils::MarkBlueprintAsModified(AnimBP);
 	
 	// 패키지 저장
-	FString PackageFileName = FPackageName::LongPackageNameToFilename(PackagePath, FPackageName::GetAssetPackageExtension());
-	FSavePackageArgs SaveArgs;
-	SaveArgs.TopLevelFlags = EObjectFlags::RF_Public | EObjectFlags::RF_Standalone;
-	UPackage::SavePackage(Package, AnimBP, *PackageFileName, SaveArgs);
+	if (!Pipeline.EnterStage(EGenerationStage::Save)) return false;
+	FPackageSaveQueue::Save(Package, AnimBP);
 	
 	// 에셋 레지스트리 알림
 	FAssetRegistryModule::AssetCreated(AnimBP);
+	Pipeline.Commit();
 	
 	// ============================================================================
 	// 9. 결과 보고
@@ -8908,12 +9419,15 @@ bool SControlRigToolWidget::CreateKawaiiAnimBlueprint()
 	
 	SetKawaiiStatus(TEXT("AnimBP created: ") + NewAssetPath);
 	
-	FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Summary));
-	
-	// Content Browser에서 열기
-	TArray<UObject*> ObjectsToSync;
-	ObjectsToSync.Add(AnimBP);
-	GEditor->SyncBrowserToObjects(ObjectsToSync);
+	if (!bHeadless)
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Summary));
+		
+		// Content Browser에서 열기
+		TArray<UObject*> ObjectsToSync;
+		ObjectsToSync.Add(AnimBP);
+		GEditor->SyncBrowserToObjects(ObjectsToSync);
+	}
 	
 	return true;
 }
@@ -9239,6 +9753,7 @@ void SControlRigToolWidget::OnPhysAssetMeshSelectionChanged(TSharedPtr<FString>
 	}
 	
 	// 매핑 초기화
+	SetTabMappingSession(PhysAssetMappingSession, nullptr);
 	PhysAssetBoneMapping.Empty();
 	PhysAssetMainBones.Empty();
 	UpdatePhysAssetBoneListUI();
@@ -9246,6 +9761,7 @@ void SControlRigToolWidget::OnPhysAssetMeshSelectionChanged(TSharedPtr<FString>
 	if (NewValue.IsValid())
 	{
 		UE_LOG(LogTemp, Log, TEXT("[PhysicsAsset] Selected mesh: %s"), **NewValue);
+		StartSelectionPrefetch(FAssetCatalog::Get().FindPackagePathByName(EAssetCatalogClass::SkeletalMesh, *NewValue));
 	}
 }
 
@@ -9268,19 +9784,16 @@ FReply SControlRigToolWidget::OnUseSelectedPhysAssetMeshClicked()
 	{
 		if (Asset.AssetClassPath == USkeletalMesh::StaticClass()->GetClassPathName())
 		{
-			FString AssetName = Asset.AssetName.ToString();
-			for (TSharedPtr<FString>& Option : MeshOptions)
+			if (const FAssetCatalogEntry* Entry = FAssetCatalog::Get().FindByPackage(EAssetCatalogClass::SkeletalMesh, Asset.PackageName.ToString()))
 			{
-				if (*Option == AssetName)
+				TSharedPtr<FString> Option = Entry->NameOption;
+				SelectedPhysAssetMesh = Option;
+				if (PhysAssetMeshComboBox.IsValid())
 				{
-					SelectedPhysAssetMesh = Option;
-					if (PhysAssetMeshComboBox.IsValid())
-					{
-						PhysAssetMeshComboBox->SetSelectedItem(Option);
-					}
-					OnPhysAssetMeshSelectionChanged(Option, ESelectInfo::Direct);
-					return FReply::Handled();
+					PhysAssetMeshComboBox->SetSelectedItem(Option);
 				}
+				OnPhysAssetMeshSelectionChanged(Option, ESelectInfo::Direct);
+				return FReply::Handled();
 			}
 		}
 	}
@@ -9297,20 +9810,13 @@ void SControlRigToolWidget::UpdatePhysAssetMeshThumbnail()
 	
 	if (SelectedPhysAssetMesh.IsValid())
 	{
-		FString AssetPath;
-		for (const FAssetInfo& MeshInfo : SkeletalMeshes)
-		{
-			if (MeshInfo.Name == *SelectedPhysAssetMesh)
-			{
-				AssetPath = MeshInfo.Path;
-				break;
-			}
-		}
+		FString AssetPath = FAssetCatalog::Get().FindPackagePathByName(EAssetCatalogClass::SkeletalMesh, *SelectedPhysAssetMesh);
 		
 		if (!AssetPath.IsEmpty())
 		{
+			// 에셋 데이터로 썸네일 (메쉬 로드 없음)
 			PhysAssetMeshThumbnail = MakeShared<FAssetThumbnail>(
-				LoadObject<UObject>(nullptr, *AssetPath),
+				FMeshBoneHierarchy::GetAssetData(AssetPath),
 				64, 64, ThumbnailPool
 			);
 			
@@ -9362,13 +9868,13 @@ void SControlRigToolWidget::UpdatePhysAssetBoneListUI()
 	for (const FName& BoneName : PhysAssetMainBones)
 	{
 		FName MappedBone = NAME_None;
-		for (auto& Pair : PhysAssetBoneMapping)
+		if (PhysAssetBoneMapping.ContainsSource(BoneName))
 		{
-			if (Pair.Value == BoneName || Pair.Key == BoneName)
-			{
-				MappedBone = Pair.Value;
-				break;
-			}
+			MappedBone = BoneName;
+		}
+		else if (const FName* Source = PhysAssetBoneMapping.Find(BoneName))
+		{
+			MappedBone = *Source;
 		}
 		
 		PhysAssetBoneListBox->AddSlot()
@@ -9402,129 +9908,20 @@ FReply SControlRigToolWidget::OnPhysAssetBoneMappingClicked()
 		return FReply::Handled();
 	}
 	
-	SetPhysAssetStatus(TEXT("Running AI Bone Mapping..."));
-	
-	// 기존 Control Rig 탭의 AI 본 매핑 로직 재사용
-	// LastBoneMapping에서 결과를 가져옴
-	if (LastBoneMapping.Num() > 0)
-	{
-		PhysAssetBoneMapping = LastBoneMapping;
-		PhysAssetMainBones.Empty();
-		
-		for (auto& Pair : LastBoneMapping)
-		{
-			PhysAssetMainBones.Add(Pair.Value);
-		}
-		
-		UpdatePhysAssetBoneListUI();
-		SetPhysAssetStatus(FString::Printf(TEXT("Found %d main bones from existing mapping"), PhysAssetMainBones.Num()));
-		return FReply::Handled();
-	}
-	
-	// 새로 매핑 실행 (간단히 API 호출)
-	// 여기서는 기존 OnAIBoneMappingClicked 로직을 공유하거나 호출할 수 있음
-	// 우선 간단하게 처리
-	
-	// 메쉬 로드
-	USkeletalMesh* TargetMesh = nullptr;
-	for (const FAssetInfo& MeshInfo : SkeletalMeshes)
-	{
-		if (MeshInfo.Name == *SelectedPhysAssetMesh)
-		{
-			TargetMesh = Cast<USkeletalMesh>(LoadObject<USkeletalMesh>(nullptr, *MeshInfo.Path));
-			break;
-		}
-	}
-	
-	if (!TargetMesh)
+	const FString TargetMeshPath = FAssetCatalog::Get().FindPackagePathByName(EAssetCatalogClass::SkeletalMesh, *SelectedPhysAssetMesh);
+	if (TargetMeshPath.IsEmpty())
 	{
 		SetPhysAssetStatus(TEXT("Failed to load skeletal mesh"));
 		return FReply::Handled();
 	}
 	
-	// 본 정보 수집 및 API 호출
-	const FReferenceSkeleton& RefSkeleton = TargetMesh->GetRefSkeleton();
-	TArray<TSharedPtr<FJsonValue>> BonesArray;
-	
-	for (int32 i = 0; i < RefSkeleton.GetNum(); ++i)
+	// 선택된 메쉬의 세션 사용 (Control Rig / IK Rig 탭에서 같은 메쉬를 매핑했으면 요청 없이 재사용)
+	TSharedRef<FBoneMappingSession> Session = AcquireMappingSession(PhysAssetMappingSession, TargetMeshPath);
+	if (Session->RequestMapping() || Session->GetState() == EBoneMappingSessionState::Requesting)
 	{
-		TSharedPtr<FJsonObject> BoneObj = MakeShared<FJsonObject>();
-		FName BoneName = RefSkeleton.GetBoneName(i);
-		int32 ParentIdx = RefSkeleton.GetParentIndex(i);
-		
-		BoneObj->SetStringField(TEXT("name"), BoneName.ToString());
-		BoneObj->SetStringField(TEXT("parent"), ParentIdx >= 0 ? RefSkeleton.GetBoneName(ParentIdx).ToString() : TEXT(""));
-		
-		// 자식 본 찾기
-		TArray<TSharedPtr<FJsonValue>> ChildrenArray;
-		for (int32 j = 0; j < RefSkeleton.GetNum(); ++j)
-		{
-			if (RefSkeleton.GetParentIndex(j) == i)
-			{
-				ChildrenArray.Add(MakeShared<FJsonValueString>(RefSkeleton.GetBoneName(j).ToString()));
-			}
-		}
-		BoneObj->SetArrayField(TEXT("children"), ChildrenArray);
-		
-		BonesArray.Add(MakeShared<FJsonValueObject>(BoneObj));
+		ApplyMappingSessionToPhysAssetTab(EBoneMappingSessionChange::State);
 	}
 	
-	// API 요청
-	TSharedPtr<FJsonObject> RequestObj = MakeShared<FJsonObject>();
-	RequestObj->SetArrayField(TEXT("bones"), BonesArray);
-	
-	FString RequestBody;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&RequestBody);
-	FJsonSerializer::Serialize(RequestObj.ToSharedRef(), Writer);
-	
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
-	HttpRequest->SetURL(TEXT("http://localhost:8000/predict"));
-	HttpRequest->SetVerb(TEXT("POST"));
-	HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-	HttpRequest->SetContentAsString(RequestBody);
-	
-	HttpRequest->OnProcessRequestComplete().BindLambda([this](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess)
-	{
-		if (bSuccess && Response.IsValid() && Response->GetResponseCode() == 200)
-		{
-			TSharedPtr<FJsonObject> JsonResponse;
-			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
-			
-			if (FJsonSerializer::Deserialize(Reader, JsonResponse) && JsonResponse.IsValid())
-			{
-				const TSharedPtr<FJsonObject>* MappingObj;
-				if (JsonResponse->TryGetObjectField(TEXT("mapping"), MappingObj))
-				{
-					PhysAssetBoneMapping.Empty();
-					PhysAssetMainBones.Empty();
-					
-					for (auto& Pair : (*MappingObj)->Values)
-					{
-						FName StandardBone = FName(*Pair.Key);
-						FName MeshBone = FName(*Pair.Value->AsString());
-						PhysAssetBoneMapping.Add(StandardBone, MeshBone);
-						PhysAssetMainBones.Add(MeshBone);
-					}
-					
-					AsyncTask(ENamedThreads::GameThread, [this]()
-					{
-						UpdatePhysAssetBoneListUI();
-						SetPhysAssetStatus(FString::Printf(TEXT("Found %d main bones"), PhysAssetMainBones.Num()));
-					});
-				}
-			}
-		}
-		else
-		{
-			AsyncTask(ENamedThreads::GameThread, [this]()
-			{
-				SetPhysAssetStatus(TEXT("API Error - Make sure API server is running"));
-			});
-		}
-	});
-	
-	HttpRequest->ProcessRequest();
-	
 	return FReply::Handled();
 }
 
@@ -9554,15 +9951,16 @@ bool SControlRigToolWidget::CreatePhysicsAsset()
 		return false;
 	}
 	
+	// 실패/취소 시 새로 만든 Physics Asset 삭제
+	FGenerationPipeline Pipeline(TEXT("Create Physics Asset"), bHeadless, [this](const FString& Message) { SetPhysAssetStatus(Message); });
+	
 	// 1. 스켈레탈 메쉬 로드
+	if (!Pipeline.EnterStage(EGenerationStage::Load)) return false;
 	USkeletalMesh* TargetMesh = nullptr;
-	for (const FAssetInfo& MeshInfo : SkeletalMeshes)
+	const FString TargetMeshPath = FAssetCatalog::Get().FindPackagePathByName(EAssetCatalogClass::SkeletalMesh, *SelectedPhysAssetMesh);
+	if (!TargetMeshPath.IsEmpty())
 	{
-		if (MeshInfo.Name == *SelectedPhysAssetMesh)
-		{
-			TargetMesh = Cast<USkeletalMesh>(LoadObject<USkeletalMesh>(nullptr, *MeshInfo.Path));
-			break;
-		}
+		TargetMesh = LoadObject<USkeletalMesh>(nullptr, *TargetMeshPath);
 	}
 	
 	if (!TargetMesh)
@@ -9588,386 +9986,405 @@ bool SControlRigToolWidget::CreatePhysicsAsset()
 	FString PackagePath = OutputFolder / OutputName;
 	FString PackageName = FPackageName::ObjectPathToPackageName(PackagePath);
 	
-	// 3. 기존 에셋 삭제 (있는 경우)
-	UPackage* ExistingPackage = FindPackage(nullptr, *PackageName);
-	if (ExistingPackage)
-	{
-		UPhysicsAsset* ExistingAsset = FindObject<UPhysicsAsset>(ExistingPackage, *OutputName);
-		if (ExistingAsset)
-		{
-			UE_LOG(LogTemp, Log, TEXT("[PhysicsAsset] Deleting existing asset: %s"), *PackageName);
-			GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->CloseAllEditorsForAsset(ExistingAsset);
-			
-			TArray<UObject*> ObjectsToDelete;
-			ObjectsToDelete.Add(ExistingAsset);
-			ObjectTools::ForceDeleteObjects(ObjectsToDelete, false);
-		}
-	}
-	
-	// 4. 새 패키지 생성
-	UPackage* Package = CreatePackage(*PackageName);
-	if (!Package)
-	{
-		SetPhysAssetStatus(TEXT("Failed to create package"));
-		return false;
-	}
-	
-	// 5. Physics Asset 생성
-	UPhysicsAsset* PhysAsset = NewObject<UPhysicsAsset>(Package, *OutputName, RF_Public | RF_Standalone);
-	if (!PhysAsset)
-	{
-		SetPhysAssetStatus(TEXT("Failed to create Physics Asset"));
-		return false;
-	}
-	
-	// 6. 스켈레톤 정보 가져오기
+	// 3. 스켈레톤 정보 가져오기
+	if (!Pipeline.EnterStage(EGenerationStage::Analyze)) return false;
 	const FReferenceSkeleton& RefSkeleton = TargetMesh->GetRefSkeleton();
 	const TArray<FTransform>& RefBonePose = RefSkeleton.GetRefBonePose();
+	const FSkeletonTopology& Topology = GetSkeletonTopology(TargetMesh);
+	
+	// 4. 버텍스 기반 본 크기 계산 (메쉬 두께 반영, 메쉬별 캐시, 워커 스레드)
+	if (!PrewarmVertexAnalysis(Pipeline, TargetMesh)) return false;
+	const TSharedRef<const FMeshVertexAnalysis> VertexAnalysis = FBoneVertexAnalysisCache::Get().GetAnalysis(TargetMesh);
+	UE_LOG(LogTemp, Log, TEXT("[PhysicsAsset] Vertex info for %d bones"), VertexAnalysis->Num());
+	
+	// 5. 본별 캡슐 피팅 (CPU 전용 → 워커 스레드, UObject는 건드리지 않음)
+	struct FCapsuleFit
+	{
+		FName BoneName;
+		FVector Center;
+		FRotator Rotation;
+		float Radius;
+		float Length;
+		float BoneLength;
+		FVector Direction;
+	};
+	TArray<FCapsuleFit> CapsuleFits;
+	CapsuleFits.Reserve(PhysAssetMainBones.Num());
 	
-	// 6.5 버텍스 기반 본 크기 계산 (메쉬 두께 반영)
-	TArray<FBoneVertInfo> BoneVertInfos;
-	FMeshUtilitiesEngine::CalcBoneVertInfos(TargetMesh, BoneVertInfos, true);
-	UE_LOG(LogTemp, Log, TEXT("[PhysicsAsset] Calculated vertex info for %d bones"), BoneVertInfos.Num());
-	
-	int32 BodiesCreated = 0;
+	// 분류기 초기화는 게임 스레드에서 (워커에서는 읽기만)
+	const FBoneKeywordClassifier& Classifier = FBoneKeywordClassifier::Get();
 	
-	// 7. 각 메인 본에 대해 BodySetup 생성
-	for (const FName& BoneName : PhysAssetMainBones)
+	if (!Pipeline.EnterStage(EGenerationStage::Map)) return false;
+	const bool bFitted = Pipeline.RunInBackground([&]()
 	{
-		// Root 본은 캡슐 생성 제외
-		FString RootCheckName = BoneName.ToString().ToLower();
-		if (RootCheckName.Contains(TEXT("root")))
-		{
-			UE_LOG(LogTemp, Log, TEXT("[PhysicsAsset] Skipping root bone: %s"), *BoneName.ToString());
-			continue;
-		}
-		
-		int32 BoneIndex = RefSkeleton.FindBoneIndex(BoneName);
-		if (BoneIndex == INDEX_NONE)
+		for (const FName& BoneName : PhysAssetMainBones)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("[PhysicsAsset] Bone not found: %s"), *BoneName.ToString());
-			continue;
-		}
-		
-		// 부모가 없는 본(진짜 루트)도 제외
-		int32 ParentIndex = RefSkeleton.GetParentIndex(BoneIndex);
-		if (ParentIndex == INDEX_NONE)
-		{
-			UE_LOG(LogTemp, Log, TEXT("[PhysicsAsset] Skipping root bone (no parent): %s"), *BoneName.ToString());
-			continue;
-		}
-		
-		// 본 길이 계산 (자식 본까지의 평균 거리)
-		float BoneLength = 10.0f; // 기본값
-		float BoneRadius = 5.0f;  // 기본 반지름
-		
-		// ★ 버텍스 기반 크기 계산 (메쉬 두께 반영)
-		float VertexBasedRadius = 5.0f;
-		float VertexBasedLength = 10.0f;
-		FVector VertexCenter = FVector::ZeroVector;
-		FVector VertexBoxSize = FVector::ZeroVector;
-		bool bHasVertexInfo = false;
-		
-		if (BoneIndex < BoneVertInfos.Num() && BoneVertInfos[BoneIndex].Positions.Num() > 0)
-		{
-			const FBoneVertInfo& VertInfo = BoneVertInfos[BoneIndex];
-			bHasVertexInfo = true;
+			// 본 이름 키워드 분류 (한 번의 스캔으로 아래 규칙 전부 판정)
+			const EBoneKeyword BoneKeywords = Classifier.Classify(BoneName.ToString());
+			
+			// Root 본은 캡슐 생성 제외
+			if (EnumHasAnyFlags(BoneKeywords, EBoneKeyword::PhysicsSkip))
+			{
+				UE_LOG(LogTemp, Log, TEXT("[PhysicsAsset] Skipping root bone: %s"), *BoneName.ToString());
+				continue;
+			}
 			
-			// 버텍스 바운딩 박스 계산
-			FBox VertexBox(ForceInit);
-			for (const FVector3f& Pos : VertInfo.Positions)
+			int32 BoneIndex = Topology.FindBoneIndex(BoneName);
+			if (BoneIndex == INDEX_NONE)
 			{
-				VertexBox += FVector(Pos);
+				UE_LOG(LogTemp, Warning, TEXT("[PhysicsAsset] Bone not found: %s"), *BoneName.ToString());
+				continue;
 			}
 			
-			VertexBoxSize = VertexBox.GetSize();
-			VertexCenter = VertexBox.GetCenter();
+			// 부모가 없는 본(진짜 루트)도 제외
+			int32 ParentIndex = Topology.GetParent(BoneIndex);
+			if (ParentIndex == INDEX_NONE)
+			{
+				UE_LOG(LogTemp, Log, TEXT("[PhysicsAsset] Skipping root bone (no parent): %s"), *BoneName.ToString());
+				continue;
+			}
 			
-			// 가장 긴 축을 길이로, 나머지 두 축 평균을 반지름으로
-			float MaxAxis = FMath::Max3(VertexBoxSize.X, VertexBoxSize.Y, VertexBoxSize.Z);
-			float SumOtherAxes = VertexBoxSize.X + VertexBoxSize.Y + VertexBoxSize.Z - MaxAxis;
+			// 본 길이 계산 (자식 본까지의 평균 거리)
+			float BoneLength = 10.0f; // 기본값
+			float BoneRadius = 5.0f;  // 기본 반지름
 			
-			VertexBasedLength = MaxAxis;
-			VertexBasedRadius = SumOtherAxes * 0.25f; // 나머지 두 축 평균의 절반
-			VertexBasedRadius = FMath::Clamp(VertexBasedRadius, 2.0f, MaxAxis * 0.4f); // 반지름이 길이보다 크지 않도록
+			// ★ 버텍스 기반 크기 계산 (메쉬 두께 반영)
+			float VertexBasedRadius = 5.0f;
+			float VertexBasedLength = 10.0f;
+			FVector VertexCenter = FVector::ZeroVector;
+			FVector VertexBoxSize = FVector::ZeroVector;
+			bool bHasVertexInfo = false;
 			
-			UE_LOG(LogTemp, Log, TEXT("[PhysicsAsset] %s vertex box: (%.1f, %.1f, %.1f), length=%.1f, radius=%.1f"), 
-				*BoneName.ToString(), VertexBoxSize.X, VertexBoxSize.Y, VertexBoxSize.Z, VertexBasedLength, VertexBasedRadius);
-		}
-		
-		// 자식 본들의 위치를 확인해서 길이 계산
-		TArray<int32> ChildIndices;
-		for (int32 i = 0; i < RefSkeleton.GetNum(); ++i)
-		{
-			if (RefSkeleton.GetParentIndex(i) == BoneIndex)
+			if (const FBoneVertexStats* VertexStats = VertexAnalysis->GetBone(BoneIndex))
 			{
-				ChildIndices.Add(i);
+				bHasVertexInfo = true;
+				
+				// 버텍스 바운딩 박스
+				const FBox& VertexBox = VertexStats->Bounds;
+				
+				VertexBoxSize = VertexBox.GetSize();
+				VertexCenter = VertexBox.GetCenter();
+				
+				// 가장 긴 축을 길이로, 나머지 두 축 평균을 반지름으로
+				float MaxAxis = FMath::Max3(VertexBoxSize.X, VertexBoxSize.Y, VertexBoxSize.Z);
+				float SumOtherAxes = VertexBoxSize.X + VertexBoxSize.Y + VertexBoxSize.Z - MaxAxis;
+				
+				VertexBasedLength = MaxAxis;
+				VertexBasedRadius = SumOtherAxes * 0.25f; // 나머지 두 축 평균의 절반
+				VertexBasedRadius = FMath::Clamp(VertexBasedRadius, 2.0f, MaxAxis * 0.4f); // 반지름이 길이보다 크지 않도록
+				
+				UE_LOG(LogTemp, Log, TEXT("[PhysicsAsset] %s vertex box: (%.1f, %.1f, %.1f), length=%.1f, radius=%.1f"), 
+					*BoneName.ToString(), VertexBoxSize.X, VertexBoxSize.Y, VertexBoxSize.Z, VertexBasedLength, VertexBasedRadius);
 			}
-		}
-		
-		// 자식 본 방향 계산 (캡슐 방향 결정용)
-		FVector BoneDirection = FVector::XAxisVector; // 기본값: X축
-		
-		if (ChildIndices.Num() > 0)
-		{
-			// 자식 본들까지의 평균 거리 및 방향 계산
-			FVector AvgChildDirection = FVector::ZeroVector;
-			float TotalLength = 0.0f;
 			
-			for (int32 ChildIndex : ChildIndices)
+			// 자식 본들의 위치를 확인해서 길이 계산
+			const TArrayView<const int32> ChildIndices = Topology.GetChildren(BoneIndex);
+			
+			// 자식 본 방향 계산 (캡슐 방향 결정용)
+			FVector BoneDirection = FVector::XAxisVector; // 기본값: X축
+			
+			if (ChildIndices.Num() > 0)
 			{
-				FVector ChildLocalPos = RefBonePose[ChildIndex].GetLocation();
-				float ChildDist = ChildLocalPos.Size();
-				TotalLength += ChildDist;
+				// 자식 본들까지의 평균 거리 및 방향 계산
+				FVector AvgChildDirection = FVector::ZeroVector;
+				float TotalLength = 0.0f;
+				
+				for (int32 ChildIndex : ChildIndices)
+				{
+					FVector ChildLocalPos = RefBonePose[ChildIndex].GetLocation();
+					float ChildDist = ChildLocalPos.Size();
+					TotalLength += ChildDist;
+					
+					if (ChildDist > KINDA_SMALL_NUMBER)
+					{
+						AvgChildDirection += ChildLocalPos.GetSafeNormal();
+					}
+				}
+				
+				BoneLength = FMath::Max(TotalLength / ChildIndices.Num(), 5.0f);
 				
-				if (ChildDist > KINDA_SMALL_NUMBER)
+				// 평균 방향 계산
+				if (!AvgChildDirection.IsNearlyZero())
 				{
-					AvgChildDirection += ChildLocalPos.GetSafeNormal();
+					BoneDirection = AvgChildDirection.GetSafeNormal();
+				}
+			}
+			else
+			{
+				// 자식 본이 없으면 자신의 로컬 위치 방향 사용 (부모로부터의 방향)
+				FVector BoneLocalPos = RefBonePose[BoneIndex].GetLocation();
+				BoneLength = FMath::Max(BoneLocalPos.Size() * 0.5f, 5.0f);
+				
+				if (!BoneLocalPos.IsNearlyZero())
+				{
+					BoneDirection = BoneLocalPos.GetSafeNormal();
 				}
 			}
 			
-			BoneLength = FMath::Max(TotalLength / ChildIndices.Num(), 5.0f);
+			// 본 이름에 따라 회전 고정 및 크기 제한 결정
+			bool bForceZeroRotation = false; // spine 등은 회전 0으로 고정
+			float MaxRadiusLimit = 30.0f; // 기본 최대 반지름
 			
-			// 평균 방향 계산
-			if (!AvgChildDirection.IsNearlyZero())
+			// pelvis, spine 계열만 회전 0으로 고정 (세로 방향 몸통)
+			if (EnumHasAnyFlags(BoneKeywords, EBoneKeyword::PhysicsUpright))
 			{
-				BoneDirection = AvgChildDirection.GetSafeNormal();
+				bForceZeroRotation = true;
 			}
-		}
-		else
-		{
-			// 자식 본이 없으면 자신의 로컬 위치 방향 사용 (부모로부터의 방향)
-			FVector BoneLocalPos = RefBonePose[BoneIndex].GetLocation();
-			BoneLength = FMath::Max(BoneLocalPos.Size() * 0.5f, 5.0f);
 			
-			if (!BoneLocalPos.IsNearlyZero())
+			// 본 이름별 반지름 범위 설정
+			float MinRadiusLimit = 4.0f; // 기본 최소 반지름
+			
+			if (EnumHasAnyFlags(BoneKeywords, EBoneKeyword::PhysicsFinger))
 			{
-				BoneDirection = BoneLocalPos.GetSafeNormal();
+				MinRadiusLimit = 1.5f;
+				MaxRadiusLimit = 3.0f; // 손가락
 			}
-		}
-		
-		// 본 이름에 따라 회전 고정 및 크기 제한 결정
-		FString BoneNameStr = BoneName.ToString().ToLower();
-		bool bForceZeroRotation = false; // spine 등은 회전 0으로 고정
-		float MaxRadiusLimit = 30.0f; // 기본 최대 반지름
-		
-		// pelvis, spine 계열만 회전 0으로 고정 (세로 방향 몸통)
-		if (BoneNameStr.Contains(TEXT("spine")) || BoneNameStr.Contains(TEXT("pelvis")) || 
-		    BoneNameStr.Contains(TEXT("hips")))
-		{
-			bForceZeroRotation = true;
-		}
-		
-		// 본 이름별 반지름 범위 설정
-		float MinRadiusLimit = 4.0f; // 기본 최소 반지름
-		
-		if (BoneNameStr.Contains(TEXT("finger")) || BoneNameStr.Contains(TEXT("thumb")) ||
-		    BoneNameStr.Contains(TEXT("index")) || BoneNameStr.Contains(TEXT("middle")) ||
-		    BoneNameStr.Contains(TEXT("ring")) || BoneNameStr.Contains(TEXT("pinky")))
-		{
-			MinRadiusLimit = 1.5f;
-			MaxRadiusLimit = 3.0f; // 손가락
-		}
-		else if (BoneNameStr.Contains(TEXT("hand")) || BoneNameStr.Contains(TEXT("wrist")))
-		{
-			MinRadiusLimit = 3.0f;
-			MaxRadiusLimit = 6.0f; // 손목/손
-		}
-		else if (BoneNameStr.Contains(TEXT("clavicle")) || BoneNameStr.Contains(TEXT("shoulder")))
-		{
-			MinRadiusLimit = 3.0f;
-			MaxRadiusLimit = 5.0f; // 쇄골 (얇게)
-		}
-		else if (BoneNameStr.Contains(TEXT("spine")))
-		{
-			MinRadiusLimit = 5.0f;
-			MaxRadiusLimit = 10.0f; // spine 반지름 제한 (너무 크지 않게)
-		}
-		else if (BoneNameStr.Contains(TEXT("upperarm")) || BoneNameStr.Contains(TEXT("upper_arm")))
-		{
-			MinRadiusLimit = 6.0f; // upperarm 더 크게
-			MaxRadiusLimit = 15.0f;
-		}
-		else if (BoneNameStr.Contains(TEXT("forearm")) || BoneNameStr.Contains(TEXT("lowerarm")) || BoneNameStr.Contains(TEXT("lower_arm")))
-		{
-			MinRadiusLimit = 5.0f;
-			MaxRadiusLimit = 12.0f;
-		}
-		
-		// ★ 길이/반지름 계산: 버텍스 기반 우선, 없으면 본 길이 기반 폴백
-		if (bHasVertexInfo)
-		{
-			// 버텍스 기반 사용 (메쉬 실제 크기 반영)
-			BoneLength = VertexBasedLength;
-			BoneRadius = VertexBasedRadius;
-		}
-		else
-		{
-			// 버텍스 정보 없으면 본 길이의 25%
-			BoneRadius = FMath::Clamp(BoneLength * 0.25f, 3.0f, 20.0f);
-		}
-		
-		// 캡슐 방향, 길이, 반지름, 중심 계산
-		FRotator CapsuleRotator;
-		FVector CapsuleCenter;
-		float CapsuleLength;
-		
-		// ★ 캡슐 방향 결정
-		if (bForceZeroRotation)
-		{
-			// spine/pelvis는 항상 Z축 정렬 (회전 없음)
-			CapsuleRotator = FRotator::ZeroRotator;
-		}
-		else
-		{
-			// 다른 본은 자식 본 방향 기반
-			FQuat CapsuleRotation = FQuat::FindBetweenNormals(FVector::ZAxisVector, BoneDirection);
-			CapsuleRotator = CapsuleRotation.Rotator();
-		}
-		
-		if (bHasVertexInfo)
-		{
-			// ★ 버텍스 박스에서 크기 가져오기
-			float LengthAxis, Axis1, Axis2;
+			else if (EnumHasAnyFlags(BoneKeywords, EBoneKeyword::PhysicsHand))
+			{
+				MinRadiusLimit = 3.0f;
+				MaxRadiusLimit = 6.0f; // 손목/손
+			}
+			else if (EnumHasAnyFlags(BoneKeywords, EBoneKeyword::PhysicsClavicle))
+			{
+				MinRadiusLimit = 3.0f;
+				MaxRadiusLimit = 5.0f; // 쇄골 (얇게)
+			}
+			else if (EnumHasAnyFlags(BoneKeywords, EBoneKeyword::PhysicsSpine))
+			{
+				MinRadiusLimit = 5.0f;
+				MaxRadiusLimit = 10.0f; // spine 반지름 제한 (너무 크지 않게)
+			}
+			else if (EnumHasAnyFlags(BoneKeywords, EBoneKeyword::PhysicsUpperArm))
+			{
+				MinRadiusLimit = 6.0f; // upperarm 더 크게
+				MaxRadiusLimit = 15.0f;
+			}
+			else if (EnumHasAnyFlags(BoneKeywords, EBoneKeyword::PhysicsLowerArm))
+			{
+				MinRadiusLimit = 5.0f;
+				MaxRadiusLimit = 12.0f;
+			}
+			
+			// ★ 길이/반지름 계산: 버텍스 기반 우선, 없으면 본 길이 기반 폴백
+			if (bHasVertexInfo)
+			{
+				// 버텍스 기반 사용 (메쉬 실제 크기 반영)
+				BoneLength = VertexBasedLength;
+				BoneRadius = VertexBasedRadius;
+			}
+			else
+			{
+				// 버텍스 정보 없으면 본 길이의 25%
+				BoneRadius = FMath::Clamp(BoneLength * 0.25f, 3.0f, 20.0f);
+			}
+			
+			// 캡슐 방향, 길이, 반지름, 중심 계산
+			FRotator CapsuleRotator;
+			FVector CapsuleCenter;
+			float CapsuleLength;
 			
+			// ★ 캡슐 방향 결정
 			if (bForceZeroRotation)
 			{
-				// spine/pelvis는 항상 Z축이 길이
-				LengthAxis = VertexBoxSize.Z;
-				Axis1 = VertexBoxSize.X;
-				Axis2 = VertexBoxSize.Y;
+				// spine/pelvis는 항상 Z축 정렬 (회전 없음)
+				CapsuleRotator = FRotator::ZeroRotator;
 			}
 			else
 			{
-				// 본 방향 축의 크기 = 길이
-				FVector AbsDir = BoneDirection.GetAbs();
-				if (AbsDir.X >= AbsDir.Y && AbsDir.X >= AbsDir.Z)
-				{
-					LengthAxis = VertexBoxSize.X;
-					Axis1 = VertexBoxSize.Y;
-					Axis2 = VertexBoxSize.Z;
-				}
-				else if (AbsDir.Y >= AbsDir.X && AbsDir.Y >= AbsDir.Z)
+				// 다른 본은 자식 본 방향 기반
+				FQuat CapsuleRotation = FQuat::FindBetweenNormals(FVector::ZAxisVector, BoneDirection);
+				CapsuleRotator = CapsuleRotation.Rotator();
+			}
+			
+			if (bHasVertexInfo)
+			{
+				// ★ 버텍스 박스에서 크기 가져오기
+				float LengthAxis, Axis1, Axis2;
+				
+				if (bForceZeroRotation)
 				{
-					LengthAxis = VertexBoxSize.Y;
+					// spine/pelvis는 항상 Z축이 길이
+					LengthAxis = VertexBoxSize.Z;
 					Axis1 = VertexBoxSize.X;
-					Axis2 = VertexBoxSize.Z;
+					Axis2 = VertexBoxSize.Y;
 				}
 				else
 				{
-					LengthAxis = VertexBoxSize.Z;
-					Axis1 = VertexBoxSize.X;
-					Axis2 = VertexBoxSize.Y;
+					// 본 방향 축의 크기 = 길이
+					FVector AbsDir = BoneDirection.GetAbs();
+					if (AbsDir.X >= AbsDir.Y && AbsDir.X >= AbsDir.Z)
+					{
+						LengthAxis = VertexBoxSize.X;
+						Axis1 = VertexBoxSize.Y;
+						Axis2 = VertexBoxSize.Z;
+					}
+					else if (AbsDir.Y >= AbsDir.X && AbsDir.Y >= AbsDir.Z)
+					{
+						LengthAxis = VertexBoxSize.Y;
+						Axis1 = VertexBoxSize.X;
+						Axis2 = VertexBoxSize.Z;
+					}
+					else
+					{
+						LengthAxis = VertexBoxSize.Z;
+						Axis1 = VertexBoxSize.X;
+						Axis2 = VertexBoxSize.Y;
+					}
 				}
-			}
-			
-			// 길이와 반지름 계산
-			float OriginalBoneLength = BoneLength; // 자식 본까지의 거리 (원래 값 보존)
-			BoneLength = FMath::Max(LengthAxis, 5.0f);
-			BoneRadius = FMath::Max(Axis1, Axis2) * 0.5f;
-			
-			// ★ upperarm만 특별 처리 (버텍스 박스가 너무 작음)
-			if (BoneNameStr.Contains(TEXT("upperarm")) || BoneNameStr.Contains(TEXT("upper_arm")))
-			{
-				// 버텍스 박스와 본 체인 길이 중 큰 값 사용
-				BoneLength = FMath::Max(LengthAxis, OriginalBoneLength);
 				
-				// 반지름 = 버텍스 박스의 두께 또는 본 길이의 30% 중 큰 값
-				float VertexRadius = FMath::Max(Axis1, Axis2) * 0.5f;
-				float LengthBasedRadius = BoneLength * 0.30f;
-				BoneRadius = FMath::Max(VertexRadius, LengthBasedRadius);
-				BoneRadius = FMath::Clamp(BoneRadius, 5.0f, 12.0f); // 5~12 범위
+				// 길이와 반지름 계산
+				float OriginalBoneLength = BoneLength; // 자식 본까지의 거리 (원래 값 보존)
+				BoneLength = FMath::Max(LengthAxis, 5.0f);
+				BoneRadius = FMath::Max(Axis1, Axis2) * 0.5f;
+				
+				// ★ upperarm만 특별 처리 (버텍스 박스가 너무 작음)
+				if (EnumHasAnyFlags(BoneKeywords, EBoneKeyword::PhysicsUpperArm))
+				{
+					// 버텍스 박스와 본 체인 길이 중 큰 값 사용
+					BoneLength = FMath::Max(LengthAxis, OriginalBoneLength);
+					
+					// 반지름 = 버텍스 박스의 두께 또는 본 길이의 30% 중 큰 값
+					float VertexRadius = FMath::Max(Axis1, Axis2) * 0.5f;
+					float LengthBasedRadius = BoneLength * 0.30f;
+					BoneRadius = FMath::Max(VertexRadius, LengthBasedRadius);
+					BoneRadius = FMath::Clamp(BoneRadius, 5.0f, 12.0f); // 5~12 범위
+					
+					UE_LOG(LogTemp, Warning, TEXT("[PhysicsAsset] UPPERARM %s: VertexBox=(%.1f,%.1f,%.1f), BoneChainLen=%.1f -> Final Length=%.1f, Radius=%.1f"),
+						*BoneName.ToString(), VertexBoxSize.X, VertexBoxSize.Y, VertexBoxSize.Z, OriginalBoneLength, BoneLength, BoneRadius);
+				}
+				
+				BoneRadius = FMath::Clamp(BoneRadius, MinRadiusLimit, MaxRadiusLimit); // 본 타입별 최소/최대 적용
+				
+				// 캡슐 길이 = 전체 길이 - 양쪽 반구 (최소 5 보장으로 구체 방지)
+				CapsuleLength = BoneLength - BoneRadius * 2.0f;
+				
+				// 캡슐 길이가 너무 짧으면 반지름을 줄여서 캡슐 형태 유지
+				if (CapsuleLength < 5.0f)
+				{
+					// 최소 길이 5를 확보하면서 반지름 재계산
+					BoneRadius = FMath::Max((BoneLength - 5.0f) * 0.5f, MinRadiusLimit * 0.5f);
+					CapsuleLength = FMath::Max(BoneLength - BoneRadius * 2.0f, 5.0f);
+				}
+				
+				// 버텍스 중심을 캡슐 중심으로 사용
+				CapsuleCenter = VertexCenter;
 				
-				UE_LOG(LogTemp, Warning, TEXT("[PhysicsAsset] UPPERARM %s: VertexBox=(%.1f,%.1f,%.1f), BoneChainLen=%.1f -> Final Length=%.1f, Radius=%.1f"),
-					*BoneName.ToString(), VertexBoxSize.X, VertexBoxSize.Y, VertexBoxSize.Z, OriginalBoneLength, BoneLength, BoneRadius);
+				UE_LOG(LogTemp, Log, TEXT("[PhysicsAsset] %s: BoxSize=(%.1f,%.1f,%.1f) -> CapsuleLen=%.1f, Radius=%.1f"),
+					*BoneName.ToString(), VertexBoxSize.X, VertexBoxSize.Y, VertexBoxSize.Z, CapsuleLength, BoneRadius);
 			}
-			
-			BoneRadius = FMath::Clamp(BoneRadius, MinRadiusLimit, MaxRadiusLimit); // 본 타입별 최소/최대 적용
-			
-			// 캡슐 길이 = 전체 길이 - 양쪽 반구 (최소 5 보장으로 구체 방지)
-			CapsuleLength = BoneLength - BoneRadius * 2.0f;
-			
-			// 캡슐 길이가 너무 짧으면 반지름을 줄여서 캡슐 형태 유지
-			if (CapsuleLength < 5.0f)
+			else
 			{
-				// 최소 길이 5를 확보하면서 반지름 재계산
-				BoneRadius = FMath::Max((BoneLength - 5.0f) * 0.5f, MinRadiusLimit * 0.5f);
+				// 버텍스 정보 없으면 자식 본 방향 기반
+				BoneRadius = FMath::Clamp(BoneRadius, MinRadiusLimit, MaxRadiusLimit);
 				CapsuleLength = FMath::Max(BoneLength - BoneRadius * 2.0f, 5.0f);
+				CapsuleCenter = BoneDirection * (BoneLength * 0.5f);
+				
+				UE_LOG(LogTemp, Warning, TEXT("[PhysicsAsset] %s: NO VERTEX INFO! Using bone chain. Length=%.1f, Radius=%.1f"),
+					*BoneName.ToString(), CapsuleLength, BoneRadius);
 			}
 			
-			// 버텍스 중심을 캡슐 중심으로 사용
-			CapsuleCenter = VertexCenter;
+			// ★★★ 팔/다리 본 강제 처리 (버텍스 유무와 관계없이, 본 방향 기준) ★★★
+			bool bForceBoneChain = EnumHasAnyFlags(BoneKeywords, EBoneKeyword::ChainLimb);
 			
-			UE_LOG(LogTemp, Log, TEXT("[PhysicsAsset] %s: BoxSize=(%.1f,%.1f,%.1f) -> CapsuleLen=%.1f, Radius=%.1f"),
-				*BoneName.ToString(), VertexBoxSize.X, VertexBoxSize.Y, VertexBoxSize.Z, CapsuleLength, BoneRadius);
-		}
-		else
-		{
-			// 버텍스 정보 없으면 자식 본 방향 기반
-			BoneRadius = FMath::Clamp(BoneRadius, MinRadiusLimit, MaxRadiusLimit);
-			CapsuleLength = FMath::Max(BoneLength - BoneRadius * 2.0f, 5.0f);
-			CapsuleCenter = BoneDirection * (BoneLength * 0.5f);
-			
-			UE_LOG(LogTemp, Warning, TEXT("[PhysicsAsset] %s: NO VERTEX INFO! Using bone chain. Length=%.1f, Radius=%.1f"),
-				*BoneName.ToString(), CapsuleLength, BoneRadius);
-		}
-		
-		// ★★★ 팔/다리 본 강제 처리 (버텍스 유무와 관계없이, 본 방향 기준) ★★★
-		bool bForceBoneChain = BoneNameStr.Contains(TEXT("upperarm")) || BoneNameStr.Contains(TEXT("upper_arm")) ||
-		                       BoneNameStr.Contains(TEXT("forearm")) || BoneNameStr.Contains(TEXT("lower_arm")) ||
-		                       BoneNameStr.Contains(TEXT("thigh")) || BoneNameStr.Contains(TEXT("calf")) ||
-		                       BoneNameStr.Contains(TEXT("shin")) || BoneNameStr.Contains(TEXT("lowerleg"));
-		
-		if (bForceBoneChain)
-		{
-			// 자식 본까지 거리 다시 계산
-			float ChildDist = 0.0f;
-			for (int32 i = 0; i < RefSkeleton.GetNum(); ++i)
+			if (bForceBoneChain)
 			{
-				if (RefSkeleton.GetParentIndex(i) == BoneIndex)
+				// 자식 본까지 거리 다시 계산
+				float ChildDist = 0.0f;
+				for (int32 ChildIndex : ChildIndices)
 				{
-					FVector ChildPos = RefBonePose[i].GetLocation();
+					FVector ChildPos = RefBonePose[ChildIndex].GetLocation();
 					ChildDist = FMath::Max(ChildDist, ChildPos.Size());
 				}
-			}
-			
-			if (ChildDist > 5.0f)
-			{
-				// 반지름 결정 (본 타입별)
-				float RadiusRatio = 0.25f; // 기본
-				float MinR = 4.0f, MaxR = 10.0f;
 				
-				if (BoneNameStr.Contains(TEXT("upperarm")) || BoneNameStr.Contains(TEXT("upper_arm")))
+				if (ChildDist > 5.0f)
 				{
-					RadiusRatio = 0.28f; MinR = 5.0f; MaxR = 10.0f;
-				}
-				else if (BoneNameStr.Contains(TEXT("forearm")) || BoneNameStr.Contains(TEXT("lower_arm")))
-				{
-					RadiusRatio = 0.22f; MinR = 3.0f; MaxR = 8.0f;
-				}
-				else if (BoneNameStr.Contains(TEXT("thigh")))
-				{
-					RadiusRatio = 0.22f; MinR = 5.0f; MaxR = 10.0f; // 조금 얇게
-				}
-				else if (BoneNameStr.Contains(TEXT("calf")) || BoneNameStr.Contains(TEXT("shin")) || BoneNameStr.Contains(TEXT("lowerleg")))
-				{
-					RadiusRatio = 0.20f; MinR = 4.0f; MaxR = 8.0f;
+					// 반지름 결정 (본 타입별)
+					float RadiusRatio = 0.25f; // 기본
+					float MinR = 4.0f, MaxR = 10.0f;
+					
+					if (EnumHasAnyFlags(BoneKeywords, EBoneKeyword::ChainUpperArm))
+					{
+						RadiusRatio = 0.28f; MinR = 5.0f; MaxR = 10.0f;
+					}
+					else if (EnumHasAnyFlags(BoneKeywords, EBoneKeyword::ChainForearm))
+					{
+						RadiusRatio = 0.22f; MinR = 3.0f; MaxR = 8.0f;
+					}
+					else if (EnumHasAnyFlags(BoneKeywords, EBoneKeyword::ChainThigh))
+					{
+						RadiusRatio = 0.22f; MinR = 5.0f; MaxR = 10.0f; // 조금 얇게
+					}
+					else if (EnumHasAnyFlags(BoneKeywords, EBoneKeyword::ChainCalf))
+					{
+						RadiusRatio = 0.20f; MinR = 4.0f; MaxR = 8.0f;
+					}
+					
+					// 캡슐 길이 = 자식 본까지 거리의 85%
+					CapsuleLength = ChildDist * 0.85f;
+					// 반지름 = 길이의 비율
+					BoneRadius = CapsuleLength * RadiusRatio;
+					BoneRadius = FMath::Clamp(BoneRadius, MinR, MaxR);
+					// 중심 = 본 방향으로 절반
+					CapsuleCenter = BoneDirection * (ChildDist * 0.5f);
+					// 캡슐 방향 = 본 방향 (버텍스 박스 무시)
+					FQuat CapsuleRot = FQuat::FindBetweenNormals(FVector::ZAxisVector, BoneDirection);
+					CapsuleRotator = CapsuleRot.Rotator();
 				}
-				
-				// 캡슐 길이 = 자식 본까지 거리의 85%
-				CapsuleLength = ChildDist * 0.85f;
-				// 반지름 = 길이의 비율
-				BoneRadius = CapsuleLength * RadiusRatio;
-				BoneRadius = FMath::Clamp(BoneRadius, MinR, MaxR);
-				// 중심 = 본 방향으로 절반
-				CapsuleCenter = BoneDirection * (ChildDist * 0.5f);
-				// 캡슐 방향 = 본 방향 (버텍스 박스 무시)
-				FQuat CapsuleRot = FQuat::FindBetweenNormals(FVector::ZAxisVector, BoneDirection);
-				CapsuleRotator = CapsuleRot.Rotator();
 			}
+			
+			CapsuleFits.Add({ BoneName, CapsuleCenter, CapsuleRotator, BoneRadius, CapsuleLength, BoneLength, BoneDirection });
+		}
+		return true;
+	});
+	if (!bFitted) return false;
+	
+	// 6. 기존 에셋 삭제 + 새 Physics Asset 생성 (게임 스레드)
+	if (!Pipeline.EnterStage(EGenerationStage::BuildHierarchy)) return false;
+	
+	// 기존 에셋 삭제 (있는 경우)
+	UPackage* ExistingPackage = FindPackage(nullptr, *PackageName);
+	if (ExistingPackage)
+	{
+		UPhysicsAsset* ExistingAsset = FindObject<UPhysicsAsset>(ExistingPackage, *OutputName);
+		if (ExistingAsset)
+		{
+			UE_LOG(LogTemp, Log, TEXT("[PhysicsAsset] Deleting existing asset: %s"), *PackageName);
+			GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->CloseAllEditorsForAsset(ExistingAsset);
+			
+			TArray<UObject*> ObjectsToDelete;
+			ObjectsToDelete.Add(ExistingAsset);
+			ObjectTools::ForceDeleteObjects(ObjectsToDelete, false);
 		}
+	}
+	
+	// 새 패키지 생성
+	UPackage* Package = CreatePackage(*PackageName);
+	if (!Package)
+	{
+		SetPhysAssetStatus(TEXT("Failed to create package"));
+		return false;
+	}
+	
+	// Physics Asset 생성
+	UPhysicsAsset* PhysAsset = NewObject<UPhysicsAsset>(Package, *OutputName, RF_Public | RF_Standalone);
+	if (!PhysAsset)
+	{
+		SetPhysAssetStatus(TEXT("Failed to create Physics Asset"));
+		return false;
+	}
+	
+	Pipeline.TrackCreatedAsset(PhysAsset);
+	
+	// 7. 피팅 결과로 BodySetup 생성
+	int32 BodiesCreated = 0;
+	for (const FCapsuleFit& Fit : CapsuleFits)
+	{
+		// 64개마다 진행 바 갱신 + 취소 확인
+		if ((BodiesCreated & 63) == 0 && !Pipeline.Tick()) return false;
+		
+		const FName& BoneName = Fit.BoneName;
 		
-		// 8. SkeletalBodySetup 생성
+		// SkeletalBodySetup 생성
 		USkeletalBodySetup* BodySetup = NewObject<USkeletalBodySetup>(PhysAsset, BoneName, RF_Transactional);
 		BodySetup->BoneName = BoneName;
 		
@@ -9975,12 +10392,12 @@ bool SControlRigToolWidget::CreatePhysicsAsset()
 		BodySetup->CollisionTraceFlag = CTF_UseSimpleAsComplex;
 		BodySetup->PhysicsType = PhysType_Kinematic;
 		
-		// 9. 캡슐 콜리전 생성
+		// 캡슐 콜리전 생성
 		FKSphylElem CapsuleElem;
-		CapsuleElem.Center = CapsuleCenter;
-		CapsuleElem.Rotation = CapsuleRotator;
-		CapsuleElem.Radius = BoneRadius;
-		CapsuleElem.Length = CapsuleLength;
+		CapsuleElem.Center = Fit.Center;
+		CapsuleElem.Rotation = Fit.Rotation;
+		CapsuleElem.Radius = Fit.Radius;
+		CapsuleElem.Length = Fit.Length;
 		CapsuleElem.SetName(BoneName);
 		
 		// AggGeom에 캡슐 추가
@@ -9995,10 +10412,10 @@ bool SControlRigToolWidget::CreatePhysicsAsset()
 		BodiesCreated++;
 		
 		UE_LOG(LogTemp, Log, TEXT("[PhysicsAsset] Created body for %s: Length=%.1f, Radius=%.1f, Dir=(%.2f,%.2f,%.2f)"), 
-			*BoneName.ToString(), BoneLength, BoneRadius, BoneDirection.X, BoneDirection.Y, BoneDirection.Z);
+			*BoneName.ToString(), Fit.BoneLength, Fit.Radius, Fit.Direction.X, Fit.Direction.Y, Fit.Direction.Z);
 	}
 	
-	// 10. Physics Asset 후처리
+	// 8. Physics Asset 후처리
 	PhysAsset->UpdateBoundsBodiesArray();
 	PhysAsset->UpdateBodySetupIndexMap();
 	
@@ -10007,30 +10424,253 @@ bool SControlRigToolWidget::CreatePhysicsAsset()
 	PhysAsset->PreviewSkeletalMesh = TSoftObjectPtr<USkeletalMesh>(TargetMesh);
 #endif
 	
-	// 11. 패키지 저장
+	// 9. 패키지 저장
+	if (!Pipeline.EnterStage(EGenerationStage::Save)) return false;
 	Package->MarkPackageDirty();
 	FAssetRegistryModule::AssetCreated(PhysAsset);
 	
-	FString PackageFilePath = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
-	FSavePackageArgs SaveArgs;
-	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
-	SaveArgs.Error = GError;
-	UPackage::SavePackage(Package, PhysAsset, *PackageFilePath, SaveArgs);
+	FPackageSaveQueue::Save(Package, PhysAsset);
+	Pipeline.Commit();
 	
-	// 12. 에셋 에디터에서 열기
-	GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->OpenEditorForAsset(PhysAsset);
-	
-	// Content Browser에서 선택
-	TArray<UObject*> ObjectsToSync;
-	ObjectsToSync.Add(PhysAsset);
-	GEditor->SyncBrowserToObjects(ObjectsToSync);
-	
-	FString Summary = FString::Printf(TEXT("Physics Asset Created!\n\nPath: %s\nBodies: %d"), *PackagePath, BodiesCreated);
-	FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Summary));
+	// 10. 에셋 에디터에서 열기 (헤드리스 실행 시 생략)
+	if (!bHeadless)
+	{
+		GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->OpenEditorForAsset(PhysAsset);
+		
+		// Content Browser에서 선택
+		TArray<UObject*> ObjectsToSync;
+		ObjectsToSync.Add(PhysAsset);
+		GEditor->SyncBrowserToObjects(ObjectsToSync);
+		
+		FString Summary = FString::Printf(TEXT("Physics Asset Created!\n\nPath: %s\nBodies: %d"), *PackagePath, BodiesCreated);
+		FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(Summary));
+	}
 	
 	SetPhysAssetStatus(FString::Printf(TEXT("Created: %s (%d bodies)"), *OutputName, BodiesCreated));
 	
 	return true;
 }
 
+// ============================================================================
+// 헤드리스 배치 실행 (AIRigSetup Commandlet)
+// UI 입력 대신 FAIRigSetupJob 값으로 선택 상태를 채운 뒤 기존 생성 함수 재사용
+// ============================================================================
+bool SControlRigToolWidget::WaitForMappingResponse(double TimeoutSeconds)
+{
+	// Commandlet에는 엔진 틱이 없으므로 HTTP 매니저를 직접 틱
+	const double StartTime = FPlatformTime::Seconds();
+	while (bMappingRequestInFlight)
+	{
+		if (FPlatformTime::Seconds() - StartTime > TimeoutSeconds)
+		{
+			return false;
+		}
+		FTSTicker::GetCoreTicker().Tick(0.05f);  // AI 서버 시작 대기 (/health 폴링)
+		FHttpModule::Get().GetHttpManager().Tick(0.05f);
+		FPlatformProcess::Sleep(0.05f);
+	}
+	return true;
+}
+
+int32 SControlRigToolWidget::AutoTagKawaiiChainRoots()
+{
+	// Secondary 체인의 시작 본(부모가 Secondary가 아닌 본)에만 기본 태그 적용
+	TSet<int32> SecondaryBoneIndices;
+	for (const FKawaiiBoneDisplayInfo& Info : KawaiiBoneDisplayList)
+	{
+		if (Info.bIsSecondary)
+		{
+			SecondaryBoneIndices.Add(Info.BoneIndex);
+		}
+	}
+	
+	if (SecondaryBoneIndices.Num() == 0)
+	{
+		return 0;
+	}
+	
+	if (KawaiiTags.Num() == 0)
+	{
+		KawaiiTags.Add(FKawaiiTag(TEXT("secondary"), FLinearColor(0.6f, 0.7f, 0.2f, 1.0f)));
+	}
+	
+	int32 TaggedCount = 0;
+	for (FKawaiiBoneDisplayInfo& Info : KawaiiBoneDisplayList)
+	{
+		if (Info.bIsSecondary && !SecondaryBoneIndices.Contains(Info.ParentIndex))
+		{
+			Info.TagIndex = 0;
+			TaggedCount++;
+		}
+	}
+	return TaggedCount;
+}
+
+bool SControlRigToolWidget::RunHeadlessSetup(const FAIRigSetupJob& Job, FAIRigSetupReport& OutReport)
+{
+	const double JobStartTime = FPlatformTime::Seconds();
+	OutReport = FAIRigSetupReport();
+	OutReport.MeshName = FPaths::GetBaseFilename(Job.MeshPath);
+	
+	// 단계 실행 + 시간 기록
+	auto RunStage = [&OutReport](const TCHAR* StageName, bool bEnabled, TFunctionRef<bool()> StageFunc) -> bool
+	{
+		FAIRigSetupStageTiming& Timing = OutReport.Stages.AddDefaulted_GetRef();
+		Timing.Stage = StageName;
+		if (!bEnabled)
+		{
+			Timing.bSkipped = true;
+			Timing.bSuccess = true;
+			return true;
+		}
+		const double StageStartTime = FPlatformTime::Seconds();
+		Timing.bSuccess = StageFunc();
+		Timing.Seconds = FPlatformTime::Seconds() - StageStartTime;
+		UE_LOG(LogTemp, Display, TEXT("[AIRigSetup]   %-14s %s (%.2fs)"), StageName, Timing.bSuccess ? TEXT("OK") : TEXT("FAILED"), Timing.Seconds);
+		return Timing.bSuccess;
+	};
+	
+	// 1. 메쉬 선택 (콤보박스 옵션과 동일한 이름 기반)
+	SelectedMesh.Reset();
+	if (const FAssetCatalogEntry* MeshEntry = FAssetCatalog::Get().FindByPackage(EAssetCatalogClass::SkeletalMesh, Job.MeshPath))
+	{
+		SelectedMesh = MeshEntry->NameOption;
+	}
+	if (!SelectedMesh.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("[AIRigSetup] Mesh not found in asset registry: %s"), *Job.MeshPath);
+		OutReport.TotalSeconds = FPlatformTime::Seconds() - JobStartTime;
+		return false;
+	}
+	
+	// 2. 템플릿 선택 (이름 또는 경로)
+	if (!Job.TemplatePath.IsEmpty())
+	{
+		SelectedTemplate.Reset();
+		const FAssetCatalogEntry* TemplateEntry = FAssetCatalog::Get().FindByPackage(EAssetCatalogClass::ControlRig, Job.TemplatePath);
+		if (!TemplateEntry)
+		{
+			TemplateEntry = FAssetCatalog::Get().FindByName(EAssetCatalogClass::ControlRig, Job.TemplatePath);
+		}
+		if (TemplateEntry)
+		{
+			SelectedTemplate = TemplateEntry->NameOption;
+		}
+	}
+	if (!Job.IKRigTemplatePath.IsEmpty())
+	{
+		SelectedIKRigTemplate = MakeShared<FString>(Job.IKRigTemplatePath);
+		for (const TSharedPtr<FString>& Option : IKRigTemplateOptions)
+		{
+			if (Option->StartsWith(Job.IKRigTemplatePath))
+			{
+				SelectedIKRigTemplate = Option;
+				break;
+			}
+		}
+	}
+	
+	// 3. 출력 폴더: <OutputFolder>/<메쉬 이름>
+	const FString MeshOutputFolder = Job.OutputFolder / OutReport.MeshName;
+	DefaultOutputFolder = MeshOutputFolder;
+	IKDefaultOutputFolder = MeshOutputFolder;
+	KawaiiDefaultOutputFolder = MeshOutputFolder;
+	PhysAssetDefaultOutputFolder = MeshOutputFolder;
+	
+	UE_LOG(LogTemp, Display, TEXT("[AIRigSetup] %s -> %s"), *Job.MeshPath, *MeshOutputFolder);
+	
+	// 4. AI 본 매핑 (서버 기동 중이면 재시도)
+	const bool bMapped = RunStage(TEXT("Mapping"), true, [this, &Job]()
+	{
+		const double Deadline = FPlatformTime::Seconds() + Job.MappingTimeout;
+		while (FPlatformTime::Seconds() < Deadline)
+		{
+			RequestAIBoneMapping();
+			if (!WaitForMappingResponse(Deadline - FPlatformTime::Seconds()))
+			{
+				break;
+			}
+			if (LastBoneMapping.Num() > 0)
+			{
+				return true;
+			}
+			FPlatformProcess::Sleep(2.0f);
+		}
+		return false;
+	});
+	
+	if (!bMapped)
+	{
+		OutReport.TotalSeconds = FPlatformTime::Seconds() - JobStartTime;
+		return false;
+	}
+	
+	bool bAllSucceeded = true;
+	
+	// 생성 함수들의 저장은 모았다가 9단계에서 한 번에 (직렬화 후 파일 쓰기 동시 진행)
+	FPackageSaveQueue SaveQueue(FString::Printf(TEXT("AIRigSetup %s"), *OutReport.MeshName));
+	
+	// 5. Control Rig (Body → 기본 분류로 세컨더리 추가 → 저장)
+	bAllSucceeded &= RunStage(TEXT("ControlRig"), Job.bControlRig, [this]()
+	{
+		if (!CreateBodyControlRig())
+		{
+			return false;
+		}
+		BuildBoneDisplayList();
+		return CreateFinalControlRig();
+	});
+	
+	// 6. IK Rig (같은 메쉬이므로 Control Rig 매핑 재사용)
+	bAllSucceeded &= RunStage(TEXT("IKRig"), Job.bIKRig, [this]()
+	{
+		if (!SelectedIKRigTemplate.IsValid())
+		{
+			SetIKStatus(TEXT("Error: No IK Rig template"));
+			return false;
+		}
+		SelectedIKMesh = SelectedMesh;
+		IKBoneMapping = LastBoneMapping;
+		CreateIKRigFromTemplate();
+		return UEditorAssetLibrary::DoesAssetExist(IKDefaultOutputFolder / (*SelectedIKMesh + TEXT("_IK_Rig")));
+	});
+	
+	// 7. Physics Asset
+	bAllSucceeded &= RunStage(TEXT("PhysicsAsset"), Job.bPhysicsAsset, [this]()
+	{
+		SelectedPhysAssetMesh = SelectedMesh;
+		PhysAssetBoneMapping = LastBoneMapping;
+		PhysAssetMainBones = ControlRigMappingSession->GetMainBones();
+		return CreatePhysicsAsset();
+	});
+	
+	// 8. Kawaii AnimBP (Secondary 체인이 없으면 생략)
+	bool bHasKawaiiChains = false;
+	if (Job.bKawaii)
+	{
+		SelectedKawaiiMesh = MakeShared<FString>(Job.MeshPath);
+		if (BoneDisplayList.Num() == 0)
+		{
+			BuildBoneDisplayList();
+		}
+		BuildKawaiiBoneDisplayList();
+		bHasKawaiiChains = AutoTagKawaiiChainRoots() > 0;
+	}
+	bAllSucceeded &= RunStage(TEXT("Kawaii"), bHasKawaiiChains, [this]()
+	{
+		return CreateKawaiiAnimBlueprint();
+	});
+	
+	// 9. 일괄 저장
+	bAllSucceeded &= RunStage(TEXT("Save"), true, [&SaveQueue, &OutReport]()
+	{
+		OutReport.SavedPackages = SaveQueue.Flush();
+		return !OutReport.SavedPackages.ContainsByPredicate([](const FPackageSaveResult& Result) { return !Result.bSuccess; });
+	});
+	
+	OutReport.TotalSeconds = FPlatformTime::Seconds() - JobStartTime;
+	OutReport.bSuccess = bAllSucceeded;
+	return bAllSucceeded;
+}
+
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,113 @@
+#include "SkeletonTopology.h"
+#include "ReferenceSkeleton.h"
+
+void FSkeletonTopology::Build(const FReferenceSkeleton& RefSkeleton)
+{
+	const int32 NumBones = RefSkeleton.GetNum();
+	const TArray<FMeshBoneInfo>& BoneInfos = RefSkeleton.GetRefBoneInfo();
+	Signature = ComputeSignature(RefSkeleton);
+
+	Parents.SetNumUninitialized(NumBones);
+	Depths.SetNumUninitialized(NumBones);
+	NameToIndex.Empty(NumBones);
+
+	// 1. 부모 / 깊이 / 이름 인덱스 (부모가 항상 앞 인덱스)
+	TArray<int32> ChildCount;
+	ChildCount.SetNumZeroed(NumBones + 1);
+	for (int32 i = 0; i < NumBones; ++i)
+	{
+		const int32 ParentIdx = BoneInfos[i].ParentIndex;
+		Parents[i] = ParentIdx;
+		Depths[i] = (ParentIdx == INDEX_NONE) ? 0 : Depths[ParentIdx] + 1;
+		NameToIndex.Add(BoneInfos[i].Name, i);
+		if (ParentIdx != INDEX_NONE)
+		{
+			ChildCount[ParentIdx]++;
+		}
+	}
+
+	// 2. 자식 목록 (CSR)
+	ChildStart.SetNumUninitialized(NumBones + 1);
+	ChildStart[0] = 0;
+	for (int32 i = 0; i < NumBones; ++i)
+	{
+		ChildStart[i + 1] = ChildStart[i] + ChildCount[i];
+	}
+	ChildList.SetNumUninitialized(ChildStart[NumBones]);
+	TArray<int32> Cursor(ChildStart.GetData(), NumBones);
+	for (int32 i = 0; i < NumBones; ++i)
+	{
+		if (Parents[i] != INDEX_NONE)
+		{
+			ChildList[Cursor[Parents[i]]++] = i;
+		}
+	}
+
+	// 3. 오일러 투어 (반복 DFS, 깊은 체인에서도 스택 오버플로 없음)
+	DfsOrder.Reset(NumBones);
+	EnterTime.SetNumUninitialized(NumBones);
+	ExitTime.SetNumUninitialized(NumBones);
+	TArray<TPair<int32, int32>> Stack;  // (본, 다음 자식 오프셋)
+	for (int32 RootIdx = 0; RootIdx < NumBones; ++RootIdx)
+	{
+		if (Parents[RootIdx] != INDEX_NONE) continue;
+
+		EnterTime[RootIdx] = DfsOrder.Add(RootIdx);
+		Stack.Add(TPair<int32, int32>(RootIdx, 0));
+		while (Stack.Num() > 0)
+		{
+			TPair<int32, int32>& Top = Stack.Last();
+			const int32 Bone = Top.Key;
+			if (ChildStart[Bone] + Top.Value < ChildStart[Bone + 1])
+			{
+				const int32 Child = ChildList[ChildStart[Bone] + Top.Value++];
+				EnterTime[Child] = DfsOrder.Add(Child);
+				Stack.Add(TPair<int32, int32>(Child, 0));
+			}
+			else
+			{
+				ExitTime[Bone] = DfsOrder.Num();
+				Stack.Pop(EAllowShrinking::No);
+			}
+		}
+	}
+}
+
+bool FSkeletonTopology::IsBuiltFrom(const FReferenceSkeleton& RefSkeleton) const
+{
+	return Parents.Num() == RefSkeleton.GetNum() && Signature == ComputeSignature(RefSkeleton);
+}
+
+uint32 FSkeletonTopology::ComputeSignature(const FReferenceSkeleton& RefSkeleton)
+{
+	// 토폴로지는 인덱스 기준 → 순서에 민감한 해시 (FName 해시는 세션 안에서 고정, 메모리 캐시용으로 충분)
+	const TArray<FMeshBoneInfo>& BoneInfos = RefSkeleton.GetRefBoneInfo();
+	uint32 Hash = GetTypeHash(BoneInfos.Num());
+	for (const FMeshBoneInfo& Info : BoneInfos)
+	{
+		Hash = HashCombineFast(Hash, GetTypeHash(Info.Name));
+		Hash = HashCombineFast(Hash, GetTypeHash(Info.ParentIndex));
+	}
+	return Hash;
+}
+
+TArray<int32> FSkeletonTopology::BuildNearestMarkedAncestors(const TBitArray<>& Marked) const
+{
+	const int32 NumBones = Parents.Num();
+	TArray<int32> Nearest;
+	Nearest.SetNumUninitialized(NumBones);
+
+	for (int32 i = 0; i < NumBones; ++i)
+	{
+		const int32 ParentIdx = Parents[i];
+		if (ParentIdx == INDEX_NONE)
+		{
+			Nearest[i] = INDEX_NONE;
+		}
+		else
+		{
+			Nearest[i] = Marked[ParentIdx] ? ParentIdx : Nearest[ParentIdx];
+		}
+	}
+	return Nearest;
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AIRigSetupCommandlet.generated.h"
+
+// ============================================================================
+// 배치 캐릭터 셋업 Commandlet
+// 사용 예:
+//   UnrealEditor-Cmd.exe Project.uproject -run=AIRigSetup -Folder=/Game/Characters -nullrhi -unattended
+//   -Meshes=/Game/A/SK_A+/Game/B/SK_B   대상 메쉬 (패키지 경로, '+' 구분)
+//   -Folder=/Game/Characters            폴더 내 모든 스켈레탈 메쉬 (하위 폴더 포함)
+//   -Template=CTR_Template              Control Rig 템플릿 (이름 또는 경로)
+//   -IKTemplate=/Game/.../AI_IK_Rig_Template
+//   -Output=/Game/AIRigSetup            출력 루트 (메쉬별 하위 폴더)
+//   -Skip=IKRig+Kawaii                  생략할 단계 (ControlRig, IKRig, PhysicsAsset, Kawaii)
+//   -Csv=D:/Reports/AIRigSetup.csv      단계별 시간 CSV 저장
+// ============================================================================
+UCLASS()
+class UAIRigSetupCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAIRigSetupCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,65 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "HAL/PlatformProcess.h"
+#include "Containers/Ticker.h"
+#include "Interfaces/IHttpRequest.h"
+
+// ============================================================================
+// 본 매핑 AI 서버 (Python) 수명 관리
+// - 에디터 시작 시 띄우지 않음 → 첫 서버 요청 때 실행 (툴을 안 쓰면 비용 0)
+// - 실행 시 빈 포트를 골라 --port로 전달 (기존 프로세스 강제 종료 없음)
+// - 준비 확인은 /health 폴링 (고정 대기 없음). 준비 전 요청은 모아뒀다가 한 번에 전송
+// - cmd.exe / 배치 파일 없이 Python 직접 실행 (Windows 내장 Python / Linux python3)
+// - 시작 실패 시 대기 요청은 그대로 전송 → 연결 실패 콜백으로 네이티브 폴백
+//   (응답 없는 프로세스는 종료 → 재시도 때 모델을 올린 프로세스가 두 개 남지 않음)
+// ============================================================================
+class FAIServerLauncher
+{
+public:
+	static FAIServerLauncher& Get();
+
+	// 요청 전송 (URL = 서버 주소 + Endpoint)
+	// bStartIfNeeded=false면 서버가 이미 준비된 경우에만 전송하고, 아니면 false
+	bool Send(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request, const FString& Endpoint, bool bStartIfNeeded = true);
+
+	FString GetURL(const FString& Endpoint) const;
+	bool IsReady() const { return State == EState::Ready; }
+
+	// 모듈 종료 시 호출 (우리가 띄운 프로세스만 종료)
+	void Shutdown();
+
+private:
+	enum class EState : uint8
+	{
+		Stopped,
+		Starting,
+		Ready,
+		Failed
+	};
+
+	struct FPendingRequest
+	{
+		TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request;
+		FString Endpoint;
+	};
+
+	bool Launch();
+	void StopProcess();
+	bool ResolveServerPaths(FString& OutPython, FString& OutScript, FString& OutWorkingDir) const;
+	static int32 FindFreePort();
+
+	bool TickStartup(float DeltaTime);
+	void FinishStartup(bool bReady);
+
+	EState State = EState::Stopped;
+	int32 Port = 0;
+	FProcHandle ProcessHandle;
+	uint32 ProcessId = 0;
+	double LaunchTime = 0.0;
+	double LastHealthPollTime = 0.0;
+	double FailedTime = 0.0;
+	bool bHealthRequestInFlight = false;
+
+	TArray<FPendingRequest> PendingRequests;
+	FTSTicker::FDelegateHandle StartupTickerHandle;
+};
@@ -0,0 +1,101 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/TopLevelAssetPath.h"
+#include "Containers/Ticker.h"
+
+struct FAssetData;
+
+// ============================================================================
+// 카탈로그 대상 에셋 종류
+// ============================================================================
+enum class EAssetCatalogClass : uint8
+{
+	ControlRig,
+	SkeletalMesh,
+	IKRig,
+	Num
+};
+
+// ============================================================================
+// 카탈로그 항목 (에셋 1개)
+// - NameOption / ObjectPathOption은 항목당 한 번만 만들어 콤보박스 옵션으로 그대로 사용
+//   → 목록이 갱신돼도 같은 에셋이면 포인터가 유지되어 선택 상태가 풀리지 않음
+// ============================================================================
+struct FAssetCatalogEntry
+{
+	FString Name;          // 에셋 이름
+	FString PackagePath;   // /Game/.../Asset
+	FString ObjectPath;    // /Game/.../Asset.Asset
+	TSharedPtr<FString> NameOption;
+	TSharedPtr<FString> ObjectPathOption;
+};
+
+// ============================================================================
+// 에셋 카탈로그 (에디터 세션 전체 공유)
+// - 최초 조회 시 Asset Registry 한 번 스캔
+// - 이후 OnAssetAdded / Removed / Renamed 이벤트로 증분 갱신 (전체 재스캔 없음)
+// - 이름/패키지 → 항목 해시 인덱스, 이름순 정렬 목록은 변경 시에만 재정렬
+// - 변경 알림은 프레임당 한 번으로 모아서 브로드캐스트 (대량 임포트 시 UI 갱신 1회)
+// ============================================================================
+class FAssetCatalog
+{
+public:
+	static FAssetCatalog& Get();
+
+	// 모듈 시작/종료 시 호출
+	void RegisterHooks();
+	void UnregisterHooks();
+
+	// 이름순 정렬 목록
+	const TArray<FAssetCatalogEntry>& GetSorted(EAssetCatalogClass Class);
+
+	// 해시 조회 (없으면 nullptr). 반환 포인터는 다음 카탈로그 변경 전까지만 유효
+	const FAssetCatalogEntry* FindByName(EAssetCatalogClass Class, const FString& Name);
+	const FAssetCatalogEntry* FindByPackage(EAssetCatalogClass Class, const FString& PackagePath);
+
+	// 이름 조회 편의 함수 (없으면 빈 문자열)
+	FString FindPackagePathByName(EAssetCatalogClass Class, const FString& Name);
+
+	// 변경될 때마다 증가 (목록을 다시 만들어야 하는지 비교용)
+	uint32 GetRevision() const { return Revision; }
+
+	// 변경 알림 (게임 스레드, 프레임당 최대 1회)
+	FSimpleMulticastDelegate& OnChanged() { return ChangedEvent; }
+
+	// 타입어헤드 필터: 부분 문자열(대소문자 무시) 일치하는 옵션만 남김. 빈 필터면 전체
+	static void FilterOptions(const TArray<TSharedPtr<FString>>& Source, const FString& FilterText, TArray<TSharedPtr<FString>>& OutFiltered);
+
+private:
+	struct FClassIndex
+	{
+		FTopLevelAssetPath ClassPath;
+		TSet<FTopLevelAssetPath> ClassPaths;          // 파생 클래스 포함
+		TMap<FName, FAssetCatalogEntry> ByPackage;
+		TMap<FString, FName> PackageByName;           // 같은 이름이면 먼저 등록된 패키지
+		TArray<FAssetCatalogEntry> Sorted;
+		bool bSortedDirty = true;
+	};
+
+	FAssetCatalog();
+
+	void EnsureInitialized();
+	FClassIndex* FindIndexForAsset(const FAssetData& Asset);
+	bool AddEntry(FClassIndex& Index, const FAssetData& Asset);
+	bool RemoveEntry(FClassIndex& Index, FName PackageName);
+	void MarkChanged();
+
+	void OnAssetAdded(const FAssetData& Asset);
+	void OnAssetRemoved(const FAssetData& Asset);
+	void OnAssetRenamed(const FAssetData& Asset, const FString& OldObjectPath);
+
+	FClassIndex Indices[static_cast<int32>(EAssetCatalogClass::Num)];
+	bool bInitialized = false;
+	uint32 Revision = 0;
+
+	FSimpleMulticastDelegate ChangedEvent;
+	FTSTicker::FDelegateHandle BroadcastTickerHandle;
+
+	FDelegateHandle AddedHandle;
+	FDelegateHandle RemovedHandle;
+	FDelegateHandle RenamedHandle;
+};
@@ -0,0 +1,76 @@
+#pragma once
+#include "CoreMinimal.h"
+
+// ============================================================================
+// 본 키워드 카테고리 (비트 플래그 - 한 본이 여러 카테고리에 동시에 걸릴 수 있음)
+// ============================================================================
+enum class EBoneKeyword : uint32
+{
+	None            = 0,
+	Zero            = 1 << 0,   // UE5 표준 본 (정확히 일치)
+	Accessory       = 1 << 1,   // 액세서리 (컨트롤러 생성 O)
+	Helper          = 1 << 2,   // 헬퍼 (트위스트, 보정, IK 등)
+	BipRoot         = 1 << 3,   // bip001 계열 → bip001_space
+	SceneRoot       = 1 << 4,   // root / armature → root_space
+
+	// Physics Asset 캡슐 규칙
+	PhysicsSkip     = 1 << 5,   // 캡슐 생성 제외 (root 계열)
+	PhysicsUpright  = 1 << 6,   // 회전 0 고정 (spine, pelvis, hips)
+	PhysicsFinger   = 1 << 7,
+	PhysicsHand     = 1 << 8,
+	PhysicsClavicle = 1 << 9,
+	PhysicsSpine    = 1 << 10,
+	PhysicsUpperArm = 1 << 11,
+	PhysicsLowerArm = 1 << 12,
+
+	// 팔/다리 본 방향 강제 캡슐
+	ChainUpperArm   = 1 << 13,
+	ChainForearm    = 1 << 14,
+	ChainThigh      = 1 << 15,
+	ChainCalf       = 1 << 16,
+
+	ChainLimb = ChainUpperArm | ChainForearm | ChainThigh | ChainCalf,
+};
+ENUM_CLASS_FLAGS(EBoneKeyword);
+
+// ============================================================================
+// 본 이름 키워드 분류기 (Aho-Corasick)
+// 모든 카테고리 키워드를 하나의 오토마톤으로 컴파일 → 본 이름 한 번 스캔으로 전체 카테고리 반환
+// 기본 테이블 + 프로젝트 Config/AIRigSetup/BoneKeywords.json (재컴파일 없이 키워드 추가)
+// ============================================================================
+class FBoneKeywordClassifier
+{
+public:
+	static const FBoneKeywordClassifier& Get();
+
+	// 설정 파일 다시 읽기 (키워드 수정 후 에디터 재시작 없이 반영)
+	static void Reload();
+
+	// 대소문자 무시, 포함(contains) + 정확히 일치(exact) 카테고리 모두 반환
+	EBoneKeyword Classify(const FString& BoneName) const;
+
+	bool HasAny(const FString& BoneName, EBoneKeyword Categories) const
+	{
+		return EnumHasAnyFlags(Classify(BoneName), Categories);
+	}
+
+private:
+	FBoneKeywordClassifier();
+
+	void AddContains(const FString& Keyword, EBoneKeyword Category);
+	void AddExact(const FString& Keyword, EBoneKeyword Category);
+	void LoadConfigFile(const FString& FilePath);
+	void Compile();
+
+	struct FNode
+	{
+		TMap<TCHAR, int32> Next;
+		int32 Fail = 0;
+		EBoneKeyword Output = EBoneKeyword::None;  // Fail 체인 출력까지 합친 값
+	};
+
+	TArray<FNode> Nodes;
+	TMap<FString, EBoneKeyword> ExactMatches;
+
+	static TUniquePtr<FBoneKeywordClassifier>& GetInstance();
+};
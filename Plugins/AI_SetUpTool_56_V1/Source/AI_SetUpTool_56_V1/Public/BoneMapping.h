@@ -0,0 +1,91 @@
+#pragma once
+#include "CoreMinimal.h"
+
+// ============================================================================
+// 본 매핑 컨테이너: target(UE5 표준 본) -> source(메쉬 본) + 역방향 인덱스
+// FName 해시/비교는 대소문자 무시 → 양방향 모두 O(1) 대소문자 무시 조회
+// 역방향 인덱스는 변경 후 첫 역방향 조회 때 한 번만 재구축
+// ============================================================================
+class FBoneMapping
+{
+public:
+	FBoneMapping() = default;
+	FBoneMapping(const TMap<FName, FName>& InMapping) : Forward(InMapping) {}
+	FBoneMapping(TMap<FName, FName>&& InMapping) : Forward(MoveTemp(InMapping)) {}
+
+	FBoneMapping& operator=(const TMap<FName, FName>& InMapping)
+	{
+		Forward = InMapping;
+		bReverseDirty = true;
+		return *this;
+	}
+	FBoneMapping& operator=(TMap<FName, FName>&& InMapping)
+	{
+		Forward = MoveTemp(InMapping);
+		bReverseDirty = true;
+		return *this;
+	}
+
+	// 기존 TMap 기반 API (캐시, 네이티브 매퍼 등)에 그대로 전달
+	const TMap<FName, FName>& ToMap() const { return Forward; }
+	operator const TMap<FName, FName>&() const { return Forward; }
+
+	int32 Num() const { return Forward.Num(); }
+	bool IsEmpty() const { return Forward.IsEmpty(); }
+
+	void Empty()
+	{
+		Forward.Empty();
+		Reverse.Empty();
+		bReverseDirty = false;
+	}
+
+	void Add(const FName& Target, const FName& Source)
+	{
+		Forward.Add(Target, Source);
+		bReverseDirty = true;
+	}
+
+	// ---------- 정방향: target -> source ----------
+	bool Contains(const FName& Target) const { return Forward.Contains(Target); }
+	const FName* Find(const FName& Target) const { return Forward.Find(Target); }
+	FName FindRef(const FName& Target) const { return Forward.FindRef(Target); }
+	const FName& operator[](const FName& Target) const { return Forward.FindChecked(Target); }
+	void GetKeys(TArray<FName>& OutKeys) const { Forward.GetKeys(OutKeys); }
+
+	// ---------- 역방향: source -> target ----------
+	// 같은 source가 여러 target에 매핑되면 먼저 추가된 target
+	const FName* FindTarget(const FName& Source) const
+	{
+		RebuildReverseIfDirty();
+		return Reverse.Find(Source);
+	}
+	bool ContainsSource(const FName& Source) const
+	{
+		RebuildReverseIfDirty();
+		return Reverse.Contains(Source);
+	}
+
+	auto begin() const { return Forward.begin(); }
+	auto end() const { return Forward.end(); }
+
+private:
+	void RebuildReverseIfDirty() const
+	{
+		if (!bReverseDirty) return;
+
+		Reverse.Empty(Forward.Num());
+		for (const auto& Pair : Forward)
+		{
+			if (!Reverse.Contains(Pair.Value))
+			{
+				Reverse.Add(Pair.Value, Pair.Key);
+			}
+		}
+		bReverseDirty = false;
+	}
+
+	TMap<FName, FName> Forward;
+	mutable TMap<FName, FName> Reverse;
+	mutable bool bReverseDirty = true;
+};
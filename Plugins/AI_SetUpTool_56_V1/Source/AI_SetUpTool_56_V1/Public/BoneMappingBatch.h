@@ -0,0 +1,66 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "ReferenceSkeleton.h"
+#include "Interfaces/IHttpRequest.h"
+
+// ============================================================================
+// 여러 스켈레톤 본 매핑을 /predict_batch 한 번으로 요청 (의상 세트, 군중 변형 등)
+// - 디스크 캐시 적중 / 네이티브로 충분한 스켈레톤은 요청에서 제외
+// - 같은 스켈레톤(해시 동일)은 한 번만 전송하고 결과를 모든 Key에 전달
+// - 서버는 스켈레톤마다 끝나는 대로 NDJSON 한 줄씩 응답 → 도착 즉시 콜백 + 캐시 저장
+// - 콜백은 게임 스레드 (HTTP 매니저 틱의 progress/complete 콜백에서 처리)
+// ============================================================================
+class FBoneMappingBatch : public TSharedFromThis<FBoneMappingBatch>
+{
+public:
+	DECLARE_DELEGATE_ThreeParams(FOnSkeletonMapped, const FString& /*Key*/, const TMap<FName, FName>& /*Mapping*/, const FString& /*Method*/);
+	DECLARE_DELEGATE_OneParam(FOnBatchFinished, bool /*bServerOk*/);
+
+	// Key = 호출부 식별자 (메쉬 경로 등), SkeletonName = 캐시에 기록할 이름
+	void Add(const FString& Key, const FString& SkeletonName, const FReferenceSkeleton& RefSkeleton);
+
+	// 캐시/네이티브 결과는 바로 콜백, 나머지는 서버 요청. 반환값 = 서버 요청 여부
+	bool Send(FOnSkeletonMapped InOnMapped, FOnBatchFinished InOnFinished);
+
+	// 진행 중인 요청 취소 (이후 콜백 없음). 이미 도착한 결과는 캐시에 남음
+	void Cancel();
+
+	bool IsFinished() const { return bFinished; }
+	int32 NumServerSkeletons() const { return Skeletons.Num(); }
+
+private:
+	struct FResolved
+	{
+		FString Key;
+		TMap<FName, FName> Mapping;
+		FString Method;
+	};
+
+	struct FSkeletonEntry
+	{
+		FString Hash;
+		FString SkeletonName;
+		FReferenceSkeleton RefSkeleton;
+		TMap<FName, FName> NativeMapping;
+		TArray<FString> Keys;
+		bool bDone = false;
+	};
+
+	// HTTP 스레드 → 버퍼에 누적, 게임 스레드 → 완성된 줄 처리
+	void OnBodyChunk(const void* Data, int64 Length);
+	void DrainLines(bool bFinal);
+	void HandleLine(const FString& Line);
+	void Finish(bool bServerOk);
+
+	TArray<FResolved> Resolved;
+	TArray<FSkeletonEntry> Skeletons;
+	TMap<FString, int32> SkeletonIndexByHash;
+
+	FOnSkeletonMapped OnMapped;
+	FOnBatchFinished OnFinished;
+	TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> HttpRequest;
+
+	FCriticalSection BufferLock;
+	TArray<uint8> PendingBytes;
+	bool bFinished = false;
+};
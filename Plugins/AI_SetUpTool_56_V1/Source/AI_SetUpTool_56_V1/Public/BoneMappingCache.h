@@ -0,0 +1,51 @@
+#pragma once
+#include "CoreMinimal.h"
+
+struct FReferenceSkeleton;
+
+// ============================================================================
+// 본 매핑 디스크 캐시 (Saved/AIRigSetup/BoneMappingCache.json)
+// 키: 본 이름 + 부모 본 이름 해시 → LOD/의상 변형/탭 간 동일 스켈레톤 재사용
+// 서버 모델 버전이 바뀌면 승인되지 않은 엔트리는 무효화
+// ============================================================================
+class FBoneMappingCache
+{
+public:
+	static FBoneMappingCache& Get();
+	
+	// 스켈레톤 토폴로지 해시 (본 이름 + 부모 본 이름, 가상 본 제외)
+	// 본 순서와 무관 → 로드된 메쉬 / 스켈레톤 에셋 어느 쪽에서 읽은 계층이든 같은 값
+	static FString ComputeSkeletonHash(const FReferenceSkeleton& RefSkeleton);
+	
+	// target(UE5 표준 본) -> source(메쉬 본)
+	bool Find(const FString& SkeletonHash, TMap<FName, FName>& OutMapping) const;
+	bool IsApproved(const FString& SkeletonHash) const;
+	
+	// bApproved = 사용자 승인 매핑 (항상 덮어씀, 모델 버전 변경에도 유지)
+	// 승인되지 않은 매핑은 기존 승인 엔트리를 덮어쓰지 않음
+	void Store(const FString& SkeletonHash, const FString& SkeletonName, const TMap<FName, FName>& Mapping, bool bApproved = false);
+	
+	// 서버 model_version 갱신 (/health, /predict 응답)
+	void SetModelVersion(const FString& NewModelVersion);
+	const FString& GetModelVersion() const { return ModelVersion; }
+	
+	int32 Num() const { return Entries.Num(); }
+
+private:
+	FBoneMappingCache();
+	
+	struct FEntry
+	{
+		FString SkeletonName;
+		FString ModelVersion;
+		bool bApproved = false;
+		TMap<FName, FName> Mapping;
+	};
+	
+	FString GetCacheFilePath() const;
+	void Load();
+	void Save() const;
+	
+	TMap<FString, FEntry> Entries;
+	FString ModelVersion;
+};
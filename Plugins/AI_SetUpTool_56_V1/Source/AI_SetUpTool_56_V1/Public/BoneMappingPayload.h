@@ -0,0 +1,32 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+
+struct FReferenceSkeleton;
+
+// ============================================================================
+// /predict 요청/응답 직렬화 (DOM 없이 스트리밍)
+// - 요청: 이름 테이블 + 부모 인덱스 배열 (본마다 parent/children 이름 반복 X)
+//   {"names":["root","pelvis",...], "parents":[-1,0,...], "use_ai":true}
+//   자식 목록은 서버가 parents로 복원
+// - 큰 본문은 gzip (Content-Encoding: gzip, 서버 미들웨어가 해제)
+// - 응답: 토큰 단위로 읽어 mapping / model_version만 바로 추출
+// ============================================================================
+class FBoneMappingPayload
+{
+public:
+	static FString BuildPredictRequest(const FReferenceSkeleton& RefSkeleton, bool bUseAI = true);
+
+	// /predict_batch: {"skeletons":[{"names":[...],"parents":[...]}, ...], "use_ai":true}
+	static FString BuildPredictBatchRequest(TConstArrayView<const FReferenceSkeleton*> RefSkeletons, bool bUseAI = true);
+
+	// /approve: {"skeleton_name":..., "names":[...], "parents":[...], "mapping":{target: source}}
+	static FString BuildApproveRequest(const FString& SkeletonName, const FReferenceSkeleton& RefSkeleton, const TMap<FName, FName>& Mapping);
+
+	// UTF-8 본문 설정 (임계값 이상이면 gzip) + keep-alive 헤더
+	static void SetJsonBody(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request, const FString& Body);
+
+	// 파싱 실패 시 false (mapping 필드가 없으면 빈 맵으로 true)
+	// OutIndex: /predict_batch 응답 줄의 "index" (요청 skeletons 배열 위치)
+	static bool ParsePredictResponse(const FString& Content, TMap<FName, FName>& OutMapping, FString& OutModelVersion, int32* OutIndex = nullptr);
+};
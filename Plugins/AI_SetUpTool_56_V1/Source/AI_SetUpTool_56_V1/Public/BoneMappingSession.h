@@ -0,0 +1,81 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "BoneMapping.h"
+#include "ReferenceSkeleton.h"
+#include "Interfaces/IHttpRequest.h"
+
+enum class EBoneMappingSessionState : uint8
+{
+	Empty,
+	Requesting,
+	Ready,
+	Failed
+};
+
+enum class EBoneMappingSessionChange : uint8
+{
+	State,     // 요청 시작 / 완료 / 실패
+	Approved
+};
+
+// ============================================================================
+// 메쉬별 본 매핑 세션 (Control Rig / IK Rig / Physics Asset 탭이 공유)
+// - 같은 메쉬 = 같은 세션 → 탭을 바꿔도 요청 0회, 진행 중인 요청에는 합류
+// - 매핑 / 승인 상태 / 파생 데이터(메인 본)를 한 곳에서 보관
+// - 상태 변경 시 OnChanged 브로드캐스트 → 구독 중인 탭이 각자 UI 갱신
+// - 조회 순서: 디스크 캐시 → 네이티브 체인 분석 → 서버(/predict)
+// - 레지스트리는 약참조만 보관 (세션을 잡고 있는 탭이 없으면 해제)
+// ============================================================================
+class FBoneMappingSession : public TSharedFromThis<FBoneMappingSession>
+{
+public:
+	static TSharedRef<FBoneMappingSession> FindOrCreate(const FString& MeshPath);
+
+	DECLARE_MULTICAST_DELEGATE_TwoParams(FOnChanged, FBoneMappingSession& /*Session*/, EBoneMappingSessionChange /*Change*/);
+	FOnChanged& OnChanged() { return ChangedEvent; }
+
+	// true = 이미 Ready (호출부가 바로 사용, 브로드캐스트 없음)
+	// false = 요청 시작 또는 진행 중인 요청에 합류 → 결과는 OnChanged
+	// 서버 없이 얻은 부분 매핑은 다시 요청하면 서버 재시도
+	bool RequestMapping();
+
+	// 승인: 캐시 엔트리 고정 + 학습 저널 기록. 매핑이 없으면 false
+	// 매핑을 얻을 때 읽은 본 계층 / 해시를 그대로 사용 (그 사이 메쉬가 로드돼도 같은 키)
+	bool Approve();
+
+	const FString& GetMeshPath() const { return MeshPath; }
+	const FString& GetMeshName() const { return MeshName; }
+	EBoneMappingSessionState GetState() const { return State; }
+	bool IsReady() const { return State == EBoneMappingSessionState::Ready; }
+	bool IsApproved() const { return bApproved; }
+
+	const FBoneMapping& GetMapping() const { return Mapping; }
+	const FString& GetMethod() const { return Method; }
+	const FString& GetError() const { return Error; }
+
+	// 파생 데이터 (매핑이 바뀔 때 한 번 계산)
+	const TArray<FName>& GetMainBones() const { return MainBones; }  // 매핑된 메쉬 본 (Physics 캡슐 대상, 중복 없음)
+
+private:
+	explicit FBoneMappingSession(const FString& InMeshPath);
+
+	void OnPredictResponse(const TMap<FName, FName>& NativeMapping, FHttpResponsePtr Response, bool bSucceeded);
+	void SetReady(TMap<FName, FName>&& InMapping, const FString& InMethod, bool bInPartial = false);
+	void SetFailed(const FString& InError);
+
+	FString MeshPath;
+	FString MeshName;
+	FString SkeletonHash;
+	FReferenceSkeleton Hierarchy;  // RequestMapping에서 읽은 본 계층 (Approve 본문용)
+
+	EBoneMappingSessionState State = EBoneMappingSessionState::Empty;
+	FBoneMapping Mapping;
+	FString Method;
+	FString Error;
+	bool bApproved = false;
+	bool bPartial = false;  // 서버 없이 네이티브만으로 얻은 결과
+
+	TArray<FName> MainBones;
+
+	FOnChanged ChangedEvent;
+};
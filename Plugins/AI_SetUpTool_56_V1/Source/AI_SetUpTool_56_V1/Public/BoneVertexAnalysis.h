@@ -0,0 +1,116 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include "Tasks/Task.h"
+#include <atomic>
+
+class USkeletalMesh;
+class UObject;
+struct FPropertyChangedEvent;
+
+// ============================================================================
+// 본별 버텍스 통계 (본 로컬 스페이스, 지배 본 기준 스킨 버텍스)
+// ============================================================================
+struct FBoneVertexStats
+{
+	int32 VertexCount = 0;
+	
+	FBox Bounds = FBox(ForceInit);
+	FVector Centroid = FVector::ZeroVector;
+	
+	// 노멀 합을 정규화한 값 (노멀 없으면 Z축)
+	FVector MeanNormal = FVector::ZAxisVector;
+	
+	// 공분산 (대칭 3x3 → 대각 XX/YY/ZZ + 비대각 XY/XZ/YZ)
+	FVector CovarianceDiagonal = FVector::ZeroVector;
+	FVector CovarianceOffDiagonal = FVector::ZeroVector;
+	
+	// 본 원점에서 가장 먼 버텍스 (컨트롤러 오프셋용)
+	FVector FurthestDirection = FVector::ZeroVector;
+	float MaxDistance = 0.0f;
+	
+	bool HasVertices() const { return VertexCount > 0; }
+};
+
+// ============================================================================
+// 메쉬 한 개의 분석 결과 (본 인덱스 = RefSkeleton 인덱스)
+// ============================================================================
+struct FMeshVertexAnalysis
+{
+	TArray<FBoneVertexStats> Bones;
+	
+	int32 Num() const { return Bones.Num(); }
+	
+	// 범위 밖이거나 스킨 버텍스가 없으면 nullptr
+	const FBoneVertexStats* GetBone(int32 BoneIndex) const
+	{
+		return Bones.IsValidIndex(BoneIndex) && Bones[BoneIndex].HasVertices() ? &Bones[BoneIndex] : nullptr;
+	}
+};
+
+// ============================================================================
+// 진행 중인 워커 스레드 분석 (메쉬당 하나)
+// ============================================================================
+struct FVertexAnalysisTask
+{
+	// 캐시 키 (워커는 시작 시 복사한 스냅샷만 읽음 → 메쉬를 붙잡지 않음)
+	TWeakObjectPtr<USkeletalMesh> Mesh;
+	UE::Tasks::FTask Task;
+	
+	// 워커가 기록, Task 완료 후에만 읽음
+	TSharedPtr<const FMeshVertexAnalysis> Result;
+	std::atomic<bool> bCancelled{false};
+};
+
+// ============================================================================
+// 메쉬별 버텍스 분석 캐시
+// 버텍스 수집 / 리덕션을 메쉬당 한 번만 실행 → Shape Info / 웨폰 박스 / Physics 바디가 공유
+// 메쉬 리임포트 또는 PostEditChange 시 해당 메쉬 엔트리 무효화 (진행 중인 분석도 취소)
+// 같은 메쉬 분석은 동시에 하나만 → 프리페치 / Prewarm / GetAnalysis가 같은 작업을 기다림
+// ============================================================================
+class FBoneVertexAnalysisCache
+{
+public:
+	static FBoneVertexAnalysisCache& Get();
+	
+	// 모듈 Startup/Shutdown에서 호출 (에디터 델리게이트 등록/해제)
+	void RegisterInvalidationHooks();
+	void UnregisterInvalidationHooks();
+	
+	// 캐시에 없으면 계산 후 저장 (진행 중인 분석이 있으면 그 완료를 기다림)
+	// 무효화되어도 반환된 결과는 계속 유효
+	TSharedRef<const FMeshVertexAnalysis> GetAnalysis(USkeletalMesh* Mesh);
+	
+	void Invalidate(const USkeletalMesh* Mesh);
+	void InvalidateAll();
+	
+	// 캐시된 결과가 현재 본 수와 맞는지 (게임 스레드)
+	bool IsCached(const USkeletalMesh* Mesh) const;
+	
+	// 캐시를 거치지 않는 계산 (게임 스레드 - 메쉬 LOD 데이터는 게임 스레드에서 다시 만들어질 수 있음)
+	static TSharedRef<const FMeshVertexAnalysis> Analyze(USkeletalMesh* Mesh);
+	void Store(USkeletalMesh* Mesh, TSharedRef<const FMeshVertexAnalysis> Analysis);
+	
+	// 메쉬 데이터를 복사한 뒤 워커 스레드 분석 시작, 완료되면 게임 스레드에서 캐시 저장
+	// 취소는 복사본 분배 / 리덕션 사이에서 반영
+	// 같은 메쉬 분석이 진행 중이면 새로 시작하지 않고 그 작업 반환 (이미 캐시됐으면 nullptr)
+	TSharedPtr<FVertexAnalysisTask> AnalyzeAsync(USkeletalMesh* Mesh);
+	
+	// 더 이상 필요 없는 분석 (선택 변경 등) - 결과는 캐시에 저장되지 않음
+	void CancelAsync(const TSharedPtr<FVertexAnalysisTask>& Pending);
+
+private:
+	FBoneVertexAnalysisCache() = default;
+	
+	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event);
+	void OnAssetReimport(UObject* Object);
+	
+	// 완료된 작업이 아직 이 메쉬의 현재 작업이면 캐시 저장 (취소 / 무효화된 작업은 무시)
+	bool CompleteAsync(const TSharedRef<FVertexAnalysisTask>& Pending);
+	
+	TMap<TWeakObjectPtr<const USkeletalMesh>, TSharedRef<const FMeshVertexAnalysis>> Entries;
+	TMap<TWeakObjectPtr<const USkeletalMesh>, TSharedRef<FVertexAnalysisTask>> InFlight;
+	
+	FDelegateHandle PropertyChangedHandle;
+	FDelegateHandle ReimportHandle;
+};
@@ -0,0 +1,81 @@
+#pragma once
+#include "CoreMinimal.h"
+
+class UControlRigBlueprint;
+class URigVMGraph;
+
+// ============================================================================
+// 템플릿 본 슬롯: 템플릿 본 이름을 참조하는 핀 (메쉬 본 이름으로 채울 자리)
+// ============================================================================
+struct FControlRigBoneSlot
+{
+	FString PinPath;
+	FName BoneName;            // 템플릿 본 (UE5 표준 이름)
+	bool bElementKey = false;  // true = FRigElementKey 핀, false = BoneName 위젯 FName 핀
+};
+
+// ============================================================================
+// 세컨더리 함수 노드 앵커 (템플릿의 빈 AI_Setup / AI_Forward / AI_Backward)
+// 세컨더리 노드는 빈 노드를 지우고 그 자리에서 앞 노드(Neck 등)에 이어 붙임
+// ============================================================================
+struct FControlRigFunctionAnchor
+{
+	TArray<FName> EmptyNodes;  // 지울 빈 노드 (같은 종류가 여러 개면 모두)
+	FName PrevNode;            // Execute 입력에 연결된 앞 노드 (없으면 None)
+	FVector2D Position = FVector2D::ZeroVector;
+};
+
+// ============================================================================
+// Control Rig 템플릿 스냅샷 (템플릿 버전별 1회 전처리)
+// - 베이크 에셋: 템플릿 복제 후 메쉬 본 제거 (템플릿 전용 IK/heel/tip 본만 유지)
+//   → 새 리그는 이 에셋을 복제 (캐릭터마다 템플릿 전체 복제 → 본 삭제 반복 없음)
+// - 본 슬롯: 그래프 전체 핀 순회 없이 슬롯 목록만 매핑으로 채움
+// - 컨트롤 목록 / AI_* 함수 노드 앵커: 생성 단계에서 계층 / 그래프 재탐색 없음
+// 버전 = 템플릿 패키지 파일 타임스탬프 + 크기 (+ 베이크 형식 버전)
+// 인덱스: Saved/AIRigSetup/TemplateSnapshots.json
+// 베이크 에셋: /Game/AIRigSetup/TemplateSnapshots/ (에셋 카탈로그에서 제외)
+// ============================================================================
+struct FControlRigTemplateSnapshot
+{
+	FString TemplatePath;
+	FString Version;
+	FString BakedAssetPath;
+	TArray<FControlRigBoneSlot> BoneSlots;
+	TArray<FName> Controls;
+	TMap<FString, FControlRigFunctionAnchor> FunctionAnchors;  // "AI_Setup" / "AI_Forward" / "AI_Backward"
+
+	// 템플릿 전용 본 (메쉬 본 임포트 후에도 유지)
+	static bool IsTemplateOnlyBone(const FName& BoneName);
+
+	// 템플릿 전용 본을 제외한 모든 본 삭제. 반환: 삭제한 본 수
+	static int32 RemoveMeshBones(UControlRigBlueprint* Rig);
+
+	// 그래프에서 직접 수집 (스냅샷이 없을 때 / 베이크 시)
+	static TArray<FControlRigBoneSlot> CollectBoneSlots(URigVMGraph* Graph);
+	static TMap<FString, FControlRigFunctionAnchor> FindFunctionAnchors(URigVMGraph* Graph);
+};
+
+class FControlRigTemplateSnapshotCache
+{
+public:
+	static FControlRigTemplateSnapshotCache& Get();
+
+	static const TCHAR* SnapshotFolder;
+
+	// 버전이 같으면 캐시된 스냅샷, 템플릿이 바뀌었으면 다시 베이크
+	// 템플릿이 저장 안 된 상태(더티)거나 베이크 실패 시 nullptr → 템플릿 직접 복제로 진행
+	TSharedPtr<const FControlRigTemplateSnapshot> FindOrBake(const FString& TemplatePath);
+
+private:
+	FControlRigTemplateSnapshotCache();
+
+	static FString ComputeTemplateVersion(const FString& TemplatePath);
+	static FString GetBakedAssetPath(const FString& TemplatePath);
+	TSharedPtr<const FControlRigTemplateSnapshot> Bake(const FString& TemplatePath, const FString& Version);
+
+	FString GetIndexFilePath() const;
+	void Load();
+	void Save() const;
+
+	TMap<FString, TSharedPtr<const FControlRigTemplateSnapshot>> Snapshots;  // 템플릿 경로 → 스냅샷
+};
@@ -1,7 +1,6 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
-#include "HAL/PlatformProcess.h"
 
 class FControlRigToolModule : public IModuleInterface
 {
@@ -10,8 +9,6 @@ public:
 	virtual void ShutdownModule() override;
 private:
 	void RegisterMenus();
-	void StartAPIServer();
 	
 	TSharedPtr<class FUICommandList> PluginCommands;
-	FProcHandle ServerProcessHandle;
 };
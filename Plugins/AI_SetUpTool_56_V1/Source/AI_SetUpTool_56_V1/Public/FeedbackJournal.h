@@ -0,0 +1,57 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+// ============================================================================
+// 학습 신호(승인/분류 피드백) 오프라인 저널 (Saved/AIRigSetup/FeedbackJournal.jsonl)
+// - 기록 즉시 파일에 한 줄 추가 → 호출부는 서버 응답을 기다리지 않음
+// - 백그라운드로 서버에 재전송 (/approve, /classify_batch)
+//   이번 세션 기록은 서버를 띄워서라도 전송, 이전 세션 기록은 서버가 준비됐을 때만
+// - 연속된 분류 피드백은 /classify_batch 한 번으로 합쳐서 전송
+// - 전달된 엔트리는 파일에서 제거 (남은 엔트리만 .tmp에 기록 후 교체 → 중간에 끊겨도 기존 파일 유지)
+// - 5xx가 반복되는 엔트리(서버 처리 중 예외 등)는 뒤 엔트리를 막지 않도록
+//   묶음 전송이면 단독 전송으로 분리, 단독으로도 계속 실패하면 FeedbackJournal.dead.jsonl로 이동
+// 줄 형식: <id>\t<endpoint>\t<condensed JSON body>
+// ============================================================================
+class FFeedbackJournal
+{
+public:
+	static FFeedbackJournal& Get();
+
+	void Append(const FString& Endpoint, const FString& Body);
+	int32 NumPending() const { return Entries.Num(); }
+
+	// 모듈 종료 시 호출 (남은 엔트리는 파일에 유지 → 다음 세션에 재전송)
+	void Shutdown();
+
+private:
+	FFeedbackJournal();
+
+	struct FEntry
+	{
+		uint64 Id = 0;
+		FString Endpoint;
+		FString Body;
+		bool bThisSession = false;
+		int32 ServerErrors = 0;   // 연속 5xx 횟수 (세션 내)
+		bool bSendAlone = false;  // 묶음 전송이 계속 실패 → 단독 전송으로 원인 엔트리 분리
+	};
+
+	FString GetJournalFilePath() const;
+	FString GetDeadLetterFilePath() const;
+	void MoveToDeadLetter(const TArray<uint64>& Ids, int32 ResponseCode, const FString& Response);
+	void Load();
+	void Compact() const;
+	static FString ToLine(const FEntry& Entry);
+
+	void EnsureTicker();
+	bool Tick(float DeltaTime);
+	void SendNext();
+	void OnSendComplete(const TArray<uint64>& SentIds, int32 ResponseCode, const FString& Response);
+
+	TArray<FEntry> Entries;
+	uint64 NextId = 1;
+	bool bInFlight = false;
+	double NextAttemptTime = 0.0;
+	FTSTicker::FDelegateHandle TickerHandle;
+};
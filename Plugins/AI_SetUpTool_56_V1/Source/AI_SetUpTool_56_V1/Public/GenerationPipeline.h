@@ -0,0 +1,79 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+struct FScopedSlowTask;
+class UObject;
+
+// ============================================================================
+// 생성 단계 (진행 바 순서)
+// ============================================================================
+enum class EGenerationStage : uint8
+{
+	Load,
+	Analyze,
+	Map,
+	BuildHierarchy,
+	BuildGraph,
+	Compile,
+	Save,
+	Num
+};
+
+// ============================================================================
+// 단계별 생성 파이프라인 스코프 (에셋 생성 함수 1개 = 파이프라인 1개)
+// - 진행 바 + 취소 버튼 (헤드리스면 진행 로그만)
+// - EnterStage / Tick에서 취소 확인 → false면 호출부가 바로 return
+// - RunInBackground: CPU 전용 작업을 태스크 그래프에서 실행, 대기 중에도 진행 바 갱신
+//   (UObject 생성/수정은 게임 스레드 단계에서만)
+// - Commit 없이 스코프를 벗어나면 (실패/취소) 이번에 만든 에셋 삭제 + 롤백 실행
+// ============================================================================
+class FGenerationPipeline
+{
+public:
+	FGenerationPipeline(const FString& InTitle, bool bInHeadless, TFunction<void(const FString&)> InStatusSink);
+	~FGenerationPipeline();
+
+	FGenerationPipeline(const FGenerationPipeline&) = delete;
+	FGenerationPipeline& operator=(const FGenerationPipeline&) = delete;
+
+	// 다음 단계로 진행 (건너뛴 단계만큼 진행 바도 이동). 취소되면 false
+	bool EnterStage(EGenerationStage Stage);
+
+	// 게임 스레드 루프 중간에 호출 (진행 바/취소 버튼 처리). 취소되면 false
+	bool Tick();
+
+	// CPU 전용 작업 (UObject 수정 금지). 작업 결과 false 또는 취소면 false
+	// 취소돼도 작업은 끝까지 기다림 (참조 캡처 안전)
+	bool RunInBackground(TFunction<bool()> Work);
+
+	// 실패/취소 시 삭제할 에셋
+	void TrackCreatedAsset(UObject* Asset);
+
+	// 실패/취소 시 실행할 복구 작업 (등록 역순 실행)
+	void AddRollback(TFunction<void()> Rollback);
+
+	// 성공 확정 → 롤백 안 함
+	void Commit() { bCommitted = true; }
+
+	bool IsCancelled() const { return bCancelled; }
+
+	static const TCHAR* GetStageName(EGenerationStage Stage);
+
+private:
+	void Rollback();
+
+	FString Title;
+	bool bHeadless = false;
+	TFunction<void(const FString&)> StatusSink;
+	TUniquePtr<FScopedSlowTask> SlowTask;
+
+	int32 CurrentStage = INDEX_NONE;
+	bool bCancelled = false;
+	bool bCommitted = false;
+	double StartTime = 0.0;
+	double StageStartTime = 0.0;
+
+	TArray<TWeakObjectPtr<UObject>> CreatedAssets;
+	TArray<TFunction<void()>> Rollbacks;
+};
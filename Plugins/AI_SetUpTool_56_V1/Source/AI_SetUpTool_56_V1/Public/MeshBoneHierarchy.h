@@ -0,0 +1,38 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+struct FReferenceSkeleton;
+class USkeletalMesh;
+
+// ============================================================================
+// 스켈레탈 메쉬를 로드하지 않고 본 계층 읽기
+// - 이미 메모리에 있는 메쉬 → 그 RefSkeleton (추가 로드 없음)
+// - 에셋 레지스트리 태그(Skeleton, Bones)로 USkeleton만 로드 (렌더 데이터 / LOD 없음)
+//   스켈레톤 본 수 == 메쉬 본 수일 때만 사용
+//   (메쉬 본은 항상 스켈레톤 본의 부분집합 → 개수가 같으면 같은 집합)
+// - 태그가 없거나 본 수가 다르면 메쉬 로드 (폴백)
+// 스켈레톤 경로는 본 인덱스 순서가 메쉬와 다를 수 있음 → 본 이름으로 대응시킬 것
+// 버텍스/스킨 웨이트가 필요한 생성 단계는 여기 대신 메쉬를 직접 로드
+// ============================================================================
+class FMeshBoneHierarchy
+{
+public:
+	enum class ESource : uint8
+	{
+		LoadedMesh,   // 이미 로드된 메쉬
+		Skeleton,     // 스켈레톤 에셋만 로드
+		MeshLoad      // 폴백: 메쉬 전체 로드
+	};
+
+	// 본 계층 (실패 시 nullptr). 반환 포인터는 같은 프레임 안에서만 사용
+	static const FReferenceSkeleton* Read(const FString& MeshPath, ESource* OutSource = nullptr);
+
+	// 메모리에 이미 있는 메쉬 (없으면 nullptr, 로드 안 함)
+	static USkeletalMesh* FindLoadedMesh(const FString& MeshPath);
+
+	// 패키지 경로 또는 오브젝트 경로 → 에셋 데이터 (썸네일용, 로드 안 함)
+	static FAssetData GetAssetData(const FString& Path);
+
+	static const TCHAR* GetSourceName(ESource Source);
+};
@@ -0,0 +1,63 @@
+#pragma once
+#include "CoreMinimal.h"
+
+struct FReferenceSkeleton;
+
+// ============================================================================
+// 네이티브 본 매퍼 (api_server.py 체인 분석 v4 포팅)
+// analyze_and_map_skeleton / map_chain / map_fingers 규칙을 그대로 옮김
+// 표준 스켈레톤은 Python 서버 없이 바로 매핑, 못 찾은 본만 서버에 요청
+// ============================================================================
+class FNativeBoneMapper
+{
+public:
+	// 스켈레톤 전체 분석 → target(UE5 표준 본) -> source(메쉬 본)
+	static TMap<FName, FName> MapSkeleton(const FReferenceSkeleton& RefSkeleton);
+	
+	// 코어 본(pelvis, spine, neck/head, 팔, 다리)이 모두 매핑됐는지
+	// false면 빠진 본은 서버(/predict)에 요청
+	static bool IsCoreMappingComplete(const TMap<FName, FName>& Mapping);
+	
+	// 네이티브 결과 우선, 서버 결과로 빈 target만 채움
+	static void MergeServerMapping(TMap<FName, FName>& InOutMapping, const TMap<FName, FName>& ServerMapping);
+
+private:
+	struct FSkeletonView
+	{
+		TArray<FString> Names;
+		TArray<FString> LowerNames;
+		TArray<int32> Parents;
+		TArray<TArray<int32>> Children;  // 본 인덱스 순서
+	};
+	
+	struct FMappingState
+	{
+		TMap<FString, int32> Targets;  // target -> 본 인덱스
+		TSet<int32> MappedSources;
+		
+		bool Contains(const FString& Target) const { return Targets.Contains(Target); }
+		void Set(const FString& Target, int32 BoneIndex)
+		{
+			Targets.Add(Target, BoneIndex);
+			MappedSources.Add(BoneIndex);
+		}
+		void AddIfMissing(const FString& Target, int32 BoneIndex)
+		{
+			if (!Targets.Contains(Target))
+			{
+				Set(Target, BoneIndex);
+			}
+		}
+	};
+	
+	// 분석 헬퍼 (Python 함수와 1:1 대응)
+	static bool IsSecondaryBone(const FString& LowerName);
+	static TCHAR DetectSide(const FString& LowerName);  // 'l', 'r', 0
+	static FString GetBoneTypeFromKeyword(const FString& LowerName);
+	static TArray<int32> GetChainFromBone(const FSkeletonView& View, int32 BoneIndex, const FString& ChainType = FString(), int32 MaxDepth = 10);
+	static TArray<int32> GetParentChain(const FSkeletonView& View, int32 BoneIndex, int32 MaxDepth = 10);
+	
+	static void MapLegChain(const TArray<TPair<int32, TArray<int32>>>& Chains, const FString& Side, const FSkeletonView& View, FMappingState& State);
+	static void MapArms(const FSkeletonView& View, FMappingState& State);
+	static void MapFingers(const TArray<int32>& FingerRoots, const FSkeletonView& View, const FString& Side, FMappingState& State);
+};
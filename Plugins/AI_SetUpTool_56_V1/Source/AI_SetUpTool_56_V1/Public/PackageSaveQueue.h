@@ -0,0 +1,60 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UPackage;
+class UObject;
+
+// ============================================================================
+// 패키지 저장 결과 (패키지 1개)
+// ============================================================================
+struct FPackageSaveResult
+{
+	FString PackageName;
+	double Seconds = 0.0;    // 직렬화 시간 (게임 스레드)
+	int64 SizeBytes = 0;     // 디스크 파일 크기 (쓰기 완료 후)
+	bool bSuccess = false;
+};
+
+// ============================================================================
+// 패키지 일괄 저장 큐 스코프
+// - 스코프 동안 Save() 호출은 등록만 → 가장 바깥 스코프 종료(또는 Flush) 시 한 번에 저장
+// - 직렬화는 게임 스레드에서 순서대로, 파일 쓰기는 SAVE_Async로 백그라운드 동시 진행
+//   → 마지막에 한 번만 쓰기 완료 대기
+// - 활성 스코프가 없으면 Save()가 바로 저장 (버튼 하나로 에셋 하나 만드는 경우)
+// - 같은 패키지를 여러 번 등록해도 한 번만 저장
+// ============================================================================
+class FPackageSaveQueue
+{
+public:
+	explicit FPackageSaveQueue(const FString& InTitle);
+	~FPackageSaveQueue();
+
+	FPackageSaveQueue(const FPackageSaveQueue&) = delete;
+	FPackageSaveQueue& operator=(const FPackageSaveQueue&) = delete;
+
+	// 활성 큐에 등록 (없으면 즉시 저장). 즉시 저장 실패 시에만 false
+	static bool Save(UPackage* Package, UObject* Asset);
+
+	// 등록된 패키지 저장 (중첩 스코프에서 호출하면 바깥 큐를 비움)
+	const TArray<FPackageSaveResult>& Flush();
+
+	// 지금까지 Flush된 결과 전체
+	const TArray<FPackageSaveResult>& GetResults() const { return Results; }
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<UPackage> Package;
+		TWeakObjectPtr<UObject> Asset;
+	};
+
+	FPackageSaveQueue& GetRoot() { return OuterScope ? OuterScope->GetRoot() : *this; }
+
+	FString Title;
+	FPackageSaveQueue* OuterScope = nullptr;
+	TArray<FEntry> Entries;
+	TArray<FPackageSaveResult> Results;
+
+	static TArray<FPackageSaveQueue*>& GetActiveScopes();
+};
@@ -0,0 +1,53 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Rigs/RigHierarchyDefines.h"
+#include "Rigs/RigHierarchyElements.h"
+
+class UControlRigBlueprint;
+class URigHierarchy;
+class URigHierarchyController;
+
+// ============================================================================
+// 리그 계층 일괄 편집 스코프
+// - 스코프 동안 계층 알림 중단 (AddNull / AddControl은 HC로 바로 호출해도 알림 없음)
+// - 삭제 / 부모 변경 / 컨트롤 설정은 모아뒀다가 Flush에서 한 번에 적용
+// - 스코프 종료 시 트랜스폼 1회 재계산 + 인스턴스 전파
+// - 같은 블루프린트에 중첩되면 바깥 스코프에 합류
+// ============================================================================
+class FRigHierarchyBatchEdit
+{
+public:
+	explicit FRigHierarchyBatchEdit(UControlRigBlueprint* InBlueprint);
+	~FRigHierarchyBatchEdit();
+
+	FRigHierarchyBatchEdit(const FRigHierarchyBatchEdit&) = delete;
+	FRigHierarchyBatchEdit& operator=(const FRigHierarchyBatchEdit&) = delete;
+
+	URigHierarchy* GetHierarchy() const { return Hierarchy; }
+	URigHierarchyController* GetController() const { return Controller; }
+
+	// 지연 적용 - Flush에서 삭제 → 부모 변경 → 컨트롤 설정 순서 (같은 종류끼리는 추가한 순서)
+	void RemoveElement(const FRigElementKey& Key);
+	void SetParent(const FRigElementKey& Child, const FRigElementKey& Parent, bool bMaintainGlobalTransform = true);
+	void SetControlSettings(const FRigElementKey& Key, const FRigControlSettings& Settings);
+
+	// 모아둔 변경 적용 (이후 단계가 결과를 바로 봐야 할 때 명시적으로 호출)
+	// 반환: 성공한 변경 수 (바깥 스코프에 합류했으면 다른 코드가 쌓은 변경 포함)
+	// OutFailed: 실패한 변경의 대상 요소 (호출부가 자기 변경의 성공 여부를 판단할 때)
+	int32 Flush(TSet<FRigElementKey>* OutFailed = nullptr);
+
+private:
+	FRigHierarchyBatchEdit& GetRoot() { return OuterScope ? OuterScope->GetRoot() : *this; }
+
+	UControlRigBlueprint* Blueprint = nullptr;
+	URigHierarchy* Hierarchy = nullptr;
+	URigHierarchyController* Controller = nullptr;
+	FRigHierarchyBatchEdit* OuterScope = nullptr;
+	bool bPrevSuspendNotifications = false;
+
+	TArray<FRigElementKey> PendingRemoves;
+	TArray<TTuple<FRigElementKey, FRigElementKey, bool>> PendingParents;
+	TArray<TPair<FRigElementKey, FRigControlSettings>> PendingSettings;
+
+	static TArray<FRigHierarchyBatchEdit*>& GetActiveScopes();
+};
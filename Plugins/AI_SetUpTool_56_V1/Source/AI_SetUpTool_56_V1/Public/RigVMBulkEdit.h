@@ -0,0 +1,50 @@
+#pragma once
+#include "CoreMinimal.h"
+
+class URigVMBlueprint;
+class URigVMController;
+
+// ============================================================================
+// RigVM 그래프 일괄 편집 스코프
+// - 언두 브래킷 1개, 모델 알림 / 자동 VM 재컴파일 중단
+// - 스코프 종료 시 EdGraph 재구성 + VM 컴파일 1회
+// - 같은 블루프린트에 중첩되면 바깥 스코프에 합류 (컴파일은 가장 바깥에서만)
+// 컨트롤러 호출은 BulkEdit->AddLink(...) 형태로 → 호출 수 집계
+// ============================================================================
+class FRigVMBulkEdit
+{
+public:
+	FRigVMBulkEdit(URigVMBlueprint* InBlueprint, URigVMController* InController, const FString& InTitle);
+	~FRigVMBulkEdit();
+
+	FRigVMBulkEdit(const FRigVMBulkEdit&) = delete;
+	FRigVMBulkEdit& operator=(const FRigVMBulkEdit&) = delete;
+
+	URigVMController* operator->()
+	{
+		++OperationCount;
+		return Controller;
+	}
+
+	// 집계하지 않는 조회용 접근
+	URigVMController* GetController() const { return Controller; }
+
+	int32 GetOperationCount() const { return OperationCount; }
+
+	// 배열 핀 전체를 한 번의 SetPinDefaultValue로 설정 (InsertArrayPin 반복 대신)
+	bool SetArrayPinDefaultValue(const FString& ArrayPinPath, const TArray<FString>& Elements);
+
+	// FRigElementKey 배열 요소 문자열: (Type=Bone,Name="...")
+	static TArray<FString> MakeElementKeys(const TCHAR* ElementType, const TArray<FName>& Names);
+
+private:
+	URigVMBlueprint* Blueprint = nullptr;
+	URigVMController* Controller = nullptr;
+	FRigVMBulkEdit* OuterScope = nullptr;
+	FString Title;
+	int32 OperationCount = 0;
+	bool bPrevAutoVMRecompile = true;
+	double StartTime = 0.0;
+
+	static TArray<FRigVMBulkEdit*>& GetActiveScopes();
+};
@@ -3,9 +3,15 @@
 #include "CoreMinimal.h"
 #include "Widgets/SCompoundWidget.h"
 #include "Widgets/DeclarativeSyntaxSupport.h"
+#include "Containers/Ticker.h"
 #include "Widgets/Input/SComboBox.h"
 #include "Widgets/Input/SCheckBox.h"
+#include "Widgets/Views/SListView.h"
+#include "Widgets/Views/STreeView.h"
 #include "AssetThumbnail.h"
+#include "BoneMapping.h"
+#include "BoneMappingSession.h"
+#include "PackageSaveQueue.h"
 
 class UControlRigBlueprint;
 class USkeletalMesh;
@@ -15,6 +21,11 @@ class SBox;
 class SVerticalBox;
 class SScrollBox;
 class SWidgetSwitcher;
+class FJsonObject;
+class FSkeletonTopology;
+class FRigVMBulkEdit;
+class FGenerationPipeline;
+struct FRigElementKey;
 
 // ============================================================================
 // 워크플로우 단계
@@ -108,15 +119,73 @@ struct FBoneDisplayInfo
 	{}
 };
 
+// ============================================================================
+// 세컨더리 함수 노드 배치 (AI_Setup / AI_Forward / AI_Backward)
+// 최종 생성 때 기록 → 분류 변경 시 Space 단위로 노드 추가 / 삭제 / 배열 패치
+// ============================================================================
+struct FSecondaryFunctionLayout
+{
+	static constexpr int32 NumKinds = 3;
+	static constexpr const TCHAR* KindNames[NumKinds] = { TEXT("AI_Setup"), TEXT("AI_Forward"), TEXT("AI_Backward") };
+	static constexpr float XSpacing = 400.0f;  // Space별 가로 간격
+	
+	bool bResolved = false;                   // 템플릿 빈 노드 처리 완료 (시작 위치 / 앞 노드 확정)
+	FVector2D StartPos[NumKinds];
+	FName PrevNode[NumKinds];                 // 첫 세컨더리 노드의 Execute 앞 노드 (Neck 등)
+	TArray<FName> SpaceOrder;                 // Execute 체인 순서 (Space 부모 이름)
+	TMap<FName, TArray<FName>> NodesBySpace;  // Space 부모 → 종류별 노드 이름 (NumKinds개)
+	int32 NextSpaceIndex = 0;                 // 새 Space 노드의 가로 배치 인덱스
+};
+
+// ============================================================================
+// 헤드리스 배치 실행 (AIRigSetup Commandlet)
+// ============================================================================
+struct FAIRigSetupJob
+{
+	FString MeshPath;                // 대상 스켈레탈 메쉬 패키지 경로
+	FString TemplatePath;            // Control Rig 템플릿 (이름 또는 패키지 경로, 비우면 기본 템플릿)
+	FString IKRigTemplatePath;       // IK Rig 템플릿 오브젝트 경로 (비우면 기본 템플릿)
+	FString OutputFolder = TEXT("/Game/AIRigSetup");  // 출력 루트 (메쉬 이름별 하위 폴더 생성)
+	bool bControlRig = true;
+	bool bIKRig = true;
+	bool bPhysicsAsset = true;
+	bool bKawaii = true;
+	float MappingTimeout = 120.0f;   // AI 서버 응답 대기 시간 (초)
+};
+
+struct FAIRigSetupStageTiming
+{
+	FString Stage;
+	double Seconds = 0.0;
+	bool bSuccess = false;
+	bool bSkipped = false;
+};
+
+struct FAIRigSetupReport
+{
+	FString MeshName;
+	TArray<FAIRigSetupStageTiming> Stages;
+	TArray<FPackageSaveResult> SavedPackages;  // 마지막에 한 번에 저장한 패키지별 시간/크기
+	double TotalSeconds = 0.0;
+	bool bSuccess = false;
+};
+
 class SControlRigToolWidget : public SCompoundWidget
 {
 public:
-	SLATE_BEGIN_ARGS(SControlRigToolWidget) {}
+	SLATE_BEGIN_ARGS(SControlRigToolWidget)
+		: _Headless(false)
+	{}
+		// UI 없이 파이프라인만 사용 (Commandlet용)
+		SLATE_ARGUMENT(bool, Headless)
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs);
 	virtual ~SControlRigToolWidget();
 
+	// 매핑 → Control Rig → IK Rig → Physics Asset → Kawaii AnimBP 를 UI 없이 순서대로 실행
+	bool RunHeadlessSetup(const FAIRigSetupJob& Job, FAIRigSetupReport& OutReport);
+
 private:
 	struct FAssetInfo
 	{
@@ -148,6 +217,8 @@ private:
 	// 데이터
 	void LoadAssetData();
 	void RefreshData();
+	void OnAssetCatalogChanged();     // 카탈로그 증분 갱신 → 콤보 옵션만 다시 구성
+	void ApplyAssetFilters();         // 타입어헤드 필터 → Filtered*Options
 
 	// 썸네일
 	void UpdateTemplateThumbnail();
@@ -177,6 +248,12 @@ private:
 	void RequestAIBoneMapping();
 	bool CreateBodyControlRig();       // Body Control Rig만 생성 (저장 X)
 	bool CreateFinalControlRig();      // 세컨더리 추가 + 최종 저장
+	
+	// 최종 생성 이후 분류 변경분만 반영 (템플릿 복제 / 본 교체 / 전체 재생성 없음)
+	bool CanUpdateSecondaryIncrementally() const;
+	bool UpdateSecondaryControlRig();
+	void MarkClassificationDirty(const FBoneDisplayInfo& Info);
+	void ResetSecondaryBuildState();
 	void RemapBoneReferences(class UControlRigBlueprint* Rig);
 	void SendApproveRequest();
 	
@@ -184,23 +261,32 @@ private:
 	FReply OnCreateSecondaryOnlyControlRigClicked();
 	bool CreateSecondaryOnlyControlRig();
 	
-	// 세컨더리 컨트롤러 생성
-	void CreateSecondaryControlsFromSelection(class UControlRigBlueprint* Rig, class USkeletalMesh* Mesh);
+	// 세컨더리 컨트롤러 생성 (취소 / 실패 시 false → 호출부 파이프라인이 롤백)
+	bool CreateSecondaryControlsFromSelection(FGenerationPipeline& Pipeline, class UControlRigBlueprint* Rig, class USkeletalMesh* Mesh);
+	void RevertSecondaryEdits(class UControlRigBlueprint* Rig, const TSet<FRigElementKey>& BodyElements, const TSet<FName>& BodyNodes);
 	bool IsZeroBone(const FString& BoneName) const;
 	bool IsAccessoryBone(const FString& BoneName) const;
 	bool IsHelperBone(const FString& BoneName) const;
 	
 	// 체인 분석 및 Space/Control 생성
-	FName FindZeroBoneParent(const FName& BoneName, const FReferenceSkeleton& RefSkel) const;
+	TArray<FName> FindZeroBoneParents(const TArray<FName>& BoneNames, const USkeletalMesh* Mesh) const;
 	void BuildSecondaryChains(class USkeletalMesh* Mesh, TMap<FName, TArray<FName>>& OutChainsBySpace);
 	void CreateSpaceNull(class URigHierarchyController* HC, const FName& SpaceName, const FTransform& Transform);
+	FTransform GetSecondarySpaceTransform(const FName& SpaceParent, const FReferenceSkeleton& RefSkel) const;
 	void CreateChainControls(class URigHierarchyController* HC, class URigHierarchy* Hierarchy, 
 		const FName& SpaceName, const TArray<FName>& ChainBones, const FReferenceSkeleton& RefSkel);
 	bool HasSkinWeight(class USkeletalMesh* Mesh, const FName& BoneName) const;
 	
+	// 스켈레톤 토폴로지 인덱스 (메쉬당 한 번 빌드, 리임포트 등으로 본 구성이 바뀌면 재빌드)
+	// 메쉬 약참조 키 → GC된 메쉬 엔트리는 조회 때 정리
+	const FSkeletonTopology& GetSkeletonTopology(const USkeletalMesh* Mesh) const;
+	mutable TMap<TWeakObjectPtr<const USkeletalMesh>, TSharedPtr<FSkeletonTopology>> SkeletonTopologies;
+	
 	// 본 선택 UI 관련
 	void BuildBoneDisplayList();
 	void UpdateBoneSelectionUI();
+	void UpdateBoneSelectionHeader();
+	TSharedRef<ITableRow> OnGenerateBoneRow(TSharedPtr<int32> Item, const TSharedRef<STableViewBase>& OwnerTable);
 	void OnBoneClassificationChanged(EBoneClassification NewClassification, int32 BoneIndex);
 	void OnBoneRowClicked(int32 BoneIndex, const FModifierKeysState& ModifierKeys);
 	TSharedRef<SWidget> CreateBoneRow(int32 Index);
@@ -208,34 +294,74 @@ private:
 	// Weapon 본 처리
 	void CreateWeaponControlsFromSelection(class UControlRigBlueprint* Rig, class USkeletalMesh* Mesh);
 	void CreateWeaponSpaceAndControls(class URigHierarchyController* HC, class URigHierarchy* Hierarchy,
-		bool bIsLeft, const TArray<FName>& WeaponBones, const FReferenceSkeleton& RefSkel);
+		bool bIsLeft, const TArray<FName>& WeaponBones, class USkeletalMesh* Mesh);
 	void ConnectWeaponFunctionNodes(class UControlRigBlueprint* Rig, 
 		bool bIsLeft, const FName& WeaponSpaceName, const TArray<FName>& WeaponBones, const TArray<FName>& WeaponCtrls);
 	
+	// 헤드리스 실행 헬퍼
+	bool WaitForMappingResponse(double TimeoutSeconds);
+	int32 AutoTagKawaiiChainRoots();
+
 	// 헬퍼
 	FString GetSelectedTemplatePath() const;
 	FString GetSelectedMeshPath() const;
 	void SetStatus(const FString& Message);
 	void DisplayMappingResults();
+	void OnAIBoneMappingCompleted(const FString& Method);
+	void RefreshMappingCacheModelVersion();
+	
+	// 탭 공유 매핑 세션 - 탭이 잡은 세션이 바뀌면 구독/해제, 결과는 세션을 잡은 모든 탭에 반영
+	TSharedRef<FBoneMappingSession> AcquireMappingSession(TSharedPtr<FBoneMappingSession>& TabSession, const FString& MeshPath);
+	void SetTabMappingSession(TSharedPtr<FBoneMappingSession>& TabSession, const TSharedPtr<FBoneMappingSession>& NewSession);
+	void OnMappingSessionChanged(FBoneMappingSession& Session, EBoneMappingSessionChange Change);
+	void ApplyMappingSessionToControlRigTab(EBoneMappingSessionChange Change);
+	void ApplyMappingSessionToIKTab(EBoneMappingSessionChange Change);
+	void ApplyMappingSessionToPhysAssetTab(EBoneMappingSessionChange Change);
 	void UpdateWorkflowUI();  // 워크플로우 단계에 따라 UI 업데이트
 	
-	// 분류 피드백 (AI 학습용)
-	void SendClassificationFeedback(const FString& BoneName, const FString& Classification);
+	// 메쉬 선택 시 매핑 / 버텍스 분석 선행 실행 (버튼 클릭 전에 캐시 채움)
+	void StartSelectionPrefetch(const FString& MeshPath);
+	void OnPrefetchMeshLoaded(const FString& MeshPath, uint32 Serial);
+	
+	// 분류 피드백 (AI 학습용) - 모았다가 /classify_batch로 한 번에 전송
+	void QueueClassificationFeedback(FName BoneName, const FString& Classification);
+	void FlushClassificationFeedback();
+	bool OnClassificationFeedbackTimer(float DeltaTime);
 	
 	// RigVM 함수 노드 연결 (AI_Setup, AI_Forward, AI_Backward)
-	void ConnectSecondaryFunctionNodes(class UControlRigBlueprint* Rig, 
-		const TMap<FName, TArray<FName>>& ChainsBySpace);
+	bool ConnectSecondaryFunctionNodes(class UControlRigBlueprint* Rig, 
+		const TMap<FName, TArray<FName>>& ChainsBySpace, FSecondaryFunctionLayout* OutLayout = nullptr);
+	bool PatchFunctionNodeArrays(FRigVMBulkEdit& BulkEdit, class URigVMGraph* Graph, const FName& NodeName,
+		const TArray<FName>& Bones, const TArray<FName>& Controls);
+	void RemoveFunctionNodeWithArrays(FRigVMBulkEdit& BulkEdit, class URigVMGraph* Graph, const FName& NodeName);
+	static bool LinkExecutePins(FRigVMBulkEdit& BulkEdit, const FString& FromNode, const FString& ToNode);
 	class URigVMNode* FindLastAIFunctionNode(class URigVMGraph* Graph, const FString& FunctionPrefix);
-	class URigVMNode* AddFunctionReferenceNode(class URigVMController* Controller, 
+	class URigVMNode* AddFunctionReferenceNode(FRigVMBulkEdit& BulkEdit, 
 		const FString& FunctionName, const FVector2D& Position, FString& OutDebugInfo);
-	void SetFunctionNodePins(class URigVMController* Controller, class URigVMNode* FuncNode,
+	void SetFunctionNodePins(FRigVMBulkEdit& BulkEdit, class URigVMNode* FuncNode,
 		const FName& BoneName, const FName& SpaceName, 
 		const TArray<FName>& Bones, const TArray<FName>& Controls);
 
 private:
+	// 헤드리스 모드 (Commandlet) - 위젯/다이얼로그 없이 동작
+	bool bHeadless = false;
+	bool bMappingRequestInFlight = false;
+	
+	// 선택 선행 작업 (새 선택이 오면 이전 작업 취소)
+	uint32 PrefetchSerial = 0;
+	FString PrefetchMeshPath;
+	TSharedPtr<class FBoneMappingBatch> PrefetchMappingBatch;
+	TSharedPtr<struct FVertexAnalysisTask> PrefetchVertexTask;
+	
+	// 탭별 매핑 세션 (같은 메쉬를 고른 탭은 같은 세션 → 탭 전환 시 재요청 없음)
+	TSharedPtr<FBoneMappingSession> ControlRigMappingSession;
+	TSharedPtr<FBoneMappingSession> IKMappingSession;
+	TSharedPtr<FBoneMappingSession> PhysAssetMappingSession;
+	
 	// 워크플로우 상태
 	EControlRigWorkflowStep CurrentStep = EControlRigWorkflowStep::Step1_Setup;
 	TWeakObjectPtr<UControlRigBlueprint> PendingControlRig;  // 아직 저장 안 된 임시 Control Rig
+	TSharedPtr<const struct FControlRigTemplateSnapshot> PendingTemplateSnapshot;  // PendingControlRig를 만든 템플릿 스냅샷 (없으면 템플릿 직접 복제)
 	FString PendingOutputPath;  // 저장할 경로
 	
 	// 에셋 데이터
@@ -248,6 +374,16 @@ private:
 	TSharedPtr<FString> SelectedTemplate;
 	TSharedPtr<FString> SelectedMesh;
 
+	// 타입어헤드 필터 (Control Rig 탭 템플릿/메쉬 콤보)
+	TArray<TSharedPtr<FString>> FilteredTemplateOptions;
+	TArray<TSharedPtr<FString>> FilteredMeshOptions;
+	FString TemplateFilterText;
+	FString MeshFilterText;
+
+	// 카탈로그 리비전 (같으면 옵션 재구성 생략)
+	uint32 LoadedCatalogRevision = 0;
+	FDelegateHandle CatalogChangedHandle;
+
 	// 위젯
 	TSharedPtr<SComboBox<TSharedPtr<FString>>> TemplateComboBox;
 	TSharedPtr<SComboBox<TSharedPtr<FString>>> MeshComboBox;
@@ -268,8 +404,9 @@ private:
 	TSharedPtr<SVerticalBox> MappingResultBox;
 	
 	// 본 선택 UI
-	TSharedPtr<SVerticalBox> BoneSelectionBox;
-	TSharedPtr<SScrollBox> BoneScrollBox;
+	TSharedPtr<SVerticalBox> BoneSelectionBox;           // 헤더 (통계 + 범례)
+	TSharedPtr<SListView<TSharedPtr<int32>>> BoneListView;  // 가상화 목록 (보이는 행만 생성)
+	TArray<TSharedPtr<int32>> BoneListItems;              // BoneDisplayList 인덱스
 	TArray<FBoneDisplayInfo> BoneDisplayList;
 	int32 LastSelectedBoneIndex = INDEX_NONE;  // Shift 다중선택용
 
@@ -279,12 +416,29 @@ private:
 	TSharedPtr<SButton> SecondaryOnlyButton;  // 세컨더리 전용 Control Rig 버튼
 
 	// 매핑 데이터
-	TMap<FName, FName> LastBoneMapping;  // target -> source
+	FBoneMapping LastBoneMapping;  // target -> source
 	TWeakObjectPtr<USkeletalMesh> CachedMesh;
 	
+	// 분류 피드백 대기열 (같은 본은 마지막 분류만 유지, 디바운스 후 일괄 전송)
+	TMap<FName, FString> PendingClassificationFeedback;
+	TWeakObjectPtr<USkeletalMesh> PendingFeedbackMesh;
+	FTSTicker::FDelegateHandle FeedbackFlushHandle;
+	
 	// 세컨더리 컨트롤러 생성 결과
 	int32 LastSecondaryControlCount = 0;
 	
+	// 마지막 최종 생성 결과 (이후 분류 변경은 이 상태와의 차이만 리그에 반영)
+	struct FSecondaryBuildState
+	{
+		TWeakObjectPtr<UControlRigBlueprint> Rig;
+		TWeakObjectPtr<USkeletalMesh> Mesh;
+		TMap<FName, EBoneClassification> Classifications;  // Helper가 아닌 본만
+		TMap<FName, TArray<FName>> ChainsBySpace;           // Space 부모 → 체인 본 (스켈레톤 순서)
+		FSecondaryFunctionLayout Layout;
+	};
+	FSecondaryBuildState LastSecondaryBuild;
+	TSet<FName> DirtyClassificationBones;  // 마지막 생성 이후 분류가 바뀐 본
+	
 	// 본별 버텍스 기반 Shape Transform 정보
 	struct FBoneShapeInfo
 	{
@@ -332,9 +486,14 @@ private:
 	FReply OnAddKawaiiTagClicked();
 	void UpdateKawaiiMeshThumbnail();
 	void BuildKawaiiBoneDisplayList();
+	void FillKawaiiBoneDisplayList(const FReferenceSkeleton& RefSkel, USkeletalMesh* WeightMesh);
+	void SyncKawaiiBoneDisplayListToMesh(USkeletalMesh* Mesh);  // 생성 직전: 메쉬 본 순서 + 스킨 웨이트 반영
 	void UpdateKawaiiBoneTreeUI();
 	void UpdateKawaiiTagListUI();
 	TSharedRef<SWidget> CreateKawaiiBoneRow(int32 Index);
+	TSharedRef<ITableRow> OnGenerateKawaiiBoneRow(TSharedPtr<int32> Item, const TSharedRef<STableViewBase>& OwnerTable);
+	void OnGetKawaiiBoneChildren(TSharedPtr<int32> Item, TArray<TSharedPtr<int32>>& OutChildren);
+	void OnKawaiiBoneExpansionChanged(TSharedPtr<int32> Item, bool bExpanded);
 	TSharedRef<SWidget> CreateKawaiiTagRow(int32 TagIndex);
 	void OnKawaiiBoneTagChanged(int32 BoneIndex, int32 NewTagIndex);
 	void OnKawaiiTagNameChanged(int32 TagIndex, const FText& NewName);
@@ -357,15 +516,6 @@ private:
 	FString DefaultOutputFolder = TEXT("/Game/ControlRigs");
 	static constexpr int32 ThumbnailSize = 64;
 	
-	// 제로 뼈구조 (UE5 표준 본) - 이 외의 본들이 세컨더리
-	static const TSet<FString> ZeroBones;
-	
-	// 액세서리 키워드 (컨트롤러 생성 O)
-	static const TArray<FString> AccessoryKeywords;
-	
-	// 헬퍼 키워드 (컨트롤러 생성 X)
-	static const TArray<FString> HelperKeywords;
-	
 	// IK Rig 관련
 	TArray<TSharedPtr<FString>> IKRigTemplateOptions;
 	TSharedPtr<FString> SelectedIKRigTemplate;
@@ -382,7 +532,7 @@ private:
 	TSharedPtr<SEditableTextBox> IKOutputFolderBox;
 	TSharedPtr<STextBlock> IKStatusText;
 	TSharedPtr<SVerticalBox> IKMappingResultBox;
-	TMap<FName, FName> IKBoneMapping;  // target -> source (IK Rig용)
+	FBoneMapping IKBoneMapping;  // target -> source (IK Rig용)
 	FString IKDefaultOutputFolder = TEXT("/Game/IKRigs");
 	
 	// 탭 관련
@@ -394,11 +544,15 @@ private:
 	// ============================================================================
 	TArray<FKawaiiTag> KawaiiTags;                        // 태그 목록
 	TArray<FKawaiiBoneDisplayInfo> KawaiiBoneDisplayList; // 본 목록
+	bool bKawaiiSkinWeightsPending = false;               // 메쉬 로드 전이라 스킨 웨이트 미확인
 	TSharedPtr<FString> SelectedKawaiiMesh;
 	TSharedPtr<SComboBox<TSharedPtr<FString>>> KawaiiMeshComboBox;
 	TSharedPtr<FAssetThumbnail> KawaiiMeshThumbnail;
 	TSharedPtr<SBox> KawaiiMeshThumbnailBox;
-	TSharedPtr<SVerticalBox> KawaiiBoneTreeBox;           // 스켈레톤 트리 박스
+	TSharedPtr<STreeView<TSharedPtr<int32>>> KawaiiBoneTreeView;  // 가상화 스켈레톤 트리
+	TArray<TSharedPtr<int32>> KawaiiBoneItems;            // 행 인덱스 == 본 인덱스
+	TArray<TSharedPtr<int32>> KawaiiBoneRootItems;
+	TArray<TArray<TSharedPtr<int32>>> KawaiiBoneChildItems;
 	TSharedPtr<SVerticalBox> KawaiiTagListBox;            // 태그 목록 박스
 	TSharedPtr<SEditableTextBox> KawaiiOutputNameBox;
 	TSharedPtr<SEditableTextBox> KawaiiOutputFolderBox;
@@ -451,7 +605,7 @@ private:
 	TSharedPtr<SEditableTextBox> PhysAssetOutputFolderBox;
 	TSharedPtr<STextBlock> PhysAssetStatusText;
 	FString PhysAssetDefaultOutputFolder = TEXT("/Game/PhysicsAssets");
-	TMap<FName, FName> PhysAssetBoneMapping;              // 본 매핑 결과 (StandardBone -> MeshBone)
+	FBoneMapping PhysAssetBoneMapping;                    // 본 매핑 결과 (StandardBone -> MeshBone)
 	TArray<FName> PhysAssetMainBones;                     // 메인 본 목록 (캡슐 생성 대상)
 	
 	// Physics Asset UI 함수
@@ -0,0 +1,70 @@
+#pragma once
+#include "CoreMinimal.h"
+
+struct FReferenceSkeleton;
+
+// ============================================================================
+// 스켈레톤 토폴로지 인덱스 (메쉬당 한 번 빌드)
+// 자식 목록 / 깊이 / 서브트리 범위(오일러 투어) / 가장 가까운 마킹 조상
+// 부모 따라 올라가기, 자식 찾기 전체 스캔(O(N²)) 대체용
+// ============================================================================
+class FSkeletonTopology
+{
+public:
+	FSkeletonTopology() = default;
+	explicit FSkeletonTopology(const FReferenceSkeleton& RefSkeleton) { Build(RefSkeleton); }
+
+	void Build(const FReferenceSkeleton& RefSkeleton);
+
+	// 같은 본 구성으로 빌드됐는지 (리임포트 등으로 바뀌면 false)
+	// 본 수 + 인덱스 순서의 이름 / 부모 인덱스 시그니처 비교 (메모리 주소 재사용과 무관)
+	bool IsBuiltFrom(const FReferenceSkeleton& RefSkeleton) const;
+	static uint32 ComputeSignature(const FReferenceSkeleton& RefSkeleton);
+
+	int32 Num() const { return Parents.Num(); }
+	bool IsValidIndex(int32 BoneIndex) const { return Parents.IsValidIndex(BoneIndex); }
+
+	int32 FindBoneIndex(const FName& BoneName) const
+	{
+		const int32* Found = NameToIndex.Find(BoneName);
+		return Found ? *Found : INDEX_NONE;
+	}
+
+	int32 GetParent(int32 BoneIndex) const { return Parents[BoneIndex]; }
+	int32 GetDepth(int32 BoneIndex) const { return Depths[BoneIndex]; }
+
+	// 자식 본 인덱스 (본 인덱스 오름차순)
+	TArrayView<const int32> GetChildren(int32 BoneIndex) const
+	{
+		return TArrayView<const int32>(ChildList.GetData() + ChildStart[BoneIndex], ChildStart[BoneIndex + 1] - ChildStart[BoneIndex]);
+	}
+	bool HasChildren(int32 BoneIndex) const { return ChildStart[BoneIndex + 1] > ChildStart[BoneIndex]; }
+
+	// 서브트리 = DfsOrder[EnterTime, ExitTime) (자기 자신 포함)
+	TArrayView<const int32> GetSubtree(int32 BoneIndex) const
+	{
+		return TArrayView<const int32>(DfsOrder.GetData() + EnterTime[BoneIndex], ExitTime[BoneIndex] - EnterTime[BoneIndex]);
+	}
+
+	// Ancestor == Bone이면 true
+	bool IsAncestorOf(int32 Ancestor, int32 Bone) const
+	{
+		return EnterTime[Ancestor] <= EnterTime[Bone] && ExitTime[Bone] <= ExitTime[Ancestor];
+	}
+
+	// 각 본에서 가장 가까운 마킹된 조상 (자기 자신 제외, 없으면 INDEX_NONE)
+	// 부모가 항상 자식보다 앞 인덱스이므로 한 번의 패스로 계산
+	TArray<int32> BuildNearestMarkedAncestors(const TBitArray<>& Marked) const;
+
+private:
+	TArray<int32> Parents;
+	TArray<int32> Depths;
+	TArray<int32> ChildStart;  // CSR: 본 i의 자식 = ChildList[ChildStart[i], ChildStart[i+1])
+	TArray<int32> ChildList;
+	TArray<int32> DfsOrder;
+	TArray<int32> EnterTime;
+	TArray<int32> ExitTime;
+	TMap<FName, int32> NameToIndex;
+
+	uint32 Signature = 0;
+};